@@ -32,6 +32,9 @@ extern "C" {
 
 #define F_CPU 1000000
 
+/* stdio does not use a periph/uart device, all of them are free */
+#define STDIO (-1)
+
 void _native_LED_GREEN_OFF(void);
 #define LED_GREEN_OFF (_native_LED_GREEN_OFF())
 void _native_LED_GREEN_ON(void);
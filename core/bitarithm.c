@@ -19,9 +19,32 @@
  * @}
  */
 
-#include <stdio.h>
+#include <stdint.h>
 
-unsigned bitarithm_msb(unsigned v)
+#include "bitarithm.h"
+
+/* bit number of the highest '1' and number of '1's of a nibble */
+static const uint8_t _nibble_msb[16] = {
+    0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3
+};
+static const uint8_t _nibble_bits[16] = {
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+};
+
+#if ARCH_32_BIT
+/* position of the isolated lowest bit, indexed by its de Bruijn product */
+static const uint8_t _debruijn_lsb[32] = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+#else
+/* bit number of the lowest '1' of a nibble */
+static const uint8_t _nibble_lsb[16] = {
+    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0
+};
+#endif
+
+unsigned bitarithm_msb_generic(unsigned v)
 {
     register unsigned r; // result of log2(v) will go here
 
@@ -31,37 +54,41 @@ unsigned bitarithm_msb(unsigned v)
     r =     (v > 0xFFFF) << 4; v >>= r;
     shift = (v > 0xFF  ) << 3; v >>= shift; r |= shift;
     shift = (v > 0xF   ) << 2; v >>= shift; r |= shift;
-    shift = (v > 0x3   ) << 1; v >>= shift; r |= shift;
-                                            r |= (v >> 1);
 #else
     r = 0;
-    while (v >>= 1) { // unroll for more speed...
-        r++;
+    while (v > 0xF) {
+        v >>= 4;
+        r += 4;
     }
-
 #endif
 
-    return r;
+    return r + _nibble_msb[v];
 }
 /*---------------------------------------------------------------------------*/
-unsigned bitarithm_lsb(register unsigned v)
+unsigned bitarithm_lsb_generic(unsigned v)
 {
+#if ARCH_32_BIT
+    /* a single multiplication, cheap on every 32 bit core */
+    return _debruijn_lsb[((uint32_t)((v & -v) * 0x077CB531U)) >> 27];
+#else
     register unsigned r = 0;
 
-    while ((v & 0x01) == 0) {
-        v >>= 1;
-        r++;
-    };
+    while ((v & 0xF) == 0) {
+        v >>= 4;
+        r += 4;
+    }
 
-    return r;
+    return r + _nibble_lsb[v & 0xF];
+#endif
 }
 /*---------------------------------------------------------------------------*/
-unsigned bitarithm_bits_set(unsigned v)
+unsigned bitarithm_bits_set_generic(unsigned v)
 {
-    unsigned c; // c accumulates the total bits set in v
+    unsigned c = 0; // c accumulates the total bits set in v
 
-    for (c = 0; v; c++) {
-        v &= v - 1; // clear the least significant bit set
+    while (v) {
+        c += _nibble_bits[v & 0xF];
+        v >>= 4;
     }
 
     return c;
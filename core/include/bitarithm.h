@@ -91,32 +91,98 @@
 #define ARCH_32_BIT   (__INT_MAX__ == 2147483647) /**< 1 for 32 bit architectures, 0 otherwise */
 
 /**
- * @brief   Returns the number of the highest '1' bit in a value
+ * @brief   1 if the compiler can map bitarithm_msb() and bitarithm_lsb() to
+ *          a count leading/trailing zeros instruction, 0 otherwise
+ *
+ * @details ARM cores from ARMv5 on (except for ARMv6-M, i.e. Cortex-M0)
+ *          have CLZ (and ARMv7 RBIT for trailing zeros), x86 has BSR/BSF.
+ *          Everything else (e.g. MSP430, AVR, Cortex-M0) uses the
+ *          table-driven implementations below.
+ */
+#if defined(__ARM_FEATURE_CLZ) || defined(__i386__) || defined(__x86_64__)
+#define BITARITHM_HAS_CLZ   (1)
+#else
+#define BITARITHM_HAS_CLZ   (0)
+#endif
+
+/**
+ * @brief   1 if bitarithm_bits_set() should use the compiler's popcount,
+ *          0 otherwise
+ */
+#if defined(__i386__) || defined(__x86_64__)
+#define BITARITHM_HAS_POPCOUNT  (1)
+#else
+#define BITARITHM_HAS_POPCOUNT  (0)
+#endif
+
+/**
+ * @brief   Table-driven implementation of bitarithm_msb()
  * @param[in]   v   Input value
  * @return          Bit Number
  *
  * Source: http://graphics.stanford.edu/~seander/bithacks.html#IntegerLogObvious
  */
-unsigned bitarithm_msb(unsigned v);
+unsigned bitarithm_msb_generic(unsigned v);
 
 /**
- * @brief   Returns the number of the lowest '1' bit in a value
+ * @brief   Table-driven implementation of bitarithm_lsb()
  * @param[in]   v   Input value - must be unequal to '0', otherwise the
  *                  function will produce an infinite loop
  * @return          Bit Number
  *
- * Source: http://graphics.stanford.edu/~seander/bithacks.html#IntegerLogObvious
+ * Source: http://graphics.stanford.edu/~seander/bithacks.html#ZerosOnRightMultLookup
+ */
+unsigned bitarithm_lsb_generic(unsigned v);
+
+/**
+ * @brief   Table-driven implementation of bitarithm_bits_set()
+ * @param[in]   v   Input value
+ * @return          Number of set bits
+ */
+unsigned bitarithm_bits_set_generic(unsigned v);
+
+/**
+ * @brief   Returns the number of the highest '1' bit in a value
+ * @param[in]   v   Input value
+ * @return          Bit Number, 0 for @p v = 0
+ */
+static inline unsigned bitarithm_msb(unsigned v)
+{
+#if BITARITHM_HAS_CLZ
+    return (v == 0) ? 0 : ((sizeof(unsigned) * 8) - 1 - __builtin_clz(v));
+#else
+    return bitarithm_msb_generic(v);
+#endif
+}
+
+/**
+ * @brief   Returns the number of the lowest '1' bit in a value
+ * @param[in]   v   Input value - must be unequal to '0', otherwise the
+ *                  result is undefined
+ * @return          Bit Number
  */
-unsigned bitarithm_lsb(register unsigned v);
+static inline unsigned bitarithm_lsb(unsigned v)
+{
+#if BITARITHM_HAS_CLZ
+    return __builtin_ctz(v);
+#else
+    return bitarithm_lsb_generic(v);
+#endif
+}
 
 /**
  * @brief   Returns the number of bits set in a value
  * @param[in]   v   Input value
  * @return          Number of set bits
- *
- * Source: http://graphics.stanford.edu/~seander/bithacks.html#IntegerLogObvious
  */
-unsigned bitarithm_bits_set(unsigned v);
+static inline unsigned bitarithm_bits_set(unsigned v)
+{
+#if BITARITHM_HAS_POPCOUNT
+    return __builtin_popcount(v);
+#else
+    return bitarithm_bits_set_generic(v);
+#endif
+}
 
 #ifdef __cplusplus
 }
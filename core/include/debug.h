@@ -53,8 +53,18 @@ extern "C" {
  * implementation file, all usages of ::DEBUG_PRINT will print the given
  * information to stdout after verifying the stack is big enough. If `DEVELHELP`
  * is not set, this check is not performed. (CPU exception may occur)
+ *
+ * With the `log_binary` module the information is only recorded and
+ * formatted on the host, so neither the stack nor the time of the caller is
+ * spent on printf. Files whose output log_binary can not record, e.g. 64 bit
+ * values, strings in buffers or `*` widths, define `DEBUG_USE_PRINTF`
+ * before including debug.h to keep printing with printf.
  */
-#if DEVELHELP
+#if defined(MODULE_LOG_BINARY) && !defined(DEBUG_USE_PRINTF)
+/* recorded without formatting, see sys_log_binary */
+#include "log.h"
+#define DEBUG_PRINT(...) log_write(LOG_DEBUG, __VA_ARGS__)
+#elif DEVELHELP
 #include "cpu_conf.h"
 #define DEBUG_PRINT(...) \
     do { \
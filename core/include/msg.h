@@ -191,6 +191,7 @@ int msg_try_receive(msg_t *m);
  * @param[in] target_pid    The PID of the target process
  *
  * @return  1, if successful.
+ * @return  -1, on error (invalid PID)
  */
 int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid);
 
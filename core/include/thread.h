@@ -35,6 +35,13 @@
  */
 #define STATUS_NOT_FOUND (-1)
 
+/**
+ * @brief Number of PIDs thread_reserve_pid() can hand out
+ */
+#ifndef THREAD_RESERVED_PIDS_NUMOF
+#define THREAD_RESERVED_PIDS_NUMOF  (16)
+#endif
+
  /**
  * @def THREAD_STACKSIZE_DEFAULT
  * @brief A reasonable default stack size that will suffice most smaller tasks
@@ -215,6 +222,19 @@ static inline kernel_pid_t thread_getpid(void)
     return sched_active_pid;
 }
 
+/**
+ * @brief Reserves a PID for a module that runs without a thread of its own
+ *
+ * The PIDs come after @ref KERNEL_PID_LAST and KERNEL_PID_ISR, so they
+ * never name a thread, and messages sent to them fail with `-1`. Modules
+ * must not make up such PIDs themselves, they would collide.
+ *
+ * @return          the reserved PID
+ * @return          `KERNEL_PID_UNDEF` if all
+ *                  @ref THREAD_RESERVED_PIDS_NUMOF PIDs are taken
+ */
+kernel_pid_t thread_reserve_pid(void);
+
 #ifdef DEVELHELP
 /**
  * @brief Returns the name of a process
@@ -77,11 +77,12 @@ int msg_try_send(msg_t *m, kernel_pid_t target_pid)
 
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state)
 {
-#if DEVELHELP
     if (!pid_is_valid(target_pid)) {
-        DEBUG("msg_send(): target_pid is invalid, continuing anyways\n");
+        /* e.g. a PID of thread_reserve_pid(), there is no thread to index */
+        DEBUG("msg_send(): target_pid is invalid\n");
+        restoreIRQ(state);
+        return -1;
     }
-#endif /* DEVELHELP */
 
     tcb_t *target = (tcb_t*) sched_threads[target_pid];
 
@@ -179,11 +180,10 @@ int msg_send_to_self(msg_t *m)
 
 int msg_send_int(msg_t *m, kernel_pid_t target_pid)
 {
-#if DEVELHELP
     if (!pid_is_valid(target_pid)) {
-        DEBUG("msg_send(): target_pid is invalid, continuing anyways\n");
+        DEBUG("msg_send_int(): target_pid is invalid\n");
+        return -1;
     }
-#endif /* DEVELHELP */
 
     tcb_t *target = (tcb_t *) sched_threads[target_pid];
 
@@ -214,6 +214,11 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
 
 int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
 {
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_send_receive(): target_pid is invalid\n");
+        return -1;
+    }
+
     unsigned state = disableIRQ();
     tcb_t *me = (tcb_t*) sched_threads[sched_active_pid];
     sched_set_status(me, STATUS_REPLY_BLOCKED);
@@ -227,12 +232,14 @@ int msg_reply(msg_t *m, msg_t *reply)
 {
     unsigned state = disableIRQ();
 
-    tcb_t *target = (tcb_t*) sched_threads[m->sender_pid];
+    /* range checked, the sender may be KERNEL_PID_ISR */
+    tcb_t *target = (tcb_t*) thread_get(m->sender_pid);
 
     if (!target) {
         DEBUG("msg_reply(): %" PRIkernel_pid ": Target \"%" PRIkernel_pid
               "\" not existing...dropping msg!\n", sched_active_thread->pid,
               m->sender_pid);
+        restoreIRQ(state);
         return -1;
     }
 
@@ -258,11 +265,12 @@ int msg_reply(msg_t *m, msg_t *reply)
 
 int msg_reply_int(msg_t *m, msg_t *reply)
 {
-    tcb_t *target = (tcb_t*) sched_threads[m->sender_pid];
+    tcb_t *target = (tcb_t*) thread_get(m->sender_pid);
 
-    if (target->status != STATUS_REPLY_BLOCKED) {
+    if (!target || (target->status != STATUS_REPLY_BLOCKED)) {
         DEBUG("msg_reply_int(): %" PRIkernel_pid ": Target \"%" PRIkernel_pid
-              "\" not waiting for reply.", sched_active_thread->pid, target->pid);
+              "\" not waiting for reply.", sched_active_thread->pid,
+              m->sender_pid);
         return -1;
     }
 
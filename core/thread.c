@@ -32,6 +32,11 @@
 #include "hwtimer.h"
 #include "sched.h"
 
+/* KERNEL_PID_LAST + 1 is KERNEL_PID_ISR */
+#define RESERVED_PID_FIRST  (KERNEL_PID_LAST + 2)
+
+static unsigned reserved_pids_numof;
+
 volatile tcb_t *thread_get(kernel_pid_t pid)
 {
     if (pid_is_valid(pid)) {
@@ -91,6 +96,19 @@ int thread_wakeup(kernel_pid_t pid)
     }
 }
 
+kernel_pid_t thread_reserve_pid(void)
+{
+    kernel_pid_t pid = KERNEL_PID_UNDEF;
+    unsigned old_state = disableIRQ();
+
+    if (reserved_pids_numof < THREAD_RESERVED_PIDS_NUMOF) {
+        pid = RESERVED_PID_FIRST + reserved_pids_numof++;
+    }
+    restoreIRQ(old_state);
+
+    return pid;
+}
+
 void thread_yield(void)
 {
     unsigned old_state = disableIRQ();
@@ -7,6 +7,11 @@
  *
  * XXX: does not scale well with number of timers (overhead: O(N)).
  *
+ * With the native_vtime module the timers run on a virtual clock
+ * instead: time does not pass while threads are running (apart from
+ * NATIVE_VTIME_READ_TICKS per hwtimer_arch_now call, so busy waiting
+ * terminates) and jumps to the next deadline as soon as the CPU idles.
+ *
  * Copyright (C) 2013 Ludwig Ortmann <ludwig.ortmann@fu-berlin.de>
  *
  * This file is subject to the terms and conditions of the GNU Lesser
@@ -28,6 +33,7 @@
 
 #include <time.h>
 #include <sys/time.h>
+#include <inttypes.h>
 #include <signal.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -46,7 +52,11 @@
 
 #include "debug.h"
 
+#ifdef MODULE_NATIVE_VTIME
+#define HWTIMERMINOFFSET (1UL) // virtual deadlines are exact
+#else
 #define HWTIMERMINOFFSET (1000UL) // 1ms
+#endif
 
 static unsigned long native_hwtimer_now;
 static unsigned long time_null;
@@ -57,6 +67,14 @@ static int native_hwtimer_isset[HWTIMER_MAXTIMERS];
 static int next_timer = -1;
 static void (*int_handler)(int);
 
+#ifdef MODULE_NATIVE_VTIME
+#ifndef NATIVE_VTIME_READ_TICKS
+#define NATIVE_VTIME_READ_TICKS (1)     /**< virtual time passing per clock read */
+#endif
+
+static uint64_t native_vtime;           /**< virtual ticks since startup */
+#endif
+
 
 /**
  * Subtract the `struct timeval' values x and y, storing the result in
@@ -134,6 +152,9 @@ void schedule_timer(void)
     }
     if (next_timer == -1) {
         DEBUG("schedule_timer(): no valid timer found - nothing to schedule\n");
+#ifdef MODULE_NATIVE_VTIME
+        _native_syscall_enter();
+#endif
         struct itimerval null_timer;
         null_timer.it_interval.tv_sec = 0;
         null_timer.it_interval.tv_usec = 0;
@@ -142,6 +163,12 @@ void schedule_timer(void)
         if (real_setitimer(ITIMER_REAL, &null_timer, NULL) == -1) {
             err(EXIT_FAILURE, "schedule_timer: setitimer");
         }
+#ifdef MODULE_NATIVE_EPOLL
+        _native_event_set_timer(NULL);
+#endif
+#ifdef MODULE_NATIVE_VTIME
+        _native_syscall_leave();
+#endif
         return;
     }
 
@@ -170,6 +197,12 @@ void schedule_timer(void)
         result.it_value.tv_sec = 0;
         result.it_value.tv_usec = 1;
     }
+#ifdef MODULE_NATIVE_VTIME
+    else {
+        /* the timer will be fired by _native_vtime_advance once idle */
+        memset(&result, 0, sizeof(result));
+    }
+#endif
 
     _native_syscall_enter();
     if (real_setitimer(ITIMER_REAL, &result, NULL) == -1) {
@@ -178,9 +211,64 @@ void schedule_timer(void)
     else {
         DEBUG("schedule_timer(): set next timer (%i).\n", next_timer);
     }
+#ifdef MODULE_NATIVE_EPOLL
+    /* the itimer preempts running threads, the timerfd wakes up idle */
+    _native_event_set_timer(timerisset(&result.it_value) ? &result.it_value : NULL);
+#endif
     _native_syscall_leave();
 }
 
+#ifdef MODULE_NATIVE_VTIME
+/**
+ * jump the virtual clock to the next timer deadline and queue the timer
+ * interrupt (called from the idle loop)
+ *
+ * returns 0 if there was a timer to advance to, -1 otherwise
+ */
+int _native_vtime_advance(void)
+{
+    uint64_t deadline = UINT64_MAX;
+
+    if (next_timer != -1) {
+        /* timer values are absolute and wrap with unsigned long */
+        unsigned long offset = tv2ticks(&native_hwtimer[next_timer].it_value)
+                               - (unsigned long) native_vtime;
+        deadline = native_vtime + offset;
+    }
+
+    if (_native_vtime_ctrl_fd != -1) {
+        /* other instances might still be busy before our deadline */
+        uint64_t granted = _native_vtime_sync(deadline);
+        if (granted < deadline) {
+            if (granted > native_vtime) {
+                native_vtime = granted;
+            }
+            return 0;
+        }
+    }
+    else if (deadline == UINT64_MAX) {
+        return -1;
+    }
+
+    DEBUG("_native_vtime_advance(): %" PRIu64 " -> %" PRIu64 "\n",
+          native_vtime, deadline);
+    native_vtime = deadline;
+
+    int sig = SIGALRM;
+    if (real_write(_sig_pipefd[1], &sig, sizeof(int)) == -1) {
+        err(EXIT_FAILURE, "_native_vtime_advance: real_write()");
+    }
+    _native_sigpend++;
+
+    return 0;
+}
+
+uint64_t _native_vtime_now(void)
+{
+    return native_vtime;
+}
+#endif
+
 /**
  * native timer signal handler
  *
@@ -268,10 +356,15 @@ void hwtimer_arch_set_absolute(unsigned long value, short timer)
 
 unsigned long hwtimer_arch_now(void)
 {
-    struct timespec t;
-
     DEBUG("hwtimer_arch_now()\n");
 
+#ifdef MODULE_NATIVE_VTIME
+    native_vtime += NATIVE_VTIME_READ_TICKS;
+    native_hwtimer_now = (unsigned long) native_vtime;
+    return native_hwtimer_now;
+#else
+    struct timespec t;
+
     _native_syscall_enter();
 #ifdef __MACH__
     clock_serv_t cclock;
@@ -298,6 +391,7 @@ unsigned long hwtimer_arch_now(void)
             (unsigned long)tv.tv_sec, (unsigned long)tv.tv_usec);
     DEBUG("hwtimer_arch_now(): returning %lu\n", native_hwtimer_now);
     return native_hwtimer_now;
+#endif
 }
 
 /**
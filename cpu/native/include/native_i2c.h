@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    native_i2c Native mock I2C bus
+ * @ingroup     native_cpu
+ * @brief       I2C bus with slaves implemented by the application
+ *
+ * The native I2C bus does not talk to any hardware. Instead, the
+ * application attaches mock slaves, which model the register map of a
+ * device in software. Every transaction addressed to a slave calls one of
+ * its callbacks, a transaction to an address without slave fails like a
+ * NACK.
+ *
+ * Transactions without register address (i2c_read_bytes() and
+ * i2c_write_bytes()) use the register pointer of the slave, which is set
+ * by the first byte written.
+ * @{
+ *
+ * @file
+ * @brief       Native mock I2C bus
+ */
+
+#ifndef NATIVE_I2C_H
+#define NATIVE_I2C_H
+
+#include <stdint.h>
+
+#include "periph/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A mock I2C slave
+ */
+typedef struct native_i2c_slave native_i2c_slave_t;
+
+/**
+ * @brief   A mock I2C slave
+ */
+struct native_i2c_slave {
+    native_i2c_slave_t *next;   /**< next slave on the bus */
+    uint8_t addr;               /**< 7 bit slave address */
+    uint8_t reg;                /**< register pointer */
+    /**
+     * @brief   Reads @p len bytes starting at register @p reg
+     *
+     * @return  number of bytes read, negative to NACK
+     */
+    int (*read)(native_i2c_slave_t *slave, uint8_t reg, char *data, int len);
+    /**
+     * @brief   Writes @p len bytes starting at register @p reg
+     *
+     * @return  number of bytes written, negative to NACK
+     */
+    int (*write)(native_i2c_slave_t *slave, uint8_t reg, const char *data,
+                 int len);
+};
+
+/**
+ * @brief   Attaches a mock slave to a bus
+ *
+ * @param[in] dev       the bus
+ * @param[in] slave     the slave, addr, read and write must be set
+ */
+void native_i2c_attach(i2c_t dev, native_i2c_slave_t *slave);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_I2C_H */
+/** @} */
@@ -92,6 +92,8 @@ extern void (*real_srandom)(unsigned int seed);
 extern int (*real_accept)(int socket, ...);
 /* The ... is a hack to save includes: */
 extern int (*real_bind)(int socket, ...);
+/* The ... is a hack to save includes: */
+extern int (*real_connect)(int socket, ...);
 extern int (*real_chdir)(const char *path);
 extern int (*real_close)(int);
 /* The ... is a hack to save includes: */
@@ -152,6 +154,8 @@ extern pid_t _native_id;
 extern unsigned _native_rng_seed;
 extern int _native_rng_mode; /**< 0 = /dev/random, 1 = random(3) */
 extern const char *_native_unix_socket_path;
+extern const char *_native_spi_path; /**< SPI backend, see periph/spi.c */
+extern const char *_native_adc_path; /**< ADC samples, see periph/adc.c */
 
 #ifdef MODULE_UART0
 #include <sys/select.h>
@@ -161,6 +165,58 @@ extern fd_set _native_rfds;
 ssize_t _native_read(int fd, void *buf, size_t count);
 ssize_t _native_write(int fd, const void *buf, size_t count);
 
+#ifdef MODULE_NATIVE_VTIME
+extern const char *_native_vtime_ctrl_path;
+extern int _native_vtime_ctrl_fd;
+
+/**
+ * connect to the virtual time controller if _native_vtime_ctrl_path is set
+ */
+void _native_vtime_init(void);
+
+/**
+ * report the next local deadline to the controller, returns the granted time
+ */
+uint64_t _native_vtime_sync(uint64_t deadline);
+
+/**
+ * advance the virtual clock to the next timer deadline (idle loop)
+ */
+int _native_vtime_advance(void);
+
+/**
+ * current virtual time in microseconds
+ */
+uint64_t _native_vtime_now(void);
+#endif
+
+#ifdef MODULE_NATIVE_EPOLL
+/**
+ * initialize the epoll based event core
+ */
+void _native_event_init(void);
+
+/**
+ * let signal sig wake up the event core (for signals sent by other processes)
+ */
+int _native_event_add_sig(int sig);
+
+/**
+ * let the event core raise interrupt sig when fd becomes readable
+ */
+int _native_event_add_fd(int fd, int sig);
+
+/**
+ * arm the event core timer relative to now, NULL disarms it
+ */
+void _native_event_set_timer(struct timeval *timeout);
+
+/**
+ * wait for and queue all pending events (idle loop)
+ */
+void _native_event_wait(void);
+#endif
+
 /**
  * register interrupt handler handler for interrupt sig
  */
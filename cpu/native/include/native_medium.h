@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    native_medium Native shared-memory radio medium
+ * @ingroup     native_cpu
+ * @brief       Virtual 802.15.4-like medium connecting many native
+ *              instances through shared memory
+ *
+ * All instances attached to a medium share one POSIX shared memory
+ * segment. It holds a receive ring per node and a directed link matrix
+ * with a loss rate and a latency per link. Sending a frame copies it into
+ * the ring of every node the sender has a link to and signals the
+ * receiving process with SIGIO; no tap device, bridge or kernel network
+ * stack is involved.
+ *
+ * The segment is created (and the topology configured) by the
+ * `native_medium` tool in dist/tools/native_medium. An instance attaches
+ * with the `-m <name>` command line option, its node number is given by
+ * `-i <id>`.
+ *
+ * The layout is shared between 32 bit RIOT processes and the (possibly
+ * 64 bit) tool, so all 64 bit members are explicitly aligned.
+ * @{
+ *
+ * @file
+ * @brief       Native shared-memory radio medium
+ */
+
+#ifndef NATIVE_MEDIUM_H
+#define NATIVE_MEDIUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NATIVE_MEDIUM_MAGIC         (0x52494f4d)    /**< "RIOM" */
+#define NATIVE_MEDIUM_FRAME_MAX     (256)   /**< maximum frame size in byte */
+#define NATIVE_MEDIUM_RX_SLOTS      (32)    /**< receive ring size per node */
+#define NATIVE_MEDIUM_NO_LINK       (0xffff)    /**< loss value: no link */
+#define NATIVE_MEDIUM_LOSS_MAX      (1000)  /**< loss values are per mille */
+
+/**
+ * @brief   Shared memory segment header
+ */
+typedef struct {
+    uint32_t magic;             /**< NATIVE_MEDIUM_MAGIC */
+    uint32_t nodes;             /**< number of nodes */
+    uint32_t slots;             /**< NATIVE_MEDIUM_RX_SLOTS of the creator */
+    uint32_t frame_max;         /**< NATIVE_MEDIUM_FRAME_MAX of the creator */
+} native_medium_hdr_t;
+
+/**
+ * @brief   Directed link between two nodes
+ */
+typedef struct {
+    uint16_t loss;              /**< loss rate in per mille, or
+                                 *   NATIVE_MEDIUM_NO_LINK */
+    uint16_t reserved;
+    uint32_t latency;           /**< latency in microseconds */
+} native_medium_link_t;
+
+/**
+ * @brief   Frame in a receive ring
+ */
+typedef struct {
+    uint64_t due __attribute__((aligned(8)));   /**< delivery time (host
+                                                 *   CLOCK_MONOTONIC or
+                                                 *   virtual time, us) */
+    uint16_t src;               /**< sending node */
+    uint16_t len;               /**< frame length */
+    uint16_t chan;              /**< channel the frame was sent on */
+    uint16_t reserved;
+    uint8_t data[NATIVE_MEDIUM_FRAME_MAX];  /**< frame */
+} native_medium_frame_t;
+
+/**
+ * @brief   Per node state: a multi-producer, single-consumer receive ring
+ */
+typedef struct {
+    volatile int32_t pid;       /**< process attached as this node, 0 if none */
+    volatile uint32_t lock;     /**< spin lock serializing senders */
+    volatile uint32_t head;     /**< next slot to write (free running) */
+    volatile uint32_t tail;     /**< next slot to read (free running) */
+    volatile uint32_t drops;    /**< frames dropped because the ring was full */
+    uint32_t reserved;
+    native_medium_frame_t frames[NATIVE_MEDIUM_RX_SLOTS];   /**< the ring */
+} native_medium_node_t;
+
+/**
+ * @brief   Size of a medium segment for @p nodes nodes
+ */
+#define NATIVE_MEDIUM_SIZE(nodes) (sizeof(native_medium_hdr_t) + \
+        (nodes) * sizeof(native_medium_node_t) + \
+        (nodes) * (nodes) * sizeof(native_medium_link_t))
+
+/**
+ * @brief   Get the node table of a medium segment
+ */
+static inline native_medium_node_t *native_medium_nodes(native_medium_hdr_t *hdr)
+{
+    return (native_medium_node_t *)(hdr + 1);
+}
+
+/**
+ * @brief   Get the link from @p src to @p dst of a medium segment
+ */
+static inline native_medium_link_t *native_medium_link(native_medium_hdr_t *hdr,
+                                                       unsigned src, unsigned dst)
+{
+    native_medium_link_t *links = (native_medium_link_t *)
+                                  (native_medium_nodes(hdr) + hdr->nodes);
+    return &links[(src * hdr->nodes) + dst];
+}
+
+#ifdef MODULE_NATIVE_MEDIUM
+/**
+ * @brief   Name of the medium to attach to (set by the `-m` option)
+ */
+extern const char *_native_medium_name;
+
+/**
+ * @brief   Attach to the medium as node _native_id
+ *
+ * @param[in] rx_cb     called in interrupt context when frames arrive
+ *
+ * @return  0 on success, exits the process if the medium can not be used
+ */
+int native_medium_init(void (*rx_cb)(void));
+
+/**
+ * @brief   Get this instance's node number on the medium
+ */
+unsigned native_medium_node(void);
+
+/**
+ * @brief   Send a frame to all neighbors
+ *
+ * @param[in] chan      channel to send on, only receivers on the same
+ *                      channel get the frame
+ * @param[in] data      the frame
+ * @param[in] len       length of @p data
+ *
+ * @return  @p len on success
+ * @return  -EOVERFLOW if @p len exceeds NATIVE_MEDIUM_FRAME_MAX
+ */
+int native_medium_send(uint16_t chan, const void *data, size_t len);
+
+/**
+ * @brief   Get the next frame that is due for delivery
+ *
+ * Frames sent on other channels than @p chan are dropped. If the next
+ * frame is not due yet, @p rx_cb is called again once it is.
+ *
+ * @param[in] chan      receiving channel
+ * @param[out] buf      buffer for the frame
+ * @param[in] max_len   size of @p buf
+ * @param[out] src      sending node, may be NULL
+ *
+ * @return  length of the frame, 0 if there is none (yet)
+ * @return  -EMSGSIZE if the frame was longer than @p max_len, it is dropped
+ */
+int native_medium_recv(uint16_t chan, void *buf, size_t max_len, uint16_t *src);
+
+/**
+ * @brief   Check if the channel is clear
+ *
+ * A frame is on the air from the moment it is sent until the latency of
+ * its link has passed, so the channel is busy while a frame on @p chan is
+ * on its way to this node. With links without latency, or in virtual time,
+ * the channel is always clear.
+ *
+ * @param[in] chan      channel to check
+ *
+ * @return  1 if the channel is clear, 0 if it is busy
+ */
+int native_medium_cca(uint16_t chan);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_MEDIUM_H */
+/** @} */
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    ng_native_medium Native medium 802.15.4 network device
+ * @ingroup     native_medium
+ * @brief       ng_netdev driver exchanging IEEE 802.15.4 frames over the
+ *              native shared-memory medium
+ *
+ * Packets starting with a netif header get an 802.15.4 data frame header
+ * from the driver. Any other packet is sent as it is, so a MAC layer can
+ * build its own frames; with @ref NETCONF_OPT_RAWMODE enabled it receives
+ * them unfiltered and unparsed. The medium carries no FCS.
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the native medium network device
+ */
+
+#ifndef NG_NATIVE_MEDIUM_H
+#define NG_NATIVE_MEDIUM_H
+
+#include <stdint.h>
+
+#include "net/ng_netdev.h"
+#include "net/ng_nettype.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum frame size (without FCS) as on a real 802.15.4 radio
+ */
+#define NG_NATIVE_MEDIUM_MAX_PKT_LENGTH     (125)
+
+/**
+ * @brief   Default channel and PAN ID
+ * @{
+ */
+#define NG_NATIVE_MEDIUM_DEFAULT_CHANNEL    (26U)
+#define NG_NATIVE_MEDIUM_DEFAULT_PANID      (0x0023)
+/** @} */
+
+/**
+ * @brief   Device options
+ * @{
+ */
+#define NG_NATIVE_MEDIUM_OPT_PROMISCUOUS    (0x0001)    /**< promiscuous mode */
+#define NG_NATIVE_MEDIUM_OPT_RAWDUMP        (0x0002)    /**< pass RAW frames up */
+#define NG_NATIVE_MEDIUM_OPT_SRC_ADDR_LONG  (0x0004)    /**< send with long
+                                                         *   source address */
+#define NG_NATIVE_MEDIUM_OPT_TELL_TX_END    (0x0008)    /**< notify MAC layer on
+                                                         *   TX finished */
+/** @} */
+
+/**
+ * @brief   Device descriptor
+ */
+typedef struct {
+    /* netdev fields */
+    const ng_netdev_driver_t *driver;   /**< pointer to the devices interface */
+    ng_netdev_event_cb_t event_cb;      /**< netdev event callback */
+    kernel_pid_t mac_pid;               /**< the driver's thread's PID */
+    /* device specific fields */
+    ng_nettype_t proto;                 /**< protocol the device expects */
+    uint16_t pan;                       /**< PAN ID */
+    uint16_t chan;                      /**< channel */
+    uint16_t addr_short;                /**< short address */
+    uint64_t addr_long;                 /**< long address */
+    uint16_t options;                   /**< state of used options */
+    uint8_t seq_nr;                     /**< sequence number to use next */
+    uint8_t state;                      /**< ng_netconf_state_t */
+} ng_native_medium_t;
+
+/**
+ * @brief   Reference to the native medium driver interface
+ */
+extern const ng_netdev_driver_t ng_native_medium_driver;
+
+/**
+ * @brief   Attach to the medium and initialize the device
+ *
+ * The short address defaults to the node number, the long address to a
+ * locally administered EUI-64 containing it.
+ *
+ * @param[out] dev      device descriptor
+ *
+ * @return  0 on success
+ */
+int ng_native_medium_init(ng_native_medium_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NG_NATIVE_MEDIUM_H */
+/** @} */
@@ -34,6 +34,56 @@
 #define RTC_NUMOF (1)
 /** @} */
 
+/**
+ * @name ADC configuration
+ *
+ * Samples are replayed from a file (see -A), continuous sampling is
+ * implemented by the CPU itself.
+ * @{
+ */
+#define ADC_NUMOF           (1U)
+#define ADC_0_EN            1
+#define ADC_MAX_CHANNELS    4
+#define ADC_0_CHANNELS      4
+#define HAVE_ADC_STREAM
+/** @} */
+
+/**
+ * @name UART configuration
+ *
+ * Each UART is connected to a pseudo terminal, see periph/uart.c.
+ * @{
+ */
+#define UART_NUMOF          (1U)
+#define UART_0_EN           1
+/** @} */
+
+/**
+ * @name SPI configuration
+ *
+ * The bus is backed by a loopback, a file or a UNIX socket (see -S), it
+ * implements spi_transfer_async() itself. Define NATIVE_SPI_SYNC to use the
+ * generic emulation of the spi_async module instead.
+ * @{
+ */
+#define SPI_NUMOF           (1U)
+#define SPI_0_EN            1
+#ifndef NATIVE_SPI_SYNC
+#define HAVE_SPI_ASYNC
+#endif
+/** @} */
+
+/**
+ * @name I2C configuration
+ *
+ * The bus is connected to mock slaves of the application, see
+ * native_i2c.h.
+ * @{
+ */
+#define I2C_NUMOF           (1U)
+#define I2C_0_EN            1
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
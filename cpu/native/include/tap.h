@@ -36,6 +36,14 @@ extern "C" {
  */
 int tap_init(char *name);
 
+#ifdef MODULE_NATIVE_MEDIUM
+/**
+ * attach nativenet to the shared-memory medium instead of a tap
+ * interface
+ */
+void nativenet_medium_init(void);
+#endif
+
 extern int _native_tap_fd;
 extern unsigned char _native_tap_mac[ETHER_ADDR_LEN];
 
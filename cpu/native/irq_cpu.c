@@ -523,6 +523,10 @@ void native_interrupt_init(void)
     }
 
 
+#ifdef MODULE_NATIVE_EPOLL
+    _native_event_init();
+#endif
+
     puts("RIOT native interrupts/signals initialized.");
 }
 /** @} */
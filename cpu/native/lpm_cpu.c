@@ -43,9 +43,55 @@ void lpm_init(void)
     return;
 }
 
-void _native_lpm_sleep(void)
+#ifdef MODULE_NATIVE_VTIME
+/**
+ * poll for pending input and advance the virtual clock if there is none
+ *
+ * returns 0 if there is something to handle without blocking
+ */
+static int _native_vtime_idle(void)
 {
+    if (_native_sigpend > 0) {
+        return 0;
+    }
+
 #ifdef MODULE_UART0
+    struct timeval zero = { 0, 0 };
+    int nfds;
+
+    FD_ZERO(&_native_rfds);
+    nfds = _native_set_uart_fds() + 1;
+
+    _native_in_syscall++;
+    nfds = real_select(nfds, &_native_rfds, NULL, NULL, &zero);
+    _native_in_syscall--;
+
+    if (nfds > 0) {
+        _native_handle_uart0_input();
+        return 0;
+    }
+#endif
+
+    return _native_vtime_advance();
+}
+#endif
+
+void _native_lpm_sleep(void)
+{
+#ifdef MODULE_NATIVE_VTIME
+    /* in virtual time idling means skipping to the next timer */
+    if (_native_vtime_idle() == 0) {
+        if (_native_sigpend > 0) {
+            _native_in_syscall++;
+            _native_syscall_leave();
+        }
+        return;
+    }
+#endif
+
+#ifdef MODULE_NATIVE_EPOLL
+    _native_event_wait();
+#elif defined(MODULE_UART0)
     int nfds;
 
     /* set fds */
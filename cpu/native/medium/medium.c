@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_medium
+ * @{
+ *
+ * @file
+ * @brief       Native shared-memory radio medium implementation
+ *
+ * @}
+ */
+
+#ifdef __MACH__
+#error "native_medium is not supported on OSX"
+#endif
+
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "hwtimer.h"
+#include "native_internal.h"
+#include "native_medium.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+const char *_native_medium_name = NULL;
+
+static native_medium_hdr_t *_medium;
+static native_medium_node_t *_self;
+static unsigned _node;
+static void (*_rx_cb)(void);
+static volatile int _retry_timer = -1;
+
+static uint64_t _now(void)
+{
+#ifdef MODULE_NATIVE_VTIME
+    /* all instances share the virtual clock of the controller */
+    return _native_vtime_now();
+#else
+    struct timespec t;
+
+    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
+        err(EXIT_FAILURE, "native_medium: clock_gettime");
+    }
+
+    return ((uint64_t)t.tv_sec * 1000000) + (t.tv_nsec / 1000);
+#endif
+}
+
+static void _lock(native_medium_node_t *node)
+{
+    while (__atomic_exchange_n(&node->lock, 1, __ATOMIC_ACQUIRE)) {
+        /* other instances only hold the lock for one frame copy */
+    }
+}
+
+static void _unlock(native_medium_node_t *node)
+{
+    __atomic_store_n(&node->lock, 0, __ATOMIC_RELEASE);
+}
+
+static void _isr(void)
+{
+    DEBUG("native_medium: rx interrupt\n");
+
+    if (_rx_cb != NULL) {
+        _rx_cb();
+    }
+}
+
+static void _retry(void *arg)
+{
+    (void)arg;
+    _retry_timer = -1;
+    _isr();
+}
+
+int native_medium_init(void (*rx_cb)(void))
+{
+    struct stat st;
+    int fd;
+
+    if (_native_medium_name == NULL) {
+        errx(EXIT_FAILURE, "native_medium: no medium given (-m <name>)");
+    }
+
+    if ((fd = shm_open(_native_medium_name, O_RDWR, 0)) == -1) {
+        err(EXIT_FAILURE, "native_medium: shm_open(%s)", _native_medium_name);
+    }
+
+    if (fstat(fd, &st) == -1) {
+        err(EXIT_FAILURE, "native_medium: fstat");
+    }
+
+    _medium = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (_medium == MAP_FAILED) {
+        err(EXIT_FAILURE, "native_medium: mmap");
+    }
+    real_close(fd);
+
+    if ((_medium->magic != NATIVE_MEDIUM_MAGIC) ||
+        (_medium->slots != NATIVE_MEDIUM_RX_SLOTS) ||
+        (_medium->frame_max != NATIVE_MEDIUM_FRAME_MAX) ||
+        ((size_t)st.st_size < NATIVE_MEDIUM_SIZE(_medium->nodes))) {
+        errx(EXIT_FAILURE, "native_medium: %s is not a compatible medium",
+             _native_medium_name);
+    }
+
+    _node = (unsigned)_native_id;
+    if (_node >= _medium->nodes) {
+        errx(EXIT_FAILURE, "native_medium: node %u out of range, use -i <0..%u>",
+             _node, (unsigned)_medium->nodes - 1);
+    }
+
+    _self = &native_medium_nodes(_medium)[_node];
+    if ((_self->pid != 0) && (_self->pid != _native_pid) &&
+        (kill(_self->pid, 0) == 0)) {
+        errx(EXIT_FAILURE, "native_medium: node %u is in use by process %i",
+             _node, (int)_self->pid);
+    }
+
+    /* discard whatever was sent to a previous instance */
+    _lock(_self);
+    _self->tail = _self->head;
+    _self->pid = _native_pid;
+    _unlock(_self);
+
+    _rx_cb = rx_cb;
+    register_interrupt(SIGIO, _isr);
+#ifdef MODULE_NATIVE_EPOLL
+    if (_native_event_add_sig(SIGIO) == -1) {
+        err(EXIT_FAILURE, "native_medium: _native_event_add_sig");
+    }
+#endif
+
+    DEBUG("native_medium: attached to %s as node %u of %u\n",
+          _native_medium_name, _node, (unsigned)_medium->nodes);
+    return 0;
+}
+
+unsigned native_medium_node(void)
+{
+    return _node;
+}
+
+int native_medium_send(uint16_t chan, const void *data, size_t len)
+{
+    native_medium_node_t *nodes = native_medium_nodes(_medium);
+    uint64_t now;
+
+    if (len > NATIVE_MEDIUM_FRAME_MAX) {
+        return -EOVERFLOW;
+    }
+
+    _native_syscall_enter();
+    now = _now();
+
+    for (unsigned dst = 0; dst < _medium->nodes; dst++) {
+        native_medium_link_t *link = native_medium_link(_medium, _node, dst);
+        native_medium_node_t *node = &nodes[dst];
+        int32_t pid = node->pid;
+
+        if ((dst == _node) || (link->loss == NATIVE_MEDIUM_NO_LINK) ||
+            (pid == 0)) {
+            continue;
+        }
+        if ((link->loss > 0) &&
+            ((unsigned)(real_random() % NATIVE_MEDIUM_LOSS_MAX) < link->loss)) {
+            DEBUG("native_medium: lost frame to %u\n", dst);
+            continue;
+        }
+
+        _lock(node);
+        if ((node->head - node->tail) >= NATIVE_MEDIUM_RX_SLOTS) {
+            node->drops++;
+            _unlock(node);
+            continue;
+        }
+
+        native_medium_frame_t *frame = &node->frames[node->head % NATIVE_MEDIUM_RX_SLOTS];
+        frame->due = now + link->latency;
+        frame->src = _node;
+        frame->len = len;
+        frame->chan = chan;
+        memcpy(frame->data, data, len);
+        __atomic_store_n(&node->head, node->head + 1, __ATOMIC_RELEASE);
+        _unlock(node);
+
+        kill(pid, SIGIO);
+    }
+
+    _native_syscall_leave();
+
+    return (int)len;
+}
+
+int native_medium_recv(uint16_t chan, void *buf, size_t max_len, uint16_t *src)
+{
+    uint32_t tail = _self->tail;
+
+    while (tail != __atomic_load_n(&_self->head, __ATOMIC_ACQUIRE)) {
+        native_medium_frame_t *frame = &_self->frames[tail % NATIVE_MEDIUM_RX_SLOTS];
+        uint64_t now = _now();
+        int len = 0;
+
+        if (frame->due > now) {
+            /* come back when the link latency has passed */
+            if (_retry_timer == -1) {
+                _retry_timer = hwtimer_set(HWTIMER_TICKS(frame->due - now),
+                                           _retry, NULL);
+            }
+            return 0;
+        }
+
+        if (frame->chan == chan) {
+            if (frame->len > max_len) {
+                /* drop it rather than passing on a partial frame */
+                len = -EMSGSIZE;
+            }
+            else {
+                len = frame->len;
+                memcpy(buf, frame->data, len);
+                if (src != NULL) {
+                    *src = frame->src;
+                }
+            }
+        }
+
+        __atomic_store_n(&_self->tail, ++tail, __ATOMIC_RELEASE);
+
+        if (len != 0) {
+            return len;
+        }
+    }
+
+    return 0;
+}
+
+int native_medium_cca(uint16_t chan)
+{
+    uint32_t head = __atomic_load_n(&_self->head, __ATOMIC_ACQUIRE);
+    uint64_t now = _now();
+
+    for (uint32_t tail = _self->tail; tail != head; tail++) {
+        native_medium_frame_t *frame = &_self->frames[tail % NATIVE_MEDIUM_RX_SLOTS];
+
+        if ((frame->chan == chan) && (frame->due > now)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
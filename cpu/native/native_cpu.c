@@ -72,7 +72,7 @@ int reboot_arch(int mode)
 #ifdef MODULE_UART0
     /* TODO: close stdio fds */
 #endif
-#ifdef MODULE_NATIVENET
+#if defined(MODULE_NATIVENET) && !defined(MODULE_NATIVE_MEDIUM)
     if (_native_tap_fd != -1) {
         real_close(_native_tap_fd);
     }
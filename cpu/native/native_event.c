@@ -0,0 +1,247 @@
+/**
+ * Native CPU epoll based event core
+ *
+ * Instead of sleeping in pause()/select() and getting woken up by one
+ * signal per timer expiry or received frame, the idle loop waits on an
+ * epoll set containing a timerfd (armed for the next hwtimer deadline),
+ * the tap file descriptors and the uart file descriptors. All events that
+ * are ready on wakeup are queued as interrupts at once and processed in a
+ * single pass of native_irq_handler().
+ *
+ * SIGALRM and SIGIO are still used while a thread is running, so
+ * interrupts preempt threads exactly as before. While idle they are
+ * blocked and, if raised in the meantime, consumed without delivery.
+ * Signals raised by other processes (see native_medium) wake up the idle
+ * loop through a signalfd.
+ *
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup native_cpu
+ * @{
+ * @file
+ * @}
+ */
+
+#ifdef MODULE_NATIVE_EPOLL
+
+#ifndef __linux__
+#error "native_epoll is only supported on Linux"
+#endif
+
+#include <err.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "native_internal.h"
+#ifdef MODULE_UART0
+#include "board_internal.h"
+#endif
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#ifndef NATIVE_EVENT_MAX
+#define NATIVE_EVENT_MAX    (16)    /**< maximum number of events per wakeup */
+#endif
+
+#define EVENT_IRQ           (0)     /**< event data: interrupt (signal) number */
+#define EVENT_UART          (1)     /**< event data: uart file descriptor */
+#define EVENT_SIGNAL        (2)     /**< event data: signalfd */
+
+#define EVENT_DATA(type, val)   (((uint64_t)(type) << 32) | (uint32_t)(val))
+#define EVENT_TYPE(data)        ((uint32_t)((data) >> 32))
+#define EVENT_VAL(data)         ((int)((data) & 0xffffffff))
+
+static int _epfd = -1;
+static int _timerfd = -1;
+static int _sigfd = -1;
+static sigset_t _event_sigs;
+
+static int _add_fd(int fd, uint64_t data)
+{
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = data;
+
+    if ((epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &ev) == -1) && (errno != EEXIST)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+void _native_event_init(void)
+{
+    DEBUG("_native_event_init\n");
+
+    if ((_epfd = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+        err(EXIT_FAILURE, "_native_event_init: epoll_create1");
+    }
+
+    if ((_timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) == -1) {
+        err(EXIT_FAILURE, "_native_event_init: timerfd_create");
+    }
+
+    if (sigemptyset(&_event_sigs) == -1) {
+        err(EXIT_FAILURE, "_native_event_init: sigemptyset");
+    }
+
+    if ((_sigfd = signalfd(-1, &_event_sigs, SFD_NONBLOCK | SFD_CLOEXEC)) == -1) {
+        err(EXIT_FAILURE, "_native_event_init: signalfd");
+    }
+
+    if ((_add_fd(_sigfd, EVENT_DATA(EVENT_SIGNAL, 0)) == -1) ||
+        (_native_event_add_fd(_timerfd, SIGALRM) == -1)) {
+        err(EXIT_FAILURE, "_native_event_init: epoll_ctl");
+    }
+}
+
+int _native_event_add_sig(int sig)
+{
+    DEBUG("_native_event_add_sig(%i)\n", sig);
+
+    if (sigaddset(&_event_sigs, sig) == -1) {
+        return -1;
+    }
+
+    /* pending signals are consumed by sigtimedwait, the signalfd is only
+     * used to wake up */
+    if (signalfd(_sigfd, &_event_sigs, 0) == -1) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int _native_event_add_fd(int fd, int sig)
+{
+    DEBUG("_native_event_add_fd(%i, %i)\n", fd, sig);
+
+    if (_native_event_add_sig(sig) == -1) {
+        return -1;
+    }
+
+    return _add_fd(fd, EVENT_DATA(EVENT_IRQ, sig));
+}
+
+void _native_event_set_timer(struct timeval *timeout)
+{
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+
+    if (timeout != NULL) {
+        its.it_value.tv_sec = timeout->tv_sec;
+        its.it_value.tv_nsec = timeout->tv_usec * 1000;
+    }
+
+    if (timerfd_settime(_timerfd, 0, &its, NULL) == -1) {
+        err(EXIT_FAILURE, "_native_event_set_timer: timerfd_settime");
+    }
+}
+
+void _native_event_wait(void)
+{
+    struct epoll_event events[NATIVE_EVENT_MAX];
+    struct timespec zero = { 0, 0 };
+    sigset_t old_mask;
+    uint32_t pending = 0;
+    int nfds, sig;
+
+    _native_in_syscall++; /* no switching here */
+
+    /* keep the kernel from delivering interrupts while we poll for them */
+    if (sigprocmask(SIG_BLOCK, &_event_sigs, &old_mask) == -1) {
+        err(EXIT_FAILURE, "_native_event_wait: sigprocmask");
+    }
+
+#ifdef MODULE_UART0
+    /* uart descriptors change when a client connects, (re-)add them */
+    FD_ZERO(&_native_rfds);
+    int maxfd = _native_set_uart_fds();
+    for (int fd = 0; fd <= maxfd; fd++) {
+        if (FD_ISSET(fd, &_native_rfds)) {
+            _add_fd(fd, EVENT_DATA(EVENT_UART, fd));
+        }
+    }
+    FD_ZERO(&_native_rfds);
+#endif
+
+    nfds = epoll_wait(_epfd, events, NATIVE_EVENT_MAX, -1);
+
+    if ((nfds == -1) && (errno != EINTR)) {
+        err(EXIT_FAILURE, "_native_event_wait: epoll_wait");
+    }
+
+    for (int i = 0; i < nfds; i++) {
+        int val = EVENT_VAL(events[i].data.u64);
+
+        switch (EVENT_TYPE(events[i].data.u64)) {
+            case EVENT_IRQ:
+                pending |= (1UL << val);
+                break;
+#ifdef MODULE_UART0
+            case EVENT_UART:
+                FD_SET(val, &_native_rfds);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+
+    if (pending & (1UL << SIGALRM)) {
+        uint64_t expirations;
+        /* reset readiness, the hwtimer ISR re-arms the timer */
+        if ((real_read(_timerfd, &expirations, sizeof(expirations)) == -1) &&
+            (errno != EAGAIN)) {
+            err(EXIT_FAILURE, "_native_event_wait: read(timerfd)");
+        }
+    }
+
+    /* consume interrupts raised while blocked, they are covered by the events
+     * above or have to be handled now anyway */
+    while ((sig = sigtimedwait(&_event_sigs, NULL, &zero)) > 0) {
+        pending |= (1UL << sig);
+    }
+
+    /* queue all interrupts for a single pass of native_irq_handler */
+    for (sig = 1; pending != 0; sig++) {
+        if (pending & (1UL << sig)) {
+            pending &= ~(1UL << sig);
+
+            if (real_write(_sig_pipefd[1], &sig, sizeof(int)) == -1) {
+                err(EXIT_FAILURE, "_native_event_wait: real_write()");
+            }
+
+            _native_sigpend++;
+        }
+    }
+
+    if (sigprocmask(SIG_SETMASK, &old_mask, NULL) == -1) {
+        err(EXIT_FAILURE, "_native_event_wait: sigprocmask");
+    }
+
+    _native_in_syscall--;
+
+#ifdef MODULE_UART0
+    _native_handle_uart0_input();
+#endif
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NATIVE_EPOLL */
@@ -0,0 +1,101 @@
+/**
+ * Native CPU virtual time controller client
+ *
+ * Several native instances running in virtual time are kept in lockstep
+ * by a controller process (see dist/tools/native_vtime). Whenever an
+ * instance becomes idle it reports its next timer deadline and blocks
+ * until the controller grants a time to advance to. The controller only
+ * grants once all instances are idle, and never beyond the earliest
+ * reported deadline.
+ *
+ * Messages are native endian uint64_t values in microseconds of virtual
+ * time, UINT64_MAX denotes "no deadline".
+ *
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup native_cpu
+ * @{
+ * @file
+ * @}
+ */
+
+#ifdef MODULE_NATIVE_VTIME
+
+#include <err.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "native_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+const char *_native_vtime_ctrl_path = NULL;
+int _native_vtime_ctrl_fd = -1;
+
+static void _xfer(uint8_t *buf, int len, int out)
+{
+    while (len > 0) {
+        ssize_t res = out ? real_write(_native_vtime_ctrl_fd, buf, len)
+                          : real_read(_native_vtime_ctrl_fd, buf, len);
+        if (res == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            err(EXIT_FAILURE, "_native_vtime_sync");
+        }
+        else if (res == 0) {
+            errx(EXIT_FAILURE, "_native_vtime_sync: controller went away");
+        }
+        buf += res;
+        len -= res;
+    }
+}
+
+void _native_vtime_init(void)
+{
+    struct sockaddr_un sa;
+
+    if (_native_vtime_ctrl_path == NULL) {
+        return;
+    }
+
+    if ((_native_vtime_ctrl_fd = real_socket(AF_UNIX, SOCK_STREAM, 0)) == -1) {
+        err(EXIT_FAILURE, "_native_vtime_init: socket");
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sun_family = AF_UNIX;
+    strncpy(sa.sun_path, _native_vtime_ctrl_path, sizeof(sa.sun_path) - 1);
+
+    if (real_connect(_native_vtime_ctrl_fd, (struct sockaddr *)&sa, sizeof(sa)) == -1) {
+        err(EXIT_FAILURE, "_native_vtime_init: connect(%s)", _native_vtime_ctrl_path);
+    }
+}
+
+uint64_t _native_vtime_sync(uint64_t deadline)
+{
+    uint64_t granted;
+
+    DEBUG("_native_vtime_sync(%lu)\n", (unsigned long) deadline);
+
+    /* frames received meanwhile (SIGIO) are handled after the grant */
+    _native_in_syscall++; /* no switching here */
+    _xfer((uint8_t *)&deadline, sizeof(deadline), 1);
+    _xfer((uint8_t *)&granted, sizeof(granted), 0);
+    _native_in_syscall--;
+
+    return granted;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NATIVE_VTIME */
@@ -0,0 +1,115 @@
+/**
+ * nativenet transceiver on top of the shared-memory medium
+ *
+ * Replaces the tap interface when the native_medium module is used:
+ * frames are a struct nativenet_header followed by the payload, node
+ * numbers double as long addresses.
+ *
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup native_cpu
+ * @ingroup net
+ * @{
+ * @file
+ */
+
+#ifdef MODULE_NATIVE_MEDIUM
+
+#include <stdint.h>
+#include <string.h>
+#include <inttypes.h>
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#include "hwtimer.h"
+#include "native_internal.h"
+#include "native_medium.h"
+#include "nativenet.h"
+#include "nativenet_internal.h"
+
+static void _handle_medium_input(void)
+{
+    uint8_t buf[NATIVE_MEDIUM_FRAME_MAX];
+    struct nativenet_header *hdr = (struct nativenet_header *)buf;
+    int len;
+
+    while ((len = native_medium_recv(_nativenet_default_dev_more._channel,
+                                     buf, sizeof(buf), NULL)) != 0) {
+        radio_packet_t p;
+        unsigned long t = hwtimer_now();
+
+        if (len < 0) {
+            DEBUG("nativenet_medium: dropped oversized frame\n");
+            continue;
+        }
+        if ((len < (int)sizeof(*hdr)) ||
+            (hdr->length > (len - sizeof(*hdr)))) {
+            DEBUG("nativenet_medium: discarding malformed frame\n");
+            continue;
+        }
+
+        p.processing = 0;
+        p.src = hdr->src;
+        p.dst = hdr->dst;
+        p.rssi = 0;
+        p.lqi = 0;
+        p.toa.seconds = HWTIMER_TICKS_TO_US(t) / 1000000;
+        p.toa.microseconds = HWTIMER_TICKS_TO_US(t) % 1000000;
+        p.length = hdr->length;
+        p.data = buf + sizeof(*hdr);
+
+        DEBUG("nativenet_medium: received packet of length %" PRIu16 " for %"
+              PRIu16 " from %" PRIu16 "\n", p.length, p.dst, p.src);
+        _nativenet_handle_packet(&p);
+    }
+}
+
+int8_t send_buf(radio_packet_t *packet)
+{
+    uint8_t buf[NATIVE_MEDIUM_FRAME_MAX];
+    struct nativenet_header *hdr = (struct nativenet_header *)buf;
+    int res;
+
+    if ((packet->length + sizeof(*hdr)) > sizeof(buf)) {
+        DEBUG("send_buf: packet too large for the medium\n");
+        return -1;
+    }
+
+    hdr->length = packet->length;
+    hdr->dst = packet->dst;
+    hdr->src = packet->src;
+    memcpy(buf + sizeof(*hdr), packet->data, packet->length);
+
+    res = native_medium_send(_nativenet_default_dev_more._channel, buf,
+                             packet->length + sizeof(*hdr));
+    if (res < 0) {
+        return -1;
+    }
+
+    return (res > INT8_MAX ? INT8_MAX : res);
+}
+
+void nativenet_medium_init(void)
+{
+    unsigned char *eui_64 = (unsigned char *)&(_nativenet_default_dev_more._long_addr);
+    unsigned node;
+
+    native_medium_init(_handle_medium_input);
+    node = native_medium_node();
+
+    /* locally administered EUI-64 derived from the node number */
+    memset(eui_64, 0, sizeof(uint64_t));
+    eui_64[0] = 0x02;
+    eui_64[6] = (uint8_t)(node >> 8);
+    eui_64[7] = (uint8_t)node;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NATIVE_MEDIUM */
+/** @} */
@@ -57,6 +57,8 @@
 #include "hwtimer.h"
 #include "timex.h"
 
+#ifndef MODULE_NATIVE_MEDIUM /* see medium.c */
+
 #define TAP_BUFFER_LENGTH (ETHER_MAX_LEN)
 int _native_marshall_ethernet(uint8_t *framebuf, radio_packet_t *packet);
 
@@ -346,9 +348,17 @@ int tap_init(char *name)
         err(EXIT_FAILURE, "tap_init(): fcntl(F_SETFL)");
     }
 
+#ifdef MODULE_NATIVE_EPOLL
+    /* wake up the idle loop without a signal */
+    if (_native_event_add_fd(_native_tap_fd, SIGIO) == -1) {
+        err(EXIT_FAILURE, "tap_init(): _native_event_add_fd");
+    }
+#endif
+
 #endif /* not OSX */
 
     DEBUG("RIOT native tap initialized.\n");
     return _native_tap_fd;
 }
+#endif /* MODULE_NATIVE_MEDIUM */
 /** @} */
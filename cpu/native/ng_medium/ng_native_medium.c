@@ -0,0 +1,507 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     ng_native_medium
+ * @{
+ *
+ * @file
+ * @brief       ng_netdev driver for the native shared-memory medium
+ *
+ * Frames on the medium are IEEE 802.15.4 data frames without FCS.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "msg.h"
+#include "native_internal.h"
+#include "native_medium.h"
+#include "net/ng_ieee802154.h"
+#include "net/ng_netbase.h"
+#include "ng_native_medium.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define BROADCAST       (0xffff)
+
+/* support one medium interface, like the tap drivers */
+static ng_native_medium_t *_dev;
+
+static void _rx_isr(void)
+{
+    msg_t msg;
+
+    if ((_dev == NULL) || (_dev->mac_pid == KERNEL_PID_UNDEF)) {
+        return;
+    }
+
+    /* let the MAC thread drain the receive ring */
+    msg.type = NG_NETDEV_MSG_TYPE_EVENT;
+    msg.content.value = NETDEV_EVENT_RX_COMPLETE;
+    msg_send_int(&msg, _dev->mac_pid);
+}
+
+static size_t _make_data_frame_hdr(ng_native_medium_t *dev, uint8_t *buf,
+                                   ng_netif_hdr_t *hdr)
+{
+    static const uint8_t bcast[] = NG_IEEE802154_ADDR_BCAST;
+    uint8_t src[8];
+    const uint8_t *dst;
+    size_t src_len, dst_len;
+    le_uint16_t pan = byteorder_btols(byteorder_htons(dev->pan));
+
+    if (hdr->flags & (NG_NETIF_HDR_FLAGS_BROADCAST | NG_NETIF_HDR_FLAGS_MULTICAST)) {
+        dst = bcast;
+        dst_len = sizeof(bcast);
+    }
+    else {
+        dst = ng_netif_hdr_get_dst_addr(hdr);
+        dst_len = hdr->dst_l2addr_len;
+    }
+
+    if (dev->options & NG_NATIVE_MEDIUM_OPT_SRC_ADDR_LONG) {
+        network_uint64_t addr = byteorder_htonll(dev->addr_long);
+
+        memcpy(src, &addr, sizeof(addr));
+        src_len = sizeof(addr);
+    }
+    else {
+        network_uint16_t addr = byteorder_htons(dev->addr_short);
+
+        memcpy(src, &addr, sizeof(addr));
+        src_len = sizeof(addr);
+    }
+
+    return ng_ieee802154_set_frame_hdr(buf, src, src_len, dst, dst_len, pan, pan,
+                                       NG_IEEE802154_FCF_TYPE_DATA |
+                                       NG_IEEE802154_FCF_PAN_COMP,
+                                       dev->seq_nr++);
+}
+
+static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
+{
+    ng_native_medium_t *dev = (ng_native_medium_t *)netdev;
+    uint8_t frame[NG_NATIVE_MEDIUM_MAX_PKT_LENGTH];
+    ng_pktsnip_t *payload;
+    size_t len;
+    int res;
+
+    if (pkt == NULL) {
+        return -ENOMSG;
+    }
+    if (dev == NULL) {
+        ng_pktbuf_release(pkt);
+        return -ENODEV;
+    }
+
+    if (pkt->type == NG_NETTYPE_NETIF) {
+        len = _make_data_frame_hdr(dev, frame, (ng_netif_hdr_t *)pkt->data);
+        if (len == 0) {
+            DEBUG("[ng_native_medium] error: unable to create 802.15.4 header\n");
+            ng_pktbuf_release(pkt);
+            return -ENOMSG;
+        }
+        payload = pkt->next;
+    }
+    else {
+        /* the frame was built by the MAC layer */
+        len = 0;
+        payload = pkt;
+    }
+    if ((ng_pkt_len(payload) + len) > sizeof(frame)) {
+        DEBUG("[ng_native_medium] error: packet too large to be send\n");
+        ng_pktbuf_release(pkt);
+        return -EOVERFLOW;
+    }
+    for (ng_pktsnip_t *snip = payload; snip != NULL; snip = snip->next) {
+        memcpy(&frame[len], snip->data, snip->size);
+        len += snip->size;
+    }
+    ng_pktbuf_release(pkt);
+
+    res = native_medium_send(dev->chan, frame, len);
+
+    if ((res > 0) && dev->event_cb && (dev->options & NG_NATIVE_MEDIUM_OPT_TELL_TX_END)) {
+        dev->event_cb(NETDEV_EVENT_TX_COMPLETE, NULL);
+    }
+
+    return res;
+}
+
+/* returns the MHR length or 0 if the frame is not for us */
+static size_t _parse_frame_hdr(ng_native_medium_t *dev, uint8_t *mhr, size_t len)
+{
+    const ng_ieee802154_mhr_layout_t *layout;
+    uint8_t dst[8];
+    le_uint16_t pan;
+    uint16_t pan_id;
+
+    if ((len < 3) || ((mhr[0] & NG_IEEE802154_FCF_TYPE_MASK) != NG_IEEE802154_FCF_TYPE_DATA)) {
+        return 0;
+    }
+    layout = ng_ieee802154_get_mhr_layout(mhr);
+    /* data frames without either address are not supported */
+    if ((layout->len == 0) || (layout->dst_len == 0) || (layout->src_len == 0) ||
+        (len < layout->len)) {
+        return 0;
+    }
+
+    if (dev->options & NG_NATIVE_MEDIUM_OPT_PROMISCUOUS) {
+        return layout->len;
+    }
+
+    /* address filter */
+    ng_ieee802154_get_dst(mhr, dst, &pan);
+    pan_id = byteorder_ntohs(byteorder_ltobs(pan));
+    if ((pan_id != dev->pan) && (pan_id != BROADCAST)) {
+        return 0;
+    }
+    if (layout->dst_len == 2) {
+        uint16_t addr = (uint16_t)((dst[0] << 8) | dst[1]);
+
+        if ((addr != dev->addr_short) && (addr != BROADCAST)) {
+            return 0;
+        }
+    }
+    else {
+        network_uint64_t addr;
+
+        memcpy(&addr, dst, sizeof(addr));
+        if (byteorder_ntohll(addr) != dev->addr_long) {
+            return 0;
+        }
+    }
+
+    return layout->len;
+}
+
+static void _receive_data(ng_native_medium_t *dev, uint8_t *frame, size_t len)
+{
+    ng_pktsnip_t *hdr, *payload;
+    ng_netif_hdr_t *netif;
+    size_t pos;
+
+    if (dev->options & NG_NATIVE_MEDIUM_OPT_RAWDUMP) {
+        payload = ng_pktbuf_add(NULL, frame, len, NG_NETTYPE_UNDEF);
+        if (payload == NULL) {
+            DEBUG("[ng_native_medium] error: unable to allocate RAW data\n");
+            return;
+        }
+        dev->event_cb(NETDEV_EVENT_RX_COMPLETE, payload);
+        return;
+    }
+
+    pos = _parse_frame_hdr(dev, frame, len);
+    if (pos == 0) {
+        DEBUG("[ng_native_medium] dropping frame not for us\n");
+        return;
+    }
+
+    hdr = ng_ieee802154_netif_hdr_build(frame);
+    if (hdr == NULL) {
+        DEBUG("[ng_native_medium] error: unable to allocate netif header\n");
+        return;
+    }
+    netif = (ng_netif_hdr_t *)hdr->data;
+    netif->if_pid = dev->mac_pid;
+    netif->rssi = 0;
+    netif->lqi = 0xff;
+
+    payload = ng_pktbuf_add(hdr, &frame[pos], len - pos, dev->proto);
+    if (payload == NULL) {
+        DEBUG("[ng_native_medium] error: unable to allocate incoming payload\n");
+        ng_pktbuf_release(hdr);
+        return;
+    }
+
+    dev->event_cb(NETDEV_EVENT_RX_COMPLETE, payload);
+}
+
+static int _get(ng_netdev_t *device, ng_netconf_opt_t opt, void *val, size_t max_len)
+{
+    ng_native_medium_t *dev = (ng_native_medium_t *)device;
+
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+
+    switch (opt) {
+        case NETCONF_OPT_ADDRESS:
+        case NETCONF_OPT_NID:
+        case NETCONF_OPT_CHANNEL:
+        case NETCONF_OPT_ADDR_LEN:
+        case NETCONF_OPT_SRC_LEN:
+        case NETCONF_OPT_MAX_PACKET_SIZE:
+            if (max_len < sizeof(uint16_t)) {
+                return -EOVERFLOW;
+            }
+            if (opt == NETCONF_OPT_ADDRESS) {
+                *((uint16_t *)val) = dev->addr_short;
+            }
+            else if (opt == NETCONF_OPT_NID) {
+                *((uint16_t *)val) = dev->pan;
+            }
+            else if (opt == NETCONF_OPT_CHANNEL) {
+                *((uint16_t *)val) = dev->chan;
+            }
+            else if (opt == NETCONF_OPT_ADDR_LEN) {
+                *((uint16_t *)val) = 2;
+            }
+            else if (opt == NETCONF_OPT_SRC_LEN) {
+                *((uint16_t *)val) = (dev->options & NG_NATIVE_MEDIUM_OPT_SRC_ADDR_LONG) ? 8 : 2;
+            }
+            else {
+                *((uint16_t *)val) = NG_NATIVE_MEDIUM_MAX_PKT_LENGTH;
+            }
+            return sizeof(uint16_t);
+
+        case NETCONF_OPT_ADDRESS_LONG:
+            if (max_len < sizeof(uint64_t)) {
+                return -EOVERFLOW;
+            }
+            *((uint64_t *)val) = dev->addr_long;
+            return sizeof(uint64_t);
+
+        case NETCONF_OPT_PROTO:
+            if (max_len < sizeof(ng_nettype_t)) {
+                return -EOVERFLOW;
+            }
+            *((ng_nettype_t *)val) = dev->proto;
+            return sizeof(ng_nettype_t);
+
+        case NETCONF_OPT_STATE:
+            if (max_len < sizeof(ng_netconf_state_t)) {
+                return -EOVERFLOW;
+            }
+            *((ng_netconf_state_t *)val) = (ng_netconf_state_t)dev->state;
+            return sizeof(ng_netconf_state_t);
+
+        case NETCONF_OPT_IS_CHANNEL_CLR:
+            if (max_len < sizeof(ng_netconf_enable_t)) {
+                return -EOVERFLOW;
+            }
+            *((ng_netconf_enable_t *)val) = native_medium_cca(dev->chan) ?
+                                            NETCONF_ENABLE : NETCONF_DISABLE;
+            return sizeof(ng_netconf_enable_t);
+
+        case NETCONF_OPT_PROMISCUOUSMODE:
+            if (max_len < sizeof(ng_netconf_enable_t)) {
+                return -EOVERFLOW;
+            }
+            *((ng_netconf_enable_t *)val) =
+                !!(dev->options & NG_NATIVE_MEDIUM_OPT_PROMISCUOUS);
+            return sizeof(ng_netconf_enable_t);
+
+        case NETCONF_OPT_RAWMODE:
+            if (max_len < sizeof(ng_netconf_enable_t)) {
+                return -EOVERFLOW;
+            }
+            *((ng_netconf_enable_t *)val) =
+                !!(dev->options & NG_NATIVE_MEDIUM_OPT_RAWDUMP);
+            return sizeof(ng_netconf_enable_t);
+
+        case NETCONF_OPT_TX_END_IRQ:
+            if (max_len < sizeof(ng_netconf_enable_t)) {
+                return -EOVERFLOW;
+            }
+            *((ng_netconf_enable_t *)val) =
+                !!(dev->options & NG_NATIVE_MEDIUM_OPT_TELL_TX_END);
+            return sizeof(ng_netconf_enable_t);
+
+        default:
+            return -ENOTSUP;
+    }
+}
+
+static void _set_option(ng_native_medium_t *dev, uint16_t option, bool state)
+{
+    if (state) {
+        dev->options |= option;
+    }
+    else {
+        dev->options &= ~option;
+    }
+}
+
+static int _set(ng_netdev_t *device, ng_netconf_opt_t opt, void *val, size_t len)
+{
+    ng_native_medium_t *dev = (ng_native_medium_t *)device;
+
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+
+    switch (opt) {
+        case NETCONF_OPT_ADDRESS:
+            if (len > sizeof(uint16_t)) {
+                return -EOVERFLOW;
+            }
+            dev->addr_short = *((uint16_t *)val);
+            return sizeof(uint16_t);
+
+        case NETCONF_OPT_ADDRESS_LONG:
+            if (len > sizeof(uint64_t)) {
+                return -EOVERFLOW;
+            }
+            dev->addr_long = *((uint64_t *)val);
+            return sizeof(uint64_t);
+
+        case NETCONF_OPT_SRC_LEN:
+            if (len > sizeof(uint16_t)) {
+                return -EOVERFLOW;
+            }
+            if ((*((uint16_t *)val) != 2) && (*((uint16_t *)val) != 8)) {
+                return -ENOTSUP;
+            }
+            _set_option(dev, NG_NATIVE_MEDIUM_OPT_SRC_ADDR_LONG,
+                        *((uint16_t *)val) == 8);
+            return sizeof(uint16_t);
+
+        case NETCONF_OPT_NID:
+            if (len > sizeof(uint16_t)) {
+                return -EOVERFLOW;
+            }
+            dev->pan = *((uint16_t *)val);
+            return sizeof(uint16_t);
+
+        case NETCONF_OPT_CHANNEL:
+            if (len != sizeof(uint16_t)) {
+                return -EINVAL;
+            }
+            dev->chan = *((uint16_t *)val);
+            return sizeof(uint16_t);
+
+        case NETCONF_OPT_PROTO:
+            if (len != sizeof(ng_nettype_t)) {
+                return -EINVAL;
+            }
+            dev->proto = *((ng_nettype_t *)val);
+            return sizeof(ng_nettype_t);
+
+        case NETCONF_OPT_STATE:
+            if (len > sizeof(ng_netconf_state_t)) {
+                return -EOVERFLOW;
+            }
+            dev->state = *((ng_netconf_state_t *)val);
+            if (dev->state == NETCONF_STATE_TX || dev->state == NETCONF_STATE_RESET) {
+                dev->state = NETCONF_STATE_IDLE;
+            }
+            return sizeof(ng_netconf_state_t);
+
+        case NETCONF_OPT_PROMISCUOUSMODE:
+            if (len != sizeof(ng_netconf_enable_t)) {
+                return -EINVAL;
+            }
+            _set_option(dev, NG_NATIVE_MEDIUM_OPT_PROMISCUOUS,
+                        *((ng_netconf_enable_t *)val) == NETCONF_ENABLE);
+            return sizeof(ng_netconf_enable_t);
+
+        case NETCONF_OPT_RAWMODE:
+            if (len != sizeof(ng_netconf_enable_t)) {
+                return -EINVAL;
+            }
+            _set_option(dev, NG_NATIVE_MEDIUM_OPT_RAWDUMP,
+                        *((ng_netconf_enable_t *)val) == NETCONF_ENABLE);
+            return sizeof(ng_netconf_enable_t);
+
+        case NETCONF_OPT_TX_END_IRQ:
+            if (len != sizeof(ng_netconf_enable_t)) {
+                return -EINVAL;
+            }
+            _set_option(dev, NG_NATIVE_MEDIUM_OPT_TELL_TX_END,
+                        *((ng_netconf_enable_t *)val) == NETCONF_ENABLE);
+            return sizeof(ng_netconf_enable_t);
+
+        default:
+            return -ENOTSUP;
+    }
+}
+
+static int _add_event_cb(ng_netdev_t *dev, ng_netdev_event_cb_t cb)
+{
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+    if (dev->event_cb) {
+        return -ENOBUFS;
+    }
+
+    dev->event_cb = cb;
+    return 0;
+}
+
+static int _rem_event_cb(ng_netdev_t *dev, ng_netdev_event_cb_t cb)
+{
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+    if (dev->event_cb != cb) {
+        return -ENOENT;
+    }
+
+    dev->event_cb = NULL;
+    return 0;
+}
+
+static void _isr_event(ng_netdev_t *device, uint32_t event_type)
+{
+    ng_native_medium_t *dev = (ng_native_medium_t *)device;
+    uint8_t frame[NATIVE_MEDIUM_FRAME_MAX];
+    int len;
+
+    (void)event_type;
+
+    /* handle everything that arrived since the last event in one go */
+    while ((len = native_medium_recv(dev->chan, frame, sizeof(frame), NULL)) != 0) {
+        if (len < 0) {
+            DEBUG("[ng_native_medium] dropped oversized frame\n");
+            continue;
+        }
+        if ((dev->state == NETCONF_STATE_SLEEP) || (dev->state == NETCONF_STATE_OFF) ||
+            (dev->event_cb == NULL)) {
+            continue;
+        }
+        _receive_data(dev, frame, len);
+    }
+}
+
+const ng_netdev_driver_t ng_native_medium_driver = {
+    .send_data = _send,
+    .add_event_callback = _add_event_cb,
+    .rem_event_callback = _rem_event_cb,
+    .get = _get,
+    .set = _set,
+    .isr_event = _isr_event,
+};
+
+int ng_native_medium_init(ng_native_medium_t *dev)
+{
+    memset(dev, 0, sizeof(ng_native_medium_t));
+    dev->driver = &ng_native_medium_driver;
+    dev->mac_pid = KERNEL_PID_UNDEF;
+#ifdef MODULE_NG_SIXLOWPAN
+    dev->proto = NG_NETTYPE_SIXLOWPAN;
+#else
+    dev->proto = NG_NETTYPE_UNDEF;
+#endif
+    dev->pan = NG_NATIVE_MEDIUM_DEFAULT_PANID;
+    dev->chan = NG_NATIVE_MEDIUM_DEFAULT_CHANNEL;
+    dev->state = NETCONF_STATE_IDLE;
+
+    _dev = dev;
+    native_medium_init(_rx_isr);
+
+    dev->addr_short = (uint16_t)native_medium_node();
+    /* locally administered EUI-64 containing the node number */
+    dev->addr_long = 0x0200000000000000ULL | native_medium_node();
+
+    return 0;
+}
@@ -264,6 +264,12 @@ static int _init(dev_eth_t *ethdev)
     if (fcntl(dev->tap_fd, F_SETFL, O_NONBLOCK | O_ASYNC) == -1) {
         err(EXIT_FAILURE, "ng_tabnet_init(): fcntl(F_SETFL)");
     }
+#ifdef MODULE_NATIVE_EPOLL
+    /* wake up the idle loop without a signal */
+    if (_native_event_add_fd(dev->tap_fd, SIGIO) == -1) {
+        err(EXIT_FAILURE, "ng_tapnet_init(): _native_event_add_fd");
+    }
+#endif
 #endif /* not OSX */
     DEBUG("ng_tapnet: initialized.\n");
     return 0;
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * Native CPU periph/adc.h implementation
+ *
+ * Samples are replayed from the text file given with the -A command line
+ * option: one line per sample time, one value per channel, separated by
+ * white space or commas. Lines starting with '#' are ignored, channels
+ * without a column reuse the last one, and the file is replayed from the
+ * start when its end is reached. Each channel advances through the file on
+ * its own. Without a file every channel yields a sawtooth.
+ *
+ * Continuous sampling fills whole blocks at once from a hwtimer interrupt
+ * at the time the last sample of the block is due.
+ *
+ * @ingroup _native_cpu
+ * @defgroup _native_adc
+ * @file
+ */
+
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "irq.h"
+#include "hwtimer.h"
+#include "periph/adc.h"
+
+#include "native_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+const char *_native_adc_path = NULL;
+
+#if ADC_NUMOF
+
+static uint16_t *_samples;      /* row major, _rows x _cols */
+static unsigned _rows, _cols;
+static unsigned _pos[ADC_MAX_CHANNELS];
+static uint16_t _max_value;
+static int _powered;
+
+static char *_load_file(const char *path, size_t *len)
+{
+    char *data = NULL;
+    size_t size = 0;
+    ssize_t res;
+    int fd;
+
+    if ((fd = real_open(path, O_RDONLY)) < 0) {
+        err(EXIT_FAILURE, "adc: open(%s)", path);
+    }
+
+    do {
+        char *tmp = real_realloc(data, size + 4096 + 1);
+        if (tmp == NULL) {
+            err(EXIT_FAILURE, "adc: realloc");
+        }
+        data = tmp;
+        res = real_read(fd, data + size, 4096);
+        if ((res < 0) && (errno != EINTR)) {
+            err(EXIT_FAILURE, "adc: read(%s)", path);
+        }
+        size += (res > 0) ? res : 0;
+    } while (res != 0);
+    real_close(fd);
+
+    data[size] = '\0';
+    *len = size;
+    return data;
+}
+
+static void _parse(char *text)
+{
+    unsigned cap = 0, n = 0;
+    char *line = text;
+
+    _rows = 0;
+    _cols = 0;
+
+    while (*line != '\0') {
+        char *end = strchr(line, '\n');
+        char *p = line;
+        unsigned cols = 0;
+
+        if (end != NULL) {
+            *end = '\0';
+        }
+
+        while (line[0] != '#') {
+            char *next;
+            unsigned long v;
+
+            p += strspn(p, " \t\r,");
+            if (*p == '\0') {
+                break;
+            }
+            v = strtoul(p, &next, 0);
+            if (next == p) {
+                errx(EXIT_FAILURE, "adc: %s: invalid value in line %u",
+                     _native_adc_path, _rows + 1);
+            }
+            p = next;
+
+            if (_cols == 0 || cols < _cols) {
+                if (n == cap) {
+                    cap = cap ? 2 * cap : 256;
+                    _samples = real_realloc(_samples, cap * sizeof(uint16_t));
+                    if (_samples == NULL) {
+                        err(EXIT_FAILURE, "adc: realloc");
+                    }
+                }
+                _samples[n++] = (v > UINT16_MAX) ? UINT16_MAX : (uint16_t)v;
+            }
+            cols++;
+        }
+
+        if (cols > 0) {
+            if (_cols == 0) {
+                /* the first line defines the number of columns */
+                _cols = cols;
+            }
+            /* pad short lines with their last value */
+            while (cols < _cols) {
+                _samples[n] = _samples[n - 1];
+                n++;
+                cols++;
+            }
+            _rows++;
+        }
+
+        if (end == NULL) {
+            break;
+        }
+        line = end + 1;
+    }
+
+    if (_rows == 0) {
+        errx(EXIT_FAILURE, "adc: %s contains no samples", _native_adc_path);
+    }
+    DEBUG("adc: %u samples of %u channels\n", _rows, _cols);
+}
+
+int adc_init(adc_t dev, adc_precision_t precision)
+{
+    if (((unsigned)dev >= ADC_NUMOF) || (precision > ADC_RES_16BIT)) {
+        return -1;
+    }
+
+    if ((_native_adc_path != NULL) && (_samples == NULL)) {
+        size_t len;
+        char *text;
+
+        _native_syscall_enter();
+        text = _load_file(_native_adc_path, &len);
+        _parse(text);
+        real_free(text);
+        _native_syscall_leave();
+    }
+
+    _max_value = (uint16_t)((1UL << (6 + 2 * precision)) - 1);
+    memset(_pos, 0, sizeof(_pos));
+    _powered = 1;
+
+    return 0;
+}
+
+int adc_sample(adc_t dev, int channel)
+{
+    unsigned pos;
+    uint32_t v;
+
+    if (((unsigned)dev >= ADC_NUMOF) || (channel < 0) ||
+        (channel >= ADC_0_CHANNELS) || !_powered) {
+        return -1;
+    }
+
+    pos = _pos[channel]++;
+    if (_samples != NULL) {
+        unsigned col = ((unsigned)channel < _cols) ? (unsigned)channel : _cols - 1;
+        v = _samples[(pos % _rows) * _cols + col];
+    }
+    else {
+        v = pos * (channel + 1);
+        v %= (uint32_t)_max_value + 1;
+    }
+
+    return (v > _max_value) ? _max_value : (int)v;
+}
+
+void adc_poweron(adc_t dev)
+{
+    if ((unsigned)dev < ADC_NUMOF) {
+        _powered = 1;
+    }
+}
+
+void adc_poweroff(adc_t dev)
+{
+    if ((unsigned)dev < ADC_NUMOF) {
+        _powered = 0;
+    }
+}
+
+int adc_map(adc_t dev, int value, int min, int max)
+{
+    return (int)adc_mapf(dev, value, (float)min, (float)max);
+}
+
+float adc_mapf(adc_t dev, int value, float min, float max)
+{
+    (void)dev;
+
+    return min + ((max - min) / ((float)_max_value)) * value;
+}
+
+#ifdef MODULE_ADC_STREAM
+
+static struct {
+    int channel;
+    uint16_t *buf;
+    unsigned block_len;
+    uint32_t rate;
+    uint16_t *block;            /* block filled next */
+    unsigned long start;        /* hwtimer ticks at adc_stream_start() */
+    uint64_t blocks;            /* number of blocks filled so far */
+    int timer;                  /* -1 if not running */
+    adc_block_cb_t cb;
+    void *arg;
+} _stream = { .timer = -1 };
+
+static void _block_done(void *arg);
+
+static int _schedule(void)
+{
+    uint64_t us = ((_stream.blocks + 1) * _stream.block_len * 1000000ULL) /
+                  _stream.rate;
+
+    _stream.timer = hwtimer_set_absolute(_stream.start + HWTIMER_TICKS(us),
+                                         _block_done, NULL);
+    return _stream.timer;
+}
+
+static void _block_done(void *arg)
+{
+    uint16_t *block = _stream.block;
+    adc_stats_t stats;
+
+    (void)arg;
+    _stream.timer = -1;
+
+    for (unsigned i = 0; i < _stream.block_len; i++) {
+        int v = adc_sample(ADC_0, _stream.channel);
+        block[i] = (v < 0) ? 0 : (uint16_t)v;
+    }
+    _stream.blocks++;
+    _stream.block = (block == _stream.buf) ? &_stream.buf[_stream.block_len]
+                                           : _stream.buf;
+
+    adc_stream_stats(block, _stream.block_len, &stats);
+    _stream.cb(_stream.arg, block, _stream.block_len, &stats);
+
+    /* the callback may have stopped the stream */
+    if ((_stream.cb != NULL) && (_schedule() < 0)) {
+        adc_block_cb_t cb = _stream.cb;
+
+        DEBUG("adc: no hwtimer left, stream stopped\n");
+        _stream.cb = NULL;
+        cb(_stream.arg, NULL, 0, NULL);
+    }
+}
+
+int adc_stream_start(adc_t dev, int channel, uint32_t rate, uint16_t *buf,
+                     unsigned block_len, adc_block_cb_t cb, void *arg)
+{
+    if (((unsigned)dev >= ADC_NUMOF) || (channel < 0) ||
+        (channel >= ADC_0_CHANNELS) || (rate == 0) || (buf == NULL) ||
+        (block_len == 0) || (cb == NULL) || (_stream.cb != NULL)) {
+        return -1;
+    }
+
+    _stream.channel = channel;
+    _stream.buf = buf;
+    _stream.block = buf;
+    _stream.block_len = block_len;
+    _stream.rate = rate;
+    _stream.blocks = 0;
+    _stream.arg = arg;
+    _stream.cb = cb;
+    _stream.start = hwtimer_now();
+
+    if (_schedule() < 0) {
+        _stream.cb = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+void adc_stream_stop(adc_t dev)
+{
+    unsigned state;
+
+    if ((unsigned)dev >= ADC_NUMOF) {
+        return;
+    }
+
+    state = disableIRQ();
+    if (_stream.timer >= 0) {
+        hwtimer_remove(_stream.timer);
+        _stream.timer = -1;
+    }
+    _stream.cb = NULL;
+    restoreIRQ(state);
+}
+
+#endif /* MODULE_ADC_STREAM */
+
+#else
+typedef int dont_be_pedantic;
+#endif /* ADC_NUMOF */
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * Native CPU periph/i2c.h implementation
+ *
+ * The bus is connected to mock slaves attached by the application, see
+ * native_i2c.h. Transactions complete immediately.
+ *
+ * @ingroup _native_cpu
+ * @defgroup _native_i2c
+ * @file
+ */
+
+#include <err.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "periph/i2c.h"
+#include "native_i2c.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if I2C_NUMOF
+
+static native_i2c_slave_t *_slaves[I2C_NUMOF];
+static mutex_t _locks[I2C_NUMOF] = { MUTEX_INIT };
+static int _powered[I2C_NUMOF];
+
+static native_i2c_slave_t *_find(i2c_t dev, uint8_t address)
+{
+    native_i2c_slave_t *slave;
+
+    if (!_powered[dev]) {
+        return NULL;
+    }
+    for (slave = _slaves[dev]; slave != NULL; slave = slave->next) {
+        if (slave->addr == address) {
+            return slave;
+        }
+    }
+    DEBUG("i2c: no slave at 0x%02x\n", address);
+    return NULL;
+}
+
+static int _read(i2c_t dev, uint8_t address, uint8_t reg, char *data,
+                 int length)
+{
+    native_i2c_slave_t *slave;
+
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    slave = _find(dev, address);
+    if (slave == NULL) {
+        return -2;
+    }
+    slave->reg = reg;
+    return slave->read(slave, reg, data, length);
+}
+
+static int _write(i2c_t dev, uint8_t address, uint8_t reg, const char *data,
+                  int length)
+{
+    native_i2c_slave_t *slave;
+
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    slave = _find(dev, address);
+    if (slave == NULL) {
+        return -2;
+    }
+    slave->reg = reg;
+    return slave->write(slave, reg, data, length);
+}
+
+void native_i2c_attach(i2c_t dev, native_i2c_slave_t *slave)
+{
+    if (dev >= I2C_NUMOF) {
+        return;
+    }
+    slave->next = _slaves[dev];
+    _slaves[dev] = slave;
+}
+
+int i2c_init_master(i2c_t dev, i2c_speed_t speed)
+{
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    if (speed > I2C_SPEED_HIGH) {
+        return -2;
+    }
+    _powered[dev] = 1;
+    return 0;
+}
+
+int i2c_init_slave(i2c_t dev, uint8_t address)
+{
+    (void)dev;
+    (void)address;
+
+    warnx("i2c_init_slave: not implemented");
+    return -1;
+}
+
+int i2c_acquire(i2c_t dev)
+{
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    mutex_lock(&_locks[dev]);
+    return 0;
+}
+
+int i2c_release(i2c_t dev)
+{
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    mutex_unlock(&_locks[dev]);
+    return 0;
+}
+
+int i2c_read_byte(i2c_t dev, uint8_t address, char *data)
+{
+    return i2c_read_bytes(dev, address, data, 1);
+}
+
+int i2c_read_bytes(i2c_t dev, uint8_t address, char *data, int length)
+{
+    native_i2c_slave_t *slave;
+
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    slave = _find(dev, address);
+    if (slave == NULL) {
+        return -2;
+    }
+    return slave->read(slave, slave->reg, data, length);
+}
+
+int i2c_read_reg(i2c_t dev, uint8_t address, uint8_t reg, char *data)
+{
+    return _read(dev, address, reg, data, 1);
+}
+
+int i2c_read_regs(i2c_t dev, uint8_t address, uint8_t reg, char *data, int length)
+{
+    return _read(dev, address, reg, data, length);
+}
+
+int i2c_write_byte(i2c_t dev, uint8_t address, char data)
+{
+    return i2c_write_bytes(dev, address, &data, 1);
+}
+
+int i2c_write_bytes(i2c_t dev, uint8_t address, char *data, int length)
+{
+    int res;
+
+    if (length < 1) {
+        return 0;
+    }
+    /* the first byte sets the register pointer */
+    res = _write(dev, address, (uint8_t)data[0], &data[1], length - 1);
+    return (res < 0) ? res : (res + 1);
+}
+
+int i2c_write_reg(i2c_t dev, uint8_t address, uint8_t reg, char data)
+{
+    return _write(dev, address, reg, &data, 1);
+}
+
+int i2c_write_regs(i2c_t dev, uint8_t address, uint8_t reg, char *data, int length)
+{
+    return _write(dev, address, reg, data, length);
+}
+
+void i2c_poweron(i2c_t dev)
+{
+    if (dev < I2C_NUMOF) {
+        _powered[dev] = 1;
+    }
+}
+
+void i2c_poweroff(i2c_t dev)
+{
+    if (dev < I2C_NUMOF) {
+        _powered[dev] = 0;
+    }
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* I2C_NUMOF */
@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * Native CPU periph/spi.h implementation
+ *
+ * The bus is connected to one of the following backends, selected with
+ * the -S command line option:
+ *
+ * - no option: MISO is looped back from MOSI
+ * - UNIX socket: all MOSI bytes are written to the socket, the same
+ *   number of MISO bytes is read back from it (i.e. the peer is the slave)
+ * - any other file: MOSI is discarded, MISO is replayed from the file,
+ *   0xff is read after the end of the file
+ *
+ * Asynchronous transfers complete after the time the transfer would take
+ * at the configured bus speed, their callbacks are called in interrupt
+ * context. With NATIVE_SPI_SYNC they are left to the spi_async module.
+ *
+ * @ingroup _native_cpu
+ * @defgroup _native_spi
+ * @file
+ */
+
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "cpu.h"
+#include "irq.h"
+#include "mutex.h"
+#include "hwtimer.h"
+#include "periph/spi.h"
+
+#include "native_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+const char *_native_spi_path = NULL;
+
+#if SPI_NUMOF
+
+/**
+ * @brief Bus clock in Hz for each spi_speed_t
+ */
+static const uint32_t _spi_clk[] = {
+    100000, 400000, 1000000, 5000000, 10000000
+};
+
+typedef enum {
+    SPI_BACKEND_LOOPBACK,
+    SPI_BACKEND_SOCKET,
+    SPI_BACKEND_FILE,
+} _native_spi_backend_t;
+
+static _native_spi_backend_t _backend = SPI_BACKEND_LOOPBACK;
+static int _fd = -1;
+static uint32_t _clk;
+static int _powered;
+static mutex_t _lock = MUTEX_INIT;
+
+static spi_transfer_t *volatile _async_cur;
+
+static void _backend_init(void)
+{
+    struct sockaddr_un sa;
+
+    if ((_fd >= 0) || (_native_spi_path == NULL)) {
+        return;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sun_family = AF_UNIX;
+    strncpy(sa.sun_path, _native_spi_path, sizeof(sa.sun_path) - 1);
+
+    _native_syscall_enter();
+    _fd = real_socket(AF_UNIX, SOCK_STREAM, 0);
+    if ((_fd >= 0) && (real_connect(_fd, (struct sockaddr *)&sa, sizeof(sa)) == 0)) {
+        _backend = SPI_BACKEND_SOCKET;
+    }
+    else {
+        if (_fd >= 0) {
+            real_close(_fd);
+        }
+        _fd = real_open(_native_spi_path, O_RDONLY);
+        if (_fd < 0) {
+            err(EXIT_FAILURE, "spi: open(%s)", _native_spi_path);
+        }
+        _backend = SPI_BACKEND_FILE;
+    }
+    _native_syscall_leave();
+
+    DEBUG("spi: backend %i on %s\n", (int)_backend, _native_spi_path);
+}
+
+/**
+ * @brief Read exactly len bytes, returns the number of bytes until EOF
+ */
+static size_t _read_all(char *buf, size_t len)
+{
+    size_t got = 0;
+
+    while (got < len) {
+        ssize_t res = real_read(_fd, buf + got, len - got);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            err(EXIT_FAILURE, "spi: read");
+        }
+        if (res == 0) {
+            break;
+        }
+        got += res;
+    }
+
+    return got;
+}
+
+/**
+ * @brief Shift out length bytes of out (0 if NULL), store MISO in in (if
+ *        not NULL)
+ */
+static int _exchange(char *out, char *in, unsigned int length)
+{
+    char buf[64];
+
+    if (!_powered) {
+        return -1;
+    }
+
+    _native_syscall_enter();
+    for (unsigned int pos = 0; pos < length; ) {
+        unsigned int chunk = length - pos;
+        char *miso = (in != NULL) ? &in[pos] : buf;
+
+        if (chunk > sizeof(buf)) {
+            chunk = sizeof(buf);
+        }
+        if (out == NULL) {
+            memset(buf, 0, chunk);
+        }
+
+        switch (_backend) {
+            case SPI_BACKEND_SOCKET:
+                if (real_write(_fd, (out != NULL) ? &out[pos] : buf, chunk) != (ssize_t)chunk) {
+                    err(EXIT_FAILURE, "spi: write");
+                }
+                if (_read_all(miso, chunk) != chunk) {
+                    errx(EXIT_FAILURE, "spi: slave closed the connection");
+                }
+                break;
+            case SPI_BACKEND_FILE: {
+                size_t got = _read_all(miso, chunk);
+                memset(miso + got, 0xff, chunk - got);
+                break;
+            }
+            default:
+                memmove(miso, (out != NULL) ? &out[pos] : buf, chunk);
+                break;
+        }
+
+        pos += chunk;
+    }
+    _native_syscall_leave();
+
+    return (int)length;
+}
+
+static int _transfer(spi_transfer_t *xfer)
+{
+    if (xfer->reg != SPI_REG_NONE) {
+        char reg = (char)xfer->reg;
+        if (_exchange(&reg, NULL, 1) < 0) {
+            return -1;
+        }
+    }
+    return _exchange(xfer->out, xfer->in, xfer->length);
+}
+
+#ifdef HAVE_SPI_ASYNC
+static void _async_done(void *arg);
+
+static int _async_start(spi_transfer_t *xfer)
+{
+    unsigned long bits = 8UL * (xfer->length + (xfer->reg != SPI_REG_NONE));
+    unsigned long us = (bits * 1000000UL + _clk - 1) / _clk;
+
+    return hwtimer_set(HWTIMER_TICKS(us), _async_done, xfer);
+}
+
+static void _async_done(void *arg)
+{
+    spi_transfer_t *xfer = arg;
+    spi_transfer_t *next = xfer->next;
+    int res = _transfer(xfer);
+
+    if (res < 0) {
+        next = NULL;
+    }
+    _async_cur = next;
+
+    if (xfer->cb != NULL) {
+        xfer->cb(xfer->arg, res);
+    }
+
+    if ((next != NULL) && (_async_start(next) < 0)) {
+        DEBUG("spi: no hwtimer left for the next transfer\n");
+        _async_cur = NULL;
+        if (next->cb != NULL) {
+            next->cb(next->arg, -1);
+        }
+    }
+}
+#endif
+
+int spi_init_master(spi_t dev, spi_conf_t conf, spi_speed_t speed)
+{
+    (void)conf;
+
+    if (dev >= SPI_NUMOF) {
+        return -2;
+    }
+    if ((unsigned)speed >= sizeof(_spi_clk) / sizeof(_spi_clk[0])) {
+        return -1;
+    }
+
+    _backend_init();
+    _clk = _spi_clk[speed];
+    _powered = 1;
+
+    return 0;
+}
+
+int spi_init_slave(spi_t dev, spi_conf_t conf, char (*cb)(char data))
+{
+    (void)dev;
+    (void)conf;
+    (void)cb;
+
+    warnx("spi_init_slave: not implemented");
+    return -1;
+}
+
+int spi_conf_pins(spi_t dev)
+{
+    if (dev >= SPI_NUMOF) {
+        return -1;
+    }
+    return 0;
+}
+
+int spi_acquire(spi_t dev)
+{
+    if (dev >= SPI_NUMOF) {
+        return -1;
+    }
+    mutex_lock(&_lock);
+    return 0;
+}
+
+int spi_release(spi_t dev)
+{
+    if (dev >= SPI_NUMOF) {
+        return -1;
+    }
+    mutex_unlock(&_lock);
+    return 0;
+}
+
+int spi_transfer_byte(spi_t dev, char out, char *in)
+{
+    if ((dev >= SPI_NUMOF) || (_async_cur != NULL)) {
+        return -1;
+    }
+    return _exchange(&out, in, 1);
+}
+
+int spi_transfer_bytes(spi_t dev, char *out, char *in, unsigned int length)
+{
+    if ((dev >= SPI_NUMOF) || (_async_cur != NULL)) {
+        return -1;
+    }
+    return _exchange(out, in, length);
+}
+
+int spi_transfer_reg(spi_t dev, uint8_t reg, char out, char *in)
+{
+    if (spi_transfer_byte(dev, (char)reg, NULL) < 0) {
+        return -1;
+    }
+    return spi_transfer_byte(dev, out, in);
+}
+
+int spi_transfer_regs(spi_t dev, uint8_t reg, char *out, char *in, unsigned int length)
+{
+    if (spi_transfer_byte(dev, (char)reg, NULL) < 0) {
+        return -1;
+    }
+    return spi_transfer_bytes(dev, out, in, length);
+}
+
+#ifdef HAVE_SPI_ASYNC
+int spi_transfer_async(spi_t dev, spi_transfer_t *xfer)
+{
+    unsigned state;
+    int res = 0;
+
+    if ((dev >= SPI_NUMOF) || (xfer == NULL) || !_powered || (_clk == 0)) {
+        return -1;
+    }
+
+    state = disableIRQ();
+    if (_async_cur != NULL) {
+        res = -1;
+    }
+    else {
+        _async_cur = xfer;
+        if (_async_start(xfer) < 0) {
+            _async_cur = NULL;
+            res = -1;
+        }
+    }
+    restoreIRQ(state);
+
+    return res;
+}
+#endif
+
+void spi_transmission_begin(spi_t dev, char reset_val)
+{
+    (void)dev;
+    (void)reset_val;
+}
+
+void spi_poweron(spi_t dev)
+{
+    if (dev < SPI_NUMOF) {
+        _powered = 1;
+    }
+}
+
+void spi_poweroff(spi_t dev)
+{
+    if (dev < SPI_NUMOF) {
+        _powered = 0;
+    }
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* SPI_NUMOF */
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * Native CPU periph/uart.h implementation
+ *
+ * Each UART is connected to the master side of a pseudo terminal, the
+ * slave side (printed on initialization) can be opened by any terminal
+ * program. Received bytes and transmit completion are signaled with
+ * NATIVE_UART_SIG.
+ *
+ * Transmission is not throttled to the configured baud rate: each TX
+ * interrupt collects up to NATIVE_UART_TX_CHUNK bytes from the transmit
+ * callback and writes them to the pty at once. Bytes the pty can not take
+ * stay in the chunk and are written again NATIVE_UART_RETRY_US later, so
+ * transmission stalls while nobody reads the pty, as with flow control.
+ *
+ * @ingroup _native_cpu
+ * @defgroup _native_uart
+ * @file
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+
+#include "cpu.h"
+#include "hwtimer.h"
+#include "periph/uart.h"
+
+#include "native_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if UART_NUMOF
+
+/**
+ * @brief Signal used for UART interrupts
+ */
+#ifndef NATIVE_UART_SIG
+#define NATIVE_UART_SIG         (SIGUSR2)
+#endif
+
+/**
+ * @brief Maximum number of bytes written to the pty per TX interrupt
+ */
+#ifndef NATIVE_UART_TX_CHUNK
+#define NATIVE_UART_TX_CHUNK    (64U)
+#endif
+
+/**
+ * @brief Delay before writing bytes again the pty did not take
+ */
+#ifndef NATIVE_UART_RETRY_US
+#define NATIVE_UART_RETRY_US    (10000U)
+#endif
+
+typedef struct {
+    int fd;                     /**< pty master, -1 if not initialized */
+    uart_rx_cb_t rx_cb;         /**< receive callback */
+    uart_tx_cb_t tx_cb;         /**< transmit callback */
+    void *arg;                  /**< argument for both callbacks */
+    volatile int tx_pending;    /**< uart_tx_begin() was called */
+    volatile int tx_retry;      /**< chunk is waiting for the retry timer */
+    int in_tx_isr;              /**< uart_write() appends to chunk */
+    unsigned chunk_len;         /**< bytes in chunk */
+    char chunk[NATIVE_UART_TX_CHUNK];   /**< bytes of the current TX interrupt */
+} native_uart_t;
+
+static native_uart_t _uart[UART_NUMOF] = {
+    { .fd = -1 },
+};
+
+static void _raise_irq(void)
+{
+    _native_syscall_enter();
+    kill(_native_pid, NATIVE_UART_SIG);
+    _native_syscall_leave();
+}
+
+static void _retry(void *arg)
+{
+    native_uart_t *dev = arg;
+
+    dev->tx_retry = 0;
+    dev->tx_pending = 1;
+    _raise_irq();
+}
+
+/**
+ * @brief Write the chunk to the pty, keep what it does not take
+ *
+ * @return  number of bytes left in the chunk
+ */
+static unsigned _flush_chunk(native_uart_t *dev)
+{
+    unsigned pos = 0;
+
+    _native_syscall_enter();
+    while (pos < dev->chunk_len) {
+        ssize_t res = real_write(dev->fd, dev->chunk + pos, dev->chunk_len - pos);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            /* EAGAIN: the pty buffer is full, nobody reads it */
+            DEBUG("uart: %u bytes left\n", dev->chunk_len - pos);
+            break;
+        }
+        pos += res;
+    }
+    _native_syscall_leave();
+
+    dev->chunk_len -= pos;
+    memmove(dev->chunk, dev->chunk + pos, dev->chunk_len);
+
+    return dev->chunk_len;
+}
+
+static void _isr(void)
+{
+    for (unsigned i = 0; i < UART_NUMOF; i++) {
+        native_uart_t *dev = &_uart[i];
+        char buf[64];
+        ssize_t n;
+
+        if (dev->fd < 0) {
+            continue;
+        }
+
+        /* receive */
+        while ((n = real_read(dev->fd, buf, sizeof(buf))) > 0) {
+            if (dev->rx_cb == NULL) {
+                continue;
+            }
+            for (ssize_t j = 0; j < n; j++) {
+                dev->rx_cb(dev->arg, buf[j]);
+            }
+        }
+
+        /* transmit */
+        if (dev->tx_pending && !dev->tx_retry && (dev->tx_cb != NULL)) {
+            int more = 1;
+
+            dev->tx_pending = 0;
+            /* bytes left from the last interrupt go first */
+            if (_flush_chunk(dev) == 0) {
+                dev->in_tx_isr = 1;
+                while (more && (dev->chunk_len < sizeof(dev->chunk))) {
+                    more = dev->tx_cb(dev->arg);
+                }
+                dev->in_tx_isr = 0;
+            }
+
+            if (_flush_chunk(dev) > 0) {
+                /* the pty is full, the transmit callback is asked again
+                 * after the retry */
+                dev->tx_retry = 1;
+                if (hwtimer_set(HWTIMER_TICKS(NATIVE_UART_RETRY_US), _retry,
+                                dev) < 0) {
+                    _retry(dev);
+                }
+            }
+            else if (more) {
+                /* TX register empty again, ask for the next chunk */
+                dev->tx_pending = 1;
+                _raise_irq();
+            }
+        }
+    }
+}
+
+static int _open_pty(uart_t uart, int async)
+{
+    native_uart_t *dev = &_uart[uart];
+    struct termios tio;
+    int fd;
+
+    if (dev->fd >= 0) {
+        return 0;
+    }
+
+    _native_syscall_enter();
+    fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((fd < 0) || (grantpt(fd) < 0) || (unlockpt(fd) < 0)) {
+        err(EXIT_FAILURE, "uart_init: posix_openpt");
+    }
+
+    /* raw mode: no echo, no line editing, no newline translation */
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    if (fcntl(fd, F_SETFL, O_NONBLOCK) == -1) {
+        err(EXIT_FAILURE, "uart_init: fcntl(F_SETFL)");
+    }
+
+    if (async) {
+        register_interrupt(NATIVE_UART_SIG, _isr);
+#ifdef MODULE_NATIVE_EPOLL
+        if (_native_event_add_fd(fd, NATIVE_UART_SIG) == -1) {
+            err(EXIT_FAILURE, "uart_init: _native_event_add_fd");
+        }
+#else
+        if (fcntl(fd, F_SETOWN, _native_pid) == -1) {
+            err(EXIT_FAILURE, "uart_init: fcntl(F_SETOWN)");
+        }
+#ifdef F_SETSIG
+        if (fcntl(fd, F_SETSIG, NATIVE_UART_SIG) == -1) {
+            err(EXIT_FAILURE, "uart_init: fcntl(F_SETSIG)");
+        }
+#endif
+        if (fcntl(fd, F_SETFL, O_NONBLOCK | O_ASYNC) == -1) {
+            err(EXIT_FAILURE, "uart_init: fcntl(F_SETFL)");
+        }
+#endif
+    }
+
+    real_printf("UART_%i: %s\n", (int)uart, ptsname(fd));
+    _native_syscall_leave();
+
+    dev->fd = fd;
+    return 0;
+}
+
+int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, uart_tx_cb_t tx_cb, void *arg)
+{
+    (void)baudrate;
+
+    if ((unsigned)uart >= UART_NUMOF) {
+        return -2;
+    }
+
+    _uart[uart].rx_cb = rx_cb;
+    _uart[uart].tx_cb = tx_cb;
+    _uart[uart].arg = arg;
+
+    return _open_pty(uart, 1);
+}
+
+int uart_init_blocking(uart_t uart, uint32_t baudrate)
+{
+    (void)baudrate;
+
+    if ((unsigned)uart >= UART_NUMOF) {
+        return -2;
+    }
+
+    return _open_pty(uart, 0);
+}
+
+void uart_tx_begin(uart_t uart)
+{
+    if (((unsigned)uart >= UART_NUMOF) || _uart[uart].tx_pending) {
+        return;
+    }
+
+    _uart[uart].tx_pending = 1;
+    _raise_irq();
+}
+
+int uart_write(uart_t uart, char data)
+{
+    native_uart_t *dev;
+
+    if ((unsigned)uart >= UART_NUMOF) {
+        return -1;
+    }
+
+    dev = &_uart[uart];
+    if (dev->in_tx_isr) {
+        if ((dev->chunk_len == sizeof(dev->chunk)) && (_flush_chunk(dev) > 0)) {
+            /* only with transmit callbacks writing several bytes at once */
+            DEBUG("uart: chunk full, byte dropped\n");
+            return -1;
+        }
+        dev->chunk[dev->chunk_len++] = data;
+        return 1;
+    }
+
+    return uart_write_blocking(uart, data);
+}
+
+int uart_read_blocking(uart_t uart, char *data)
+{
+    native_uart_t *dev;
+    fd_set rfds;
+
+    if (((unsigned)uart >= UART_NUMOF) || (_uart[uart].fd < 0)) {
+        return -1;
+    }
+
+    dev = &_uart[uart];
+    _native_syscall_enter();
+    while (real_read(dev->fd, data, 1) != 1) {
+        FD_ZERO(&rfds);
+        FD_SET(dev->fd, &rfds);
+        if ((real_select(dev->fd + 1, &rfds, NULL, NULL, NULL) < 0) &&
+            (errno != EINTR)) {
+            _native_syscall_leave();
+            return -1;
+        }
+    }
+    _native_syscall_leave();
+
+    return 1;
+}
+
+int uart_write_blocking(uart_t uart, char data)
+{
+    native_uart_t *dev;
+    fd_set wfds;
+
+    if (((unsigned)uart >= UART_NUMOF) || (_uart[uart].fd < 0)) {
+        return -1;
+    }
+
+    dev = &_uart[uart];
+    _native_syscall_enter();
+    while (real_write(dev->fd, &data, 1) != 1) {
+        if ((errno != EINTR) && (errno != EAGAIN)) {
+            _native_syscall_leave();
+            return -1;
+        }
+        /* the pty buffer is full, wait until it is read */
+        FD_ZERO(&wfds);
+        FD_SET(dev->fd, &wfds);
+        if ((real_select(dev->fd + 1, NULL, &wfds, NULL, NULL) < 0) &&
+            (errno != EINTR)) {
+            _native_syscall_leave();
+            return -1;
+        }
+    }
+    _native_syscall_leave();
+
+    return 1;
+}
+
+void uart_poweron(uart_t uart)
+{
+    (void)uart;
+}
+
+void uart_poweroff(uart_t uart)
+{
+    (void)uart;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* UART_NUMOF */
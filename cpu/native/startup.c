@@ -36,6 +36,9 @@
 #include "board_internal.h"
 #include "native_internal.h"
 #include "tap.h"
+#ifdef MODULE_NATIVE_MEDIUM
+#include "native_medium.h"
+#endif
 
 int _native_null_in_pipe[2];
 int _native_null_out_file;
@@ -197,15 +200,34 @@ void usage_exit(void)
 {
     real_printf("usage: %s", _progname);
 
-#if defined(MODULE_NATIVENET) || defined(MODULE_NG_NATIVENET)
+#if (defined(MODULE_NATIVENET) || defined(MODULE_NG_NATIVENET)) && \
+    !defined(MODULE_NATIVE_MEDIUM)
     real_printf(" <tap interface>");
 #endif
 
+#ifdef MODULE_NATIVE_MEDIUM
+    real_printf(" -m <medium>");
+#endif
+
 #ifdef MODULE_UART0
     real_printf(" [-t <port>|-u [path]] [-r]");
 #endif
 
-    real_printf(" [-i <id>] [-d] [-e|-E] [-o]\n");
+#ifdef MODULE_NATIVE_VTIME
+    real_printf(" [-c <path>]");
+#endif
+
+    real_printf(" [-i <id>]");
+
+#ifdef MODULE_SPI_ASYNC
+    real_printf(" [-S <path>]");
+#endif
+
+#if defined(FEATURE_PERIPH_ADC) || defined(MODULE_ADC_STREAM)
+    real_printf(" [-A <path>]");
+#endif
+
+    real_printf(" [-d] [-e|-E] [-o]\n");
 
     real_printf(" help: %s -h\n", _progname);
 
@@ -219,6 +241,24 @@ void usage_exit(void)
             /tmp/riot.tty.PID otherwise)\n\
 -r          replay missed output when (re-)attaching to socket\n\
             (implies -o)\n");
+#endif
+#ifdef MODULE_NATIVE_MEDIUM
+    real_printf("\
+-m <medium> attach to shared-memory medium <medium> as node <id> (see -i)\n");
+#endif
+#ifdef MODULE_NATIVE_VTIME
+    real_printf("\
+-c <path>   synchronize virtual time with the controller listening on\n\
+            UNIX socket <path>\n");
+#endif
+#ifdef MODULE_SPI_ASYNC
+    real_printf("\
+-S <path>   connect SPI bus to UNIX socket <path> (full duplex) or replay\n\
+            MISO from file <path> (default: loopback)\n");
+#endif
+#if defined(FEATURE_PERIPH_ADC) || defined(MODULE_ADC_STREAM)
+    real_printf("\
+-A <path>   replay ADC samples from text file <path> (default: sawtooth)\n");
 #endif
     real_printf("\
 -i <id>     specify instance id (set by config module)\n\
@@ -257,7 +297,8 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
     int replay = 0;
 #endif
 
-#if defined(MODULE_NATIVENET) || defined(MODULE_NG_NATIVENET)
+#if (defined(MODULE_NATIVENET) || defined(MODULE_NG_NATIVENET)) && \
+    !defined(MODULE_NATIVE_MEDIUM)
     if (
             (argc < 2)
             || (
@@ -294,6 +335,50 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
             _native_rng_seed = atol(argv[argp]);
             _native_rng_mode = 1;
         }
+#ifdef MODULE_SPI_ASYNC
+        else if (strcmp("-S", arg) == 0) {
+            if (argp + 1 < argc) {
+                argp++;
+            }
+            else {
+                usage_exit();
+            }
+            _native_spi_path = argv[argp];
+        }
+#endif
+#if defined(FEATURE_PERIPH_ADC) || defined(MODULE_ADC_STREAM)
+        else if (strcmp("-A", arg) == 0) {
+            if (argp + 1 < argc) {
+                argp++;
+            }
+            else {
+                usage_exit();
+            }
+            _native_adc_path = argv[argp];
+        }
+#endif
+#ifdef MODULE_NATIVE_MEDIUM
+        else if (strcmp("-m", arg) == 0) {
+            if (argp + 1 < argc) {
+                argp++;
+            }
+            else {
+                usage_exit();
+            }
+            _native_medium_name = argv[argp];
+        }
+#endif
+#ifdef MODULE_NATIVE_VTIME
+        else if (strcmp("-c", arg) == 0) {
+            if (argp + 1 < argc) {
+                argp++;
+            }
+            else {
+                usage_exit();
+            }
+            _native_vtime_ctrl_path = argv[argp];
+        }
+#endif
         else if (strcmp("-d", arg) == 0) {
             if (strcmp(stdiotype, "stdio") == 0) {
                 stdiotype = "null";
@@ -366,11 +451,18 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
     _native_init_uart0(stdiotype, ioparam, replay);
 #endif
 
+#ifdef MODULE_NATIVE_VTIME
+    _native_vtime_init();
+#endif
     native_hwtimer_pre_init();
     native_cpu_init();
     native_interrupt_init();
 #ifdef MODULE_NATIVENET
+# ifdef MODULE_NATIVE_MEDIUM
+    nativenet_medium_init();
+# else
     tap_init(argv[1]);
+# endif
 #endif
 #ifdef MODULE_NG_NATIVENET
 # ifdef MODULE_NATIVENET
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2015 Kaspar Schleiser <kaspar@schleiser.de>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Formats the records of the log_binary module.
+
+Reads the output of a RIOT application from a file, a serial port or stdin,
+passes text through and replaces every record with the formatted message.
+The format strings are read from the ELF file of the application.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+LEVELS = ["NONE", "ERROR", "WARNING", "INFO", "DEBUG", "ALL"]
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?"
+                        r"(?:hh|h|ll|l|j|z|t|L)?([diouxXcsp%])")
+
+
+class Elf(object):
+    """Memory image of the allocated sections of an ELF file"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF":
+            raise ValueError("%s is no ELF file" % path)
+        bits = 64 if data[4] == 2 else 32
+        self.endian = ">" if data[5] == 2 else "<"
+        if bits == 32:
+            shoff, = struct.unpack_from(self.endian + "I", data, 0x20)
+            shentsize, shnum = struct.unpack_from(self.endian + "HH", data,
+                                                  0x2e)
+            sh = self.endian + "IIIIII"
+        else:
+            shoff, = struct.unpack_from(self.endian + "Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from(self.endian + "HH", data,
+                                                  0x3a)
+            sh = self.endian + "IIQQQQ"
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = \
+                struct.unpack_from(sh, data, shoff + i * shentsize)
+            if (flags & SHF_ALLOC) and sh_type != SHT_NOBITS and addr:
+                self.sections.append((addr, data[offset:offset + size]))
+
+    def string(self, addr):
+        """Returns the C string at addr, None if it is not in the file"""
+        for start, content in self.sections:
+            if start <= addr < start + len(content):
+                end = content.find(b"\0", addr - start)
+                if end < 0:
+                    end = len(content)
+                return content[addr - start:end].decode("utf-8", "replace")
+        return None
+
+
+def format_record(elf, fmt, args):
+    """printf for 32 bit arguments"""
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, conv = match.groups()
+        if conv == "%":
+            return "%"
+        value = args.pop(0) if args else 0
+        spec = "%" + flags + width
+        if precision is not None:
+            spec += "." + precision
+        if conv in "di":
+            if value & 0x80000000:
+                value -= 1 << 32
+            return (spec + "d") % value
+        if conv == "u":
+            return (spec + "d") % value
+        if conv in "oxX":
+            return (spec + conv) % value
+        if conv == "c":
+            return (spec + "c") % chr(value & 0xff)
+        if conv == "p":
+            return (spec + "s") % ("0x%08x" % value)
+        string = elf.string(value)
+        if string is None:
+            string = "<0x%08x>" % value
+        return (spec + "s") % string
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(elf, stream, out, levels):
+    """Copies stream to out and formats the records"""
+    while True:
+        c = stream.read(1)
+        if not c:
+            break
+        if c != b"\0":
+            out.write(c)
+            continue
+        header = stream.read(1)
+        if not header:
+            break
+        record = stream.read(header[0])
+        if len(record) < 6 or (len(record) - 6) % 4:
+            out.write(b"<broken record>\n")
+            continue
+        level, nargs, addr = struct.unpack_from(elf.endian + "BBI", record)
+        args = struct.unpack_from(elf.endian + "%dI" % nargs, record, 6)
+        fmt = elf.string(addr)
+        if fmt is None:
+            msg = "<unknown format string 0x%08x>\n" % addr
+        else:
+            msg = format_record(elf, fmt, args)
+        if levels:
+            msg = "[%s] " % (LEVELS[level] if level < len(LEVELS)
+                             else level) + msg
+        out.write(msg.encode("utf-8"))
+        out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip())
+    parser.add_argument("elf", help="ELF file of the application")
+    parser.add_argument("input", nargs="?",
+                        help="log file or serial port, default stdin")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200,
+                        help="baudrate of the serial port")
+    parser.add_argument("-l", "--levels", action="store_true",
+                        help="prefix messages with their log level")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    if args.input is None:
+        stream = sys.stdin.buffer
+    elif args.input.startswith("/dev/"):
+        import serial
+        stream = serial.Serial(args.input, args.baudrate)
+    else:
+        stream = open(args.input, "rb")
+    try:
+        decode(elf, stream, sys.stdout.buffer, args.levels)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @file
+ * @brief   Create, configure and inspect native shared-memory media
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "native_medium.h"
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s create <name> <nodes> [<topology> [<loss> [<latency>]]]\n"
+            "       %s link <name> <src> <dst> <loss> <latency>\n"
+            "       %s stats <name>\n"
+            "       %s destroy <name>\n"
+            "\n"
+            "<topology> is one of\n"
+            "  mesh          every node hears every other node (default)\n"
+            "  line          node n hears nodes n-1 and n+1\n"
+            "  grid:<width>  nodes on a grid, hearing their 4 direct neighbors\n"
+            "  <file>        lines of \"<src> <dst> [<loss> [<latency>]]\",\n"
+            "                each adding one directed link\n"
+            "<loss> is given in per mille, <latency> in microseconds.\n",
+            prog, prog, prog, prog);
+    exit(EXIT_FAILURE);
+}
+
+static native_medium_hdr_t *_map(const char *name, int flags, size_t size)
+{
+    native_medium_hdr_t *medium;
+    struct stat st;
+    int fd;
+
+    if ((fd = shm_open(name, flags, 0666)) == -1) {
+        perror("shm_open");
+        exit(EXIT_FAILURE);
+    }
+    if (size > 0) {
+        if (ftruncate(fd, size) == -1) {
+            perror("ftruncate");
+            exit(EXIT_FAILURE);
+        }
+    }
+    else {
+        if (fstat(fd, &st) == -1) {
+            perror("fstat");
+            exit(EXIT_FAILURE);
+        }
+        size = st.st_size;
+    }
+
+    medium = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (medium == MAP_FAILED) {
+        perror("mmap");
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+
+    if (!(flags & O_CREAT) && (medium->magic != NATIVE_MEDIUM_MAGIC)) {
+        fprintf(stderr, "%s is not a native medium\n", name);
+        exit(EXIT_FAILURE);
+    }
+
+    return medium;
+}
+
+static void _link(native_medium_hdr_t *medium, unsigned src, unsigned dst,
+                  unsigned loss, unsigned latency)
+{
+    if ((src >= medium->nodes) || (dst >= medium->nodes)) {
+        fprintf(stderr, "link %u -> %u: node out of range\n", src, dst);
+        exit(EXIT_FAILURE);
+    }
+    if (loss > NATIVE_MEDIUM_LOSS_MAX) {
+        loss = NATIVE_MEDIUM_LOSS_MAX;
+    }
+
+    native_medium_link(medium, src, dst)->loss = loss;
+    native_medium_link(medium, src, dst)->latency = latency;
+}
+
+static void _topology(native_medium_hdr_t *medium, const char *topo,
+                      unsigned loss, unsigned latency)
+{
+    unsigned nodes = medium->nodes;
+
+    if (strcmp(topo, "mesh") == 0) {
+        for (unsigned src = 0; src < nodes; src++) {
+            for (unsigned dst = 0; dst < nodes; dst++) {
+                if (src != dst) {
+                    _link(medium, src, dst, loss, latency);
+                }
+            }
+        }
+    }
+    else if (strcmp(topo, "line") == 0) {
+        for (unsigned n = 1; n < nodes; n++) {
+            _link(medium, n - 1, n, loss, latency);
+            _link(medium, n, n - 1, loss, latency);
+        }
+    }
+    else if (strncmp(topo, "grid:", 5) == 0) {
+        unsigned width = atoi(topo + 5);
+
+        if (width == 0) {
+            fprintf(stderr, "invalid grid width\n");
+            exit(EXIT_FAILURE);
+        }
+        for (unsigned n = 0; n < nodes; n++) {
+            if (((n % width) + 1 < width) && (n + 1 < nodes)) {
+                _link(medium, n, n + 1, loss, latency);
+                _link(medium, n + 1, n, loss, latency);
+            }
+            if (n + width < nodes) {
+                _link(medium, n, n + width, loss, latency);
+                _link(medium, n + width, n, loss, latency);
+            }
+        }
+    }
+    else {
+        FILE *f = fopen(topo, "r");
+        char line[128];
+        unsigned lineno = 0;
+
+        if (f == NULL) {
+            perror(topo);
+            exit(EXIT_FAILURE);
+        }
+        while (fgets(line, sizeof(line), f) != NULL) {
+            unsigned src, dst, l = loss, lat = latency;
+            int n = sscanf(line, "%u %u %u %u", &src, &dst, &l, &lat);
+
+            lineno++;
+            if ((line[0] == '#') || (n <= 0)) {
+                continue;
+            }
+            if (n < 2) {
+                fprintf(stderr, "%s:%u: expected \"<src> <dst>\"\n", topo, lineno);
+                exit(EXIT_FAILURE);
+            }
+            _link(medium, src, dst, l, lat);
+        }
+        fclose(f);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    native_medium_hdr_t *medium;
+
+    if (argc < 3) {
+        usage(argv[0]);
+    }
+
+    if (strcmp(argv[1], "create") == 0) {
+        unsigned nodes;
+        size_t size;
+
+        if ((argc < 4) || ((nodes = atoi(argv[3])) == 0) || (nodes > UINT16_MAX)) {
+            usage(argv[0]);
+        }
+        size = NATIVE_MEDIUM_SIZE(nodes);
+        medium = _map(argv[2], O_RDWR | O_CREAT | O_TRUNC, size);
+
+        memset(medium, 0, size);
+        medium->nodes = nodes;
+        medium->slots = NATIVE_MEDIUM_RX_SLOTS;
+        medium->frame_max = NATIVE_MEDIUM_FRAME_MAX;
+        for (unsigned src = 0; src < nodes; src++) {
+            for (unsigned dst = 0; dst < nodes; dst++) {
+                native_medium_link(medium, src, dst)->loss = NATIVE_MEDIUM_NO_LINK;
+            }
+        }
+        _topology(medium, (argc > 4) ? argv[4] : "mesh",
+                  (argc > 5) ? atoi(argv[5]) : 0, (argc > 6) ? atoi(argv[6]) : 0);
+
+        /* publish the medium only once it is complete */
+        __atomic_store_n(&medium->magic, NATIVE_MEDIUM_MAGIC, __ATOMIC_RELEASE);
+        printf("created medium %s with %u nodes (%zu bytes)\n", argv[2], nodes, size);
+    }
+    else if (strcmp(argv[1], "link") == 0) {
+        if (argc != 7) {
+            usage(argv[0]);
+        }
+        medium = _map(argv[2], O_RDWR, 0);
+        _link(medium, atoi(argv[3]), atoi(argv[4]), atoi(argv[5]), atoi(argv[6]));
+    }
+    else if (strcmp(argv[1], "stats") == 0) {
+        medium = _map(argv[2], O_RDWR, 0);
+        printf("node      pid  queued  dropped\n");
+        for (unsigned n = 0; n < medium->nodes; n++) {
+            native_medium_node_t *node = &native_medium_nodes(medium)[n];
+            if (node->pid == 0) {
+                continue;
+            }
+            printf("%4u %8i %7u %8u\n", n, (int)node->pid,
+                   (unsigned)(node->head - node->tail), (unsigned)node->drops);
+        }
+    }
+    else if (strcmp(argv[1], "destroy") == 0) {
+        if (shm_unlink(argv[2]) == -1) {
+            perror("shm_unlink");
+            return EXIT_FAILURE;
+        }
+    }
+    else {
+        usage(argv[0]);
+    }
+
+    return EXIT_SUCCESS;
+}
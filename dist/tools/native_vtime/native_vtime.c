@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @file
+ * @brief   Virtual time controller for native instances built with the
+ *          native_vtime module
+ *
+ * Waits for the given number of instances to connect, then repeatedly
+ * waits until every instance reported its next deadline (i.e. is idle)
+ * and grants the earliest of them to all instances.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define MAX_INSTANCES   (256)
+#define NO_DEADLINE     (UINT64_MAX)
+
+typedef struct {
+    int fd;             /**< connection, -1 if gone */
+    int waiting;        /**< deadline received, grant outstanding */
+    uint64_t deadline;  /**< last reported deadline */
+} instance_t;
+
+static instance_t instances[MAX_INSTANCES];
+static int num;
+
+static int xfer(int fd, void *buf, size_t len, int out)
+{
+    uint8_t *p = buf;
+
+    while (len > 0) {
+        ssize_t res = out ? write(fd, p, len) : read(fd, p, len);
+        if (res == -1 && errno == EINTR) {
+            continue;
+        }
+        if (res <= 0) {
+            return -1;
+        }
+        p += res;
+        len -= res;
+    }
+    return 0;
+}
+
+static void drop(instance_t *inst)
+{
+    printf("native_vtime: instance %d disconnected\n", (int)(inst - instances));
+    close(inst->fd);
+    inst->fd = -1;
+    inst->waiting = 0;
+}
+
+int main(int argc, char **argv)
+{
+    struct sockaddr_un sa;
+    struct pollfd pfds[MAX_INSTANCES];
+    uint64_t now = 0;
+    int srv;
+
+    if (argc != 3 || (num = atoi(argv[2])) < 1 || num > MAX_INSTANCES) {
+        fprintf(stderr, "usage: %s <socket path> <number of instances>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if ((srv = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) {
+        perror("socket");
+        return EXIT_FAILURE;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sun_family = AF_UNIX;
+    strncpy(sa.sun_path, argv[1], sizeof(sa.sun_path) - 1);
+    unlink(argv[1]);
+
+    if (bind(srv, (struct sockaddr *)&sa, sizeof(sa)) == -1 || listen(srv, num) == -1) {
+        perror("bind/listen");
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < num; i++) {
+        if ((instances[i].fd = accept(srv, NULL, NULL)) == -1) {
+            perror("accept");
+            return EXIT_FAILURE;
+        }
+        instances[i].waiting = 0;
+        printf("native_vtime: instance %d connected\n", i);
+    }
+    close(srv);
+
+    for (;;) {
+        int alive = 0, busy = 0;
+        uint64_t grant = NO_DEADLINE;
+
+        for (int i = 0; i < num; i++) {
+            pfds[i].fd = instances[i].waiting ? -1 : instances[i].fd;
+            pfds[i].events = POLLIN;
+            pfds[i].revents = 0;
+
+            if (instances[i].fd != -1) {
+                alive++;
+                busy += !instances[i].waiting;
+            }
+        }
+
+        if (alive == 0) {
+            break;
+        }
+
+        if (busy > 0) {
+            if (poll(pfds, num, -1) == -1 && errno != EINTR) {
+                perror("poll");
+                return EXIT_FAILURE;
+            }
+
+            for (int i = 0; i < num; i++) {
+                if (pfds[i].revents == 0) {
+                    continue;
+                }
+                if (xfer(instances[i].fd, &instances[i].deadline,
+                         sizeof(uint64_t), 0) == -1) {
+                    drop(&instances[i]);
+                }
+                else {
+                    instances[i].waiting = 1;
+                }
+            }
+            continue;
+        }
+
+        /* everybody is idle: advance to the earliest deadline */
+        for (int i = 0; i < num; i++) {
+            if (instances[i].waiting && instances[i].deadline < grant) {
+                grant = instances[i].deadline;
+            }
+        }
+
+        if (grant == NO_DEADLINE) {
+            fprintf(stderr, "native_vtime: no deadlines left at %llu us, stopping\n",
+                    (unsigned long long) now);
+            break;
+        }
+        if (grant > now) {
+            now = grant;
+        }
+
+        for (int i = 0; i < num; i++) {
+            if (!instances[i].waiting) {
+                continue;
+            }
+            instances[i].waiting = 0;
+            if (xfer(instances[i].fd, &now, sizeof(now), 1) == -1) {
+                drop(&instances[i]);
+            }
+        }
+    }
+
+    unlink(argv[1]);
+    return EXIT_SUCCESS;
+}
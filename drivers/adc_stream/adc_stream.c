@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     driver_periph
+ * @{
+ *
+ * @file
+ * @brief       Continuous ADC sampling on top of adc_sample()
+ *
+ * Unless the CPU implements continuous sampling itself (HAVE_ADC_STREAM),
+ * each sample is triggered by a hwtimer interrupt. Deadlines are absolute,
+ * so the sampling rate does not drift with the interrupt latency.
+ *
+ * @}
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwtimer.h"
+#include "irq.h"
+#include "periph/adc.h"
+
+#if ADC_NUMOF
+
+void adc_stream_stats(const uint16_t *block, unsigned len, adc_stats_t *stats)
+{
+    uint16_t min = UINT16_MAX, max = 0;
+    uint32_t sum = 0;
+
+    for (unsigned i = 0; i < len; i++) {
+        uint16_t v = block[i];
+
+        if (v < min) {
+            min = v;
+        }
+        if (v > max) {
+            max = v;
+        }
+        sum += v;
+    }
+
+    stats->min = min;
+    stats->max = max;
+    stats->mean = (uint16_t)(sum / len);
+}
+
+#ifndef HAVE_ADC_STREAM
+
+typedef struct {
+    adc_t dev;                  /**< the device this state belongs to */
+    int channel;                /**< sampled channel */
+    uint16_t *buf;              /**< double buffer */
+    unsigned block_len;         /**< samples per block */
+    unsigned pos;               /**< next sample in buf */
+    unsigned long period;       /**< hwtimer ticks between samples */
+    unsigned long next;         /**< absolute hwtimer deadline of the next sample */
+    int timer;                  /**< hwtimer id, only valid while cb is set */
+    adc_block_cb_t cb;          /**< block callback, NULL when stopped */
+    void *arg;                  /**< argument for cb */
+} adc_stream_t;
+
+static adc_stream_t _stream[ADC_NUMOF];
+
+static void _sample(void *arg)
+{
+    adc_stream_t *s = arg;
+    int v = adc_sample(s->dev, s->channel);
+
+    s->timer = -1;
+    s->buf[s->pos++] = (v < 0) ? 0 : (uint16_t)v;
+
+    if ((s->pos % s->block_len) == 0) {
+        uint16_t *block = &s->buf[s->pos - s->block_len];
+        adc_stats_t stats;
+
+        if (s->pos == 2 * s->block_len) {
+            s->pos = 0;
+        }
+        adc_stream_stats(block, s->block_len, &stats);
+        s->cb(s->arg, block, s->block_len, &stats);
+
+        if (s->cb == NULL) {
+            /* stopped by the callback */
+            return;
+        }
+    }
+
+    s->next += s->period;
+    s->timer = hwtimer_set_absolute(s->next, _sample, s);
+    if (s->timer < 0) {
+        adc_block_cb_t cb = s->cb;
+
+        /* no hwtimer left, stop and tell the user */
+        s->cb = NULL;
+        cb(s->arg, NULL, 0, NULL);
+    }
+}
+
+int adc_stream_start(adc_t dev, int channel, uint32_t rate, uint16_t *buf,
+                     unsigned block_len, adc_block_cb_t cb, void *arg)
+{
+    adc_stream_t *s;
+
+    if (((unsigned)dev >= ADC_NUMOF) || (rate == 0) || (buf == NULL) ||
+        (block_len == 0) || (cb == NULL)) {
+        return -1;
+    }
+
+    s = &_stream[dev];
+    if (s->cb != NULL) {
+        return -1;
+    }
+
+    s->dev = dev;
+    s->channel = channel;
+    s->buf = buf;
+    s->block_len = block_len;
+    s->pos = 0;
+    s->period = HWTIMER_TICKS(1000000UL / rate);
+    if (s->period == 0) {
+        s->period = 1;
+    }
+    s->cb = cb;
+    s->arg = arg;
+    s->next = hwtimer_now() + s->period;
+    s->timer = hwtimer_set_absolute(s->next, _sample, s);
+    if (s->timer < 0) {
+        s->cb = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+void adc_stream_stop(adc_t dev)
+{
+    adc_stream_t *s;
+    unsigned state;
+
+    if ((unsigned)dev >= ADC_NUMOF) {
+        return;
+    }
+
+    s = &_stream[dev];
+    state = disableIRQ();
+    /* _stream is zeroed, so timer is 0 before the first start */
+    if (s->cb == NULL) {
+        restoreIRQ(state);
+        return;
+    }
+    if (s->timer >= 0) {
+        hwtimer_remove(s->timer);
+        s->timer = -1;
+    }
+    s->cb = NULL;
+    restoreIRQ(state);
+}
+
+#endif /* HAVE_ADC_STREAM */
+
+#else
+typedef int dont_be_pedantic;
+#endif /* ADC_NUMOF */
@@ -27,6 +27,7 @@
 
 #include "periph/i2c.h"
 #include "periph/gpio.h"
+#include "sensor_fifo.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -115,6 +116,24 @@ int l3g4200d_init(l3g4200d_t *dev, i2c_t i2c, uint8_t address,
  */
 int l3g4200d_read(l3g4200d_t *dev, l3g4200d_data_t *acc_data);
 
+/**
+ * @brief Configure the FIFO of the gyro for batched reads
+ *
+ * Samples are collected in the FIFO in stream mode. The watermark
+ * interrupt is routed to the DRDY pin (INT2), which must be connected.
+ * Read samples with sensor_fifo_read() into an array of l3g4200d_data_t.
+ * Needs the module `sensor_fifo`.
+ *
+ * @param[in]  dev          device descriptor of gyro
+ * @param[out] fifo         batching state to initialize
+ * @param[in]  watermark    samples to collect before waking up the reader,
+ *                          1 to 31
+ *
+ * @return                  0 on success
+ * @return                  -1 on error
+ */
+int l3g4200d_fifo_init(l3g4200d_t *dev, sensor_fifo_t *fifo, uint8_t watermark);
+
 /**
  * @brief Power-up the given device
  *
@@ -26,6 +26,7 @@
 
 #include "periph/spi.h"
 #include "periph/gpio.h"
+#include "sensor_fifo.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -641,6 +642,11 @@ typedef enum {
  */
 #define LIS3DH_ADC_DATA_SIZE (2)
 
+/**
+ * Number of samples in the FIFO.
+ */
+#define LIS3DH_FIFO_SIZE (32)
+
 
 /**
  * @brief Allowed values for the Output Data Rate of the sensor.
@@ -813,6 +819,24 @@ int lis3dh_set_fifo_mode(lis3dh_t *dev, const lis3dh_fifo_mode_t mode);
  */
 int lis3dh_set_fifo(lis3dh_t *dev, const uint8_t enable);
 
+/**
+ * @brief Configure the FIFO for batched reads.
+ *
+ * Samples are collected in the FIFO in stream mode. The watermark interrupt
+ * is routed to INT1, which must be connected. Read samples with
+ * sensor_fifo_read() into an array of lis3dh_data_t, scaled like
+ * lis3dh_read_xyz(). Needs the module `sensor_fifo`.
+ *
+ * @param[in]  dev          Device descriptor of sensor
+ * @param[out] fifo         Batching state to initialize
+ * @param[in]  watermark    Samples to collect before waking up the reader,
+ *                          1 to 31
+ *
+ * @return                  0 on success
+ * @return                  -1 on error
+ */
+int lis3dh_fifo_init(lis3dh_t *dev, sensor_fifo_t *fifo, uint8_t watermark);
+
 /**
  * Set the output data rate of the sensor.
  *
@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include "periph/i2c.h"
 #include "periph/gpio.h"
+#include "sensor_fifo.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -178,6 +179,26 @@ int lsm303dlhc_read_acc(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data);
  */
 int lsm303dlhc_read_mag(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data);
 
+/**
+ * @brief Configure the accelerometer FIFO for batched reads
+ *
+ * @details Samples are collected in the FIFO in stream mode. The watermark
+ *          interrupt is routed to INT1, which must be connected to
+ *          acc_pin. Read samples with sensor_fifo_read() into an array of
+ *          lsm303dlhc_3d_data_t, with the same values as
+ *          lsm303dlhc_read_acc(). Needs the module `sensor_fifo`.
+ *
+ * @param[in]  dev          device descriptor of an LSM303DLHC device
+ * @param[out] fifo         batching state to initialize
+ * @param[in]  watermark    samples to collect before waking up the
+ *                          reader, 1 to 31
+ *
+ * @return              0 on success
+ * @return              -1 on error
+ */
+int lsm303dlhc_acc_fifo_init(lsm303dlhc_t *dev, sensor_fifo_t *fifo,
+                             uint8_t watermark);
+
 /**
  * @brief Read a temperature value from the sensor.
  *
@@ -22,6 +22,7 @@
 #define MPU9150_H_
 
 #include "periph/i2c.h"
+#include "sensor_fifo.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -134,6 +135,15 @@ typedef enum {
     MPU9150_FILTER_5HZ = 0x06,
 } mpu9150_lpf_t;
 
+/**
+ * @brief Sensors that can be read through the FIFO
+ */
+typedef enum {
+    MPU9150_FIFO_OFF = 0x00,    /**< FIFO not used */
+    MPU9150_FIFO_ACCEL = 0x08,  /**< Accelerometer samples */
+    MPU9150_FIFO_GYRO = 0x70,   /**< Gyroscope samples */
+} mpu9150_fifo_src_t;
+
 /**
  * @brief MPU-9150 result vector struct
  */
@@ -157,6 +167,7 @@ typedef struct {
     uint8_t compass_x_adj;              /**< Compass X-Axis sensitivity adjustment value */
     uint8_t compass_y_adj;              /**< Compass Y-Axis sensitivity adjustment value */
     uint8_t compass_z_adj;              /**< Compass Z-Axis sensitivity adjustment value */
+    mpu9150_fifo_src_t fifo_src;        /**< Sensor written to the FIFO */
 } mpu9150_status_t;
 
 /**
@@ -332,6 +343,27 @@ int mpu9150_set_sample_rate(mpu9150_t *dev, uint16_t rate);
  */
 int mpu9150_set_compass_sample_rate(mpu9150_t *dev, uint8_t rate);
 
+/**
+ * @brief Configure the FIFO for batched reads of one sensor
+ *
+ * The MPU-9150 has no watermark interrupt, so sensor_fifo_read() polls the
+ * FIFO level once per @p watermark samples at the configured sample rate.
+ * Samples are read into an array of mpu9150_results_t, normalized like
+ * mpu9150_read_accel() or mpu9150_read_gyro(). Change the sample rate
+ * before calling this function. Needs the module `sensor_fifo`.
+ *
+ * @param[in] dev           Device descriptor of MPU9150 device
+ * @param[out] fifo         Batching state to initialize
+ * @param[in] src           MPU9150_FIFO_ACCEL or MPU9150_FIFO_GYRO
+ * @param[in] watermark     Samples to wait for between two polls
+ *
+ * @return                  0 on success
+ * @return                  -1 if device's I2C is not enabled in board config
+ * @return                  -2 if given sensor or watermark is not valid
+ */
+int mpu9150_fifo_init(mpu9150_t *dev, sensor_fifo_t *fifo,
+                      mpu9150_fifo_src_t src, uint8_t watermark);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,6 +21,8 @@
 #ifndef ADC_H
 #define ADC_H
 
+#include <stdint.h>
+
 #include "periph_conf.h"
 
 #ifdef __cplusplus
@@ -63,6 +65,29 @@ typedef enum {
     ADC_RES_16BIT,          /**< ADC precision: 16 bit */
 } adc_precision_t;
 
+/**
+ * @brief Statistics of one block of samples
+ */
+typedef struct {
+    uint16_t min;           /**< smallest sample of the block */
+    uint16_t max;           /**< largest sample of the block */
+    uint16_t mean;          /**< arithmetic mean of the block (rounded down) */
+} adc_stats_t;
+
+/**
+ * @brief Signature of the block callback of continuous sampling
+ *
+ * If sampling can not continue (e.g. no timer is left), the stream is stopped and the callback
+ * is called a last time with @p block and @p stats set to NULL and @p len set to 0.
+ *
+ * @param[in] arg           optional argument given to adc_stream_start()
+ * @param[in] block         the block that was filled, valid until the callback returns
+ * @param[in] len           number of samples in @p block
+ * @param[in] stats         statistics of @p block
+ */
+typedef void (*adc_block_cb_t)(void *arg, const uint16_t *block, unsigned len,
+                               const adc_stats_t *stats);
+
 /**
  * @brief Initialization of a given ADC device
  *
@@ -91,6 +116,49 @@ int adc_init(adc_t dev, adc_precision_t precision);
  */
 int adc_sample(adc_t dev, int channel);
 
+/**
+ * @brief Start continuous, timer triggered sampling of the given channel
+ *
+ * Samples are taken at @p rate Hz and stored in @p buf, which is used as a double buffer of
+ * two blocks of @p block_len samples each: whenever a block is full, @p cb is called for it
+ * (in interrupt context) while sampling continues into the other block. The callback has to be
+ * done with the block before the other one is full.
+ *
+ * The functions for continuous sampling are provided by the `adc_stream` module, on top of
+ * adc_sample() unless the CPU implements them itself (signaled by defining HAVE_ADC_STREAM).
+ *
+ * @param[in] dev           the ADC device to use, must be initialized
+ * @param[in] channel       the channel to sample
+ * @param[in] rate          sampling rate in Hz
+ * @param[out] buf          buffer of 2 * @p block_len samples
+ * @param[in] block_len     number of samples per block
+ * @param[in] cb            called for every full block
+ * @param[in] arg           optional argument passed to @p cb
+ *
+ * @return                  0 on success
+ * @return                  -1 on invalid parameters or if the device is already streaming
+ */
+int adc_stream_start(adc_t dev, int channel, uint32_t rate, uint16_t *buf,
+                     unsigned block_len, adc_block_cb_t cb, void *arg);
+
+/**
+ * @brief Stop continuous sampling on the given ADC device
+ *
+ * The samples of a partially filled block are discarded.
+ *
+ * @param[in] dev           the ADC device to stop
+ */
+void adc_stream_stop(adc_t dev);
+
+/**
+ * @brief Compute the statistics of a block of samples
+ *
+ * @param[in] block         the samples
+ * @param[in] len           number of samples in @p block, must not be 0
+ * @param[out] stats        the result
+ */
+void adc_stream_stats(const uint16_t *block, unsigned len, adc_stats_t *stats);
+
 /**
  * @brief Enable the power for the given ADC device
  *
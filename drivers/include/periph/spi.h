@@ -11,9 +11,12 @@
  * @ingroup     driver_periph
  * @brief       Low-level SPI peripheral driver
  *
- * The current design of this interface targets implementations that use the SPI in blocking mode.
- *
- * TODO: add means for asynchronous SPI usage
+ * The basic transfer functions of this interface use the SPI in blocking mode. For transfers of
+ * larger blocks (e.g. radio frame buffers), spi_transfer_async() starts a chain of transfers and
+ * returns right away; completion is signaled through callbacks. The asynchronous API needs the
+ * `spi_async` module (`USEMODULE += spi_async`). On CPUs that can not do this in hardware (DMA or
+ * interrupt driven), the module emulates it on top of the blocking functions; on the others
+ * (HAVE_SPI_ASYNC) it adds nothing.
  *
  * @{
  * @file
@@ -99,6 +102,36 @@ typedef enum {
     SPI_SPEED_10MHZ             /**< drive the SPI bus with 10MHz */
 } spi_speed_t;
 
+/**
+ * @brief Value of spi_transfer_t::reg for transfers without register address
+ */
+#define SPI_REG_NONE        (-1)
+
+/**
+ * @brief Signature of asynchronous transfer completion callbacks
+ *
+ * @param[in] arg       spi_transfer_t::arg of the completed transfer
+ * @param[in] res       number of bytes transferred, -1 on error
+ */
+typedef void (*spi_cb_t)(void *arg, int res);
+
+/**
+ * @brief Descriptor of an asynchronous transfer
+ *
+ * Transfers can be chained via spi_transfer_t::next, e.g. to write a command and read the data
+ * returned by the device without giving up the bus in between.
+ */
+typedef struct spi_transfer {
+    struct spi_transfer *next;  /**< next transfer of the chain, NULL for the last one */
+    int reg;                    /**< register address sent before the data (like in
+                                 *   spi_transfer_regs()) or SPI_REG_NONE */
+    char *out;                  /**< bytes to send, NULL if only receiving */
+    char *in;                   /**< buffer to receive to, NULL if only sending */
+    unsigned int length;        /**< number of bytes to transfer (excluding reg) */
+    spi_cb_t cb;                /**< called when this transfer completed, may be NULL */
+    void *arg;                  /**< argument for spi_transfer_t::cb */
+} spi_transfer_t;
+
 /**
  * @brief Initialize the given SPI device to work in master mode
  *
@@ -226,6 +259,27 @@ int spi_transfer_reg(spi_t dev, uint8_t reg, char out, char *in);
  */
 int spi_transfer_regs(spi_t dev, uint8_t reg, char *out, char *in, unsigned int length);
 
+/**
+ * @brief Start an asynchronous chain of transfers on the given SPI bus
+ *
+ * The transfers of the chain are executed in order, after each of them its callback (if any) is
+ * called - in interrupt context if the transfer is executed asynchronously. The bus must be
+ * acquired by the caller for the whole chain, descriptors and buffers must stay valid until the
+ * last callback was called.
+ *
+ * Depending on the implementation, the whole chain may be completed (and all callbacks called)
+ * before this function returns.
+ *
+ * Only available with the `spi_async` module.
+ *
+ * @param[in] dev       SPI device to use
+ * @param[in] xfer      first transfer of the chain
+ *
+ * @return              0 if the chain was started
+ * @return              -1 on error (e.g. another chain is still running)
+ */
+int spi_transfer_async(spi_t dev, spi_transfer_t *xfer);
+
 /**
  * @brief Tell the SPI driver that a new transaction was started. Call only when SPI in slave mode!
  *
@@ -21,6 +21,7 @@
 #ifndef PERIPH_UART_H
 #define PERIPH_UART_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "periph_conf.h"
@@ -32,6 +33,13 @@ extern "C" {
 /* guard file in case no UART device was specified */
 #if UART_NUMOF
 
+/**
+ * @brief Size of the TX ring buffer of each UART initialized with uart_init_bulk()
+ */
+#ifndef UART_TX_BUFSIZE
+#define UART_TX_BUFSIZE         (64U)
+#endif
+
 /**
  * @brief Definition of available UART devices
  *
@@ -112,6 +120,46 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, uart_tx_cb_t t
  */
 int uart_init_blocking(uart_t uart, uint32_t baudrate);
 
+/**
+ * @brief Initialize a given UART device for buffered writes with uart_write_bulk()
+ *
+ * The UART device is configured like with uart_init(), but the transmit callback is provided
+ * by the driver: it drains a TX ring buffer of UART_TX_BUFSIZE bytes that is filled by
+ * uart_write_bulk(). Both functions are provided by the `uart_bulk` module for all CPUs that
+ * do not implement them themselves (signaled by defining HAVE_UART_WRITE_BULK). The newlib
+ * stdio uses them only with the `stdio_uart_bulk` module, not whenever `uart_bulk` is built.
+ *
+ * @param[in] uart          the UART device to initialize
+ * @param[in] baudrate      the desired baud-rate in baud/s
+ * @param[in] rx_cb         receive callback is called for every byte the is receive
+ *                          in interrupt context
+ * @param[in] arg           optional argument passed to the receive callback
+ *
+ * @return                  0 on success
+ * @return                  -1 for invalid baud-rate
+ * @return                  -2 for all other errors
+ */
+int uart_init_bulk(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
+
+/**
+ * @brief Write a block of data to the given UART device
+ *
+ * For devices initialized with uart_init_bulk() the data is copied into the TX ring buffer and
+ * sent from the transmit interrupt, this function only blocks (sleeping) while the buffer is
+ * full. Concurrent bulk writes to the same device are not interleaved.
+ *
+ * For all other devices, and when called in interrupt context or before the scheduler was
+ * started, the data is written with uart_write_blocking() - after the data still waiting in
+ * the TX ring buffer.
+ *
+ * @param[in] uart          the UART device to write to
+ * @param[in] data          the data to send
+ * @param[in] len           number of bytes to send
+ *
+ * @return                  number of bytes written, -1 on error
+ */
+int uart_write_bulk(uart_t uart, const char *data, size_t len);
+
 /**
  * @brief Begin a new transmission, on most platforms this function will enable the TX interrupt
  *
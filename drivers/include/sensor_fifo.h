@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_sensor_fifo Sensor FIFO batching
+ * @ingroup     drivers
+ * @brief       Reads blocks of samples from the hardware FIFO of sensors
+ *
+ * @details Reading one sample per call costs a whole bus transaction per
+ *          sample. Many sensors buffer samples in a FIFO instead and
+ *          signal when it reaches a watermark. This module implements
+ *          reading N samples on top of that: it sleeps until the FIFO
+ *          holds at least a watermark (or the rest of the request), then
+ *          drains everything available in one burst transfer straight into
+ *          the buffer of the caller. The bus is idle in between.
+ *
+ *          A driver supports batching with a `<driver>_fifo_init()`
+ *          function, which configures the FIFO of the device, initializes
+ *          a sensor_fifo_t with sensor_fifo_init() and connects the
+ *          watermark interrupt to sensor_fifo_isr(). Devices without
+ *          watermark interrupt are polled instead.
+ *
+ * @code
+ * l3g4200d_data_t buf[64];
+ * sensor_fifo_t fifo;
+ *
+ * l3g4200d_fifo_init(&dev, &fifo, 16);
+ * while (sensor_fifo_read(&fifo, buf, 64) == 64) {
+ *     ...
+ * }
+ * @endcode
+ * @{
+ *
+ * @file
+ * @brief       Sensor FIFO batching interface
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ */
+
+#ifndef SENSOR_FIFO_H
+#define SENSOR_FIFO_H
+
+#include <stdint.h>
+
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   FIFO access functions of a driver
+ */
+typedef struct {
+    /**
+     * @brief   Gets the number of samples in the FIFO of the device
+     *
+     * @return  the number of samples, negative on error
+     */
+    int (*level)(void *dev);
+    /**
+     * @brief   Reads @p num samples in one burst and converts them
+     *
+     * @return  0 on success, negative on error
+     */
+    int (*drain)(void *dev, void *buf, unsigned num);
+} sensor_fifo_driver_t;
+
+/**
+ * @brief   Batching state of a device
+ */
+typedef struct {
+    const sensor_fifo_driver_t *driver; /**< FIFO access of the driver */
+    void *dev;                  /**< device descriptor */
+    uint8_t sample_size;        /**< size of a converted sample in byte */
+    uint8_t watermark;          /**< samples to wait for */
+    uint32_t poll_us;           /**< polling interval, 0 for interrupts */
+    mutex_t wait;               /**< unlocked by the watermark interrupt */
+    uint32_t bursts;            /**< number of burst transfers */
+    uint32_t samples;           /**< number of samples read */
+} sensor_fifo_t;
+
+/**
+ * @brief   Initializes the batching state, called by the drivers
+ *
+ * @param[out] fifo         the state
+ * @param[in] driver        FIFO access of the driver
+ * @param[in] dev           device descriptor
+ * @param[in] sample_size   size of a converted sample in byte
+ * @param[in] watermark     samples to wait for
+ * @param[in] poll_us       polling interval in microseconds, 0 if the
+ *                          driver connects sensor_fifo_isr() to the
+ *                          watermark interrupt
+ */
+void sensor_fifo_init(sensor_fifo_t *fifo, const sensor_fifo_driver_t *driver,
+                      void *dev, uint8_t sample_size, uint8_t watermark,
+                      uint32_t poll_us);
+
+/**
+ * @brief   Watermark interrupt handler
+ *
+ * @param[in] arg           the sensor_fifo_t
+ */
+void sensor_fifo_isr(void *arg);
+
+/**
+ * @brief   Reads samples, blocks until all are read
+ *
+ * @param[in] fifo          the batching state of the device
+ * @param[out] buf          converted samples, in the format of the
+ *                          single sample read function of the driver
+ * @param[in] num           number of samples to read
+ *
+ * @return  @p num on success
+ * @return  negative on bus errors
+ */
+int sensor_fifo_read(sensor_fifo_t *fifo, void *buf, unsigned num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENSOR_FIFO_H */
+/** @} */
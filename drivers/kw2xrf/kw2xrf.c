@@ -601,6 +601,10 @@ int kw2xrf_get(ng_netdev_t *netdev, ng_netconf_opt_t opt, void *value, size_t ma
             *((ng_netconf_enable_t *)value) = !!(dev->option & KW2XRF_OPT_AUTOACK);
             return sizeof(ng_netconf_enable_t);
 
+        case NETCONF_OPT_AUTOCCA:
+            *((ng_netconf_enable_t *)value) = !!(dev->option & KW2XRF_OPT_CSMA);
+            return sizeof(ng_netconf_enable_t);
+
         case NETCONF_OPT_PROMISCUOUSMODE:
             *((ng_netconf_enable_t *)value) = !!(dev->option & KW2XRF_OPT_PROMISCUOUS);
             return sizeof(ng_netconf_enable_t);
@@ -807,126 +811,6 @@ int kw2xrf_set(ng_netdev_t *netdev, ng_netconf_opt_t opt, void *value, size_t va
     }
 }
 
-/* TODO: generalize and move to ng_ieee802154 */
-/* TODO: include security header implications */
-static size_t _get_frame_hdr_len(uint8_t *mhr)
-{
-    uint8_t tmp;
-    size_t len = 3;
-
-    /* figure out address sizes */
-    tmp = (mhr[1] & NG_IEEE802154_FCF_DST_ADDR_MASK);
-
-    if (tmp == NG_IEEE802154_FCF_DST_ADDR_SHORT) {
-        len += 4;
-    }
-    else if (tmp == NG_IEEE802154_FCF_DST_ADDR_LONG) {
-        len += 10;
-    }
-    else if (tmp != NG_IEEE802154_FCF_DST_ADDR_VOID) {
-        return 0;
-    }
-
-    tmp = (mhr[1] & NG_IEEE802154_FCF_SRC_ADDR_MASK);
-
-    if (tmp == NG_IEEE802154_FCF_SRC_ADDR_VOID) {
-        return len;
-    }
-    else {
-        if (!(mhr[0] & NG_IEEE802154_FCF_PAN_COMP)) {
-            len += 2;
-        }
-
-        if (tmp == NG_IEEE802154_FCF_SRC_ADDR_SHORT) {
-            return (len + 2);
-        }
-        else if (tmp == NG_IEEE802154_FCF_SRC_ADDR_LONG) {
-            return (len + 8);
-        }
-    }
-
-    return 0;
-}
-
-/* TODO: generalize and move to ng_ieee802154 */
-static ng_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
-{
-    uint8_t tmp;
-    uint8_t *addr;
-    uint8_t src_len, dst_len;
-    ng_pktsnip_t *snip;
-    ng_netif_hdr_t *hdr;
-
-    /* figure out address sizes */
-    tmp = mhr[1] & NG_IEEE802154_FCF_SRC_ADDR_MASK;
-
-    if (tmp == NG_IEEE802154_FCF_SRC_ADDR_SHORT) {
-        src_len = 2;
-    }
-    else if (tmp == NG_IEEE802154_FCF_SRC_ADDR_LONG) {
-        src_len = 8;
-    }
-    else if (tmp == 0) {
-        src_len = 0;
-    }
-    else {
-        return NULL;
-    }
-
-    tmp = mhr[1] & NG_IEEE802154_FCF_DST_ADDR_MASK;
-
-    if (tmp == NG_IEEE802154_FCF_DST_ADDR_SHORT) {
-        dst_len = 2;
-    }
-    else if (tmp == NG_IEEE802154_FCF_DST_ADDR_LONG) {
-        dst_len = 8;
-    }
-    else if (tmp == 0) {
-        dst_len = 0;
-    }
-    else {
-        return NULL;
-    }
-
-    /* allocate space for header */
-    snip = ng_pktbuf_add(NULL, NULL, sizeof(ng_netif_hdr_t) + src_len + dst_len,
-                         NG_NETTYPE_NETIF);
-
-    if (snip == NULL) {
-        return NULL;
-    }
-
-    /* fill header */
-    hdr = (ng_netif_hdr_t *)snip->data;
-    ng_netif_hdr_init(hdr, src_len, dst_len);
-
-    if (dst_len > 0) {
-        tmp = 5 + dst_len;
-        addr = ng_netif_hdr_get_dst_addr(hdr);
-
-        for (int i = 0; i < dst_len; i++) {
-            addr[i] = mhr[5 + (dst_len - i) - 1];
-        }
-    }
-    else {
-        tmp = 3;
-    }
-
-    if (!(mhr[0] & NG_IEEE802154_FCF_PAN_COMP)) {
-        tmp += 2;
-    }
-
-    if (src_len > 0) {
-        addr = ng_netif_hdr_get_src_addr(hdr);
-
-        for (int i = 0; i < src_len; i++) {
-            addr[i] = mhr[tmp + (src_len - i) - 1];
-        }
-    }
-
-    return snip;
-}
-
 void _receive_data(kw2xrf_t *dev)
 {
     size_t pkt_len, hdr_len;
@@ -959,7 +843,7 @@ void _receive_data(kw2xrf_t *dev)
     }
 
     /* get FCF field and compute 802.15.4 header length */
-    hdr_len = _get_frame_hdr_len(dev->buf);
+    hdr_len = ng_ieee802154_get_frame_hdr_len(dev->buf);
 
     if (hdr_len == 0) {
         DEBUG("kw2xrf error: unable parse incoming frame header\n");
@@ -967,7 +851,7 @@ void _receive_data(kw2xrf_t *dev)
     }
 
     /* read the rest of the header and parse the netif header from it */
-    hdr = _make_netif_hdr(dev->buf);
+    hdr = ng_ieee802154_netif_hdr_build(dev->buf);
 
     if (hdr == NULL) {
         DEBUG("kw2xrf error: unable to allocate netif header\n");
@@ -1040,12 +924,13 @@ void kw2xrf_isr_event(ng_netdev_t *netdev, uint32_t event_type)
     }
 }
 
-/* TODO: Move to ng_ieee802.15.4 as soon as ready */
 int _assemble_tx_buf(kw2xrf_t *dev, ng_pktsnip_t *pkt)
 {
+    static const uint8_t bcast[] = NG_IEEE802154_ADDR_BCAST;
     ng_netif_hdr_t *hdr;
-    hdr = (ng_netif_hdr_t *)pkt->data;
-    int index = 0;
+    const uint8_t *dst, *src;
+    size_t dst_len, src_len, len;
+    le_uint16_t pan;
 
     if (dev == NULL) {
         ng_pktbuf_release(pkt);
@@ -1054,72 +939,46 @@ int _assemble_tx_buf(kw2xrf_t *dev, ng_pktsnip_t *pkt)
 
     /* get netif header check address length */
     hdr = (ng_netif_hdr_t *)pkt->data;
+    pan = byteorder_btols(byteorder_htons(dev->radio_pan));
 
-    /* FCF, set up data frame, request for ack, panid_compression */
-    /* TODO: Currently we don´t request for Ack in this device.
-     * since this is a soft_mac device this has to be
-     * handled in a upcoming CSMA-MAC layer.
-     */
-    /*if(dev->option & KW2XRF_OPT_AUTOACK) {
-        dev->buf[1] = 0x61;
-    }
-    else {
-        dev->buf[1] = 0x51;
-    }*/
-    dev->buf[1] = 0x51;
-
-    /* set sequence number */
-    dev->buf[3] = dev->seq_nr++;
-
-    index = 4;
-
-    /* set destination pan_id */
-    dev->buf[index++] = (uint8_t)((dev->radio_pan) & 0xff);
-    dev->buf[index++] = (uint8_t)((dev->radio_pan) >> 8);
-
-    /* fill in destination address */
     if (hdr->flags &
         (NG_NETIF_HDR_FLAGS_BROADCAST | NG_NETIF_HDR_FLAGS_MULTICAST)) {
-        dev->buf[2] = 0x88;
-        dev->buf[index++] = 0xff;
-        dev->buf[index++] = 0xff;
-        /* set source address */
-        dev->buf[index++] = (uint8_t)(dev->addr_short[0]);
-        dev->buf[index++] = (uint8_t)(dev->addr_short[1]);
+        dst = bcast;
+        dst_len = sizeof(bcast);
     }
-    else if (hdr->dst_l2addr_len == 2) {
-        /* set to short addressing mode */
-        dev->buf[2] = 0x88;
-        /* set destination address, byte order is inverted */
-        dev->buf[index++] = (ng_netif_hdr_get_dst_addr(hdr))[1];
-        dev->buf[index++] = (ng_netif_hdr_get_dst_addr(hdr))[0];
-        /* set source pan_id */
-        //dev->buf[index++] = (uint8_t)((dev->radio_pan) >> 8);
-        //dev->buf[index++] = (uint8_t)((dev->radio_pan) & 0xff);
-        /* set source address */
-        dev->buf[index++] = (uint8_t)(dev->addr_short[0]);
-        dev->buf[index++] = (uint8_t)(dev->addr_short[1]);
+    else {
+        dst = ng_netif_hdr_get_dst_addr(hdr);
+        dst_len = hdr->dst_l2addr_len;
     }
-    else if (hdr->dst_l2addr_len == 8) {
-        /* default to use long address mode for src and dst */
-        dev->buf[2] |= 0xcc;
-        /* set destination address located directly after ng_ifhrd_t in memory */
-        memcpy(&(dev->buf)[index], ng_netif_hdr_get_dst_addr(hdr), 8);
-        index += 8;
-        /* set source pan_id, wireshark expects it there */
-        //dev->buf[index++] = (uint8_t)((dev->radio_pan) >> 8);
-        //dev->buf[index++] = (uint8_t)((dev->radio_pan) & 0xff);
-
-        /* set source address */
-        memcpy(&(dev->buf[index]), dev->addr_long, 8);
-        index += 8;
+
+    /* default to use long address mode for src if dst is long */
+    if (dst_len == 8) {
+        src = dev->addr_long;
+        src_len = sizeof(dev->addr_long);
     }
     else {
+        src = dev->addr_short;
+        src_len = sizeof(dev->addr_short);
+    }
+
+    /* FCF, set up data frame, panid_compression
+     * TODO: Currently we don´t request for Ack in this device.
+     * since this is a soft_mac device this has to be
+     * handled in a upcoming CSMA-MAC layer.
+     */
+    len = ng_ieee802154_set_frame_hdr(&dev->buf[1], src, src_len, dst, dst_len,
+                                      pan, pan,
+                                      NG_IEEE802154_FCF_TYPE_DATA |
+                                      NG_IEEE802154_FCF_FRAME_PEND |
+                                      NG_IEEE802154_FCF_PAN_COMP,
+                                      dev->seq_nr++);
+    if (len == 0) {
         ng_pktbuf_release(pkt);
         return -ENOMSG;
     }
 
-    return index;
+    /* the header follows the length byte */
+    return len + 1;
 }
 
 int kw2xrf_send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
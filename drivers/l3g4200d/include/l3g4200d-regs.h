@@ -86,6 +86,49 @@
 #define L3G4200D_CTRL4_FS_POS           (4)
 /** @} */
 
+/**
+ * @name CTRL3 bitfields
+ * @{
+ */
+#define L3G4200D_CTRL3_I2_DRDY          0x08
+#define L3G4200D_CTRL3_I2_WTM           0x04
+#define L3G4200D_CTRL3_I2_ORUN          0x02
+#define L3G4200D_CTRL3_I2_EMPTY         0x01
+/** @} */
+
+/**
+ * @name CTRL5 bitfields
+ * @{
+ */
+#define L3G4200D_CTRL5_BOOT             0x80
+#define L3G4200D_CTRL5_FIFO_EN          0x40
+/** @} */
+
+/**
+ * @name FIFO_CTRL bitfields
+ * @{
+ */
+#define L3G4200D_FIFO_CTRL_BYPASS       0x00
+#define L3G4200D_FIFO_CTRL_FIFO         0x20
+#define L3G4200D_FIFO_CTRL_STREAM       0x40
+#define L3G4200D_FIFO_CTRL_WTM_MASK     0x1f
+/** @} */
+
+/**
+ * @name FIFO_SRC bitfields
+ * @{
+ */
+#define L3G4200D_FIFO_SRC_WTM           0x80
+#define L3G4200D_FIFO_SRC_OVRN          0x40
+#define L3G4200D_FIFO_SRC_EMPTY         0x20
+#define L3G4200D_FIFO_SRC_FSS_MASK      0x1f
+/** @} */
+
+/**
+ * @brief Number of samples in the FIFO
+ */
+#define L3G4200D_FIFO_SIZE              (32)
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,10 @@ int l3g4200d_init(l3g4200d_t *dev, i2c_t i2c, uint8_t address,
 {
     char tmp;
 
+    /* write device descriptor */
+    dev->i2c = i2c;
+    dev->addr = address;
+
     /* Acquire exclusive access to the bus. */
     i2c_acquire(dev->i2c);
     /* initialize the I2C bus */
@@ -49,9 +53,6 @@ int l3g4200d_init(l3g4200d_t *dev, i2c_t i2c, uint8_t address,
     }
     i2c_release(dev->i2c);
 
-    /* write device descriptor */
-    dev->i2c = i2c;
-    dev->addr = address;
     dev->int1 = int1_pin;
     dev->int2 = int2_pin;
 
@@ -107,6 +108,96 @@ int l3g4200d_read(l3g4200d_t *dev, l3g4200d_data_t *data)
     return 0;
 }
 
+#ifdef MODULE_SENSOR_FIFO
+static int _fifo_level(void *arg)
+{
+    l3g4200d_t *dev = arg;
+    char src;
+    int res;
+
+    i2c_acquire(dev->i2c);
+    res = i2c_read_reg(dev->i2c, dev->addr, L3G4200D_REG_FIFO_SRC, &src);
+    i2c_release(dev->i2c);
+    if (res < 1) {
+        return -1;
+    }
+    if (src & L3G4200D_FIFO_SRC_EMPTY) {
+        return 0;
+    }
+    /* a full FIFO reads as 31 samples plus the overrun flag */
+    if (src & L3G4200D_FIFO_SRC_OVRN) {
+        return L3G4200D_FIFO_SIZE;
+    }
+    return src & L3G4200D_FIFO_SRC_FSS_MASK;
+}
+
+static int _fifo_drain(void *arg, void *buf, unsigned num)
+{
+    l3g4200d_t *dev = arg;
+    l3g4200d_data_t *data = buf;
+    uint8_t *raw = buf;
+    int len = num * 6;
+    int res;
+
+    /* in FIFO mode the address wraps from OUT_Z_H back to OUT_X_L, so one
+     * burst reads num samples */
+    i2c_acquire(dev->i2c);
+    res = i2c_read_regs(dev->i2c, dev->addr, L3G4200D_REG_OUT_X_L | L3G4200D_AUTOINC,
+                        (char *)buf, len);
+    i2c_release(dev->i2c);
+    if (res < len) {
+        return -1;
+    }
+
+    /* normalize in place, as in l3g4200d_read() */
+    for (unsigned i = 0; i < num; i++, raw += 6) {
+        int16_t x = (raw[1] << 8) | raw[0];
+        int16_t y = (raw[3] << 8) | raw[2];
+        int16_t z = (raw[5] << 8) | raw[4];
+
+        data[i].acc_x = (int16_t)((dev->scale * x) / MAX_VAL);
+        data[i].acc_y = (int16_t)((dev->scale * y) / MAX_VAL);
+        data[i].acc_z = (int16_t)((dev->scale * z) / MAX_VAL);
+    }
+    return 0;
+}
+
+static const sensor_fifo_driver_t _fifo_driver = {
+    _fifo_level,
+    _fifo_drain,
+};
+
+int l3g4200d_fifo_init(l3g4200d_t *dev, sensor_fifo_t *fifo, uint8_t watermark)
+{
+    int res;
+
+    if ((watermark == 0) || (watermark >= L3G4200D_FIFO_SIZE) ||
+        (dev->int2 == GPIO_UNDEF)) {
+        return -1;
+    }
+    sensor_fifo_init(fifo, &_fifo_driver, dev, sizeof(l3g4200d_data_t),
+                     watermark, 0);
+
+    i2c_acquire(dev->i2c);
+    /* restart the FIFO in stream mode: bypass mode empties it */
+    res = i2c_write_reg(dev->i2c, dev->addr, L3G4200D_REG_FIFO_CTRL,
+                        L3G4200D_FIFO_CTRL_BYPASS);
+    res += i2c_write_reg(dev->i2c, dev->addr, L3G4200D_REG_FIFO_CTRL,
+                         L3G4200D_FIFO_CTRL_STREAM | watermark);
+    res += i2c_write_reg(dev->i2c, dev->addr, L3G4200D_REG_CTRL5,
+                         L3G4200D_CTRL5_FIFO_EN);
+    res += i2c_write_reg(dev->i2c, dev->addr, L3G4200D_REG_CTRL3,
+                         L3G4200D_CTRL3_I2_WTM);
+    i2c_release(dev->i2c);
+    if (res != 4) {
+        return -1;
+    }
+
+    return gpio_init_int(dev->int2, GPIO_NOPULL, GPIO_RISING, sensor_fifo_isr,
+                         fifo);
+}
+#endif
+
 int l3g4200d_enable(l3g4200d_t *dev)
 {
     char tmp;
@@ -136,6 +136,77 @@ int lis3dh_set_fifo(lis3dh_t *dev, const uint8_t enable)
                              (enable ? LIS3DH_CTRL_REG5_FIFO_EN_MASK : 0));
 }
 
+#ifdef MODULE_SENSOR_FIFO
+static int lis3dh_fifo_level(void *arg)
+{
+    uint8_t src;
+
+    if (lis3dh_read_regs(arg, LIS3DH_REG_FIFO_SRC_REG, 1, &src) < 0) {
+        return -1;
+    }
+    if (src & LIS3DH_FIFO_SRC_REG_EMPTY_MASK) {
+        return 0;
+    }
+    /* a full FIFO reads as 31 samples plus the overrun flag */
+    if (src & LIS3DH_FIFO_SRC_REG_OVRN_FIFO_MASK) {
+        return LIS3DH_FIFO_SIZE;
+    }
+    return (src & LIS3DH_FIFO_SRC_REG_FSS_MASK) >> LIS3DH_FIFO_SRC_REG_FSS_SHIFT;
+}
+
+static int lis3dh_fifo_drain(void *arg, void *buf, unsigned num)
+{
+    const lis3dh_t *dev = arg;
+    int16_t *data = buf;
+
+    /* in FIFO mode the address wraps from OUT_Z_H back to OUT_X_L, so one
+     * burst reads num samples */
+    if (lis3dh_read_regs(dev, LIS3DH_REG_OUT_X_L, num * sizeof(lis3dh_data_t),
+                         buf) < 0) {
+        return -1;
+    }
+
+    /* Scale to milli-G */
+    for (unsigned i = 0; i < 3 * num; ++i) {
+        int32_t tmp = data[i];
+        tmp *= dev->scale;
+        tmp /= 32768;
+        data[i] = (int16_t)tmp;
+    }
+    return 0;
+}
+
+static const sensor_fifo_driver_t lis3dh_fifo_driver = {
+    lis3dh_fifo_level,
+    lis3dh_fifo_drain,
+};
+
+int lis3dh_fifo_init(lis3dh_t *dev, sensor_fifo_t *fifo, uint8_t watermark)
+{
+    if ((watermark == 0) || (watermark >= LIS3DH_FIFO_SIZE) ||
+        (dev->int1 == GPIO_UNDEF)) {
+        return -1;
+    }
+    sensor_fifo_init(fifo, &lis3dh_fifo_driver, dev, sizeof(lis3dh_data_t),
+                     watermark, 0);
+
+    /* restart the FIFO in stream mode: bypass mode empties it */
+    if ((lis3dh_set_fifo_mode(dev, LIS3DH_FIFO_MODE_BYPASS) < 0) ||
+        (lis3dh_write_reg(dev, LIS3DH_REG_FIFO_CTRL_REG,
+                          LIS3DH_FIFO_MODE_STREAM |
+                          (watermark << LIS3DH_FIFO_CTRL_REG_FTH_SHIFT)) < 0) ||
+        (lis3dh_set_fifo(dev, 1) < 0) ||
+        (lis3dh_write_bits(dev, LIS3DH_REG_CTRL_REG3,
+                           LIS3DH_CTRL_REG3_I1_WTM_MASK,
+                           LIS3DH_CTRL_REG3_I1_WTM_MASK) < 0)) {
+        return -1;
+    }
+
+    return gpio_init_int(dev->int1, GPIO_NOPULL, GPIO_RISING, sensor_fifo_isr,
+                         fifo);
+}
+#endif
+
 int lis3dh_set_odr(lis3dh_t *dev, const lis3dh_odr_t odr)
 {
     return lis3dh_write_bits(dev, LIS3DH_REG_CTRL_REG1, LIS3DH_CTRL_REG1_ODR_MASK,
@@ -42,8 +42,15 @@ extern "C" {
 #define LSM303DLHC_REG_OUT_Y_H_A            (0x2b)
 #define LSM303DLHC_REG_OUT_Z_L_A            (0x2c)
 #define LSM303DLHC_REG_OUT_Z_H_A            (0x2d)
+#define LSM303DLHC_REG_FIFO_CTRL_A          (0x2e)
+#define LSM303DLHC_REG_FIFO_SRC_A           (0x2f)
 /** @} */
 
+/**
+ * @brief Flag for reading multiple accelerometer registers
+ */
+#define LSM303DLHC_AUTOINC                  (0x80)
+
 /**
  * @name Masks for the LSM303DLHC CTRL1_A register
  * @{
@@ -72,9 +79,9 @@ extern "C" {
 #define LSM303DLHC_CTRL3_A_I1_AOI1          (0x40)
 #define LSM303DLHC_CTRL3_A_I1_AOI2          (0x20)
 #define LSM303DLHC_CTRL3_A_I1_DRDY1         (0x10)
-#define LSM303DLHC_CTRL3_A_I1_DRDY2         (0x80)
-#define LSM303DLHC_CTRL3_A_I1_WTM           (0x40)
-#define LSM303DLHC_CTRL3_A_I1_OVERRUN       (0x20)
+#define LSM303DLHC_CTRL3_A_I1_DRDY2         (0x08)
+#define LSM303DLHC_CTRL3_A_I1_WTM           (0x04)
+#define LSM303DLHC_CTRL3_A_I1_OVERRUN       (0x02)
 #define LSM303DLHC_CTRL3_A_I1_NONE          (0x00)
 /** @} */
 
@@ -113,6 +120,31 @@ extern "C" {
 #define LSM303DLHC_REG_CTRL5_A_FIFO_EN  (0x40)
 /** @} */
 
+/**
+ * @name Masks for the LSM303DLHC FIFO_CTRL_REG_A register
+ * @{
+ */
+#define LSM303DLHC_FIFO_CTRL_A_BYPASS       (0x00)
+#define LSM303DLHC_FIFO_CTRL_A_FIFO         (0x40)
+#define LSM303DLHC_FIFO_CTRL_A_STREAM       (0x80)
+#define LSM303DLHC_FIFO_CTRL_A_FTH_MASK     (0x1f)
+/** @} */
+
+/**
+ * @name Masks for the LSM303DLHC FIFO_SRC_REG_A register
+ * @{
+ */
+#define LSM303DLHC_FIFO_SRC_A_WTM           (0x80)
+#define LSM303DLHC_FIFO_SRC_A_OVRN          (0x40)
+#define LSM303DLHC_FIFO_SRC_A_EMPTY         (0x20)
+#define LSM303DLHC_FIFO_SRC_A_FSS_MASK      (0x1f)
+/** @} */
+
+/**
+ * @brief Number of samples in the accelerometer FIFO
+ */
+#define LSM303DLHC_FIFO_SIZE                (32)
+
 /**
  * @name LSM303DLHC magnetometer registers
  * @{
@@ -134,6 +134,96 @@ int lsm303dlhc_read_acc(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data)
     return 0;
 }
 
+#ifdef MODULE_SENSOR_FIFO
+static int _acc_fifo_level(void *arg)
+{
+    lsm303dlhc_t *dev = arg;
+    char src;
+    int res;
+
+    i2c_acquire(dev->i2c);
+    res = i2c_read_reg(dev->i2c, dev->acc_address,
+                       LSM303DLHC_REG_FIFO_SRC_A, &src);
+    i2c_release(dev->i2c);
+    if (res < 1) {
+        return -1;
+    }
+    if (src & LSM303DLHC_FIFO_SRC_A_EMPTY) {
+        return 0;
+    }
+    /* a full FIFO reads as 31 samples plus the overrun flag */
+    if (src & LSM303DLHC_FIFO_SRC_A_OVRN) {
+        return LSM303DLHC_FIFO_SIZE;
+    }
+    return src & LSM303DLHC_FIFO_SRC_A_FSS_MASK;
+}
+
+static int _acc_fifo_drain(void *arg, void *buf, unsigned num)
+{
+    lsm303dlhc_t *dev = arg;
+    lsm303dlhc_3d_data_t *data = buf;
+    uint8_t *raw = buf;
+    int len = num * 6;
+    int res;
+
+    /* in FIFO mode the address wraps from OUT_Z_H_A back to OUT_X_L_A, so
+     * one burst reads num samples */
+    i2c_acquire(dev->i2c);
+    res = i2c_read_regs(dev->i2c, dev->acc_address,
+                        LSM303DLHC_REG_OUT_X_L_A | LSM303DLHC_AUTOINC,
+                        (char *)buf, len);
+    i2c_release(dev->i2c);
+    if (res < len) {
+        DEBUG("lsm303dlhc: FIFO burst failed\n");
+        return -1;
+    }
+
+    /* left aligned 12 bit values, as in lsm303dlhc_read_acc() */
+    for (unsigned i = 0; i < num; i++, raw += 6) {
+        data[i].x_axis = ((int16_t)((raw[1] << 8) | raw[0])) >> 4;
+        data[i].y_axis = ((int16_t)((raw[3] << 8) | raw[2])) >> 4;
+        data[i].z_axis = ((int16_t)((raw[5] << 8) | raw[4])) >> 4;
+    }
+    return 0;
+}
+
+static const sensor_fifo_driver_t _acc_fifo_driver = {
+    _acc_fifo_level,
+    _acc_fifo_drain,
+};
+
+int lsm303dlhc_acc_fifo_init(lsm303dlhc_t *dev, sensor_fifo_t *fifo,
+                             uint8_t watermark)
+{
+    int res;
+
+    if ((watermark == 0) || (watermark >= LSM303DLHC_FIFO_SIZE) ||
+        (dev->acc_pin == GPIO_UNDEF)) {
+        return -1;
+    }
+    sensor_fifo_init(fifo, &_acc_fifo_driver, dev,
+                     sizeof(lsm303dlhc_3d_data_t), watermark, 0);
+
+    i2c_acquire(dev->i2c);
+    /* restart the FIFO in stream mode: bypass mode empties it */
+    res = i2c_write_reg(dev->i2c, dev->acc_address, LSM303DLHC_REG_FIFO_CTRL_A,
+                        LSM303DLHC_FIFO_CTRL_A_BYPASS);
+    res += i2c_write_reg(dev->i2c, dev->acc_address, LSM303DLHC_REG_FIFO_CTRL_A,
+                         LSM303DLHC_FIFO_CTRL_A_STREAM | watermark);
+    res += i2c_write_reg(dev->i2c, dev->acc_address, LSM303DLHC_REG_CTRL5_A,
+                         LSM303DLHC_REG_CTRL5_A_FIFO_EN);
+    res += i2c_write_reg(dev->i2c, dev->acc_address, LSM303DLHC_REG_CTRL3_A,
+                         LSM303DLHC_CTRL3_A_I1_WTM);
+    i2c_release(dev->i2c);
+    if (res != 4) {
+        return -1;
+    }
+
+    return gpio_init_int(dev->acc_pin, GPIO_NOPULL, GPIO_RISING,
+                         sensor_fifo_isr, fifo);
+}
+#endif
+
 int lsm303dlhc_read_mag(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data)
 {
     int res;
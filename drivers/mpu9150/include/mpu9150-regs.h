@@ -93,8 +93,18 @@
 #define BIT_SLAVE_RW                    (0x80)
 #define BIT_SLAVE_EN                    (0x80)
 #define BIT_DMP_EN                      (0x80)
+#define BIT_FIFO_EN                     (0x40)
+#define BIT_FIFO_RESET                  (0x04)
+#define BIT_FIFO_TEMP                   (0x80)
+#define BIT_FIFO_GYRO                   (0x70)
+#define BIT_FIFO_ACCEL                  (0x08)
 /** @} */
 
+/**
+ * @brief Size of the FIFO in bytes
+ */
+#define MPU9150_FIFO_SIZE               (1024)
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,7 @@ static const mpu9150_status_t DEFAULT_STATUS = {
     .compass_x_adj = 0,
     .compass_y_adj = 0,
     .compass_z_adj = 0,
+    .fifo_src = MPU9150_FIFO_OFF,
 };
 
 /* Internal function prototypes */
@@ -489,6 +490,127 @@ int mpu9150_set_compass_sample_rate(mpu9150_t *dev, uint8_t rate)
     return 0;
 }
 
+#ifdef MODULE_SENSOR_FIFO
+/**
+ * Reset the FIFO, it is misaligned after an overflow
+ * Caution: This internal function does not acquire exclusive access to the I2C bus.
+ */
+static int fifo_reset(mpu9150_t *dev)
+{
+    char data;
+    int res;
+
+    if (i2c_read_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, &data) != 1) {
+        return -1;
+    }
+    data |= BIT_FIFO_EN;
+    res = i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG,
+                        data | BIT_FIFO_RESET);
+    res += i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, data);
+    return (res == 2) ? 0 : -1;
+}
+
+static int fifo_level(void *arg)
+{
+    mpu9150_t *dev = arg;
+    uint8_t data[2];
+    uint16_t count;
+
+    if (i2c_acquire(dev->i2c_dev)) {
+        return -1;
+    }
+    if (i2c_read_regs(dev->i2c_dev, dev->hw_addr, MPU9150_FIFO_COUNT_START_REG,
+                      (char *)data, 2) != 2) {
+        i2c_release(dev->i2c_dev);
+        return -1;
+    }
+    count = (data[0] << 8) | data[1];
+    if (count >= MPU9150_FIFO_SIZE) {
+        DEBUG("mpu9150: FIFO overflow\n");
+        count = 0;
+        if (fifo_reset(dev) < 0) {
+            i2c_release(dev->i2c_dev);
+            return -1;
+        }
+    }
+    i2c_release(dev->i2c_dev);
+
+    return count / sizeof(mpu9150_results_t);
+}
+
+static int fifo_drain(void *arg, void *buf, unsigned num)
+{
+    mpu9150_t *dev = arg;
+    mpu9150_results_t *output = buf;
+    uint8_t *data = buf;
+    int len = num * 6;
+    int32_t fsr;
+
+    if (dev->conf.fifo_src == MPU9150_FIFO_ACCEL) {
+        fsr = 2000 << dev->conf.accel_fsr;
+    }
+    else {
+        fsr = 250 << dev->conf.gyro_fsr;
+    }
+
+    if (i2c_acquire(dev->i2c_dev)) {
+        return -1;
+    }
+    /* FIFO_R_W does not auto-increment, so one burst reads num samples */
+    if (i2c_read_regs(dev->i2c_dev, dev->hw_addr, MPU9150_FIFO_RW_REG,
+                      (char *)buf, len) != len) {
+        i2c_release(dev->i2c_dev);
+        return -1;
+    }
+    i2c_release(dev->i2c_dev);
+
+    /* Normalize data according to configured full scale range */
+    for (unsigned i = 0; i < num; i++, data += 6) {
+        int16_t x = (data[0] << 8) | data[1];
+        int16_t y = (data[2] << 8) | data[3];
+        int16_t z = (data[4] << 8) | data[5];
+
+        output[i].x_axis = (x * fsr) / MAX_VALUE;
+        output[i].y_axis = (y * fsr) / MAX_VALUE;
+        output[i].z_axis = (z * fsr) / MAX_VALUE;
+    }
+
+    return 0;
+}
+
+static const sensor_fifo_driver_t fifo_driver = {
+    fifo_level,
+    fifo_drain,
+};
+
+int mpu9150_fifo_init(mpu9150_t *dev, sensor_fifo_t *fifo,
+                      mpu9150_fifo_src_t src, uint8_t watermark)
+{
+    int res;
+
+    if (((src != MPU9150_FIFO_ACCEL) && (src != MPU9150_FIFO_GYRO)) ||
+        (watermark == 0) || (dev->conf.sample_rate == 0) ||
+        (watermark * sizeof(mpu9150_results_t) >= MPU9150_FIFO_SIZE)) {
+        return -2;
+    }
+    dev->conf.fifo_src = src;
+    sensor_fifo_init(fifo, &fifo_driver, dev, sizeof(mpu9150_results_t), watermark,
+                     (watermark * 1000000UL) / dev->conf.sample_rate);
+
+    if (i2c_acquire(dev->i2c_dev)) {
+        return -1;
+    }
+    res = i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_FIFO_EN_REG, (char)src);
+    if ((res != 1) || (fifo_reset(dev) < 0)) {
+        i2c_release(dev->i2c_dev);
+        return -1;
+    }
+    i2c_release(dev->i2c_dev);
+
+    return 0;
+}
+#endif
+
 /*------------------------------------------------------------------------------------*/
 /*                                Internal functions                                  */
 /*------------------------------------------------------------------------------------*/
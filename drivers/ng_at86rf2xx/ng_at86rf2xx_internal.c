@@ -24,9 +24,93 @@
 
 #include "periph/spi.h"
 #include "periph/gpio.h"
+#include "mutex.h"
 #include "ng_at86rf2xx_internal.h"
 #include "ng_at86rf2xx_registers.h"
 
+#ifdef MODULE_SPI_ASYNC
+/**
+ * @brief   Frame buffer and SRAM accesses of at least this many bytes are done
+ *          asynchronously, the calling thread sleeps instead of busy waiting
+ */
+#ifndef NG_AT86RF2XX_SPI_ASYNC_MIN
+#define NG_AT86RF2XX_SPI_ASYNC_MIN      (16U)
+#endif
+
+/**
+ * @brief   State of an asynchronous access, shared with the callbacks
+ */
+typedef struct {
+    mutex_t done;               /**< unlocked when the chain ended */
+    int res;                    /**< -1 if a transfer of the chain failed */
+} _async_t;
+
+static void _async_cmd_done(void *arg, int res)
+{
+    _async_t *async = arg;
+
+    /* the chain stops at a failed transfer, the data phase never completes */
+    if (res < 0) {
+        async->res = -1;
+        mutex_unlock(&async->done);
+    }
+}
+
+static void _async_done(void *arg, int res)
+{
+    _async_t *async = arg;
+
+    if (res < 0) {
+        async->res = -1;
+    }
+    mutex_unlock(&async->done);
+}
+
+/**
+ * @brief   Send cmd (and the SRAM offset, if given) followed by the data phase
+ *          as one asynchronous chain, bus and CS must be held by the caller
+ *
+ * If the chain fails, part of it may have been clocked out already. CS is
+ * then toggled, so the caller can repeat the whole access in a new frame.
+ *
+ * @return  0 when the transfer completed, -1 if it failed
+ */
+static int _transfer_async(const ng_at86rf2xx_t *dev, uint8_t cmd,
+                           char *offset, char *out, char *in, size_t len)
+{
+    _async_t async = { .done = MUTEX_INIT, .res = 0 };
+    spi_transfer_t xfer[2];
+
+    xfer[0] = (spi_transfer_t) {
+        .next = &xfer[1], .reg = cmd, .out = offset, .in = NULL,
+        .length = (offset != NULL) ? 1 : 0, .cb = _async_cmd_done,
+        .arg = &async
+    };
+    xfer[1] = (spi_transfer_t) {
+        .next = NULL, .reg = SPI_REG_NONE, .out = out, .in = in,
+        .length = len, .cb = _async_done, .arg = &async
+    };
+
+    mutex_lock(&async.done);
+    if (spi_transfer_async(dev->spi, xfer) < 0) {
+        /* not started, or failed while running synchronously */
+        async.res = -1;
+    }
+    else {
+        /* sleeps until the chain ended */
+        mutex_lock(&async.done);
+    }
+
+    if (async.res < 0) {
+        gpio_set(dev->cs_pin);
+        gpio_clear(dev->cs_pin);
+        return -1;
+    }
+
+    return 0;
+}
+#endif
+
 void ng_at86rf2xx_reg_write(const ng_at86rf2xx_t *dev,
                             const uint8_t addr,
                             const uint8_t value)
@@ -62,10 +146,18 @@ void ng_at86rf2xx_sram_read(const ng_at86rf2xx_t *dev,
 {
     spi_acquire(dev->spi);
     gpio_clear(dev->cs_pin);
-    spi_transfer_reg(dev->spi,
-                     NG_AT86RF2XX_ACCESS_SRAM | NG_AT86RF2XX_ACCESS_READ,
-                     (char)offset, NULL);
-    spi_transfer_bytes(dev->spi, NULL, (char*)data, len);
+#ifdef MODULE_SPI_ASYNC
+    char addr = (char)offset;
+    if ((len < NG_AT86RF2XX_SPI_ASYNC_MIN) ||
+        (_transfer_async(dev, NG_AT86RF2XX_ACCESS_SRAM | NG_AT86RF2XX_ACCESS_READ,
+                         &addr, NULL, (char *)data, len) < 0))
+#endif
+    {
+        spi_transfer_reg(dev->spi,
+                         NG_AT86RF2XX_ACCESS_SRAM | NG_AT86RF2XX_ACCESS_READ,
+                         (char)offset, NULL);
+        spi_transfer_bytes(dev->spi, NULL, (char*)data, len);
+    }
     gpio_set(dev->cs_pin);
     spi_release(dev->spi);
 }
@@ -77,10 +169,18 @@ void ng_at86rf2xx_sram_write(const ng_at86rf2xx_t *dev,
 {
     spi_acquire(dev->spi);
     gpio_clear(dev->cs_pin);
-    spi_transfer_reg(dev->spi,
-                     NG_AT86RF2XX_ACCESS_SRAM | NG_AT86RF2XX_ACCESS_WRITE,
-                     (char)offset, NULL);
-    spi_transfer_bytes(dev->spi, (char*)data, NULL, len);
+#ifdef MODULE_SPI_ASYNC
+    char addr = (char)offset;
+    if ((len < NG_AT86RF2XX_SPI_ASYNC_MIN) ||
+        (_transfer_async(dev, NG_AT86RF2XX_ACCESS_SRAM | NG_AT86RF2XX_ACCESS_WRITE,
+                         &addr, (char *)data, NULL, len) < 0))
+#endif
+    {
+        spi_transfer_reg(dev->spi,
+                         NG_AT86RF2XX_ACCESS_SRAM | NG_AT86RF2XX_ACCESS_WRITE,
+                         (char)offset, NULL);
+        spi_transfer_bytes(dev->spi, (char*)data, NULL, len);
+    }
     gpio_set(dev->cs_pin);
     spi_release(dev->spi);
 }
@@ -91,10 +191,17 @@ void ng_at86rf2xx_fb_read(const ng_at86rf2xx_t *dev,
 {
     spi_acquire(dev->spi);
     gpio_clear(dev->cs_pin);
-    spi_transfer_byte(dev->spi,
-                      NG_AT86RF2XX_ACCESS_FB | NG_AT86RF2XX_ACCESS_READ,
-                      NULL);
-    spi_transfer_bytes(dev->spi, NULL, (char *)data, len);
+#ifdef MODULE_SPI_ASYNC
+    if ((len < NG_AT86RF2XX_SPI_ASYNC_MIN) ||
+        (_transfer_async(dev, NG_AT86RF2XX_ACCESS_FB | NG_AT86RF2XX_ACCESS_READ,
+                         NULL, NULL, (char *)data, len) < 0))
+#endif
+    {
+        spi_transfer_byte(dev->spi,
+                          NG_AT86RF2XX_ACCESS_FB | NG_AT86RF2XX_ACCESS_READ,
+                          NULL);
+        spi_transfer_bytes(dev->spi, NULL, (char *)data, len);
+    }
     gpio_set(dev->cs_pin);
     spi_release(dev->spi);
 }
@@ -29,180 +29,44 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-/* TODO: generalize and move to ng_ieee802154 */
 static size_t _make_data_frame_hdr(ng_at86rf2xx_t *dev, uint8_t *buf,
                                    ng_netif_hdr_t *hdr)
 {
-    int pos = 0;
+    static const uint8_t bcast[] = NG_IEEE802154_ADDR_BCAST;
+    uint8_t flags = NG_IEEE802154_FCF_TYPE_DATA;
+    const uint8_t *dst, *src;
+    size_t dst_len, src_len;
+    le_uint16_t pan = byteorder_btols(byteorder_htons(dev->pan));
 
-    /* we are building a data frame here */
-    buf[0] = NG_IEEE802154_FCF_TYPE_DATA;
-    buf[1] = 0x88;      /* use short src and dst addresses as starting point */
-
-    /* if AUTOACK is enabled, then we also expect ACKs for this packet */
-    if (!(hdr->flags & NG_NETIF_HDR_FLAGS_BROADCAST) &&
-        !(hdr->flags & NG_NETIF_HDR_FLAGS_MULTICAST) &&
-        (dev->options & NG_AT86RF2XX_OPT_AUTOACK)) {
-        buf[0] |= NG_IEEE802154_FCF_ACK_REQ;
-    }
-
-    /* fill in destination PAN ID */
-    pos = 3;
-    buf[pos++] = (uint8_t)((dev->pan) & 0xff);
-    buf[pos++] = (uint8_t)((dev->pan) >> 8);
-
-    /* fill in destination address */
     if (hdr->flags &
         (NG_NETIF_HDR_FLAGS_BROADCAST | NG_NETIF_HDR_FLAGS_MULTICAST)) {
-        buf[pos++] = 0xff;
-        buf[pos++] = 0xff;
-    }
-    else if (hdr->dst_l2addr_len == 2) {
-        uint8_t *dst_addr = ng_netif_hdr_get_dst_addr(hdr);
-        buf[pos++] = dst_addr[1];
-        buf[pos++] = dst_addr[0];
-    }
-    else if (hdr->dst_l2addr_len == 8) {
-        buf[1] |= 0x04;
-        uint8_t *dst_addr = ng_netif_hdr_get_dst_addr(hdr);
-        for (int i = 7;  i >= 0; i--) {
-            buf[pos++] = dst_addr[i];
-        }
+        dst = bcast;
+        dst_len = sizeof(bcast);
     }
     else {
-        /* unsupported address length */
-        return 0;
+        dst = ng_netif_hdr_get_dst_addr(hdr);
+        dst_len = hdr->dst_l2addr_len;
+        /* if AUTOACK is enabled, then we also expect ACKs for this packet */
+        if (dev->options & NG_AT86RF2XX_OPT_AUTOACK) {
+            flags |= NG_IEEE802154_FCF_ACK_REQ;
+        }
     }
-
-    /* fill in source PAN ID (if applicable */
-    if (dev->options & NG_AT86RF2XX_OPT_USE_SRC_PAN) {
-        buf[pos++] = (uint8_t)((dev->pan) & 0xff);
-        buf[pos++] = (uint8_t)((dev->pan) >> 8);
-    } else {
-        buf[0] |= NG_IEEE802154_FCF_PAN_COMP;
+    if (!(dev->options & NG_AT86RF2XX_OPT_USE_SRC_PAN)) {
+        flags |= NG_IEEE802154_FCF_PAN_COMP;
     }
-
-    /* fill in source address */
     if (dev->options & NG_AT86RF2XX_OPT_SRC_ADDR_LONG) {
-        buf[1] |= 0x40;
-        memcpy(&(buf[pos]), dev->addr_long, 8);
-        pos += 8;
+        src = dev->addr_long;
+        src_len = sizeof(dev->addr_long);
     }
     else {
-        buf[pos++] = dev->addr_short[0];
-        buf[pos++] = dev->addr_short[1];
+        src = dev->addr_short;
+        src_len = sizeof(dev->addr_short);
     }
 
-    /* set sequence number */
-    buf[2] = dev->seq_nr++;
-    /* return actual header length */
-    return pos;
-}
-
-/* TODO: generalize and move to ng_ieee802154 */
-/* TODO: include security header implications */
-static size_t _get_frame_hdr_len(uint8_t *mhr)
-{
-    uint8_t tmp;
-    size_t len = 3;
-
-    /* figure out address sizes */
-    tmp = (mhr[1] & NG_IEEE802154_FCF_DST_ADDR_MASK);
-    if (tmp == NG_IEEE802154_FCF_DST_ADDR_SHORT) {
-        len += 4;
-    }
-    else if (tmp == NG_IEEE802154_FCF_DST_ADDR_LONG) {
-        len += 10;
-    }
-    else if (tmp != NG_IEEE802154_FCF_DST_ADDR_VOID) {
-        return 0;
-    }
-    tmp = (mhr[1] & NG_IEEE802154_FCF_SRC_ADDR_MASK);
-    if (tmp == NG_IEEE802154_FCF_SRC_ADDR_VOID) {
-        return len;
-    }
-    else {
-        if (!(mhr[0] & NG_IEEE802154_FCF_PAN_COMP)) {
-            len += 2;
-        }
-        if (tmp == NG_IEEE802154_FCF_SRC_ADDR_SHORT) {
-            return (len + 2);
-        }
-        else if (tmp == NG_IEEE802154_FCF_SRC_ADDR_LONG) {
-            return (len + 8);
-        }
-    }
-    return 0;
-}
-
-/* TODO: generalize and move to ng_ieee802154 */
-static ng_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
-{
-    uint8_t tmp;
-    uint8_t *addr;
-    uint8_t src_len, dst_len;
-    ng_pktsnip_t *snip;
-    ng_netif_hdr_t *hdr;
-
-    /* figure out address sizes */
-    tmp = mhr[1] & NG_IEEE802154_FCF_SRC_ADDR_MASK;
-    if (tmp == NG_IEEE802154_FCF_SRC_ADDR_SHORT) {
-        src_len = 2;
-    }
-    else if (tmp == NG_IEEE802154_FCF_SRC_ADDR_LONG) {
-        src_len = 8;
-    }
-    else if (tmp == 0) {
-        src_len = 0;
-    }
-    else {
-        return NULL;
-    }
-    tmp = mhr[1] & NG_IEEE802154_FCF_DST_ADDR_MASK;
-    if (tmp == NG_IEEE802154_FCF_DST_ADDR_SHORT) {
-        dst_len = 2;
-    }
-    else if (tmp == NG_IEEE802154_FCF_DST_ADDR_LONG) {
-        dst_len = 8;
-    }
-    else if (tmp == 0) {
-        dst_len = 0;
-    }
-    else {
-        return NULL;
-    }
-    /* allocate space for header */
-    snip = ng_pktbuf_add(NULL, NULL, sizeof(ng_netif_hdr_t) + src_len + dst_len,
-                         NG_NETTYPE_NETIF);
-    if (snip == NULL) {
-        return NULL;
-    }
-    /* fill header */
-    hdr = (ng_netif_hdr_t *)snip->data;
-    ng_netif_hdr_init(hdr, src_len, dst_len);
-    if (dst_len > 0) {
-        tmp = 5 + dst_len;
-        addr = ng_netif_hdr_get_dst_addr(hdr);
-        for (int i = 0; i < dst_len; i++) {
-            addr[i] = mhr[5 + (dst_len - i) - 1];
-        }
-    }
-    else {
-        tmp = 3;
-    }
-    if (!(mhr[0] & NG_IEEE802154_FCF_PAN_COMP)) {
-        tmp += 2;
-    }
-    if (src_len > 0) {
-        addr = ng_netif_hdr_get_src_addr(hdr);
-        for (int i = 0; i < src_len; i++) {
-            addr[i] = mhr[tmp + (src_len - i) - 1];
-        }
-    }
-    return snip;
+    return ng_ieee802154_set_frame_hdr(buf, src, src_len, dst, dst_len, pan,
+                                       pan, flags, dev->seq_nr++);
 }
 
-
 static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
 {
     ng_at86rf2xx_t *dev = (ng_at86rf2xx_t *)netdev;
@@ -280,14 +144,14 @@ static void _receive_data(ng_at86rf2xx_t *dev)
 
     /* get FCF field and compute 802.15.4 header length */
     ng_at86rf2xx_rx_read(dev, mhr, 2, 0);
-    hdr_len = _get_frame_hdr_len(mhr);
+    hdr_len = ng_ieee802154_get_frame_hdr_len(mhr);
     if (hdr_len == 0) {
         DEBUG("[ng_at86rf2xx] error: unable parse incoming frame header\n");
         return;
     }
     /* read the rest of the header and parse the netif header from it */
     ng_at86rf2xx_rx_read(dev, &(mhr[2]), hdr_len - 2, 2);
-    hdr = _make_netif_hdr(mhr);
+    hdr = ng_ieee802154_netif_hdr_build(mhr);
     if (hdr == NULL) {
         DEBUG("[ng_at86rf2xx] error: unable to allocate netif header\n");
         return;
@@ -454,6 +318,12 @@ static int _get(ng_netdev_t *device, ng_netconf_opt_t opt,
             }
             return sizeof(ng_netconf_enable_t);
 
+        case NETCONF_OPT_AUTOCCA:
+            /* frames are always sent in TX_ARET mode, which does CSMA-CA in
+             * hardware */
+            *((ng_netconf_enable_t *)val) = NETCONF_ENABLE;
+            return sizeof(ng_netconf_enable_t);
+
         case NETCONF_OPT_RETRANS:
             if (max_len < sizeof(uint8_t)) {
                 return -EOVERFLOW;
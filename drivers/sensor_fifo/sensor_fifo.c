@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_sensor_fifo
+ * @{
+ *
+ * @file
+ * @brief       Sensor FIFO batching implementation
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include "sensor_fifo.h"
+#include "vtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+void sensor_fifo_init(sensor_fifo_t *fifo, const sensor_fifo_driver_t *driver,
+                      void *dev, uint8_t sample_size, uint8_t watermark,
+                      uint32_t poll_us)
+{
+    fifo->driver = driver;
+    fifo->dev = dev;
+    fifo->sample_size = sample_size;
+    fifo->watermark = (watermark > 0) ? watermark : 1;
+    fifo->poll_us = poll_us;
+    /* locked until the first interrupt */
+    mutex_init(&fifo->wait);
+    mutex_lock(&fifo->wait);
+    fifo->bursts = 0;
+    fifo->samples = 0;
+}
+
+void sensor_fifo_isr(void *arg)
+{
+    sensor_fifo_t *fifo = arg;
+
+    mutex_unlock(&fifo->wait);
+}
+
+int sensor_fifo_read(sensor_fifo_t *fifo, void *buf, unsigned num)
+{
+    uint8_t *pos = buf;
+    unsigned left = num;
+
+    while (left > 0) {
+        unsigned want = (left < fifo->watermark) ? left : fifo->watermark;
+        int level = fifo->driver->level(fifo->dev);
+
+        if (level < 0) {
+            return level;
+        }
+        if ((unsigned)level < want) {
+            /* an interrupt may have unlocked the mutex before we got here,
+             * so the level is checked again after waking up */
+            if (fifo->poll_us) {
+                vtimer_usleep(fifo->poll_us);
+            }
+            else {
+                mutex_lock(&fifo->wait);
+            }
+            continue;
+        }
+
+        if ((unsigned)level > left) {
+            level = left;
+        }
+        DEBUG("sensor_fifo: draining %i samples\n", level);
+        if (fifo->driver->drain(fifo->dev, pos, level) < 0) {
+            return -1;
+        }
+        fifo->bursts++;
+        fifo->samples += level;
+        pos += level * fifo->sample_size;
+        left -= level;
+    }
+
+    return num;
+}
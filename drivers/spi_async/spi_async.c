@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     driver_periph
+ * @{
+ *
+ * @file
+ * @brief       Emulation of spi_transfer_async() on top of the blocking SPI
+ *              transfer functions
+ *
+ * Used for all CPUs that do not implement asynchronous transfers themselves
+ * (signaled by defining HAVE_SPI_ASYNC). The whole chain is executed before
+ * spi_transfer_async() returns, callbacks are called in the context of the
+ * caller.
+ *
+ * @}
+ */
+
+#include <stddef.h>
+
+#include "periph/spi.h"
+
+#if SPI_NUMOF && !defined(HAVE_SPI_ASYNC)
+
+int spi_transfer_async(spi_t dev, spi_transfer_t *xfer)
+{
+    while (xfer != NULL) {
+        /* read the successor first, the callback may reuse the descriptor */
+        spi_transfer_t *next = xfer->next;
+        int res;
+
+        if (xfer->reg == SPI_REG_NONE) {
+            res = spi_transfer_bytes(dev, xfer->out, xfer->in, xfer->length);
+        }
+        else {
+            res = spi_transfer_regs(dev, (uint8_t)xfer->reg, xfer->out,
+                                    xfer->in, xfer->length);
+        }
+
+        if (res < 0) {
+            res = -1;
+        }
+        if (xfer->cb != NULL) {
+            xfer->cb(xfer->arg, res);
+        }
+        if (res < 0) {
+            return -1;
+        }
+
+        xfer = next;
+    }
+
+    return 0;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* SPI_NUMOF && !HAVE_SPI_ASYNC */
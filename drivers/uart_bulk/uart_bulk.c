@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     driver_periph
+ * @{
+ *
+ * @file
+ * @brief       Buffered UART writes on top of the interrupt driven UART driver
+ *
+ * Each UART initialized with uart_init_bulk() gets a TX ring buffer that is
+ * drained by the transmit callback, one byte per TX interrupt.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "irq.h"
+#include "mutex.h"
+#include "ringbuffer.h"
+#include "sched.h"
+#include "periph/uart.h"
+
+#if UART_NUMOF && !defined(HAVE_UART_WRITE_BULK)
+
+typedef struct {
+    uart_t uart;                /**< the device this state belongs to */
+    int active;                 /**< initialized via uart_init_bulk() */
+    uart_rx_cb_t rx_cb;         /**< the user's receive callback */
+    void *arg;                  /**< argument for rx_cb */
+    mutex_t lock;               /**< serializes uart_write_bulk() calls */
+    mutex_t space;              /**< unlocked when TX buffer space was freed */
+    ringbuffer_t buf;           /**< TX ring buffer */
+    char mem[UART_TX_BUFSIZE];  /**< memory of the TX ring buffer */
+} uart_bulk_t;
+
+static uart_bulk_t _bulk[UART_NUMOF];
+
+static void _rx_cb(void *arg, char data)
+{
+    uart_bulk_t *bulk = arg;
+
+    if (bulk->rx_cb != NULL) {
+        bulk->rx_cb(bulk->arg, data);
+    }
+}
+
+static int _tx_cb(void *arg)
+{
+    uart_bulk_t *bulk = arg;
+    int c = ringbuffer_get_one(&bulk->buf);
+
+    if (c < 0) {
+        return 0;
+    }
+
+    uart_write(bulk->uart, (char)c);
+    mutex_unlock(&bulk->space);
+
+    return 1;
+}
+
+int uart_init_bulk(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
+{
+    uart_bulk_t *bulk;
+
+    if ((unsigned)uart >= UART_NUMOF) {
+        return -2;
+    }
+
+    bulk = &_bulk[uart];
+    bulk->uart = uart;
+    bulk->rx_cb = rx_cb;
+    bulk->arg = arg;
+    mutex_init(&bulk->lock);
+    mutex_init(&bulk->space);
+    ringbuffer_init(&bulk->buf, bulk->mem, sizeof(bulk->mem));
+    bulk->active = 1;
+
+    return uart_init(uart, baudrate, _rx_cb, _tx_cb, bulk);
+}
+
+static int _write_blocking(uart_t uart, const char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        if (uart_write_blocking(uart, data[i]) < 0) {
+            return -1;
+        }
+    }
+
+    return (int)len;
+}
+
+int uart_write_bulk(uart_t uart, const char *data, size_t len)
+{
+    uart_bulk_t *bulk;
+    size_t done = 0;
+
+    if ((unsigned)uart >= UART_NUMOF) {
+        return -1;
+    }
+
+    bulk = &_bulk[uart];
+    if (!bulk->active) {
+        return _write_blocking(uart, data, len);
+    }
+
+    if (inISR() || (sched_active_thread == NULL)) {
+        /* we can not sleep waiting for the TX interrupt, flush the buffer by
+         * hand to keep the order of the output */
+        int c;
+        while ((c = ringbuffer_get_one(&bulk->buf)) >= 0) {
+            uart_write_blocking(uart, (char)c);
+        }
+        return _write_blocking(uart, data, len);
+    }
+
+    mutex_lock(&bulk->lock);
+    while (done < len) {
+        unsigned state = disableIRQ();
+        done += ringbuffer_add(&bulk->buf, data + done, len - done);
+        restoreIRQ(state);
+
+        uart_tx_begin(uart);
+
+        if (done < len) {
+            /* sleep until the TX interrupt took some bytes */
+            mutex_lock(&bulk->space);
+        }
+    }
+    mutex_unlock(&bulk->lock);
+
+    return (int)len;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* UART_NUMOF && !HAVE_UART_WRITE_BULK */
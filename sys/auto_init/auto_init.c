@@ -44,6 +44,14 @@
 #include "board_uart0.h"
 #endif
 
+#ifdef MODULE_LOG_BINARY
+#include "log.h"
+#endif
+
+#ifdef MODULE_EVENT
+#include "event.h"
+#endif
+
 #ifdef MODULE_MCI
 #include "diskio.h"
 #endif
@@ -248,6 +256,14 @@ void auto_init(void)
     DEBUG("Auto init uart0 module.\n");
     board_uart0_init();
 #endif
+#ifdef MODULE_LOG_BINARY
+    DEBUG("Auto init log_binary module.\n");
+    log_binary_init();
+#endif
+#ifdef MODULE_EVENT
+    DEBUG("Auto init event module.\n");
+    event_init();
+#endif
 #ifdef MODULE_RTC
     DEBUG("Auto init rtc module.\n");
     rtc_init();
@@ -348,6 +364,11 @@ void auto_init(void)
     auto_init_ng_netdev_eth();
 #endif
 
+#ifdef MODULE_NG_NATIVE_MEDIUM
+    extern void auto_init_ng_native_medium(void);
+    auto_init_ng_native_medium();
+#endif
+
 #endif /* MODULE_AUTO_INIT_NG_NETIF */
 
 #ifdef MODULE_NG_IPV6_NETIF
@@ -22,7 +22,11 @@
 #ifdef MODULE_KW2XRF
 
 #include "board.h"
+#ifdef MODULE_NG_CSMA
+#include "net/ng_csma.h"
+#else
 #include "net/ng_nomac.h"
+#endif
 #include "net/ng_netbase.h"
 
 #include "kw2xrf.h"
@@ -35,7 +39,8 @@
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define KW2XRF_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
+#define KW2XRF_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT + \
+                                  NG_NETAPI_DIRECT_STACKSIZE)
 #define KW2XRF_MAC_PRIO          (THREAD_PRIORITY_MAIN - 3)
 
 #define KW2XRF_NUM (sizeof(kw2xrf_params)/sizeof(kw2xrf_params[0]))
@@ -59,9 +64,15 @@ void auto_init_kw2xrf(void)
             DEBUG("Error initializing KW2xrf radio device!");
         }
         else {
+#ifdef MODULE_NG_CSMA
+            ng_csma_init(_nomac_stacks[i],
+                    KW2XRF_MAC_STACKSIZE, KW2XRF_MAC_PRIO,
+                    "kw2xrf", (ng_netdev_t *)&kw2xrf_devs[i]);
+#else
             ng_nomac_init(_nomac_stacks[i],
                     KW2XRF_MAC_STACKSIZE, KW2XRF_MAC_PRIO,
                     "kw2xrf", (ng_netdev_t *)&kw2xrf_devs[i]);
+#endif
         }
     }
 }
@@ -20,7 +20,11 @@
 #ifdef MODULE_NG_AT86RF2XX
 
 #include "board.h"
+#ifdef MODULE_NG_CSMA
+#include "net/ng_csma.h"
+#else
 #include "net/ng_nomac.h"
+#endif
 #include "net/ng_netbase.h"
 
 #include "ng_at86rf2xx.h"
@@ -33,7 +37,8 @@
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define AT86RF2XX_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
+#define AT86RF2XX_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT + \
+                                     NG_NETAPI_DIRECT_STACKSIZE)
 #define AT86RF2XX_MAC_PRIO          (THREAD_PRIORITY_MAIN - 3)
 
 #define AT86RF2XX_NUM (sizeof(at86rf2xx_params)/sizeof(at86rf2xx_params[0]))
@@ -58,9 +63,15 @@ void auto_init_ng_at86rf2xx(void)
             DEBUG("Error initializing AT86RF2xx radio device!");
         }
         else {
+#ifdef MODULE_NG_CSMA
+            ng_csma_init(_nomac_stacks[i],
+                    AT86RF2XX_MAC_STACKSIZE, AT86RF2XX_MAC_PRIO,
+                    "at86rfxx", (ng_netdev_t *)&ng_at86rf2xx_devs[i]);
+#else
             ng_nomac_init(_nomac_stacks[i],
                     AT86RF2XX_MAC_STACKSIZE, AT86RF2XX_MAC_PRIO,
                     "at86rfxx", (ng_netdev_t *)&ng_at86rf2xx_devs[i]);
+#endif
         }
     }
 }
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ */
+
+/*
+ * @ingroup auto_init_ng_netif
+ * @{
+ *
+ * @file
+ * @brief   Auto initialization for the native shared-memory medium
+ */
+
+#ifdef MODULE_NG_NATIVE_MEDIUM
+
+#include "board.h"
+#ifdef MODULE_NG_CSMA
+#include "net/ng_csma.h"
+#else
+#include "net/ng_nomac.h"
+#endif
+#include "net/ng_netbase.h"
+
+#include "ng_native_medium.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief   Define stack parameters for the MAC layer thread
+ * @{
+ */
+#define NATIVE_MEDIUM_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT + \
+                                         NG_NETAPI_DIRECT_STACKSIZE)
+#define NATIVE_MEDIUM_MAC_PRIO          (THREAD_PRIORITY_MAIN - 3)
+/** @} */
+
+static ng_native_medium_t ng_native_medium_dev;
+static char _mac_stack[NATIVE_MEDIUM_MAC_STACKSIZE];
+
+void auto_init_ng_native_medium(void)
+{
+    DEBUG("Initializing native medium device\n");
+    int res = ng_native_medium_init(&ng_native_medium_dev);
+
+    if (res < 0) {
+        DEBUG("Error initializing native medium device!");
+    }
+    else {
+#ifdef MODULE_NG_CSMA
+        ng_csma_init(_mac_stack, NATIVE_MEDIUM_MAC_STACKSIZE,
+                     NATIVE_MEDIUM_MAC_PRIO, "medium",
+                     (ng_netdev_t *)&ng_native_medium_dev);
+#else
+        ng_nomac_init(_mac_stack, NATIVE_MEDIUM_MAC_STACKSIZE,
+                      NATIVE_MEDIUM_MAC_PRIO, "medium",
+                      (ng_netdev_t *)&ng_native_medium_dev);
+#endif
+    }
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NG_NATIVE_MEDIUM */
+
+/** @} */
@@ -35,7 +35,8 @@
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define NETDEV_ETH_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
+#define NETDEV_ETH_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT + \
+                                      NG_NETAPI_DIRECT_STACKSIZE)
 #define NETDEV_ETH_MAC_PRIO          (THREAD_PRIORITY_MAIN - 3)
 
 static char _nomac_stack[NETDEV_ETH_MAC_STACKSIZE];
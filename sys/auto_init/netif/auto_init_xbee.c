@@ -37,7 +37,8 @@ static xbee_t xbee_devs[XBEE_NUM];
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define XBEE_MAC_STACKSIZE           (THREAD_STACKSIZE_DEFAULT)
+#define XBEE_MAC_STACKSIZE           (THREAD_STACKSIZE_DEFAULT + \
+                                      NG_NETAPI_DIRECT_STACKSIZE)
 #define XBEE_MAC_PRIO                (THREAD_PRIORITY_MAIN - 3)
 
 /**
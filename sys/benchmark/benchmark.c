@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_benchmark
+ * @{
+ *
+ * @file
+ * @brief       Benchmark implementation
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "hwtimer.h"
+
+#define SAMPLE_TICKS        (HWTIMER_TICKS(BENCHMARK_SAMPLE_US))
+
+/* overhead per sample in ticks, and per iteration in nanoseconds */
+static uint32_t _timer_overhead;
+static uint32_t _call_overhead;
+static int _calibrated;
+
+/* state of the benchmark the embUnit runner currently runs */
+static const benchmark_caller_t *_caller;
+static const benchmark_fixture_t *_fixture;
+
+static void _empty(void)
+{
+}
+
+static inline uint32_t _elapsed(unsigned long start)
+{
+    return (uint32_t)((hwtimer_now() - start) & HWTIMER_MAXTICKS);
+}
+
+static uint32_t _sample(void (*func)(void), uint32_t iterations)
+{
+    unsigned long start = hwtimer_now();
+    uint32_t ticks;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        func();
+    }
+    ticks = _elapsed(start);
+    return (ticks > _timer_overhead) ? (ticks - _timer_overhead) : 0;
+}
+
+static uint32_t _to_ns(uint32_t ticks, uint32_t iterations)
+{
+    return (uint32_t)(((uint64_t)ticks * 1000000000ULL) /
+                      ((uint64_t)HWTIMER_SPEED * iterations));
+}
+
+static uint32_t _sqrt(uint64_t v)
+{
+    uint64_t r = 0, bit = 1ULL << 62;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        }
+        else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)r;
+}
+
+static void _measure(void (*func)(void), benchmark_result_t *result)
+{
+    uint32_t samples[BENCHMARK_SAMPLES];
+    uint32_t iterations = 1;
+    uint64_t sum = 0, sq_sum = 0;
+
+    for (unsigned i = 0; i < BENCHMARK_WARMUP; i++) {
+        func();
+    }
+    while ((_sample(func, iterations) < SAMPLE_TICKS) &&
+           (iterations < BENCHMARK_MAX_ITERATIONS)) {
+        iterations <<= 1;
+    }
+
+    for (unsigned i = 0; i < BENCHMARK_SAMPLES; i++) {
+        uint32_t ns = _to_ns(_sample(func, iterations), iterations);
+        unsigned j = i;
+
+        ns = (ns > _call_overhead) ? (ns - _call_overhead) : 0;
+        sum += ns;
+        sq_sum += (uint64_t)ns * ns;
+        /* insertion sort for the median */
+        while ((j > 0) && (samples[j - 1] > ns)) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = ns;
+    }
+
+    result->iterations = iterations;
+    result->samples = BENCHMARK_SAMPLES;
+    result->mean = (uint32_t)(sum / BENCHMARK_SAMPLES);
+    result->median = samples[BENCHMARK_SAMPLES / 2];
+    result->stddev = _sqrt((sq_sum / BENCHMARK_SAMPLES) -
+                           ((uint64_t)result->mean * result->mean));
+    result->min = samples[0];
+    result->max = samples[BENCHMARK_SAMPLES - 1];
+}
+
+static void _calibrate(void)
+{
+    benchmark_result_t result;
+
+    /* the fastest of some back to back timer reads */
+    _timer_overhead = UINT32_MAX;
+    for (unsigned i = 0; i < BENCHMARK_SAMPLES; i++) {
+        uint32_t ticks = _elapsed(hwtimer_now());
+
+        if (ticks < _timer_overhead) {
+            _timer_overhead = ticks;
+        }
+    }
+    /* the loop around the benchmark and the call itself */
+    _call_overhead = 0;
+    _measure(_empty, &result);
+    _call_overhead = result.median;
+    _calibrated = 1;
+}
+
+void benchmark_run(void (*func)(void), benchmark_result_t *result)
+{
+    if (!_calibrated) {
+        _calibrate();
+    }
+    _measure(func, result);
+}
+
+void benchmark_print(const char *caller, const char *name,
+                     const benchmark_result_t *result)
+{
+    printf("BENCH %s %s iter=%" PRIu32 " samples=%" PRIu32 " mean_ns=%" PRIu32
+           " median_ns=%" PRIu32 " stddev_ns=%" PRIu32 " min_ns=%" PRIu32
+           " max_ns=%" PRIu32 "\n", caller, name, result->iterations,
+           result->samples, result->mean, result->median, result->stddev,
+           result->min, result->max);
+}
+
+static void _run_fixture(void)
+{
+    benchmark_result_t result;
+
+    benchmark_run(_fixture->run, &result);
+    benchmark_print(_caller->name, _fixture->name, &result);
+}
+
+static char *_caller_name(benchmark_caller_t *self)
+{
+    return self->name;
+}
+
+static void _caller_run(benchmark_caller_t *self, TestResult *result)
+{
+    TestCase cs = new_TestCase(0, 0, 0, 0);
+
+    cs.setUp = self->set_up;
+    cs.tearDown = self->tear_down;
+    cs.runTest = _run_fixture;
+    _caller = self;
+    for (int i = 0; i < self->numof; i++) {
+        _fixture = &self->fixtures[i];
+        cs.name = _fixture->name;
+        Test_run(&cs, result);
+    }
+}
+
+static int _caller_count(benchmark_caller_t *self)
+{
+    return self->numof;
+}
+
+const TestImplement benchmark_caller_impl = {
+    (TestNameFunction)          _caller_name,
+    (TestRunFunction)           _caller_run,
+    (TestCountTestCasesFunction)_caller_count,
+};
@@ -27,6 +27,9 @@
 /* Automatically enable/disable ENABLE_DEBUG based on CBOR_NO_PRINT */
 #ifndef CBOR_NO_PRINT
 #define ENABLE_DEBUG (1)
+/* the print API is regular output with 64 bit values and strings in
+ * buffers, which log_binary can not record */
+#define DEBUG_USE_PRINTF
 #include "debug.h"
 #endif
 
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Event queue implementation
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include "event.h"
+#include "irq.h"
+#include "msg.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+kernel_pid_t event_pid = KERNEL_PID_UNDEF;
+
+static char _stack[EVENT_STACKSIZE];
+
+/* queued events, event_t::next of the last one is NULL */
+static event_t *_first;
+static event_t *_last;
+
+static event_t *_pop(void)
+{
+    unsigned state = disableIRQ();
+    event_t *event = _first;
+
+    if (event != NULL) {
+        _first = event->next;
+        if (_first == NULL) {
+            _last = NULL;
+        }
+        event->next = NULL;
+    }
+    restoreIRQ(state);
+
+    return event;
+}
+
+static void *_event_loop(void *arg)
+{
+    msg_t msg, msg_queue[EVENT_MSG_QUEUE_SIZE];
+    event_t *event;
+
+    (void)arg;
+    msg_init_queue(msg_queue, EVENT_MSG_QUEUE_SIZE);
+
+    while (1) {
+        while ((event = _pop()) != NULL) {
+            DEBUG("event: running %p\n", (void *)event);
+            event->handler(event->arg);
+        }
+        msg_receive(&msg);
+    }
+
+    return NULL;
+}
+
+void event_init(void)
+{
+    if (event_pid == KERNEL_PID_UNDEF) {
+        event_pid = thread_create(_stack, sizeof(_stack), EVENT_PRIO,
+                                  CREATE_STACKTEST, _event_loop, NULL, "event");
+    }
+}
+
+void event_post(event_t *event)
+{
+    unsigned state = disableIRQ();
+    int wakeup = (_first == NULL);
+    msg_t msg;
+
+    if ((event->next != NULL) || (_last == event)) {
+        /* already queued */
+        restoreIRQ(state);
+        return;
+    }
+    if (_last == NULL) {
+        _first = event;
+    }
+    else {
+        _last->next = event;
+    }
+    _last = event;
+    restoreIRQ(state);
+
+    /* only the first event needs to wake up the thread, it runs all queued
+     * events before receiving again */
+    if (wakeup && (event_pid != KERNEL_PID_UNDEF)) {
+        msg.type = EVENT_MSG_TYPE_POST;
+        msg_try_send(&msg, event_pid);
+    }
+}
+
+void event_cancel(event_t *event)
+{
+    unsigned state = disableIRQ();
+    event_t *prev = NULL;
+
+    for (event_t *cur = _first; cur != NULL; prev = cur, cur = cur->next) {
+        if (cur == event) {
+            if (prev == NULL) {
+                _first = event->next;
+            }
+            else {
+                prev->next = event->next;
+            }
+            if (_last == event) {
+                _last = prev;
+            }
+            event->next = NULL;
+            break;
+        }
+    }
+    restoreIRQ(state);
+}
+
+/* posts from the timer interrupt, so an expired timeout can not get lost in
+ * a full message queue */
+static void _timeout_cb(vtimer_t *timer)
+{
+    event_post((event_t *)timer->arg);
+}
+
+void event_timeout_set(event_timeout_t *timeout, event_t *event,
+                       timex_t delay)
+{
+    vtimer_remove(&timeout->timer);
+    vtimer_set_cb(&timeout->timer, delay, _timeout_cb, event);
+}
+
+void event_timeout_clear(event_timeout_t *timeout)
+{
+    vtimer_remove(&timeout->timer);
+}
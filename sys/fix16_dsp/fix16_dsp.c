@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_fix16_dsp
+ * @{
+ *
+ * @file
+ * @brief       Batched fix16_t kernels
+ *
+ * @author      René Kijewski <rene.kijewski@fu-berlin.de>
+ * @}
+ */
+
+#include "fix16_dsp.h"
+
+static inline fix16_t _sat(int64_t v)
+{
+    if (v > FIX16_DSP_MAX) {
+        return FIX16_DSP_MAX;
+    }
+    if (v < FIX16_DSP_MIN) {
+        return FIX16_DSP_MIN;
+    }
+    return (fix16_t)v;
+}
+
+/* rounds a product of two fix16_t, or a sum of them */
+static inline fix16_t _round(int64_t acc)
+{
+    return _sat((acc + 0x8000) >> 16);
+}
+
+void fix16_dsp_from_int16(fix16_t *dst, const int16_t *src, fix16_t scale,
+                          size_t n)
+{
+    if ((scale > -0x10000) && (scale < 0x10000)) {
+        /* the product fits into 32 bit */
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = src[i] * scale;
+        }
+    }
+    else {
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = _sat((int64_t)src[i] * scale);
+        }
+    }
+}
+
+void fix16_dsp_mul(fix16_t *dst, const fix16_t *a, const fix16_t *b, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = _round((int64_t)a[i] * b[i]);
+    }
+}
+
+void fix16_dsp_scale(fix16_t *dst, const fix16_t *src, fix16_t k, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = _round((int64_t)src[i] * k);
+    }
+}
+
+void fix16_dsp_mac(fix16_t *acc, const fix16_t *src, fix16_t k, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        acc[i] = _round(((int64_t)acc[i] * 0x10000) + (int64_t)src[i] * k);
+    }
+}
+
+fix16_t fix16_dsp_dot(const fix16_t *a, const fix16_t *b, size_t n)
+{
+    int64_t acc = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        acc += (int64_t)a[i] * b[i];
+    }
+    return _round(acc);
+}
+
+void fix16_dsp_fir_init(fix16_dsp_fir_t *fir, const fix16_t *coeffs,
+                        fix16_t *state, uint16_t taps)
+{
+    fir->coeffs = coeffs;
+    fir->state = state;
+    fir->taps = taps;
+    fir->pos = 0;
+    for (unsigned i = 0; i < 2U * taps; i++) {
+        state[i] = 0;
+    }
+}
+
+void fix16_dsp_fir(fix16_dsp_fir_t *fir, fix16_t *dst, const fix16_t *src,
+                   size_t n)
+{
+    unsigned taps = fir->taps;
+    unsigned pos = fir->pos;
+
+    for (size_t i = 0; i < n; i++) {
+        /* every sample is stored twice, so the last taps samples are
+         * always contiguous, starting at the newest one */
+        pos = (pos == 0) ? (taps - 1) : (pos - 1);
+        fir->state[pos] = src[i];
+        fir->state[pos + taps] = src[i];
+        dst[i] = fix16_dsp_dot(fir->coeffs, &fir->state[pos], taps);
+    }
+    fir->pos = pos;
+}
+
+void fix16_dsp_biquad(const fix16_dsp_biquad_t *coeffs,
+                      fix16_dsp_biquad_state_t *state, unsigned stages,
+                      fix16_t *dst, const fix16_t *src, size_t n)
+{
+    for (unsigned s = 0; s < stages; s++) {
+        const fix16_dsp_biquad_t *c = &coeffs[s];
+        fix16_t x1 = state[s].x1, x2 = state[s].x2;
+        fix16_t y1 = state[s].y1, y2 = state[s].y2;
+
+        /* one section at a time over the whole block, so the state stays in
+         * registers */
+        for (size_t i = 0; i < n; i++) {
+            fix16_t x = src[i];
+            int64_t acc = (int64_t)c->b0 * x + (int64_t)c->b1 * x1 +
+                          (int64_t)c->b2 * x2 - (int64_t)c->a1 * y1 -
+                          (int64_t)c->a2 * y2;
+
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = _round(acc);
+            dst[i] = y1;
+        }
+        state[s].x1 = x1;
+        state[s].x2 = x2;
+        state[s].y1 = y1;
+        state[s].y2 = y2;
+        src = dst;
+    }
+}
+
+void fix16_dsp_lowpass(fix16_t *y, fix16_t *dst, const fix16_t *src,
+                       fix16_t alpha, size_t n)
+{
+    int64_t acc = (int64_t)*y * 0x10000;
+
+    for (size_t i = 0; i < n; i++) {
+        acc += ((int64_t)src[i] - ((acc + 0x8000) >> 16)) * alpha;
+        dst[i] = _round(acc);
+    }
+    if (n > 0) {
+        *y = dst[n - 1];
+    }
+}
+
+void fix16_dsp_quat_mul(fix16_dsp_quat_t *q, const fix16_dsp_quat_t *a,
+                        const fix16_dsp_quat_t *b)
+{
+    int64_t w, x, y, z;
+
+    w = (int64_t)a->w * b->w - (int64_t)a->x * b->x -
+        (int64_t)a->y * b->y - (int64_t)a->z * b->z;
+    x = (int64_t)a->w * b->x + (int64_t)a->x * b->w +
+        (int64_t)a->y * b->z - (int64_t)a->z * b->y;
+    y = (int64_t)a->w * b->y - (int64_t)a->x * b->z +
+        (int64_t)a->y * b->w + (int64_t)a->z * b->x;
+    z = (int64_t)a->w * b->z + (int64_t)a->x * b->y -
+        (int64_t)a->y * b->x + (int64_t)a->z * b->w;
+
+    q->w = _round(w);
+    q->x = _round(x);
+    q->y = _round(y);
+    q->z = _round(z);
+}
+
+void fix16_dsp_quat_normalize(fix16_dsp_quat_t *q)
+{
+    fix16_t len, inv;
+
+    len = fix16_dsp_sqrt(_round((int64_t)q->w * q->w + (int64_t)q->x * q->x +
+                                (int64_t)q->y * q->y + (int64_t)q->z * q->z));
+    if (len == 0) {
+        return;
+    }
+    /* one division for all four components */
+    inv = fix16_div(fix16_one, len);
+    q->w = _round((int64_t)q->w * inv);
+    q->x = _round((int64_t)q->x * inv);
+    q->y = _round((int64_t)q->y * inv);
+    q->z = _round((int64_t)q->z * inv);
+}
+
+void fix16_dsp_quat_integrate(fix16_dsp_quat_t *q, const fix16_t (*gyro)[3],
+                              size_t n, fix16_t dt)
+{
+    int64_t w = q->w, x = q->x, y = q->y, z = q->z;
+    fix16_t half_dt = dt / 2;
+
+    for (size_t i = 0; i < n; i++) {
+        /* rotation in this step, (0, gx, gy, gz) * dt / 2 */
+        int64_t gx = _round((int64_t)gyro[i][0] * half_dt);
+        int64_t gy = _round((int64_t)gyro[i][1] * half_dt);
+        int64_t gz = _round((int64_t)gyro[i][2] * half_dt);
+        int64_t dw, dx, dy, dz;
+
+        dw = -x * gx - y * gy - z * gz;
+        dx = w * gx + y * gz - z * gy;
+        dy = w * gy - x * gz + z * gx;
+        dz = w * gz + x * gy - y * gx;
+
+        w = _round(w * 0x10000 + dw);
+        x = _round(x * 0x10000 + dx);
+        y = _round(y * 0x10000 + dy);
+        z = _round(z * 0x10000 + dz);
+    }
+
+    q->w = (fix16_t)w;
+    q->x = (fix16_t)x;
+    q->y = (fix16_t)y;
+    q->z = (fix16_t)z;
+    fix16_dsp_quat_normalize(q);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_fix16_dsp
+ * @{
+ *
+ * @file
+ * @brief       Table driven square root and atan2
+ *
+ * @author      René Kijewski <rene.kijewski@fu-berlin.de>
+ * @}
+ */
+
+#include "bitarithm.h"
+#include "fix16_dsp.h"
+
+#define PI                  ((fix16_t)205887)   /* pi in Q16 */
+
+/* sqrt(m) in Q16 for m = 0.25 + i / 128, i = 0..96 */
+#define SQRT_STEP_SHIFT     (9)
+static const uint32_t _sqrt_tab[] = {
+    32768, 33276, 33776, 34270, 34756, 35235, 35708, 36175,
+    36636, 37091, 37540, 37985, 38424, 38858, 39287, 39712,
+    40132, 40548, 40960, 41368, 41771, 42171, 42567, 42959,
+    43348, 43733, 44115, 44494, 44869, 45242, 45611, 45977,
+    46341, 46702, 47059, 47415, 47767, 48117, 48465, 48809,
+    49152, 49492, 49830, 50166, 50499, 50830, 51159, 51486,
+    51811, 52134, 52454, 52773, 53090, 53405, 53719, 54030,
+    54340, 54647, 54954, 55258, 55561, 55862, 56162, 56459,
+    56756, 57051, 57344, 57636, 57926, 58215, 58503, 58789,
+    59073, 59357, 59639, 59919, 60199, 60477, 60753, 61029,
+    61303, 61576, 61848, 62119, 62388, 62657, 62924, 63190,
+    63455, 63719, 63982, 64243, 64504, 64763, 65022, 65279,
+    65536,
+};
+
+/* atan(2^-i) in Q29 */
+static const int32_t _atan_tab[] = {
+    421657428, 248918915, 131521918, 66762579, 33510843,
+    16771758, 8387925, 4194219, 2097141, 1048575,
+    524288, 262144, 131072, 65536, 32768,
+    16384, 8192, 4096, 2048, 1024,
+};
+
+#define ATAN_ITERATIONS     (sizeof(_atan_tab) / sizeof(_atan_tab[0]))
+
+fix16_t fix16_dsp_sqrt(fix16_t x)
+{
+    uint32_t m, t, frac;
+    int k;
+
+    if (x <= 0) {
+        return 0;
+    }
+
+    /* x = m * 4^k with m in [0.25, 1), so sqrt(x) = sqrt(m) * 2^k */
+    k = ((int)bitarithm_msb((unsigned)x) - 14) >> 1;
+    m = (k >= 0) ? ((uint32_t)x >> (2 * k)) : ((uint32_t)x << (-2 * k));
+
+    /* linear interpolation between the table entries */
+    m -= 0x4000;
+    frac = m & ((1 << SQRT_STEP_SHIFT) - 1);
+    m >>= SQRT_STEP_SHIFT;
+    t = _sqrt_tab[m] + (((_sqrt_tab[m + 1] - _sqrt_tab[m]) * frac +
+                        (1 << (SQRT_STEP_SHIFT - 1))) >> SQRT_STEP_SHIFT);
+
+    if (k >= 0) {
+        return (fix16_t)(t << k);
+    }
+    return (fix16_t)((t + (1 << (-k - 1))) >> -k);
+}
+
+fix16_t fix16_dsp_atan2(fix16_t y, fix16_t x)
+{
+    int32_t angle = 0;
+    fix16_t offset = 0;
+    uint32_t max;
+    int shift;
+
+    if ((x == 0) && (y == 0)) {
+        return 0;
+    }
+    if ((x == INT32_MIN) || (y == INT32_MIN)) {
+        x >>= 1;
+        y >>= 1;
+    }
+    /* rotate into the right half-plane */
+    if (x < 0) {
+        offset = (y >= 0) ? PI : -PI;
+        x = -x;
+        y = -y;
+    }
+
+    /* scale to 29 bits: precise, but the CORDIC gain does not overflow */
+    max = ((uint32_t)x > (uint32_t)((y < 0) ? -y : y)) ? (uint32_t)x
+                                                       : (uint32_t)((y < 0) ? -y : y);
+    shift = 28 - (int)bitarithm_msb(max);
+    if (shift >= 0) {
+        x *= 1 << shift;
+        y *= 1 << shift;
+    }
+    else {
+        x >>= -shift;
+        y >>= -shift;
+    }
+
+    /* CORDIC in vectoring mode: rotate (x, y) onto the x axis */
+    for (unsigned i = 0; i < ATAN_ITERATIONS; i++) {
+        int32_t tmp = x;
+
+        if (y > 0) {
+            x += y >> i;
+            y -= tmp >> i;
+            angle += _atan_tab[i];
+        }
+        else {
+            x -= y >> i;
+            y += tmp >> i;
+            angle -= _atan_tab[i];
+        }
+    }
+
+    return offset + (fix16_t)((angle + (1 << 12)) >> 13);
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_fix16_dsp
+ * @{
+ *
+ * @file
+ * @brief       Kernels on raw 16 bit samples
+ *
+ * @author      René Kijewski <rene.kijewski@fu-berlin.de>
+ * @}
+ */
+
+#include <string.h>
+
+#include "fix16_dsp.h"
+
+#if FIX16_DSP_HAS_SIMD
+#include "cpu_conf.h"   /* pulls in core_cmSimd.h */
+#endif
+
+/* a Q15 sum of products to fix16_t, in units of the raw samples */
+static inline fix16_t _to_fix16(int64_t acc)
+{
+    acc *= 2;
+    if (acc > FIX16_DSP_MAX) {
+        return FIX16_DSP_MAX;
+    }
+    if (acc < FIX16_DSP_MIN) {
+        return FIX16_DSP_MIN;
+    }
+    return (fix16_t)acc;
+}
+
+fix16_t fix16_dsp_dot_q15(const int16_t *a, const int16_t *b, size_t n)
+{
+    int64_t acc = 0;
+    size_t i = 0;
+
+#if FIX16_DSP_HAS_SIMD
+    /* two multiply-accumulates per instruction; memcpy because the arrays
+     * do not need to be word aligned */
+    uint64_t acc2 = 0;
+
+    for (; i + 1 < n; i += 2) {
+        uint32_t pa, pb;
+
+        memcpy(&pa, &a[i], sizeof(pa));
+        memcpy(&pb, &b[i], sizeof(pb));
+        acc2 = __SMLALD(pa, pb, acc2);
+    }
+    acc = (int64_t)acc2;
+#endif
+    for (; i < n; i++) {
+        acc += (int32_t)a[i] * b[i];
+    }
+    return _to_fix16(acc);
+}
+
+void fix16_dsp_fir_q15_init(fix16_dsp_fir_q15_t *fir, const int16_t *coeffs,
+                            int16_t *state, uint16_t taps)
+{
+    fir->coeffs = coeffs;
+    fir->state = state;
+    fir->taps = taps;
+    fir->pos = 0;
+    memset(state, 0, 2 * taps * sizeof(int16_t));
+}
+
+void fix16_dsp_fir_q15(fix16_dsp_fir_q15_t *fir, fix16_t *dst,
+                       const int16_t *src, size_t n)
+{
+    unsigned taps = fir->taps;
+    unsigned pos = fir->pos;
+
+    for (size_t i = 0; i < n; i++) {
+        /* see fix16_dsp_fir() */
+        pos = (pos == 0) ? (taps - 1) : (pos - 1);
+        fir->state[pos] = src[i];
+        fir->state[pos + taps] = src[i];
+        dst[i] = fix16_dsp_dot_q15(&fir->state[pos], fir->coeffs, taps);
+    }
+    fir->pos = pos;
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_benchmark Benchmarks
+ * @ingroup     sys
+ * @brief       Timing of functions, integrated with @ref unittests
+ *
+ * @details Benchmarks are registered like embUnit test fixtures and run by
+ *          the same test runner, so test suites can carry benchmarks next to
+ *          their tests:
+ *
+ * @code
+ * static void bench_foo(void)
+ * {
+ *     foo();
+ * }
+ *
+ * Test *tests_foo_bench_tests(void)
+ * {
+ *     BENCHMARK_FIXTURES(fixtures) {
+ *         BENCHMARK_FIXTURE(bench_foo),
+ *     };
+ *
+ *     BENCHMARK_CALLER(foo_bench, set_up, tear_down, fixtures);
+ *
+ *     return (Test *)&foo_bench;
+ * }
+ * @endcode
+ *
+ *          Each benchmark function is one iteration. It is first called
+ *          @ref BENCHMARK_WARMUP times, then the number of iterations per
+ *          sample is doubled until a sample takes at least
+ *          @ref BENCHMARK_SAMPLE_US. @ref BENCHMARK_SAMPLES samples are
+ *          taken, and the time of an iteration is reported as one line:
+ *
+ *              BENCH <caller> <fixture> iter=<n> samples=<n> mean_ns=<n> median_ns=<n> stddev_ns=<n> min_ns=<n> max_ns=<n>
+ *
+ *          The time to read the hardware timer and to call an empty
+ *          function is measured once and subtracted from all results.
+ *
+ *          The set up and tear down functions of the caller run once per
+ *          benchmark, outside of the measurement, so a benchmark must leave
+ *          everything as it found it. Assertions can be used as in tests.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Benchmark definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <stdint.h>
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Iterations run before the measurement
+ */
+#ifndef BENCHMARK_WARMUP
+#define BENCHMARK_WARMUP        (4U)
+#endif
+
+/**
+ * @brief   Samples taken per benchmark
+ */
+#ifndef BENCHMARK_SAMPLES
+#define BENCHMARK_SAMPLES       (16U)
+#endif
+
+/**
+ * @brief   Minimum duration of a sample in microseconds
+ */
+#ifndef BENCHMARK_SAMPLE_US
+#define BENCHMARK_SAMPLE_US     (10000U)
+#endif
+
+/**
+ * @brief   Maximum number of iterations per sample
+ */
+#ifndef BENCHMARK_MAX_ITERATIONS
+#define BENCHMARK_MAX_ITERATIONS    (0x10000UL)
+#endif
+
+/**
+ * @brief   Result of a benchmark, all times are per iteration in
+ *          nanoseconds
+ */
+typedef struct {
+    uint32_t iterations;    /**< iterations per sample */
+    uint32_t samples;       /**< number of samples */
+    uint32_t mean;          /**< mean */
+    uint32_t median;        /**< median */
+    uint32_t stddev;        /**< standard deviation */
+    uint32_t min;           /**< fastest sample */
+    uint32_t max;           /**< slowest sample */
+} benchmark_result_t;
+
+/**
+ * @brief   A benchmark
+ */
+typedef struct {
+    char *name;             /**< name of the benchmark */
+    void (*run)(void);      /**< one iteration of the benchmark */
+} benchmark_fixture_t;
+
+/**
+ * @brief   A set of benchmarks, runs as embUnit test
+ */
+typedef struct {
+    TestImplement *isa;                 /**< embUnit test interface */
+    char *name;                         /**< name of the set */
+    void (*set_up)(void);               /**< called before each benchmark */
+    void (*tear_down)(void);            /**< called after each benchmark */
+    int numof;                          /**< number of benchmarks */
+    const benchmark_fixture_t *fixtures;    /**< the benchmarks */
+} benchmark_caller_t;
+
+/**
+ * @brief   embUnit test interface of @ref benchmark_caller_t
+ */
+extern const TestImplement benchmark_caller_impl;
+
+/**
+ * @brief   Defines a list of benchmarks
+ *
+ * @param[in] fixtures  name of the list
+ */
+#define BENCHMARK_FIXTURES(fixtures) \
+    static const benchmark_fixture_t fixtures[] =
+
+/**
+ * @brief   Initializer for an element of a list of benchmarks
+ *
+ * @param[in] func  the benchmark function
+ */
+#define BENCHMARK_FIXTURE(func)     { #func, func }
+
+/**
+ * @brief   Defines a set of benchmarks to run with `TESTS_RUN()`
+ *
+ * @param[in] caller    name of the set
+ * @param[in] sup       set up function, may be NULL
+ * @param[in] tdw       tear down function, may be NULL
+ * @param[in] fixtures  list of benchmarks defined with BENCHMARK_FIXTURES()
+ */
+#define BENCHMARK_CALLER(caller, sup, tdw, fixtures) \
+    static const benchmark_caller_t caller = { \
+        (TestImplement *)&benchmark_caller_impl, #caller, sup, tdw, \
+        sizeof(fixtures) / sizeof(fixtures[0]), fixtures \
+    }
+
+/**
+ * @brief   Measures a function
+ *
+ * @param[in] func      one iteration of the benchmark
+ * @param[out] result   the result
+ */
+void benchmark_run(void (*func)(void), benchmark_result_t *result);
+
+/**
+ * @brief   Prints a result in the format given above
+ *
+ * @param[in] caller    name of the set of benchmarks
+ * @param[in] name      name of the benchmark
+ * @param[in] result    the result
+ */
+void benchmark_print(const char *caller, const char *name,
+                     const benchmark_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCHMARK_H_ */
+/** @} */
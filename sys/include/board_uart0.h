@@ -11,6 +11,15 @@
  * @defgroup    sys_uart0 UART0
  * @ingroup     sys
  * @brief       UART0 interface abstraction
+ *
+ * @details     Received characters are stored in a ringbuffer by the UART
+ *              interrupt. By default a chardev thread serves reads from that
+ *              ringbuffer over IPC. With the `uart0_direct` module there is
+ *              no such thread: uart0_read() takes the characters from the
+ *              ringbuffer itself and waits on a mutex unlocked by the
+ *              interrupt while it is empty. posix_open(), posix_read(),
+ *              posix_write() and posix_close() on @ref uart0_handler_pid are
+ *              redirected to these functions, so existing code keeps working.
  * @{
  *
  * @file
@@ -30,6 +39,9 @@ extern "C" {
 
 /**
  * @brief Process identifier for the UART0 module.
+ *
+ * With the `uart0_direct` module this is no real thread, but still differs
+ * from KERNEL_PID_UNDEF after board_uart0_init().
  */
 extern kernel_pid_t uart0_handler_pid;
 
@@ -47,11 +59,22 @@ void board_uart0_init(void);
 void uart0_handle_incoming(int c);
 
 /**
- * @brief Notify the chardev thread that new characters are available in the
- *        ringbuffer.
+ * @brief Notify the chardev thread (or with `uart0_direct` a blocked
+ *        uart0_read()) that new characters are available in the ringbuffer.
  */
 void uart0_notify_thread(void);
 
+/**
+ * @brief Reads characters from the ringbuffer, blocks until at least one is
+ *        available.
+ *
+ * @param[out] buf  buffer for the characters
+ * @param[in] n     size of @p buf
+ *
+ * @returns The number of characters read, at most @p n.
+ */
+int uart0_read(char *buf, int n);
+
 /**
  * @brief Reads one character from the ringbuffer.
  *
@@ -59,6 +82,16 @@ void uart0_notify_thread(void);
  */
 int uart0_readc(void);
 
+/**
+ * @brief Writes characters with uart0_putc().
+ *
+ * @param[in] buf   the characters
+ * @param[in] n     number of characters in @p buf
+ *
+ * @returns @p n
+ */
+int uart0_write(const char *buf, int n);
+
 /**
  * @brief Wrapper to putchar.
  *
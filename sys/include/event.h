@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event Event queue
+ * @ingroup     sys
+ * @brief       Deferred work run by one shared thread
+ *
+ * @details     Services that only react to timers or occasional triggers do
+ *              not need a thread of their own. They post an event_t instead,
+ *              and the event thread started by auto_init runs its handler.
+ *              Handlers run to completion one after the other, so a handler
+ *              should not block for long. Events can be posted from threads
+ *              and interrupts, and with an event_timeout_t after a delay.
+ *
+ * @code
+ * static void _tick(void *arg)
+ * {
+ *     ...
+ *     event_timeout_set(&timeout, &tick, timex_set(1, 0));
+ * }
+ *
+ * static event_t tick = { .handler = _tick };
+ * static event_timeout_t timeout;
+ *
+ * event_post(&tick);
+ * @endcode
+ * @{
+ *
+ * @file
+ * @brief       Event queue interface
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include "kernel_types.h"
+#include "thread.h"
+#include "vtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef EVENT_STACKSIZE
+/**
+ * @brief   Stack size of the event thread, must fit the largest handler
+ */
+#define EVENT_STACKSIZE     (THREAD_STACKSIZE_MAIN)
+#endif
+
+#ifndef EVENT_PRIO
+/**
+ * @brief   Priority of the event thread
+ */
+#define EVENT_PRIO          (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+#ifndef EVENT_MSG_QUEUE_SIZE
+/**
+ * @brief   Size of the message queue of the event thread, it receives one
+ *          message per post to an empty queue
+ */
+#define EVENT_MSG_QUEUE_SIZE    (8U)
+#endif
+
+/**
+ * @brief   Message type for a post to an empty queue
+ */
+#define EVENT_MSG_TYPE_POST     (0x0500)
+
+/**
+ * @brief   An event
+ */
+typedef struct event {
+    struct event *next;         /**< next queued event, internal */
+    void (*handler)(void *arg); /**< function run by the event thread */
+    void *arg;                  /**< argument of event_t::handler */
+} event_t;
+
+/**
+ * @brief   A delay before an event is posted
+ */
+typedef struct {
+    vtimer_t timer;             /**< timer of the delay, internal */
+} event_timeout_t;
+
+/**
+ * @brief   PID of the event thread
+ */
+extern kernel_pid_t event_pid;
+
+/**
+ * @brief   Starts the event thread, called by auto_init
+ */
+void event_init(void);
+
+/**
+ * @brief   Queues an event, can be called from interrupts
+ *
+ * @details Events posted before event_init() run as soon as the thread
+ *          started. Posting an event that is already queued does nothing.
+ *
+ * @param[in] event     the event
+ */
+void event_post(event_t *event);
+
+/**
+ * @brief   Removes an event from the queue
+ *
+ * @param[in] event     the event
+ */
+void event_cancel(event_t *event);
+
+/**
+ * @brief   Posts an event after a delay
+ *
+ * @details Replaces a delay still running on @p timeout. The event is posted
+ *          from the timer interrupt, events posted before event_init() run
+ *          as soon as the thread started.
+ *
+ * @param[in] timeout   the delay
+ * @param[in] event     the event
+ * @param[in] delay     time until the event is posted
+ */
+void event_timeout_set(event_timeout_t *timeout, event_t *event,
+                       timex_t delay);
+
+/**
+ * @brief   Stops a delay
+ *
+ * @details If the delay expired already, the event is queued. Use
+ *          event_cancel() to remove it from the queue as well.
+ *
+ * @param[in] timeout   the delay
+ */
+void event_timeout_clear(event_timeout_t *timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_H */
+/** @} */
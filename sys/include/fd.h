@@ -84,6 +84,32 @@ int fd_new(int internal_fd, ssize_t (*internal_read)(int, void *, size_t),
  */
 fd_t *fd_get(int fd);
 
+/**
+ * @brief   Reads up to *n* bytes from file descriptor *fd* into *buf*.
+ *
+ * @details Reads from the UART return as soon as at least one byte was
+ *          received. RIOT does not define read() itself, because the CPU ports
+ *          and the host libc on native already do.
+ *
+ * @param[in] fd    A POSIX-like file descriptor.
+ * @param[out] buf  The buffer for the read bytes.
+ * @param[in] n     Maximum number of bytes to read.
+ *
+ * @return  The number of bytes read, or -1 with *errno* set to EBADF.
+ */
+ssize_t fd_read(int fd, void *buf, size_t n);
+
+/**
+ * @brief   Writes *n* bytes of *buf* to file descriptor *fd*.
+ *
+ * @param[in] fd    A POSIX-like file descriptor.
+ * @param[in] buf   The bytes to write.
+ * @param[in] n     Number of bytes to write.
+ *
+ * @return  The number of bytes written, or -1 with *errno* set to EBADF.
+ */
+ssize_t fd_write(int fd, const void *buf, size_t n);
+
 /**
  * @brief   Removes file descriptor table entry associated with *fd* from table.
  *
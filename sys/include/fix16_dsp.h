@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_fix16_dsp Fixed-point signal processing
+ * @ingroup     sys
+ * @brief       Batched fix16_t kernels for sensor data, on top of libfixmath
+ *
+ * @details The functions of libfixmath work on single values, and each
+ *          call rounds and checks for overflow. The kernels here process
+ *          whole blocks of samples instead:
+ *          - sums of products are accumulated in 64 bit and rounded and
+ *            saturated once per result
+ *          - raw 16 bit sensor samples can be filtered without converting
+ *            them first (Q15 kernels). On Cortex-M4 these use the dual
+ *            16 bit multiply-accumulate instructions of core_cmSimd.h.
+ *          - square root and atan2 use lookup tables instead of iterations
+ *            with divisions, which Cortex-M0 does not have in hardware
+ *
+ *          Results saturate to @ref FIX16_DSP_MAX and @ref FIX16_DSP_MIN
+ *          instead of returning fix16_overflow.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Fixed-point signal processing definitions
+ *
+ * @author      René Kijewski <rene.kijewski@fu-berlin.de>
+ */
+
+#ifndef FIX16_DSP_H_
+#define FIX16_DSP_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "fix16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   1 if the Q15 kernels use the Cortex-M4 SIMD instructions
+ */
+#if defined(CPU_ARCH_CORTEX_M4) || defined(CPU_ARCH_CORTEX_M4F)
+#define FIX16_DSP_HAS_SIMD      (1)
+#else
+#define FIX16_DSP_HAS_SIMD      (0)
+#endif
+
+/**
+ * @brief   Saturation limits
+ * @{
+ */
+#define FIX16_DSP_MAX           ((fix16_t)0x7fffffff)
+#define FIX16_DSP_MIN           ((fix16_t)-0x7fffffff)
+/** @} */
+
+/**
+ * @brief   State of an FIR filter on fix16_t samples
+ */
+typedef struct {
+    const fix16_t *coeffs;  /**< taps, coeffs[0] weights the newest sample */
+    fix16_t *state;         /**< 2 * taps samples */
+    uint16_t taps;          /**< number of taps */
+    uint16_t pos;           /**< position of the newest sample in state */
+} fix16_dsp_fir_t;
+
+/**
+ * @brief   State of an FIR filter on raw 16 bit samples with Q15
+ *          coefficients
+ */
+typedef struct {
+    const int16_t *coeffs;  /**< taps, coeffs[0] weights the newest sample */
+    int16_t *state;         /**< 2 * taps samples */
+    uint16_t taps;          /**< number of taps */
+    uint16_t pos;           /**< position of the newest sample in state */
+} fix16_dsp_fir_q15_t;
+
+/**
+ * @brief   Coefficients of a biquad section, normalized so a0 = 1
+ *
+ * @details y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ */
+typedef struct {
+    fix16_t b0;             /**< b0 */
+    fix16_t b1;             /**< b1 */
+    fix16_t b2;             /**< b2 */
+    fix16_t a1;             /**< a1 */
+    fix16_t a2;             /**< a2 */
+} fix16_dsp_biquad_t;
+
+/**
+ * @brief   State of a biquad section
+ */
+typedef struct {
+    fix16_t x1;             /**< x[n-1] */
+    fix16_t x2;             /**< x[n-2] */
+    fix16_t y1;             /**< y[n-1] */
+    fix16_t y2;             /**< y[n-2] */
+} fix16_dsp_biquad_state_t;
+
+/**
+ * @brief   A quaternion
+ */
+typedef struct {
+    fix16_t w;              /**< real part */
+    fix16_t x;              /**< i */
+    fix16_t y;              /**< j */
+    fix16_t z;              /**< k */
+} fix16_dsp_quat_t;
+
+/**
+ * @brief   Converts raw sensor samples
+ *
+ * @param[out] dst      converted samples, dst[i] = src[i] * scale
+ * @param[in] src       raw samples
+ * @param[in] scale     value of one LSB of the sensor
+ * @param[in] n         number of samples
+ */
+void fix16_dsp_from_int16(fix16_t *dst, const int16_t *src, fix16_t scale,
+                          size_t n);
+
+/**
+ * @brief   Multiplies two arrays element by element
+ *
+ * @param[out] dst      products, may be @p a or @p b
+ * @param[in] a         factors
+ * @param[in] b         factors
+ * @param[in] n         number of elements
+ */
+void fix16_dsp_mul(fix16_t *dst, const fix16_t *a, const fix16_t *b, size_t n);
+
+/**
+ * @brief   Multiplies an array by a constant
+ *
+ * @param[out] dst      products, may be @p src
+ * @param[in] src       factors
+ * @param[in] k         constant factor
+ * @param[in] n         number of elements
+ */
+void fix16_dsp_scale(fix16_t *dst, const fix16_t *src, fix16_t k, size_t n);
+
+/**
+ * @brief   Adds an array multiplied by a constant: acc[i] += src[i] * k
+ *
+ * @param[in,out] acc   accumulators
+ * @param[in] src       factors
+ * @param[in] k         constant factor
+ * @param[in] n         number of elements
+ */
+void fix16_dsp_mac(fix16_t *acc, const fix16_t *src, fix16_t k, size_t n);
+
+/**
+ * @brief   Sum of products of two arrays, rounded once
+ *
+ * @param[in] a         factors
+ * @param[in] b         factors
+ * @param[in] n         number of elements
+ *
+ * @return  the dot product of @p a and @p b
+ */
+fix16_t fix16_dsp_dot(const fix16_t *a, const fix16_t *b, size_t n);
+
+/**
+ * @brief   Sum of products of raw samples and Q15 coefficients
+ *
+ * @param[in] a         raw samples
+ * @param[in] b         Q15 coefficients
+ * @param[in] n         number of elements
+ *
+ * @return  the dot product, in units of the raw samples
+ */
+fix16_t fix16_dsp_dot_q15(const int16_t *a, const int16_t *b, size_t n);
+
+/**
+ * @brief   Initializes an FIR filter
+ *
+ * @param[out] fir      the filter
+ * @param[in] coeffs    @p taps coefficients
+ * @param[in] state     buffer for 2 * @p taps samples
+ * @param[in] taps      number of taps
+ */
+void fix16_dsp_fir_init(fix16_dsp_fir_t *fir, const fix16_t *coeffs,
+                        fix16_t *state, uint16_t taps);
+
+/**
+ * @brief   Filters a block of samples
+ *
+ * @param[in,out] fir   the filter
+ * @param[out] dst      filtered samples, may be @p src
+ * @param[in] src       samples
+ * @param[in] n         number of samples
+ */
+void fix16_dsp_fir(fix16_dsp_fir_t *fir, fix16_t *dst, const fix16_t *src,
+                   size_t n);
+
+/**
+ * @brief   Initializes an FIR filter for raw samples
+ *
+ * @param[out] fir      the filter
+ * @param[in] coeffs    @p taps Q15 coefficients
+ * @param[in] state     buffer for 2 * @p taps samples
+ * @param[in] taps      number of taps
+ */
+void fix16_dsp_fir_q15_init(fix16_dsp_fir_q15_t *fir, const int16_t *coeffs,
+                            int16_t *state, uint16_t taps);
+
+/**
+ * @brief   Filters a block of raw samples
+ *
+ * @param[in,out] fir   the filter
+ * @param[out] dst      filtered samples, in units of the raw samples
+ * @param[in] src       raw samples
+ * @param[in] n         number of samples
+ */
+void fix16_dsp_fir_q15(fix16_dsp_fir_q15_t *fir, fix16_t *dst,
+                       const int16_t *src, size_t n);
+
+/**
+ * @brief   Filters a block of samples with cascaded biquad sections
+ *
+ * @param[in] coeffs    coefficients of the sections
+ * @param[in,out] state states of the sections, zeroed initially
+ * @param[in] stages    number of sections
+ * @param[out] dst      filtered samples, may be @p src
+ * @param[in] src       samples
+ * @param[in] n         number of samples
+ */
+void fix16_dsp_biquad(const fix16_dsp_biquad_t *coeffs,
+                      fix16_dsp_biquad_state_t *state, unsigned stages,
+                      fix16_t *dst, const fix16_t *src, size_t n);
+
+/**
+ * @brief   Single pole low-pass filter: y += alpha * (x - y)
+ *
+ * @param[in,out] y     output of the filter for the previous sample
+ * @param[out] dst      filtered samples, may be @p src
+ * @param[in] src       samples
+ * @param[in] alpha     smoothing factor in (0, 1]
+ * @param[in] n         number of samples
+ */
+void fix16_dsp_lowpass(fix16_t *y, fix16_t *dst, const fix16_t *src,
+                       fix16_t alpha, size_t n);
+
+/**
+ * @brief   Square root by table lookup
+ *
+ * @details The relative error is below 2^-13, and at most one LSB for small
+ *          results.
+ *
+ * @param[in] x         radicand
+ *
+ * @return  square root of @p x, 0 for negative @p x
+ */
+fix16_t fix16_dsp_sqrt(fix16_t x);
+
+/**
+ * @brief   atan2 by table driven CORDIC, without multiplications and
+ *          divisions
+ *
+ * @details The error is below 2^-14.
+ *
+ * @param[in] y         y coordinate
+ * @param[in] x         x coordinate
+ *
+ * @return  angle of (x, y) in [-pi, pi]
+ */
+fix16_t fix16_dsp_atan2(fix16_t y, fix16_t x);
+
+/**
+ * @brief   Multiplies two quaternions: q = a * b
+ *
+ * @param[out] q        the product, may be @p a or @p b
+ * @param[in] a         factor
+ * @param[in] b         factor
+ */
+void fix16_dsp_quat_mul(fix16_dsp_quat_t *q, const fix16_dsp_quat_t *a,
+                        const fix16_dsp_quat_t *b);
+
+/**
+ * @brief   Scales a quaternion to length 1
+ *
+ * @param[in,out] q     the quaternion
+ */
+void fix16_dsp_quat_normalize(fix16_dsp_quat_t *q);
+
+/**
+ * @brief   Updates an orientation with a block of gyroscope samples
+ *
+ * @details Integrates q' = 1/2 q * (0, gx, gy, gz) for each sample and
+ *          normalizes once at the end.
+ *
+ * @param[in,out] q     the orientation
+ * @param[in] gyro      angular rates around x, y, z in rad/s
+ * @param[in] n         number of samples
+ * @param[in] dt        time between samples in s
+ */
+void fix16_dsp_quat_integrate(fix16_dsp_quat_t *q, const fix16_t (*gyro)[3],
+                              size_t n, fix16_t dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIX16_DSP_H_ */
+/** @} */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_ng_csma CSMA/CA MAC layer
+ * @ingroup     net
+ * @brief       MAC protocol with unslotted CSMA/CA and retransmissions for
+ *              IEEE 802.15.4 devices
+ *
+ * @details This MAC layer is a drop-in replacement for @ref net_nomac on
+ *          IEEE 802.15.4 devices.
+ *
+ *          Outgoing packets are queued per neighbor, and the queues are
+ *          served round robin. A neighbor that does not answer therefore
+ *          only delays its own packets.
+ *
+ *          Before every transmission the channel is sensed with the
+ *          unslotted CSMA/CA algorithm of IEEE 802.15.4-2006, 7.5.1.4. This
+ *          is skipped if the device does it itself
+ *          (@ref NETCONF_OPT_AUTOCCA). Devices that can not sense the
+ *          channel are treated as if it was always clear, so they still
+ *          get the random backoff.
+ *
+ *          Some devices do not acknowledge frames in hardware, i.e. they do
+ *          not know @ref NETCONF_OPT_AUTOACK. For those the MAC layer
+ *          switches the device to @ref NETCONF_OPT_RAWMODE and does the
+ *          work itself:
+ *          - it builds and parses the frame headers with
+ *            @ref net_ng_ieee802154
+ *          - it filters frames by address
+ *          - it acknowledges unicast frames and drops duplicates
+ *          - it retransmits unacknowledged frames
+ *
+ *          Such a device must send packets that do not start with a netif
+ *          header unchanged, and must deliver raw frames without FCS.
+ *          @ref ng_native_medium behaves this way, so the whole layer can
+ *          be tested on native over a lossy medium.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the CSMA/CA MAC layer
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ */
+
+#ifndef NG_CSMA_H_
+#define NG_CSMA_H_
+
+#include <stdint.h>
+
+#include "kernel.h"
+#include "net/ng_netdev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Set the default message queue size for CSMA layers
+ */
+#ifndef NG_CSMA_MSG_QUEUE_SIZE
+#define NG_CSMA_MSG_QUEUE_SIZE          (8U)
+#endif
+
+/**
+ * @brief   Maximum number of CSMA layer instances
+ */
+#ifndef NG_CSMA_NUMOF
+#define NG_CSMA_NUMOF                   (1U)
+#endif
+
+/**
+ * @brief   Number of neighbors with their own transmit queue, per instance
+ *
+ * @details Broadcast packets use one of these queues, too.
+ */
+#ifndef NG_CSMA_NEIGHBORS_NUMOF
+#define NG_CSMA_NEIGHBORS_NUMOF         (4U)
+#endif
+
+/**
+ * @brief   Number of packets all transmit queues of an instance can hold
+ */
+#ifndef NG_CSMA_QUEUE_SIZE
+#define NG_CSMA_QUEUE_SIZE              (8U)
+#endif
+
+/**
+ * @brief   CSMA/CA and retransmission parameters
+ * @{
+ */
+#ifndef NG_CSMA_MIN_BE
+#define NG_CSMA_MIN_BE                  (3U)    /**< macMinBE */
+#endif
+#ifndef NG_CSMA_MAX_BE
+#define NG_CSMA_MAX_BE                  (5U)    /**< macMaxBE */
+#endif
+#ifndef NG_CSMA_MAX_BACKOFFS
+#define NG_CSMA_MAX_BACKOFFS            (4U)    /**< macMaxCSMABackoffs */
+#endif
+#ifndef NG_CSMA_MAX_FRAME_RETRIES
+#define NG_CSMA_MAX_FRAME_RETRIES       (3U)    /**< macMaxFrameRetries */
+#endif
+#ifndef NG_CSMA_BACKOFF_PERIOD_US
+#define NG_CSMA_BACKOFF_PERIOD_US       (320U)  /**< aUnitBackoffPeriod at
+                                                 *   2.4 GHz in microseconds */
+#endif
+#ifndef NG_CSMA_ACK_TIMEOUT_US
+#ifdef MODULE_NATIVE_MEDIUM
+/* the native medium adds its link latency and process switches */
+#define NG_CSMA_ACK_TIMEOUT_US          (10000U)
+#else
+#define NG_CSMA_ACK_TIMEOUT_US          (864U)  /**< macAckWaitDuration at
+                                                 *   2.4 GHz in microseconds */
+#endif
+#endif
+#ifndef NG_CSMA_BYTE_US
+#define NG_CSMA_BYTE_US                 (32U)   /**< time on air of one byte at
+                                                 *   250 kbit/s */
+#endif
+/** @} */
+
+/**
+ * @brief   Message types for the timers of the CSMA layer
+ * @{
+ */
+#define NG_CSMA_MSG_BACKOFF             (0x0221)    /**< backoff period over */
+#define NG_CSMA_MSG_ACK_TIMEOUT         (0x0222)    /**< no ACK received */
+/** @} */
+
+/**
+ * @brief   Statistics of a CSMA layer instance
+ */
+typedef struct {
+    uint32_t tx_frames;     /**< frames handed to the device, including
+                             *   retransmissions and ACKs */
+    uint32_t tx_success;    /**< packets acknowledged or sent to broadcast */
+    uint32_t tx_retries;    /**< retransmissions */
+    uint32_t tx_noack;      /**< packets dropped without ACK after
+                             *   @ref NG_CSMA_MAX_FRAME_RETRIES */
+    uint32_t tx_busy;       /**< packets dropped because the channel stayed
+                             *   busy */
+    uint32_t tx_qfull;      /**< packets dropped because the queues were full */
+    uint32_t rx_frames;     /**< frames passed to upper layers */
+    uint32_t rx_dups;       /**< duplicate frames dropped */
+    uint32_t acks_sent;     /**< ACKs sent */
+    uint64_t tx_airtime;    /**< estimated time on air in microseconds */
+    uint64_t uptime;        /**< microseconds since the instance started */
+} ng_csma_stats_t;
+
+/**
+ * @brief   Initialize an instance of the CSMA layer
+ *
+ * The initialization starts a new thread that connects to the given netdev
+ * device and starts a link layer event loop.
+ *
+ * @param[in] stack         stack for the control thread
+ * @param[in] stacksize     size of *stack*
+ * @param[in] priority      priority for the thread housing the CSMA instance
+ * @param[in] name          name of the thread housing the CSMA instance
+ * @param[in] dev           netdev device, needs to be already initialized
+ *
+ * @return                  PID of CSMA thread on success
+ * @return                  -EINVAL if creation of thread fails
+ * @return                  -ENODEV if *dev* is invalid
+ * @return                  -ENOBUFS if there are already
+ *                          @ref NG_CSMA_NUMOF instances
+ */
+kernel_pid_t ng_csma_init(char *stack, int stacksize, char priority,
+                          const char *name, ng_netdev_t *dev);
+
+/**
+ * @brief   Get the statistics of a CSMA layer instance
+ *
+ * @details The duty cycle is ng_csma_stats_t::tx_airtime divided by
+ *          ng_csma_stats_t::uptime.
+ *
+ * @param[in] pid           PID of the CSMA thread
+ * @param[out] stats        the statistics
+ *
+ * @return                  0 on success
+ * @return                  -ENOENT if @p pid is no CSMA thread
+ */
+int ng_csma_get_stats(kernel_pid_t pid, ng_csma_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NG_CSMA_H_ */
+/** @} */
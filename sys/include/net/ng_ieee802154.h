@@ -12,6 +12,16 @@
  * @brief       IEEE802.15.4 header definitions and utility functions
  * @{
  *
+ * @details The MAC header (MHR) of a frame has one of a few fixed layouts,
+ *          selected by the addressing modes and the PAN ID compression flag
+ *          in its frame control field. The layouts are tabulated at compile
+ *          time, so parsing and building a header is a table lookup followed
+ *          by straight copies instead of a chain of branches per field.
+ *
+ *          Addresses are exchanged with this module in network byte order,
+ *          as they are used in @ref ng_netif_hdr_t, and converted to and from
+ *          the little-endian order of the MHR.
+ *
  * @file
  * @brief       IEEE 802.14.4 header definitions
  *
@@ -22,7 +32,10 @@
 #define NG_IEEE802154_H_
 
 #include <stdint.h>
+#include <stdlib.h>
+
 #include "byteorder.h"
+#include "net/ng_pkt.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -61,6 +74,14 @@ extern "C" {
 #define NG_IEEE802154_FCF_SRC_ADDR_LONG     (0xc0)
 /** @} */
 
+/**
+ * @brief   Broadcast address
+ * @{
+ */
+#define NG_IEEE802154_ADDR_BCAST_LEN        (2U)
+#define NG_IEEE802154_ADDR_BCAST            { 0xff, 0xff }
+/** @} */
+
 /**
  * @brief Data type to represent an EUI-64.
  */
@@ -70,6 +91,137 @@ typedef union {
     le_uint16_t uint16[4];  /**< split into 4 16-bit words. */
 } eui64_t ;
 
+/**
+ * @brief   Layout of a MAC header for one combination of addressing modes
+ *
+ * @details The destination PAN ID, if present, is always at offset 3 and the
+ *          destination address at offset 5.
+ */
+typedef struct {
+    uint8_t len;        /**< length of the MHR, 0 if the addressing modes are
+                         *   invalid */
+    uint8_t dst_len;    /**< length of the destination address */
+    uint8_t src_len;    /**< length of the source address */
+    uint8_t src_pan;    /**< offset of the source PAN ID, 0 if it is elided */
+    uint8_t src;        /**< offset of the source address */
+} ng_ieee802154_mhr_layout_t;
+
+/**
+ * @brief   Layouts of all MAC headers, indexed by
+ *          @ref NG_IEEE802154_MHR_LAYOUT_IDX()
+ */
+extern const ng_ieee802154_mhr_layout_t ng_ieee802154_mhr_layouts[32];
+
+/**
+ * @brief   Index of the layout of a MAC header in
+ *          @ref ng_ieee802154_mhr_layouts
+ *
+ * @param[in] fcf0  first byte of the frame control field
+ * @param[in] fcf1  second byte of the frame control field
+ */
+#define NG_IEEE802154_MHR_LAYOUT_IDX(fcf0, fcf1) \
+    ((((fcf1) & NG_IEEE802154_FCF_DST_ADDR_MASK) >> 2) | \
+     (((fcf1) & NG_IEEE802154_FCF_SRC_ADDR_MASK) >> 4) | \
+     (((fcf0) & NG_IEEE802154_FCF_PAN_COMP) >> 2))
+
+/**
+ * @brief   Gets the layout of a MAC header.
+ *
+ * @param[in] mhr   A MAC header, only the frame control field is read.
+ *
+ * @return  The layout of @p mhr.
+ */
+static inline const ng_ieee802154_mhr_layout_t *ng_ieee802154_get_mhr_layout(const uint8_t *mhr)
+{
+    return &ng_ieee802154_mhr_layouts[NG_IEEE802154_MHR_LAYOUT_IDX(mhr[0], mhr[1])];
+}
+
+/**
+ * @brief   Gets the length of a MAC header.
+ *
+ * @todo    Include security header implications
+ *
+ * @param[in] mhr   A MAC header, only the frame control field is read.
+ *
+ * @return  The length of the MAC header.
+ * @return  0, if the addressing modes of @p mhr are invalid.
+ */
+static inline size_t ng_ieee802154_get_frame_hdr_len(const uint8_t *mhr)
+{
+    return ng_ieee802154_get_mhr_layout(mhr)->len;
+}
+
+/**
+ * @brief   Builds a MAC header.
+ *
+ * @details The addressing modes are derived from @p src_len and
+ *          @p dst_len. @p src_pan is only written if @p flags does not
+ *          contain @ref NG_IEEE802154_FCF_PAN_COMP.
+ *
+ * @param[out] buf      Buffer for the header, must have room for
+ *                      @ref NG_IEEE802154_MAX_HDR_LEN bytes.
+ * @param[in] src       Source address in network byte order.
+ * @param[in] src_len   Length of @p src: 0, 2, or 8.
+ * @param[in] dst       Destination address in network byte order.
+ * @param[in] dst_len   Length of @p dst: 0, 2, or 8.
+ * @param[in] src_pan   Source PAN ID.
+ * @param[in] dst_pan   Destination PAN ID.
+ * @param[in] flags     First byte of the frame control field: the frame type
+ *                      and the NG_IEEE802154_FCF_* flags.
+ * @param[in] seq       Sequence number of the frame.
+ *
+ * @return  The length of the header.
+ * @return  0, if an address length is invalid.
+ */
+size_t ng_ieee802154_set_frame_hdr(uint8_t *buf, const uint8_t *src,
+                                   size_t src_len, const uint8_t *dst,
+                                   size_t dst_len, le_uint16_t src_pan,
+                                   le_uint16_t dst_pan, uint8_t flags,
+                                   uint8_t seq);
+
+/**
+ * @brief   Gets the source address of a MAC header.
+ *
+ * @param[in] mhr       A MAC header.
+ * @param[out] src      The source address in network byte order, must have
+ *                      room for 8 bytes. May be NULL.
+ * @param[out] src_pan  The source PAN ID, the destination PAN ID if it is
+ *                      compressed. May be NULL.
+ *
+ * @return  The length of the source address.
+ * @return  -EINVAL, if the addressing modes of @p mhr are invalid.
+ */
+int ng_ieee802154_get_src(const uint8_t *mhr, uint8_t *src,
+                          le_uint16_t *src_pan);
+
+/**
+ * @brief   Gets the destination address of a MAC header.
+ *
+ * @param[in] mhr       A MAC header.
+ * @param[out] dst      The destination address in network byte order, must
+ *                      have room for 8 bytes. May be NULL.
+ * @param[out] dst_pan  The destination PAN ID. May be NULL.
+ *
+ * @return  The length of the destination address.
+ * @return  -EINVAL, if the addressing modes of @p mhr are invalid.
+ */
+int ng_ieee802154_get_dst(const uint8_t *mhr, uint8_t *dst,
+                          le_uint16_t *dst_pan);
+
+/**
+ * @brief   Builds the netif header of a received frame.
+ *
+ * @details Only the addresses are filled in, the interface, RSSI, and LQI
+ *          are left to the caller.
+ *
+ * @param[in] mhr   The MAC header of the frame.
+ *
+ * @return  The netif header in the packet buffer.
+ * @return  NULL, if the addressing modes of @p mhr are invalid or the
+ *          packet buffer is full.
+ */
+ng_pktsnip_t *ng_ieee802154_netif_hdr_build(const uint8_t *mhr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,6 +16,15 @@
  *              neighboring modules. In this model every module runs in its own
  *              thread and communication is done using the @ref net_ng_netapi.
  *
+ *              With the `ng_netapi_direct` module the stack runs to
+ *              completion instead: modules above the MAC layer register a
+ *              handler with ng_netapi_direct_register() in place of a thread
+ *              and the shortcut functions below call it directly. All
+ *              handlers run in the thread of the first MAC layer (ng_nomac or
+ *              ng_csma), messages of other threads are forwarded there. This
+ *              saves a stack and a context switch per layer, the stack of
+ *              the MAC layer has to be large enough for all layers though.
+ *
  * @{
  *
  * @file
@@ -30,6 +39,7 @@
 
 #include "kernel.h"
 #include "thread.h"
+#include "msg.h"
 #include "net/ng_netconf.h"
 #include "net/ng_pkt.h"
 
@@ -62,6 +72,31 @@ extern "C" {
  */
 #define NG_NETAPI_MSG_TYPE_ACK          (0x0205)
 
+/**
+ * @brief   Message types for forwarding netapi messages to modules in
+ *          @ref NG_NETAPI_DIRECT_NUMOF, handled by ng_netapi_direct_dispatch()
+ */
+#define NG_NETAPI_MSG_TYPE_DIRECT       (0x0240)
+
+/**
+ * @brief   Maximum number of modules running without a thread
+ */
+#ifndef NG_NETAPI_DIRECT_NUMOF
+#define NG_NETAPI_DIRECT_NUMOF          (4)
+#endif
+
+/**
+ * @brief   Stack size a MAC layer thread needs in addition to its own, with
+ *          `ng_netapi_direct` the layers above run on it
+ */
+#ifndef NG_NETAPI_DIRECT_STACKSIZE
+#ifdef MODULE_NG_NETAPI_DIRECT
+#define NG_NETAPI_DIRECT_STACKSIZE      (2 * THREAD_STACKSIZE_DEFAULT)
+#else
+#define NG_NETAPI_DIRECT_STACKSIZE      (0)
+#endif
+#endif
+
 /**
  * @brief   Data structure to be send for setting and getting options
  */
@@ -83,14 +118,38 @@ typedef struct {
  */
 int ng_netapi_send(kernel_pid_t pid, ng_pktsnip_t *pkt);
 
+/**
+ * @brief   Shortcut function for sending @ref NG_NETAPI_MSG_TYPE_SND messages
+ *          without blocking
+ *
+ * @details Lets senders throttle instead of blocking when the network module
+ *          can not keep up.
+ *
+ * @param[in] pid       PID of the targeted network module
+ * @param[in] pkt       pointer into the packet buffer holding the data to send
+ *
+ * @return              1 if packet was successfully delivered
+ * @return              0 if the message queue of the module is full, @p pkt
+ *                      still belongs to the caller
+ * @return              -1 on error (invalid PID)
+ */
+int ng_netapi_try_send(kernel_pid_t pid, ng_pktsnip_t *pkt);
+
 /**
  * @brief   Shortcut function for sending @ref NG_NETAPI_MSG_TYPE_RCV messages
  *
+ * @details Does not block if the receiver has a message queue, the layer
+ *          below must keep up with the network. Receivers without one,
+ *          e.g. application threads waiting in msg_receive(), only take
+ *          messages while they wait, so the call blocks for them.
+ *
  * @param[in] pid       PID of the targeted network module
  * @param[in] pkt       pointer into the packet buffer holding the received data
  *
  * @return              1 if packet was successfully delivered
- * @return              -1 on error (invalid PID or no space in queue)
+ * @return              0 if the message queue of the module was full, @p pkt
+ *                      is released and counted as dropped
+ * @return              -1 on error (invalid PID)
  */
 int ng_netapi_receive(kernel_pid_t pid, ng_pktsnip_t *pkt);
 
@@ -124,6 +183,94 @@ int ng_netapi_get(kernel_pid_t pid, ng_netconf_opt_t opt, uint16_t context,
 int ng_netapi_set(kernel_pid_t pid, ng_netconf_opt_t opt, uint16_t context,
                   void *data, size_t data_len);
 
+/**
+ * @brief   Handler of a module running without a thread
+ *
+ * @param[in] ctx       context given on registration
+ * @param[in] msg       a message as the module would have received it
+ *
+ * @return              the value to acknowledge @ref NG_NETAPI_MSG_TYPE_GET and
+ *                      @ref NG_NETAPI_MSG_TYPE_SET messages with
+ * @return              -ENOTSUP for unknown message types
+ */
+typedef int (*ng_netapi_handler_t)(void *ctx, msg_t *msg);
+
+#if defined(MODULE_NG_NETAPI_DIRECT) || defined(DOXYGEN)
+/**
+ * @brief   PID of the thread running the network stack
+ */
+extern kernel_pid_t ng_netapi_direct_pid;
+
+/**
+ * @brief   Registers a module running without a thread
+ *
+ * @param[in] handler   handler for the messages to the module
+ * @param[in] ctx       context for @p handler
+ *
+ * @return              a PID to address the module with, from
+ *                      thread_reserve_pid()
+ * @return              KERNEL_PID_UNDEF if @ref NG_NETAPI_DIRECT_NUMOF
+ *                      modules are registered already or no PID is left
+ */
+kernel_pid_t ng_netapi_direct_register(ng_netapi_handler_t handler, void *ctx);
+
+/**
+ * @brief   Makes the calling thread run the network stack
+ *
+ * @details Called by MAC layers on startup, only the first call has an
+ *          effect. @p handler serves netapi messages the stack sends to the
+ *          MAC layer itself.
+ *
+ * @param[in] handler   handler for netapi messages to the calling thread
+ * @param[in] ctx       context for @p handler
+ */
+void ng_netapi_direct_run(ng_netapi_handler_t handler, void *ctx);
+
+/**
+ * @brief   Handles a message for the modules without thread
+ *
+ * @details Called by the thread running the stack for messages it does not
+ *          know itself.
+ *
+ * @param[in] msg       the message
+ *
+ * @return              1 if the message was handled
+ * @return              0 if no module knows the message
+ */
+int ng_netapi_direct_dispatch(msg_t *msg);
+
+/**
+ * @brief   Gets the thread to send messages for @p pid to, e.g. by timers
+ *
+ * @param[in] pid       PID of a module
+ *
+ * @return              the thread running the stack if @p pid has no thread
+ * @return              @p pid otherwise
+ */
+kernel_pid_t ng_netapi_msg_pid(kernel_pid_t pid);
+
+/**
+ * @brief   Gets the message type to use for netapi messages to @p pid
+ *
+ * @param[in] pid       PID of a module
+ * @param[in] type      a netapi message type
+ *
+ * @return              the type to send to ng_netapi_msg_pid()
+ */
+uint16_t ng_netapi_msg_type(kernel_pid_t pid, uint16_t type);
+#else
+static inline kernel_pid_t ng_netapi_msg_pid(kernel_pid_t pid)
+{
+    return pid;
+}
+
+static inline uint16_t ng_netapi_msg_type(kernel_pid_t pid, uint16_t type)
+{
+    (void)pid;
+    return type;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -121,6 +121,9 @@ typedef enum {
     NETCONF_OPT_TX_END_IRQ,
     NETCONF_OPT_AUTOCCA,            /**< en/disable to check automatically
                                          before sending the channel is clear. */
+    NETCONF_OPT_STATS,              /**< (ng_netstats_t) packet, drop, queue
+                                         and latency counters of a module,
+                                         read only */
     /* add more options if needed */
 
     /**
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_ng_netstats Network module statistics
+ * @ingroup     net
+ * @brief       Packet, drop, queue and latency counters of network modules
+ *
+ * @details     Every network module keeps a ng_netstats_t and registers it
+ *              with ng_netstats_register(). The counters are read with
+ *              ng_netapi_get() and @ref NETCONF_OPT_STATS, the `netstats`
+ *              shell command prints them for all modules.
+ *
+ *              Without the `ng_netstats` module all functions are empty and
+ *              the counters are never touched.
+ * @{
+ *
+ * @file
+ * @brief       Network module statistics interface
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ */
+
+#ifndef NG_NETSTATS_H_
+#define NG_NETSTATS_H_
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hwtimer.h"
+#include "kernel_types.h"
+#include "sched.h"
+#include "net/ng_netapi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Reasons for dropping a packet
+ */
+typedef enum {
+    NG_NETSTATS_DROP_QUEUE_FULL = 0,    /**< message queue of the module full */
+    NG_NETSTATS_DROP_NOBUF,             /**< packet buffer out of memory */
+    NG_NETSTATS_DROP_CSUM,              /**< wrong checksum */
+    NG_NETSTATS_DROP_NO_ROUTE,          /**< no interface or next hop */
+    NG_NETSTATS_DROP_HOP_LIMIT,         /**< hop limit reached */
+    NG_NETSTATS_DROP_REASS_TIMEOUT,     /**< reassembly timed out */
+    NG_NETSTATS_DROP_TX_FAIL,           /**< channel busy or no ACK */
+    NG_NETSTATS_DROP_NUMOF              /**< number of reasons */
+} ng_netstats_drop_t;
+
+/**
+ * @brief   Statistics of a network module
+ */
+typedef struct ng_netstats {
+    struct ng_netstats *next;   /**< next module, internal */
+    kernel_pid_t pid;           /**< PID of the module */
+    const char *name;           /**< name of the module */
+    uint32_t packets;           /**< handled packets */
+    uint32_t drops[NG_NETSTATS_DROP_NUMOF]; /**< dropped packets by reason */
+    uint16_t queue_max;         /**< most messages waiting in the queue */
+    uint32_t latency_sum;       /**< total time handling packets in us */
+    uint32_t latency_max;       /**< longest time handling a packet in us */
+} ng_netstats_t;
+
+#if defined(MODULE_NG_NETSTATS) || defined(DOXYGEN)
+/**
+ * @brief   Registers the statistics of a module
+ *
+ * @param[out] stats    the statistics, zeroed
+ * @param[in] pid       PID of the module
+ * @param[in] name      name of the module
+ */
+void ng_netstats_register(ng_netstats_t *stats, kernel_pid_t pid,
+                          const char *name);
+
+/**
+ * @brief   Gets the registered modules
+ *
+ * @return  the first module, continue with ng_netstats_t::next
+ */
+ng_netstats_t *ng_netstats_list(void);
+
+/**
+ * @brief   Counts a packet dropped by the module with PID @p pid
+ *
+ * @details For code outside of the module, e.g. when the queue of the
+ *          module was full.
+ *
+ * @param[in] pid       PID of the module
+ * @param[in] reason    reason of the drop
+ */
+void ng_netstats_drop_pid(kernel_pid_t pid, ng_netstats_drop_t reason);
+
+/**
+ * @brief   Counts a dropped packet
+ *
+ * @param[in] stats     statistics of the module
+ * @param[in] reason    reason of the drop
+ */
+static inline void ng_netstats_drop(ng_netstats_t *stats,
+                                    ng_netstats_drop_t reason)
+{
+    stats->drops[reason]++;
+}
+
+/**
+ * @brief   Records the depth of the message queue of the calling thread,
+ *          called after msg_receive()
+ *
+ * @param[in] stats     statistics of the module
+ */
+static inline void ng_netstats_queue(ng_netstats_t *stats)
+{
+    unsigned depth = cib_avail((cib_t *)&sched_active_thread->msg_queue);
+
+    if (depth > stats->queue_max) {
+        stats->queue_max = depth;
+    }
+}
+
+/**
+ * @brief   Starts timing the handling of a packet
+ *
+ * @return  the start time for ng_netstats_done()
+ */
+static inline unsigned long ng_netstats_start(void)
+{
+    return hwtimer_now();
+}
+
+/**
+ * @brief   Counts a handled packet and its handling time
+ *
+ * @param[in] stats     statistics of the module
+ * @param[in] start     the result of ng_netstats_start()
+ */
+static inline void ng_netstats_done(ng_netstats_t *stats, unsigned long start)
+{
+    uint32_t us = HWTIMER_TICKS_TO_US(hwtimer_now() - start);
+
+    stats->packets++;
+    stats->latency_sum += us;
+    if (us > stats->latency_max) {
+        stats->latency_max = us;
+    }
+}
+#else
+static inline void ng_netstats_register(ng_netstats_t *stats, kernel_pid_t pid,
+                                        const char *name)
+{
+    (void)stats;
+    (void)pid;
+    (void)name;
+}
+
+static inline void ng_netstats_drop_pid(kernel_pid_t pid,
+                                        ng_netstats_drop_t reason)
+{
+    (void)pid;
+    (void)reason;
+}
+
+static inline void ng_netstats_drop(ng_netstats_t *stats,
+                                    ng_netstats_drop_t reason)
+{
+    (void)stats;
+    (void)reason;
+}
+
+static inline void ng_netstats_queue(ng_netstats_t *stats)
+{
+    (void)stats;
+}
+
+static inline unsigned long ng_netstats_start(void)
+{
+    return 0;
+}
+
+static inline void ng_netstats_done(ng_netstats_t *stats, unsigned long start)
+{
+    (void)stats;
+    (void)start;
+}
+#endif
+
+/**
+ * @brief   Answers a @ref NETCONF_OPT_STATS get request
+ *
+ * @param[in] stats     statistics of the module
+ * @param[in] opt       the request
+ *
+ * @return  size of ng_netstats_t on success
+ * @return  -ENOTSUP for other options or without the `ng_netstats` module
+ * @return  -EOVERFLOW if the buffer is too small
+ */
+static inline int ng_netstats_get(ng_netstats_t *stats, ng_netapi_opt_t *opt)
+{
+#ifdef MODULE_NG_NETSTATS
+    if (opt->opt != NETCONF_OPT_STATS) {
+        return -ENOTSUP;
+    }
+    if (opt->data_len < sizeof(ng_netstats_t)) {
+        return -EOVERFLOW;
+    }
+    memcpy(opt->data, stats, sizeof(ng_netstats_t));
+    return sizeof(ng_netstats_t);
+#else
+    (void)stats;
+    (void)opt;
+    return -ENOTSUP;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NG_NETSTATS_H_ */
+/** @} */
@@ -76,6 +76,9 @@ typedef enum {
      * @}
      */
 
+#ifdef MODULE_CCN_LITE
+    NG_NETTYPE_CCN,             /**< Protocol is CCN */
+#endif
 
     /**
      * @{
@@ -216,6 +216,14 @@ bool ng_pktbuf_is_empty(void);
  * @brief   Resets the whole packet buffer
  */
 void ng_pktbuf_reset(void);
+
+/**
+ * @brief   Number of allocations and reallocations of packet buffer space
+ *          since the last call of @ref ng_pktbuf_reset()
+ *
+ * @return  The number of allocations.
+ */
+unsigned int ng_pktbuf_alloc_count(void);
 #endif
 
 #ifdef __cplusplus
@@ -68,7 +68,7 @@ typedef struct {
  *
  * @param[in] addr  An IPv6 address.
  *
- * @return  The context associated with the best prefix for @p addr.
+ * @return  The context with the longest prefix matching @p addr.
  * @return  NULL if there is no such context.
  */
 ng_sixlowpan_ctx_t *ng_sixlowpan_ctx_lookup_addr(const ng_ipv6_addr_t *addr);
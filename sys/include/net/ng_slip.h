@@ -35,7 +35,7 @@ extern "C" {
 #endif
 
 /**
- * @brief   UART buffer size used for TX and RX buffers
+ * @brief   UART buffer size used for the RX buffer
  *
  * Reduce this value if your expected traffic does not include full IPv6 MTU
  * sized packets
@@ -50,9 +50,7 @@ extern "C" {
 typedef struct {
     uart_t uart;                    /**< the UART interface */
     ringbuffer_t *in_buf;           /**< RX buffer */
-    ringbuffer_t *out_buf;          /**< TX buffer */
     char rx_mem[NG_SLIP_BUFSIZE];   /**< memory used by RX buffer */
-    char tx_mem[NG_SLIP_BUFSIZE];   /**< memory used by TX buffer */
     uint32_t in_bytes;              /**< the number of bytes received of a
                                      *   currently incoming packet */
     uint16_t in_esc;                /**< receiver is in escape mode */
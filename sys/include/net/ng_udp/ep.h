@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_ng_udp_ep UDP endpoints
+ * @ingroup     sys_net_udp
+ * @brief       Zero-copy UDP endpoints on top of @ref net_ng_netreg
+ *
+ * @details An endpoint registers the calling thread for a local UDP port.
+ *          Received datagrams are handed to the application as the packet
+ *          snips the network stack delivered, and payloads to send are
+ *          built directly in the packet buffer, so no payload is ever
+ *          copied. Both sending and receiving can process several datagrams
+ *          per call.
+ *
+ *          Received packets arrive as @ref NG_NETAPI_MSG_TYPE_RCV messages
+ *          in the message queue of the thread that created the endpoint, so
+ *          that thread needs a message queue. A thread can create several
+ *          endpoints: datagrams ng_udp_ep_recv() takes from the message
+ *          queue for another endpoint of the thread are kept in the queue
+ *          of that endpoint until it is received on. Any other message is
+ *          put back into the message queue and interrupts
+ *          ng_udp_ep_recv(), so the thread can handle it with
+ *          msg_receive().
+ *
+ * @{
+ *
+ * @file
+ * @brief       UDP endpoint definitions
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ */
+
+#ifndef NG_UDP_EP_H_
+#define NG_UDP_EP_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "cib.h"
+#include "net/ng_ipv6/addr.h"
+#include "net/ng_netreg.h"
+#include "net/ng_pkt.h"
+#include "net/ng_pktbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Timeout value for ng_udp_ep_recv() to block until a datagram
+ *          arrives
+ */
+#define NG_UDP_EP_TIMEOUT_FOREVER   (UINT32_MAX)
+
+#ifndef NG_UDP_EP_QUEUE_SIZE
+/**
+ * @brief   Number of datagrams an endpoint keeps while another endpoint of
+ *          the same thread receives, must be a power of two
+ */
+#define NG_UDP_EP_QUEUE_SIZE        (4U)
+#endif
+
+/**
+ * @brief   A UDP endpoint
+ */
+typedef struct ng_udp_ep {
+    ng_netreg_entry_t netreg;   /**< registration of the endpoint, the demux
+                                 *   context is the local port */
+    struct ng_udp_ep *next;     /**< next created endpoint, internal */
+    cib_t cib;                  /**< indices of ng_udp_ep_t::queue, internal */
+    /**
+     * @brief   Datagrams for this endpoint taken from the message queue by
+     *          another endpoint of the same thread, internal
+     */
+    ng_pktsnip_t *queue[NG_UDP_EP_QUEUE_SIZE];
+} ng_udp_ep_t;
+
+/**
+ * @brief   A datagram to send or a received datagram
+ */
+typedef struct {
+    /**
+     * @brief   The datagram.
+     *
+     * @details On sending the payload only, e.g. allocated with
+     *          ng_udp_ep_alloc(). On reception the packet as received, with
+     *          the payload in the first snip and the UDP and IPv6 headers
+     *          behind it. It must be released with ng_pktbuf_release().
+     */
+    ng_pktsnip_t *pkt;
+    ng_ipv6_addr_t addr;        /**< remote address */
+    uint16_t port;              /**< remote port in host byte order */
+} ng_udp_ep_dgram_t;
+
+/**
+ * @brief   Creates an endpoint for the calling thread.
+ *
+ * @param[out] ep       The endpoint to create.
+ * @param[in] port      The local port in host byte order.
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p ep is NULL or @p port is 0
+ * @return  -ENOTCONN if there is no UDP thread
+ */
+int ng_udp_ep_create(ng_udp_ep_t *ep, uint16_t port);
+
+/**
+ * @brief   Closes an endpoint.
+ *
+ * @details Datagrams kept in the queue of the endpoint are released,
+ *          datagrams still in the message queue of the thread are not.
+ *
+ * @param[in] ep    The endpoint to close.
+ */
+void ng_udp_ep_close(ng_udp_ep_t *ep);
+
+/**
+ * @brief   Allocates a payload to send in the packet buffer.
+ *
+ * @param[in] len   The length of the payload.
+ *
+ * @return  The payload, the data can be written to ng_pktsnip_t::data
+ *          directly.
+ * @return  NULL, if the packet buffer is full.
+ */
+static inline ng_pktsnip_t *ng_udp_ep_alloc(size_t len)
+{
+    return ng_pktbuf_add(NULL, NULL, len, NG_NETTYPE_UNDEF);
+}
+
+/**
+ * @brief   Sends datagrams from an endpoint.
+ *
+ * @details All payloads in @p dgrams are consumed, even if they could not
+ *          be sent. If the UDP thread does not take a datagram, the
+ *          remaining datagrams are released.
+ *
+ * @param[in] ep        The endpoint to send from.
+ * @param[in] dgrams    The datagrams to send.
+ * @param[in] num       The number of datagrams in @p dgrams.
+ *
+ * @return  The number of datagrams handed to UDP.
+ * @return  -EINVAL if @p ep or @p dgrams is NULL
+ * @return  -ENOTCONN if there is no UDP thread or it did not take a
+ *          datagram
+ * @return  -ENOBUFS if not even the first datagram could be sent due to a
+ *          full packet buffer
+ */
+int ng_udp_ep_send(ng_udp_ep_t *ep, ng_udp_ep_dgram_t *dgrams, size_t num);
+
+/**
+ * @brief   Receives datagrams on an endpoint.
+ *
+ * @details Waits up to @p timeout for the first datagram and then takes
+ *          all datagrams already queued, up to @p num. A message that is
+ *          not a datagram for an endpoint of the calling thread stops the
+ *          call and is put back into the message queue of the thread.
+ *
+ * @param[in] ep        The endpoint to receive on.
+ * @param[out] dgrams   The received datagrams.
+ * @param[in] num       The maximum number of datagrams to receive.
+ * @param[in] timeout   Time to wait for the first datagram in microseconds.
+ *                      0 returns immediately, @ref NG_UDP_EP_TIMEOUT_FOREVER
+ *                      waits without timeout.
+ *
+ * @return  The number of received datagrams, 0 on timeout.
+ * @return  -EINVAL if @p ep or @p dgrams is NULL
+ * @return  -EINTR if another message arrived before the first datagram
+ */
+int ng_udp_ep_recv(ng_udp_ep_t *ep, ng_udp_ep_dgram_t *dgrams, size_t num,
+                   uint32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NG_UDP_EP_H_ */
+/** @} */
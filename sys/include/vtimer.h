@@ -116,6 +116,20 @@ void vtimer_set_msg(vtimer_t *t, timex_t interval, kernel_pid_t pid, uint16_t ty
  */
 int vtimer_set_wakeup(vtimer_t *t, timex_t interval, kernel_pid_t pid);
 
+/**
+ * @brief   set a vtimer that calls a function when it fires
+ *
+ * @details @p cb runs in interrupt context and gets @p t, @p arg is found
+ *          in vtimer_t::arg.
+ *
+ * @param[in]   t           pointer to preinitialised vtimer_t
+ * @param[in]   interval    the interval after which the timer shall fire
+ * @param[in]   cb          function called when the timer fires
+ * @param[in]   arg         argument for @p cb
+ * @return      0 on success, < 0 on error
+ */
+int vtimer_set_cb(vtimer_t *t, timex_t interval, void (*cb)(vtimer_t *), void *arg);
+
 /**
  * @brief   remove a vtimer
  * @param[in]   t           pointer to preinitialised vtimer_t
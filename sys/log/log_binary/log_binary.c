@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2015 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_log_binary
+ * @{
+ *
+ * @file
+ * @brief       Deferred binary logging
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "log.h"
+#include "ringbuffer.h"
+#include "thread.h"
+#include "vtimer.h"
+
+/* level, number of arguments, format string and arguments */
+#define HDR_SIZE        (2 + sizeof(uint32_t))
+#define RECORD_MAX      (HDR_SIZE + LOG_BINARY_ARGS_MAX * sizeof(uint32_t))
+
+static char buf[LOG_BINARY_BUFSIZE];
+static ringbuffer_t rb = RINGBUFFER_INIT(buf);
+static unsigned dropped;
+
+static char stack[THREAD_STACKSIZE_DEFAULT];
+
+static unsigned _record(char *rec, unsigned level, unsigned nargs,
+                        const char *format, va_list args)
+{
+    uint32_t word = (uint32_t)(uintptr_t)format;
+    char *pos = rec + HDR_SIZE;
+
+    if (nargs > LOG_BINARY_ARGS_MAX) {
+        nargs = LOG_BINARY_ARGS_MAX;
+    }
+    rec[0] = (char)level;
+    rec[1] = (char)nargs;
+    memcpy(rec + 2, &word, sizeof(word));
+    for (unsigned i = 0; i < nargs; i++) {
+        word = va_arg(args, uint32_t);
+        memcpy(pos, &word, sizeof(word));
+        pos += sizeof(word);
+    }
+
+    return pos - rec;
+}
+
+void log_binary_write(unsigned level, unsigned nargs, const char *format, ...)
+{
+    char rec[RECORD_MAX];
+    unsigned len, state;
+    va_list args;
+
+    va_start(args, format);
+    len = _record(rec, level, nargs, format, args);
+    va_end(args);
+
+    state = disableIRQ();
+    if (ringbuffer_get_free(&rb) >= len) {
+        ringbuffer_add(&rb, rec, len);
+    }
+    else {
+        dropped++;
+    }
+    restoreIRQ(state);
+}
+
+static void _emit(const char *rec, unsigned len)
+{
+    putchar(0);
+    putchar(len);
+    for (unsigned i = 0; i < len; i++) {
+        putchar(rec[i]);
+    }
+}
+
+static void _emit_dropped(unsigned num)
+{
+    char rec[HDR_SIZE + sizeof(uint32_t)];
+    uint32_t word = (uint32_t)(uintptr_t)"log_binary: %u records dropped\n";
+
+    rec[0] = LOG_WARNING;
+    rec[1] = 1;
+    memcpy(rec + 2, &word, sizeof(word));
+    word = num;
+    memcpy(rec + HDR_SIZE, &word, sizeof(word));
+    _emit(rec, sizeof(rec));
+}
+
+static void *_drain(void *arg)
+{
+    char rec[RECORD_MAX];
+    unsigned len, num;
+
+    (void)arg;
+
+    while (1) {
+        unsigned state = disableIRQ();
+
+        if (ringbuffer_empty(&rb)) {
+            /* the dropped records were newer than all records written */
+            num = dropped;
+            dropped = 0;
+            restoreIRQ(state);
+            if (num) {
+                _emit_dropped(num);
+            }
+            fflush(stdout);
+            vtimer_usleep(LOG_BINARY_POLL_US);
+            continue;
+        }
+        /* records are added and removed as a whole with interrupts
+         * disabled, so the buffer always starts with a header */
+        ringbuffer_peek(&rb, rec, 2);
+        len = HDR_SIZE + (uint8_t)rec[1] * sizeof(uint32_t);
+        ringbuffer_get(&rb, rec, len);
+        restoreIRQ(state);
+
+        _emit(rec, len);
+    }
+
+    return NULL;
+}
+
+void log_binary_init(void)
+{
+    thread_create(stack, sizeof(stack), THREAD_PRIORITY_IDLE - 1,
+                  CREATE_STACKTEST, _drain, NULL, "log_binary");
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2015 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_log_binary deferred binary log module
+ * @ingroup     sys
+ * @brief       Logging without formatting on the device
+ *
+ * @details     log_write() does not format the message. It only stores the
+ *              level, the address of the format string and the raw
+ *              arguments as a record in a ringbuffer, which takes a few
+ *              microseconds and no printf stack. A low priority thread
+ *              started by auto_init writes the records to stdout, where
+ *              `dist/tools/log_binary/log_binary.py` formats them with the
+ *              format strings from the ELF file of the application.
+ *
+ *              With this module, @ref DEBUG and @ref DEBUGF are logged the
+ *              same way, so they can be enabled in the scheduler or the
+ *              network stack without changing the timing much.
+ *
+ *              Arguments are recorded as 32 bit values, so the module is
+ *              meant for 32 bit platforms and 64 bit integers and floating
+ *              point numbers are not supported. Strings are recorded as
+ *              pointers and can only be printed if they are constant, i.e.
+ *              part of the ELF file. A call has at most
+ *              @ref LOG_BINARY_ARGS_MAX arguments after the format string,
+ *              more fail to compile.
+ *              Records are dropped if the ringbuffer is full; the thread
+ *              logs the number of dropped records.
+ *
+ *              On the wire a record is a 0 byte, the length of the record
+ *              and the record: level (1 byte), number of arguments (1 byte),
+ *              format string address and the arguments (4 byte each, in the
+ *              byte order of the device).
+ * @{
+ *
+ * @file
+ * @brief       log_module header
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef __LOG_BINARY_H
+#define __LOG_BINARY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of arguments after the format string
+ */
+#define LOG_BINARY_ARGS_MAX     (8)
+
+#ifndef LOG_BINARY_BUFSIZE
+/**
+ * @brief   Size of the ringbuffer for records in byte
+ */
+#define LOG_BINARY_BUFSIZE      (512)
+#endif
+
+#ifndef LOG_BINARY_POLL_US
+/**
+ * @brief   Interval in which the thread looks for new records
+ *
+ * The thread polls, so log_write() never touches the scheduler and can be
+ * called from anywhere, including the scheduler itself.
+ */
+#define LOG_BINARY_POLL_US      (10000U)
+#endif
+
+/**
+ * @brief   Counts the arguments after the format string, up to 16
+ * @internal
+ */
+#define LOG_BINARY_NARGS(...) \
+    _LOG_BINARY_NARGS(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, \
+                      8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define _LOG_BINARY_NARGS(fmt, a1, a2, a3, a4, a5, a6, a7, a8, \
+                          a9, a10, a11, a12, a13, a14, a15, a16, n, ...) n
+
+/**
+ * @brief   Like LOG_BINARY_NARGS(), but fails to compile (negative array
+ *          size) for more than @ref LOG_BINARY_ARGS_MAX arguments
+ * @internal
+ */
+#define LOG_BINARY_NARGS_CHECKED(...) \
+    (LOG_BINARY_NARGS(__VA_ARGS__) + 0 * sizeof(char[ \
+        (LOG_BINARY_NARGS(__VA_ARGS__) <= LOG_BINARY_ARGS_MAX) ? 1 : -1]))
+
+/**
+ * @brief   Records a log message
+ *
+ * @param[in] level     log level of the message
+ * @param[in] nargs     number of arguments after @p format
+ * @param[in] format    format string, must be constant
+ */
+void log_binary_write(unsigned level, unsigned nargs, const char *format, ...);
+
+/**
+ * @brief   Starts the thread writing the records to stdout, called by
+ *          auto_init
+ */
+void log_binary_init(void);
+
+/**
+ * @brief log_write overridden function
+ */
+#define log_write(level, ...) \
+    log_binary_write(level, LOG_BINARY_NARGS_CHECKED(__VA_ARGS__), __VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+/**@}*/
+#endif /* __LOG_BINARY_H */
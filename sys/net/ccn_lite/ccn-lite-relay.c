@@ -38,11 +38,16 @@
 
 #include "ccnl-pdu.h"
 
+#include "event.h"
 #include "msg.h"
 #include "thread.h"
 #include "transceiver.h"
 #include "vtimer.h"
 
+#ifdef MODULE_CCN_LITE_NETAPI
+#include "net/ng_netbase.h"
+#endif
+
 #include "ccnl-riot-compat.h"
 #include "ccn_lite/test_data/text.txt.ccnb.h"
 
@@ -56,6 +61,12 @@
 /** message buffer */
 msg_t msg_buffer_relay[RELAY_MSG_BUFFER_SIZE];
 
+/** The maximum number of messages handled per wakeup of the relay */
+#define RELAY_MSG_BATCH_SIZE (8)
+
+/** Delay before the helper tries again while the relay holds its lock */
+#define RELAY_HELPER_RETRY_USEC (10 * 1000)
+
 struct ccnl_relay_s *theRelay = NULL;
 
 struct timeval *
@@ -100,6 +111,11 @@ int ccnl_open_riotmsgdev(void)
 
 int ccnl_open_riottransdev(void)
 {
+#ifdef MODULE_CCN_LITE_NETAPI
+    if (riot_netapi_init() < 0) {
+        return -1;
+    }
+#endif
     return RIOT_TRANS_DEV;
 }
 
@@ -176,7 +192,11 @@ void ccnl_relay_config(struct ccnl_relay_s *relay, int max_cache_entries,
 
     i = &relay->ifs[relay->ifcount];
     i->sock = ccnl_open_riottransdev();
+#ifdef MODULE_CCN_LITE_NETAPI
+    i->sendfunc = &riot_send_netapi;
+#else
     i->sendfunc = &riot_send_transceiver;
+#endif
 #ifdef USE_FRAG
     i->mtu = 120;
 #else
@@ -254,9 +274,9 @@ void ccnl_populate_cache(struct ccnl_relay_s *ccnl, unsigned char *buf, int data
 
     Done:
         free_prefix(prefix);
-        ccnl_free(pkt);
-        ccnl_free(nonce);
-        ccnl_free(ppkd);
+        ccnl_buf_release(pkt);
+        ccnl_buf_release(nonce);
+        ccnl_buf_release(ppkd);
     }
     else {
         DEBUGMSG(6, "  not a content object\n");
@@ -313,117 +333,181 @@ int ccnl_io_loop(struct ccnl_relay_s *ccnl)
     }
 
     msg_t in;
-#if MODULE_AT86RF231 || MODULE_CC2420 || MODULE_MC1322X
+#ifdef MODULE_CCN_LITE_NETAPI
+    ng_pktsnip_t *pkt;
+    int sender;
+#elif MODULE_AT86RF231 || MODULE_CC2420 || MODULE_MC1322X
     ieee802154_packet_t *p;
 #else
     radio_packet_t *p;
 #endif
     riot_ccnl_msg_t *m;
+    int batch;
 
     while (!ccnl->halt_flag) {
 
         msg_receive(&in);
 
+        /* take everything that queued up while we were busy in one go, so
+         * the lock is not bounced with the helper thread for every frame */
         mutex_lock(&ccnl->global_lock);
-        switch (in.type) {
-            case PKT_PENDING:
-                /* msg from transceiver */
+        batch = 0;
+        do {
+            switch (in.type) {
+#ifdef MODULE_CCN_LITE_NETAPI
+                case NG_NETAPI_MSG_TYPE_RCV:
+                    /* frame from the network interface, handed over in the
+                     * packet buffer */
+                    pkt = (ng_pktsnip_t *) in.content.ptr;
+                    DEBUGMSG(1, "\tLength:\t%u\n", (unsigned) pkt->size);
+
+                    sender = riot_netapi_sender(ccnl, pkt);
+                    if (sender >= 0) {
+                        ccnl_core_RX(ccnl, RIOT_TRANS_IDX, (unsigned char *) pkt->data,
+                                     (int) pkt->size, (uint16_t) sender);
+                    }
+                    ng_pktbuf_release(pkt);
+                    break;
+#else
+                case PKT_PENDING:
+                    /* msg from transceiver */
 #if MODULE_AT86RF231 || MODULE_CC2420 || MODULE_MC1322X
-                p = (ieee802154_packet_t*) in.content.ptr;
-                DEBUGMSG(1, "\tLength:\t%u\n", p->length);
-                DEBUGMSG(1, "\tSrc:\t%u\n",
-                         (p->frame.src_addr[0]) | (p->frame.src_addr[1] << 8));
-                DEBUGMSG(1, "\tDst:\t%u\n",
-                         (p->frame.dest_addr[0]) | (p->frame.dest_addr[1] << 8));
+                    p = (ieee802154_packet_t*) in.content.ptr;
+                    DEBUGMSG(1, "\tLength:\t%u\n", p->length);
+                    DEBUGMSG(1, "\tSrc:\t%u\n",
+                             (p->frame.src_addr[0]) | (p->frame.src_addr[1] << 8));
+                    DEBUGMSG(1, "\tDst:\t%u\n",
+                             (p->frame.dest_addr[0]) | (p->frame.dest_addr[1] << 8));
 #else
-                p = (radio_packet_t *) in.content.ptr;
-                DEBUGMSG(1, "\tLength:\t%u\n", p->length);
-                DEBUGMSG(1, "\tSrc:\t%u\n", p->src);
-                DEBUGMSG(1, "\tDst:\t%u\n", p->dst);
+                    p = (radio_packet_t *) in.content.ptr;
+                    DEBUGMSG(1, "\tLength:\t%u\n", p->length);
+                    DEBUGMSG(1, "\tSrc:\t%u\n", p->src);
+                    DEBUGMSG(1, "\tDst:\t%u\n", p->dst);
 #endif
 
-                /* p->src must be > 0 */
+                    /* p->src must be > 0 */
 #if MODULE_AT86RF231 || MODULE_CC2420 || MODULE_MC1322X
-                if ((!(p->frame.src_addr[0])) | (p->frame.src_addr[1] << 8)) {
-                    p->frame.src_addr[0] = RIOT_BROADCAST >> 8;
-                    p->frame.src_addr[1] = RIOT_BROADCAST && 0xFF;
-                }
+                    if ((!(p->frame.src_addr[0])) | (p->frame.src_addr[1] << 8)) {
+                        p->frame.src_addr[0] = RIOT_BROADCAST >> 8;
+                        p->frame.src_addr[1] = RIOT_BROADCAST && 0xFF;
+                    }
 #else
-                if (!p->src) {
-                    p->src = RIOT_BROADCAST;
-                }
+                    if (!p->src) {
+                        p->src = RIOT_BROADCAST;
+                    }
 #endif
 
 #if MODULE_AT86RF231 || MODULE_CC2420 || MODULE_MC1322X
-                ccnl_core_RX(ccnl, RIOT_TRANS_IDX,
-                             (unsigned char *) p->frame.payload,
-                             (int) p->frame.payload_len,
-                             *((uint16_t*) p->frame.src_addr));
+                    ccnl_core_RX(ccnl, RIOT_TRANS_IDX,
+                                 (unsigned char *) p->frame.payload,
+                                 (int) p->frame.payload_len,
+                                 *((uint16_t*) p->frame.src_addr));
 #else
-                ccnl_core_RX(ccnl, RIOT_TRANS_IDX,
-                             (unsigned char *) p->data,
-                             (int) p->length, p->src);
+                    ccnl_core_RX(ccnl, RIOT_TRANS_IDX,
+                                 (unsigned char *) p->data,
+                                 (int) p->length, p->src);
+#endif
+                    p->processing--;
+                    break;
 #endif
-                p->processing--;
-                break;
 
-            case (CCNL_RIOT_MSG):
-                /* msg from device local client */
-                m = (riot_ccnl_msg_t *) in.content.ptr;
-                DEBUGMSG(1, "\tLength:\t%u\n", m->size);
-                DEBUGMSG(1, "\tSrc:\t%u\n", in.sender_pid);
+                case (CCNL_RIOT_MSG):
+                    /* msg from device local client */
+                    m = (riot_ccnl_msg_t *) in.content.ptr;
+                    DEBUGMSG(1, "\tLength:\t%u\n", m->size);
+                    DEBUGMSG(1, "\tSrc:\t%u\n", in.sender_pid);
 
-                ccnl_core_RX(ccnl, RIOT_MSG_IDX, (unsigned char *) m->payload, m->size,
-                             in.sender_pid);
-                break;
+                    ccnl_core_RX(ccnl, RIOT_MSG_IDX, (unsigned char *) m->payload, m->size,
+                                 in.sender_pid);
+                    break;
 
-            case (CCNL_RIOT_HALT):
-                /* cmd to stop the relay */
-                DEBUGMSG(1, "\tSrc:\t%" PRIkernel_pid "\n", in.sender_pid);
-                DEBUGMSG(1, "\tNumb:\t%" PRIu32 "\n", in.content.value);
+                case (CCNL_RIOT_HALT):
+                    /* cmd to stop the relay */
+                    DEBUGMSG(1, "\tSrc:\t%" PRIkernel_pid "\n", in.sender_pid);
+                    DEBUGMSG(1, "\tNumb:\t%" PRIu32 "\n", in.content.value);
 
-                ccnl->halt_flag = 1;
-                break;
+                    ccnl->halt_flag = 1;
+                    break;
 
 #if RIOT_CCNL_POPULATE
-            case (CCNL_RIOT_POPULATE):
-                /* cmd to polulate the cache */
-                DEBUGMSG(1, "\tSrc:\t%" PRIkernel_pid "\n", in.sender_pid);
-                DEBUGMSG(1, "\tNumb:\t%" PRIu32 "\n", in.content.value);
+                case (CCNL_RIOT_POPULATE):
+                    /* cmd to polulate the cache */
+                    DEBUGMSG(1, "\tSrc:\t%" PRIkernel_pid "\n", in.sender_pid);
+                    DEBUGMSG(1, "\tNumb:\t%" PRIu32 "\n", in.content.value);
 
-                handle_populate_cache(ccnl);
-                break;
+                    handle_populate_cache(ccnl);
+                    break;
 #endif
 #if ENABLE_DEBUG
-            case (CCNL_RIOT_PRINT_STAT):
-                /* cmd to print face statistics */
-                for (struct ccnl_face_s *f = ccnl->faces; f; f = f->next) {
-                    ccnl_face_print_stat(f);
-                }
-                break;
+                case (CCNL_RIOT_PRINT_STAT):
+                    /* cmd to print face statistics */
+                    for (struct ccnl_face_s *f = ccnl->faces; f; f = f->next) {
+                        ccnl_face_print_stat(f);
+                    }
+                    break;
 #endif
-            case (CCNL_RIOT_CONFIG_CACHE):
-                /* cmd to configure the size of the cache at runtime */
-                ccnl->max_cache_entries = in.content.value;
-                DEBUGMSG(1, "max_cache_entries set to %d\n", ccnl->max_cache_entries);
-                break;
-            case (ENOBUFFER):
-                /* transceiver has not enough buffer to store incoming packets,
-                 * one packet is dropped */
-                DEBUGMSG(1, "transceiver: one packet is dropped because buffers are full\n");
-                break;
-            default:
-                DEBUGMSG(1, "%s Packet waiting\n", riot_ccnl_event_to_string(in.type));
-                DEBUGMSG(1, "\tSrc:\t%" PRIkernel_pid "\n", in.sender_pid);
-                DEBUGMSG(1, "\tdropping it...\n");
-                break;
-        }
+                case (CCNL_RIOT_CONFIG_CACHE):
+                    /* cmd to configure the size of the cache at runtime */
+                    ccnl->max_cache_entries = in.content.value;
+                    DEBUGMSG(1, "max_cache_entries set to %d\n", ccnl->max_cache_entries);
+                    break;
+#ifndef MODULE_CCN_LITE_NETAPI
+                case (ENOBUFFER):
+                    /* transceiver has not enough buffer to store incoming packets,
+                     * one packet is dropped */
+                    DEBUGMSG(1, "transceiver: one packet is dropped because buffers are full\n");
+                    break;
+#endif
+                default:
+                    DEBUGMSG(1, "%s Packet waiting\n", riot_ccnl_event_to_string(in.type));
+                    DEBUGMSG(1, "\tSrc:\t%" PRIkernel_pid "\n", in.sender_pid);
+                    DEBUGMSG(1, "\tdropping it...\n");
+                    break;
+            }
+        } while (!ccnl->halt_flag && (++batch < RELAY_MSG_BATCH_SIZE)
+                 && (msg_try_receive(&in) > 0));
         mutex_unlock(&ccnl->global_lock);
     }
 
     return 0;
 }
 
+static void ccnl_riot_relay_helper(void *arg);
+
+static event_t relay_helper_event = { .handler = ccnl_riot_relay_helper };
+static event_timeout_t relay_helper_timeout;
+
+/* run by the event thread every CCNL_CHECK_RETRANSMIT_USEC until the relay
+ * halts, stop_lock is held in between. The event thread is shared, so the
+ * helper does not wait for global_lock but tries again a bit later */
+static void ccnl_riot_relay_helper(void *arg)
+{
+    (void) arg;
+
+    if (theRelay->halt_flag) {
+        mutex_unlock(&theRelay->stop_lock);
+        return;
+    }
+
+    if (!mutex_trylock(&theRelay->global_lock)) {
+        event_timeout_set(&relay_helper_timeout, &relay_helper_event,
+                          timex_from_uint64(RELAY_HELPER_RETRY_USEC));
+        return;
+    }
+    ccnl_run_events();
+    mutex_unlock(&theRelay->global_lock);
+
+    event_timeout_set(&relay_helper_timeout, &relay_helper_event,
+                      timex_from_uint64(CCNL_CHECK_RETRANSMIT_USEC));
+}
+
+static kernel_pid_t ccnl_riot_relay_helper_start(void)
+{
+    mutex_lock(&theRelay->stop_lock);
+    event_post(&relay_helper_event);
+    return event_pid;
+}
+
 /**
  * @brief initializing routing system
  * @param pointer to count transceiver pids
@@ -450,7 +534,7 @@ void *ccnl_riot_relay_start(void *arg)
                       CCNL_DEFAULT_THRESHOLD_PREFIX,
                       CCNL_DEFAULT_THRESHOLD_AGGREGATE);
 
-    theRelay->riot_helper_pid = riot_start_helper_thread();
+    theRelay->riot_helper_pid = ccnl_riot_relay_helper_start();
 
     ccnl_io_loop(theRelay);
     DEBUGMSG(1, "ioloop stopped\n");
@@ -466,19 +550,3 @@ void *ccnl_riot_relay_start(void *arg)
     return NULL;
 }
 
-void *ccnl_riot_relay_helper_start(void *arg)
-{
-    (void) arg;
-    unsigned long us = CCNL_CHECK_RETRANSMIT_USEC;
-    mutex_lock(&theRelay->stop_lock);
-    while (!theRelay->halt_flag) {
-        mutex_lock(&theRelay->global_lock);
-        ccnl_run_events();
-        mutex_unlock(&theRelay->global_lock);
-
-        vtimer_usleep(us);
-    }
-
-    mutex_unlock(&theRelay->stop_lock);
-    return NULL;
-}
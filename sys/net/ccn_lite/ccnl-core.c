@@ -76,7 +76,8 @@ void free_prefix(struct ccnl_prefix_s *p)
 void free_content(struct ccnl_content_s *c)
 {
     free_prefix(c->name);
-    free_2ptr_list(c->pkt, c);
+    ccnl_buf_release(c->pkt);
+    ccnl_free(c);
 }
 
 void free_forward(struct ccnl_forward_s *fwd)
@@ -98,6 +99,7 @@ ccnl_buf_new(void *data, int len)
     }
 
     b->next = NULL;
+    b->refcnt = 1;
     b->datalen = len;
 
     if (data) {
@@ -107,6 +109,25 @@ ccnl_buf_new(void *data, int len)
     return b;
 }
 
+// buffers are immutable once they are shared: instead of copying a packet
+// for every face it is sent on, each queue takes a reference
+struct ccnl_buf_s *
+ccnl_buf_hold(struct ccnl_buf_s *buf)
+{
+    if (buf) {
+        buf->refcnt++;
+    }
+
+    return buf;
+}
+
+void ccnl_buf_release(struct ccnl_buf_s *buf)
+{
+    if (buf && (--buf->refcnt == 0)) {
+        ccnl_free(buf);
+    }
+}
+
 struct ccnl_buf_s *buf_dup(struct ccnl_buf_s *B)
 {
     return (B) ? ccnl_buf_new(B->data, B->datalen) : NULL;
@@ -214,7 +235,7 @@ struct ccnl_nonce_s *ccnl_nonce_new(struct ccnl_buf_s *that)
 {
     struct ccnl_nonce_s *n = (struct ccnl_nonce_s *) ccnl_malloc(sizeof(struct ccnl_nonce_s));
 
-    n->buf = buf_dup(that);
+    n->buf = ccnl_buf_hold(that);
     ccnl_get_timeval(&n->created);
 
     n->next = NULL;
@@ -231,8 +252,8 @@ struct ccnl_nonce_s *ccnl_nonce_remove(struct ccnl_relay_s *ccnl, struct ccnl_no
     struct ccnl_nonce_s *next = nonce->next;
     DBL_LINKED_LIST_REMOVE(ccnl->nonces, nonce);
 
-    free(nonce->buf);
-    free(nonce);
+    ccnl_buf_release(nonce->buf);
+    ccnl_free(nonce);
 
     return next;
 }
@@ -525,10 +546,10 @@ ccnl_face_remove(struct ccnl_relay_s *ccnl, struct ccnl_face_s *f)
         }
     }
 
-    while (f->outq) {
-        struct ccnl_buf_s *tmp = f->outq->next;
-        ccnl_free(f->outq);
-        f->outq = tmp;
+    while (f->outqlen > 0) {
+        ccnl_buf_release(f->outq[f->outqfront]);
+        f->outqfront = (f->outqfront + 1) % CCNL_MAX_FACE_QLEN;
+        f->outqlen--;
     }
 
 #if ENABLE_DEBUG
@@ -556,6 +577,8 @@ void ccnl_face_print_stat(struct ccnl_face_s *f)
     DEBUGMSG(1, "  STAT interest received=%d\n", f->stat.received_interest);
 
     DEBUGMSG(1, "  STAT content  received=%d\n", f->stat.received_content);
+
+    DEBUGMSG(1, "  STAT dropped (queue full)=%d\n", f->stat.dropped_qfull);
 }
 #endif
 
@@ -569,7 +592,7 @@ void ccnl_interface_cleanup(struct ccnl_if_s *i)
     for (j = 0; j < i->qlen; j++) {
         struct ccnl_txrequest_s *r = i->queue
                                      + (i->qfront + j) % CCNL_MAX_IF_QLEN;
-        ccnl_free(r->buf);
+        ccnl_buf_release(r->buf);
     }
 }
 
@@ -594,7 +617,7 @@ void ccnl_interface_CTS(void *aux1, void *aux2)
     ifc->qlen--;
 
     ccnl_ll_TX(ccnl, ifc, &req.dst, req.buf);
-    ccnl_free(req.buf);
+    ccnl_buf_release(req.buf);
 }
 
 void ccnl_interface_enqueue(void (tx_done)(void *, int, int),
@@ -607,7 +630,7 @@ void ccnl_interface_enqueue(void (tx_done)(void *, int, int),
 
     if (ifc->qlen >= CCNL_MAX_IF_QLEN) {
         DEBUGMSG(2, "  DROPPING buf=%p\n", (void *) buf);
-        ccnl_free(buf);
+        ccnl_buf_release(buf);
         return;
     }
 
@@ -630,18 +653,14 @@ ccnl_face_dequeue(struct ccnl_relay_s *ccnl, struct ccnl_face_s *f)
     DEBUGMSG(20, "ccnl_face_dequeue face=%p (id=%d.%d)\n", (void *) f, ccnl->id,
              f->faceid);
 
-    if (!f->outq) {
+    if (f->outqlen <= 0) {
         return NULL;
     }
 
-    pkt = f->outq;
-    f->outq = pkt->next;
+    pkt = f->outq[f->outqfront];
+    f->outqfront = (f->outqfront + 1) % CCNL_MAX_FACE_QLEN;
+    f->outqlen--;
 
-    if (!pkt->next) {
-        f->outqend = NULL;
-    }
-
-    pkt->next = NULL;
     return pkt;
 }
 
@@ -690,27 +709,29 @@ void ccnl_face_CTS(struct ccnl_relay_s *ccnl, struct ccnl_face_s *f)
 int ccnl_face_enqueue(struct ccnl_relay_s *ccnl, struct ccnl_face_s *to,
                       struct ccnl_buf_s *buf)
 {
-    struct ccnl_buf_s *msg;
+    int j;
     DEBUGMSG(20, "ccnl_face_enqueue face=%p (id=%d.%d) buf=%p len=%d\n",
              (void *) to, ccnl->id, to->faceid, (void *) buf, buf->datalen);
 
-    for (msg = to->outq; msg; msg = msg->next) // already in the queue?
-        if (buf_equal(msg, buf)) {
+    for (j = 0; j < to->outqlen; j++) { // already in the queue?
+        struct ccnl_buf_s *msg = to->outq[(to->outqfront + j) % CCNL_MAX_FACE_QLEN];
+
+        if (msg == buf || buf_equal(msg, buf)) {
             DEBUGMSG(31, "    not enqueued because already there\n");
-            ccnl_free(buf);
+            ccnl_buf_release(buf);
             return -1;
         }
-
-    buf->next = NULL;
-
-    if (to->outqend) {
-        to->outqend->next = buf;
     }
-    else {
-        to->outq = buf;
+
+    if (to->outqlen >= CCNL_MAX_FACE_QLEN) {
+        DEBUGMSG(2, "  face queue full, DROPPING buf=%p\n", (void *) buf);
+        to->stat.dropped_qfull++;
+        ccnl_buf_release(buf);
+        return -1;
     }
 
-    to->outqend = buf;
+    to->outq[(to->outqfront + to->outqlen) % CCNL_MAX_FACE_QLEN] = buf;
+    to->outqlen++;
     ccnl_face_CTS(ccnl, to);
     return 0;
 }
@@ -846,7 +867,7 @@ void ccnl_interest_propagate(struct ccnl_relay_s *ccnl,
             i->forwarded_over = fwd;
             fwd->face->stat.send_interest[i->retries]++;
             ccnl_get_timeval(&i->last_used);
-            ccnl_face_enqueue(ccnl, fwd->face, buf_dup(i->pkt));
+            ccnl_face_enqueue(ccnl, fwd->face, ccnl_buf_hold(i->pkt));
             ccnl_get_timeval(&fwd->last_used);
             forward_cnt++;
         }
@@ -856,7 +877,7 @@ void ccnl_interest_propagate(struct ccnl_relay_s *ccnl,
         DEBUGMSG(40, "  ccnl_interest_propagate: using broadcast face!\n");
         ccnl->ifs[RIOT_TRANS_IDX].broadcast_face->stat.send_interest[i->retries]++;
         ccnl_get_timeval(&i->last_used);
-        ccnl_face_enqueue(ccnl, ccnl->ifs[RIOT_TRANS_IDX].broadcast_face, buf_dup(i->pkt));
+        ccnl_face_enqueue(ccnl, ccnl->ifs[RIOT_TRANS_IDX].broadcast_face, ccnl_buf_hold(i->pkt));
     }
 
     return;
@@ -877,7 +898,9 @@ ccnl_interest_remove(struct ccnl_relay_s *ccnl, struct ccnl_interest_s *i)
     i2 = i->next;
     DBL_LINKED_LIST_REMOVE(ccnl->pit, i);
     free_prefix(i->prefix);
-    free_3ptr_list(i->ppkd, i->pkt, i);
+    ccnl_buf_release(i->ppkd);
+    ccnl_buf_release(i->pkt);
+    ccnl_free(i);
     return i2;
 }
 
@@ -947,6 +970,66 @@ ccnl_content_new(struct ccnl_relay_s *ccnl, struct ccnl_buf_s **pkt,
     return c;
 }
 
+// the LRU list only holds dynamic content of the content store, the most
+// recently used entry at its head, so eviction never has to search
+static int ccnl_content_lru_linked(struct ccnl_relay_s *ccnl,
+                                   struct ccnl_content_s *c)
+{
+    return c->lru_prev || ccnl->lru_head == c;
+}
+
+static void ccnl_content_lru_unlink(struct ccnl_relay_s *ccnl,
+                                    struct ccnl_content_s *c)
+{
+    if (!ccnl_content_lru_linked(ccnl, c)) {
+        return;
+    }
+
+    if (c->lru_prev) {
+        c->lru_prev->lru_next = c->lru_next;
+    }
+    else {
+        ccnl->lru_head = c->lru_next;
+    }
+
+    if (c->lru_next) {
+        c->lru_next->lru_prev = c->lru_prev;
+    }
+    else {
+        ccnl->lru_tail = c->lru_prev;
+    }
+
+    c->lru_next = c->lru_prev = NULL;
+}
+
+static void ccnl_content_lru_push(struct ccnl_relay_s *ccnl,
+                                  struct ccnl_content_s *c)
+{
+    c->lru_prev = NULL;
+    c->lru_next = ccnl->lru_head;
+
+    if (ccnl->lru_head) {
+        ccnl->lru_head->lru_prev = c;
+    }
+    else {
+        ccnl->lru_tail = c;
+    }
+
+    ccnl->lru_head = c;
+}
+
+// mark content as used, cached content becomes the most recently used
+static void ccnl_content_touch(struct ccnl_relay_s *ccnl,
+                               struct ccnl_content_s *c)
+{
+    ccnl_get_timeval(&c->last_used);
+
+    if (ccnl_content_lru_linked(ccnl, c) && ccnl->lru_head != c) {
+        ccnl_content_lru_unlink(ccnl, c);
+        ccnl_content_lru_push(ccnl, c);
+    }
+}
+
 struct ccnl_content_s *
 ccnl_content_remove(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
 {
@@ -954,6 +1037,7 @@ ccnl_content_remove(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
     DEBUGMSG(99, "ccnl_content_remove: %s\n", ccnl_prefix_to_path(c->name));
 
     c2 = c->next;
+    ccnl_content_lru_unlink(ccnl, c);
     DBL_LINKED_LIST_REMOVE(ccnl->contents, c);
     free_content(c);
     ccnl->contentcnt--;
@@ -973,15 +1057,7 @@ ccnl_content_add2cache(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
 
     while (ccnl->max_cache_entries <= ccnl->contentcnt) {
         DEBUGMSG(1, "  remove Least Recently Used content...\n");
-        struct ccnl_content_s *c2, *lru = NULL;
-
-        for (c2 = ccnl->contents; c2; c2 = c2->next) {
-            DEBUGMSG(1, "    '%s' -> %ld:%ld\n", ccnl_prefix_to_path(c2->name), c2->last_used.tv_sec, c2->last_used.tv_usec);
-            if (!(c2->flags & CCNL_CONTENT_FLAGS_STATIC)
-                && ((!lru) || timevaldelta(&c2->last_used, &lru->last_used) < 0)) {
-                lru = c2;
-            }
-        }
+        struct ccnl_content_s *lru = ccnl->lru_tail;
 
         if (lru) {
             DEBUGMSG(1, "   replaced: '%s'\n", ccnl_prefix_to_path(lru->name));
@@ -995,6 +1071,11 @@ ccnl_content_add2cache(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
 
     DEBUGMSG(1, "  add new content to store: '%s'\n", ccnl_prefix_to_path(c->name));
     DBL_LINKED_LIST_ADD(ccnl->contents, c);
+
+    if (!(c->flags & CCNL_CONTENT_FLAGS_STATIC)) {
+        ccnl_content_lru_push(ccnl, c);
+    }
+
     ccnl->contentcnt++;
     return c;
 }
@@ -1043,10 +1124,10 @@ int ccnl_content_serve_pending(struct ccnl_relay_s *ccnl,
             DEBUGMSG(6, "  forwarding content <%s>\n",
                      ccnl_prefix_to_path(c->name));
             pi->face->stat.send_content[c->served_cnt % CCNL_MAX_CONTENT_SERVED_STAT]++;
-            ccnl_face_enqueue(ccnl, pi->face, buf_dup(c->pkt));
+            ccnl_face_enqueue(ccnl, pi->face, ccnl_buf_hold(c->pkt));
 
             c->served_cnt++;
-            ccnl_get_timeval(&c->last_used);
+            ccnl_content_touch(ccnl, c);
             cnt++;
         }
 
@@ -1349,9 +1430,10 @@ int ccnl_core_RX_i_or_c(struct ccnl_relay_s *relay, struct ccnl_face_s *from,
                          (void *) c);
                 from->stat.send_content[c->served_cnt % CCNL_MAX_CONTENT_SERVED_STAT]++;
                 c->served_cnt++;
+                ccnl_content_touch(relay, c);
 
                 if (from->ifndx >= 0) {
-                    ccnl_face_enqueue(relay, from, buf_dup(c->pkt));
+                    ccnl_face_enqueue(relay, from, ccnl_buf_hold(c->pkt));
                 }
 
                 goto Skip;
@@ -1432,7 +1514,9 @@ Skip:
     rc = 0;
 Done:
     free_prefix(p);
-    free_3ptr_list(buf, nonce, ppkd);
+    ccnl_buf_release(buf);
+    ccnl_buf_release(nonce);
+    ccnl_buf_release(ppkd);
     DEBUGMSG(1, "leaving\n");
     return rc;
 }
@@ -93,6 +93,7 @@ struct ccnl_relay_s {
     struct ccnl_forward_s *fib;
     struct ccnl_interest_s *pit;
     struct ccnl_content_s *contents; //, *contentsend;
+    struct ccnl_content_s *lru_head, *lru_tail; // cached dynamic content, least recently used at the tail
     struct ccnl_nonce_s *nonces;
     int contentcnt;     // number of cached items
     int max_cache_entries;  // -1: unlimited
@@ -116,6 +117,7 @@ struct ccnl_relay_s {
 
 struct ccnl_buf_s {
     struct ccnl_buf_s *next;
+    unsigned int refcnt; // see ccnl_buf_hold() and ccnl_buf_release()
     unsigned int datalen;
     unsigned char data[1];
 };
@@ -138,6 +140,7 @@ struct ccnl_stat_s {
     int send_content[CCNL_MAX_CONTENT_SERVED_STAT];
     int received_interest;
     int received_content;
+    int dropped_qfull; // packets dropped on a full output queue
 };
 
 struct ccnl_frag_s {
@@ -167,7 +170,8 @@ struct ccnl_face_s {
     sockunion peer;
     int flags;
     struct timeval last_used; // updated when we receive a packet
-    struct ccnl_buf_s *outq, *outqend; // queue of packets to send
+    struct ccnl_buf_s *outq[CCNL_MAX_FACE_QLEN]; // queue of packets to send
+    int outqfront, outqlen;
     struct ccnl_frag_s *frag;  // which special datagram armoring
     struct ccnl_sched_s *sched;
 
@@ -203,6 +207,7 @@ struct ccnl_pendint_s { // pending interest
 
 struct ccnl_content_s {
     struct ccnl_content_s *next, *prev;
+    struct ccnl_content_s *lru_next, *lru_prev; // position in the relay's LRU list
     struct ccnl_prefix_s *name;
     struct ccnl_buf_s *ppkd; // publisher public key digest
     struct ccnl_buf_s *pkt; // full datagram
@@ -246,6 +251,11 @@ void ccnl_core_cleanup(struct ccnl_relay_s *ccnl);
 struct ccnl_buf_s *
 ccnl_buf_new(void *data, int len);
 
+struct ccnl_buf_s *
+ccnl_buf_hold(struct ccnl_buf_s *buf);
+
+void ccnl_buf_release(struct ccnl_buf_s *buf);
+
 struct ccnl_content_s *
 ccnl_content_new(struct ccnl_relay_s *ccnl, struct ccnl_buf_s **pkt,
                  struct ccnl_prefix_s **prefix, struct ccnl_buf_s **ppkd,
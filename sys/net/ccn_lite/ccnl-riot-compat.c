@@ -24,13 +24,175 @@
 #include "msg.h"
 #include "thread.h"
 
+#ifdef MODULE_CCN_LITE_NETAPI
+#include "net/ng_netbase.h"
+#else
 #include "ieee802154_frame.h"
+#endif
 
+#include "ccnl-includes.h"
 #include "ccnl.h"
 #include "ccnl-core.h"
 #include "ccnl-pdu.h"
 #include "ccnl-riot-compat.h"
 
+#ifdef MODULE_CCN_LITE_NETAPI
+static kernel_pid_t netapi_if = KERNEL_PID_UNDEF;
+static ng_netreg_entry_t netapi_reg;
+
+int riot_netapi_init(void)
+{
+    kernel_pid_t ifs[NG_NETIF_NUMOF];
+    ng_nettype_t proto = NG_NETTYPE_CCN;
+
+    if (ng_netif_get(ifs) == 0) {
+        DEBUGMSG(1, "no network interface to bind to\n");
+        return -1;
+    }
+
+    /* received frames are tagged as CCN by the driver and dispatched to the
+     * relay directly, without passing another thread */
+    netapi_if = ifs[0];
+    ng_netapi_set(netapi_if, NETCONF_OPT_PROTO, 0, &proto, sizeof(proto));
+
+    netapi_reg.next = NULL;
+    netapi_reg.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
+    netapi_reg.pid = thread_getpid();
+    ng_netreg_register(NG_NETTYPE_CCN, &netapi_reg);
+
+    return 0;
+}
+
+/* faces are identified by 16 bit ids: two byte addresses are their own
+ * id, longer addresses get one of the ids at the top of the id space */
+static netapi_peer_t netapi_peers[RIOT_NETAPI_PEERS_NUMOF];
+
+#define PEER_ID(i)      ((uint16_t)(RIOT_NETAPI_PEER_ID_FIRST + (i)))
+
+static netapi_peer_t *netapi_peer_get(uint16_t id)
+{
+    unsigned i = (uint16_t)(id - RIOT_NETAPI_PEER_ID_FIRST);
+
+    if ((i < RIOT_NETAPI_PEERS_NUMOF) && (netapi_peers[i].addr_len > 0)) {
+        return &netapi_peers[i];
+    }
+    return NULL;
+}
+
+/* an id is in use as long as a face on the interface carries it */
+static int netapi_peer_used(struct ccnl_relay_s *relay, unsigned i)
+{
+    struct ccnl_face_s *f;
+
+    if (netapi_peers[i].addr_len == 0) {
+        return 0;
+    }
+    for (f = relay->faces; f; f = f->next) {
+        if ((f->ifndx == RIOT_TRANS_IDX) && (f->faceid == PEER_ID(i))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int riot_send_netapi(uint8_t *buf, uint16_t size, uint16_t to)
+{
+    ng_pktsnip_t *pkt, *hdr;
+    netapi_peer_t *peer;
+    uint8_t short_addr[2];
+
+    DEBUGMSG(1, "this is a RIOT NETAPI based connection\n");
+    DEBUGMSG(1, "size=%" PRIu16 " to=%" PRIu16 "\n", size, to);
+
+    /* the only copy of the frame: the driver sends it from the packet buffer */
+    pkt = ng_pktbuf_add(NULL, buf, size, NG_NETTYPE_CCN);
+    if (!pkt) {
+        DEBUGMSG(1, "  packet buffer full...dropping frame!\n");
+        return 0;
+    }
+
+    if (to == RIOT_BROADCAST) {
+        hdr = ng_netif_hdr_build(NULL, 0, NULL, 0);
+    }
+    else if ((peer = netapi_peer_get(to)) != NULL) {
+        hdr = ng_netif_hdr_build(NULL, 0, peer->addr, peer->addr_len);
+    }
+    else {
+        short_addr[0] = (uint8_t)(to >> 8);
+        short_addr[1] = (uint8_t)(to & 0xff);
+        hdr = ng_netif_hdr_build(NULL, 0, short_addr, sizeof(short_addr));
+    }
+
+    if (!hdr) {
+        DEBUGMSG(1, "  packet buffer full...dropping frame!\n");
+        ng_pktbuf_release(pkt);
+        return 0;
+    }
+
+    if (to == RIOT_BROADCAST) {
+        ((ng_netif_hdr_t *)hdr->data)->flags |= NG_NETIF_HDR_FLAGS_BROADCAST;
+    }
+
+    hdr->next = pkt;
+
+    if (ng_netapi_send(netapi_if, hdr) < 1) {
+        DEBUGMSG(1, "  interface queue full...dropping frame!\n");
+        ng_pktbuf_release(hdr);
+        return 0;
+    }
+
+    return size;
+}
+
+int riot_netapi_sender(struct ccnl_relay_s *relay, ng_pktsnip_t *pkt)
+{
+    ng_netif_hdr_t *netif;
+    uint8_t *src;
+    int free = -1;
+
+    for (; pkt; pkt = pkt->next) {
+        if (pkt->type == NG_NETTYPE_NETIF) {
+            break;
+        }
+    }
+
+    if (!pkt) {
+        return RIOT_BROADCAST;
+    }
+
+    netif = (ng_netif_hdr_t *)pkt->data;
+    src = ng_netif_hdr_get_src_addr(netif);
+
+    if ((netif->src_l2addr_len == 0) ||
+        (netif->src_l2addr_len > NG_NETIF_HDR_L2ADDR_MAX_LEN)) {
+        return RIOT_BROADCAST;
+    }
+
+    if (netif->src_l2addr_len == 2) {
+        return (src[0] << 8) | src[1];
+    }
+
+    for (unsigned i = 0; i < RIOT_NETAPI_PEERS_NUMOF; i++) {
+        if ((netapi_peers[i].addr_len == netif->src_l2addr_len) &&
+            (memcmp(netapi_peers[i].addr, src, netif->src_l2addr_len) == 0)) {
+            return PEER_ID(i);
+        }
+        if ((free < 0) && !netapi_peer_used(relay, i)) {
+            free = i;
+        }
+    }
+
+    if (free < 0) {
+        DEBUGMSG(1, "  no face id left for long address...dropping frame!\n");
+        return -1;
+    }
+
+    memcpy(netapi_peers[free].addr, src, netif->src_l2addr_len);
+    netapi_peers[free].addr_len = netif->src_l2addr_len;
+
+    return PEER_ID(free);
+}
+#else
 #if defined (MODULE_AT86RF231) || defined(MODULE_CC2420) || defined(MODULE_MC1322X)
 ieee802154_packet_t p;
 #else
@@ -40,8 +202,6 @@ radio_packet_t p;
 transceiver_command_t tcmd;
 msg_t mesg, rep;
 
-char relay_helper_stack[THREAD_STACKSIZE_MAIN];
-
 int riot_send_transceiver(uint8_t *buf, uint16_t size, uint16_t to)
 {
     DEBUGMSG(1, "this is a RIOT TRANSCEIVER based connection\n");
@@ -77,6 +237,7 @@ int riot_send_transceiver(uint8_t *buf, uint16_t size, uint16_t to)
 
     return size;
 }
+#endif
 
 int riot_send_msg(uint8_t *buf, uint16_t size, uint16_t to)
 {
@@ -112,20 +273,16 @@ void riot_send_nack(uint16_t to)
     msg_try_send(&m, to);
 }
 
-void *ccnl_riot_relay_helper_start(void *);
-
-kernel_pid_t riot_start_helper_thread(void)
-{
-    return thread_create(relay_helper_stack, sizeof(relay_helper_stack),
-                         THREAD_PRIORITY_MAIN - 2, CREATE_STACKTEST,
-                         ccnl_riot_relay_helper_start, NULL, "relay-helper");
-}
-
 char *riot_ccnl_event_to_string(int event)
 {
     switch (event) {
+#ifdef MODULE_CCN_LITE_NETAPI
+        case NG_NETAPI_MSG_TYPE_RCV:
+            return "NETAPI_RCV";
+#else
         case PKT_PENDING:
             return "PKT_PENDING";
+#endif
 
         case CCNL_RIOT_MSG:
             return "RIOT_MSG";
@@ -139,8 +296,10 @@ char *riot_ccnl_event_to_string(int event)
         case CCNL_RIOT_PRINT_STAT:
             return "CCNL_RIOT_PRINT_STAT";
 
+#ifndef MODULE_CCN_LITE_NETAPI
         case ENOBUFFER:
             return "ENOBUFFER";
+#endif
 
         default:
             return "UNKNOWN";
@@ -18,23 +18,56 @@
 
 #include "ccn_lite/ccnl-riot.h"
 
+#ifdef MODULE_CCN_LITE_NETAPI
+#include "net/ng_netif/hdr.h"
+#include "net/ng_pkt.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define RIOT_CCN_EVENT_NUMBER_OFFSET (1 << 8)
 
+#ifdef MODULE_CCN_LITE_NETAPI
+#define RIOT_BROADCAST (0xffff)
+#else
 #define RIOT_BROADCAST TRANSCEIVER_BROADCAST
+#endif
 
 typedef struct riot_ccnl_msg {
     void *payload;
     uint16_t size;
 } riot_ccnl_msg_t;
 
+#ifdef MODULE_CCN_LITE_NETAPI
+#ifndef RIOT_NETAPI_PEERS_NUMOF
+/* number of peers with link-layer addresses other than two bytes */
+#define RIOT_NETAPI_PEERS_NUMOF     (16)
+#endif
+
+/* face ids of these peers, two byte addresses in this range can not be
+ * told apart from them */
+#define RIOT_NETAPI_PEER_ID_FIRST   (RIOT_BROADCAST - RIOT_NETAPI_PEERS_NUMOF)
+
+/* full link-layer address behind a face id */
+typedef struct {
+    uint8_t addr[NG_NETIF_HDR_L2ADDR_MAX_LEN];
+    uint8_t addr_len;           /* 0 if the entry is free */
+} netapi_peer_t;
+
+struct ccnl_relay_s;
+
+/* binds the relay thread to the first ng_netif interface */
+int riot_netapi_init(void);
+int riot_send_netapi(uint8_t *buf, uint16_t size, uint16_t to);
+/* face id of the sender of a received frame, -1 if there is no id left */
+int riot_netapi_sender(struct ccnl_relay_s *relay, ng_pktsnip_t *pkt);
+#else
 int riot_send_transceiver(uint8_t *buf, uint16_t size, uint16_t to);
+#endif
 int riot_send_msg(uint8_t *buf, uint16_t size, uint16_t to);
 void riot_send_nack(uint16_t to);
-kernel_pid_t riot_start_helper_thread(void);
 char *riot_ccnl_event_to_string(int event);
 
 #ifdef __cplusplus
@@ -55,6 +55,12 @@ extern "C" {
 
 #define CCNL_MAX_NAME_COMP              16
 #define CCNL_MAX_IF_QLEN                64
+/* packets waiting for a face to become clear-to-send, further packets
+ * are dropped and counted in ccnl_stat_s::dropped_qfull (the queue used to
+ * be unbounded) */
+#ifndef CCNL_MAX_FACE_QLEN
+#define CCNL_MAX_FACE_QLEN              8
+#endif
 
 #define CCNL_MAX_NONCES                 256 // for detected dups
 
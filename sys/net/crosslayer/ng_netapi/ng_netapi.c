@@ -18,9 +18,143 @@
  * @}
  */
 
+#include <errno.h>
+#include <stdbool.h>
+
 #include "kernel.h"
 #include "msg.h"
+#include "thread.h"
 #include "net/ng_netapi.h"
+#include "net/ng_netstats.h"
+#include "net/ng_pktbuf.h"
+
+#ifdef MODULE_NG_NETAPI_DIRECT
+#if NG_NETAPI_DIRECT_NUMOF > 16
+#error "NG_NETAPI_DIRECT_NUMOF must fit into NG_NETAPI_MSG_TYPE_DIRECT"
+#endif
+
+/**
+ * @brief   A module running without a thread
+ */
+typedef struct {
+    ng_netapi_handler_t handler;    /**< handles the messages to the module */
+    void *ctx;                      /**< context of the handler */
+    kernel_pid_t pid;               /**< PID from thread_reserve_pid() */
+} _direct_t;
+
+#define _DIRECT_MASK        (0xffc0)
+#define _DIRECT_IDX(type)   (((type) >> 2) & 0x0f)
+#define _DIRECT_CMD(type)   (NG_NETAPI_MSG_TYPE_RCV + ((type) & 0x03))
+
+kernel_pid_t ng_netapi_direct_pid = KERNEL_PID_UNDEF;
+
+static _direct_t _direct[NG_NETAPI_DIRECT_NUMOF];
+static unsigned _direct_numof;
+static _direct_t _runner;
+
+static int _direct_idx(kernel_pid_t pid)
+{
+    if (pid_is_valid(pid)) {
+        return -1;
+    }
+    for (unsigned i = 0; i < _direct_numof; i++) {
+        if (_direct[i].pid == pid) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* gets the handler to call for @p pid in the current thread, NULL if the
+ * message has to be sent */
+static _direct_t *_local(kernel_pid_t pid)
+{
+    int i = _direct_idx(pid);
+
+    if ((ng_netapi_direct_pid != KERNEL_PID_UNDEF) &&
+        (thread_getpid() != ng_netapi_direct_pid)) {
+        return NULL;
+    }
+    if (i >= 0) {
+        return &_direct[i];
+    }
+    if ((pid == ng_netapi_direct_pid) && (_runner.handler != NULL)) {
+        return &_runner;
+    }
+    return NULL;
+}
+
+kernel_pid_t ng_netapi_direct_register(ng_netapi_handler_t handler, void *ctx)
+{
+    kernel_pid_t pid;
+
+    if (_direct_numof >= NG_NETAPI_DIRECT_NUMOF) {
+        return KERNEL_PID_UNDEF;
+    }
+    pid = thread_reserve_pid();
+    if (pid == KERNEL_PID_UNDEF) {
+        return KERNEL_PID_UNDEF;
+    }
+    _direct[_direct_numof].handler = handler;
+    _direct[_direct_numof].ctx = ctx;
+    _direct[_direct_numof].pid = pid;
+    _direct_numof++;
+    return pid;
+}
+
+void ng_netapi_direct_run(ng_netapi_handler_t handler, void *ctx)
+{
+    if (ng_netapi_direct_pid == KERNEL_PID_UNDEF) {
+        _runner.handler = handler;
+        _runner.ctx = ctx;
+        ng_netapi_direct_pid = thread_getpid();
+    }
+}
+
+int ng_netapi_direct_dispatch(msg_t *msg)
+{
+    if ((msg->type & _DIRECT_MASK) == NG_NETAPI_MSG_TYPE_DIRECT) {
+        unsigned i = _DIRECT_IDX(msg->type);
+        msg_t cmd = *msg;
+        msg_t ack;
+
+        if (i >= _direct_numof) {
+            return 0;
+        }
+        cmd.type = _DIRECT_CMD(msg->type);
+        ack.type = NG_NETAPI_MSG_TYPE_ACK;
+        ack.content.value = (uint32_t)_direct[i].handler(_direct[i].ctx, &cmd);
+        if ((cmd.type == NG_NETAPI_MSG_TYPE_GET) ||
+            (cmd.type == NG_NETAPI_MSG_TYPE_SET)) {
+            msg_reply(msg, &ack);
+        }
+        return 1;
+    }
+    /* timer messages and the like are known by their owner only */
+    for (unsigned i = 0; i < _direct_numof; i++) {
+        if (_direct[i].handler(_direct[i].ctx, msg) != -ENOTSUP) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+kernel_pid_t ng_netapi_msg_pid(kernel_pid_t pid)
+{
+    return (_direct_idx(pid) >= 0) ? ng_netapi_direct_pid : pid;
+}
+
+uint16_t ng_netapi_msg_type(kernel_pid_t pid, uint16_t type)
+{
+    int i = _direct_idx(pid);
+
+    if ((i < 0) || (type < NG_NETAPI_MSG_TYPE_RCV) ||
+        (type > NG_NETAPI_MSG_TYPE_GET)) {
+        return type;
+    }
+    return NG_NETAPI_MSG_TYPE_DIRECT | (i << 2) | (type - NG_NETAPI_MSG_TYPE_RCV);
+}
+#endif
 
 /**
  * @brief   Unified function for getting and setting netapi options
@@ -48,30 +182,70 @@ static inline int _get_set(kernel_pid_t pid, uint16_t type,
     /* set outgoing message's fields */
     cmd.type = type;
     cmd.content.ptr = (void *)&o;
+#ifdef MODULE_NG_NETAPI_DIRECT
+    _direct_t *direct = _local(pid);
+
+    if (direct != NULL) {
+        return direct->handler(direct->ctx, &cmd);
+    }
+    cmd.type = ng_netapi_msg_type(pid, type);
+    pid = ng_netapi_msg_pid(pid);
+#endif
     /* trigger the netapi */
     msg_send_receive(&cmd, &ack, pid);
     /* return the ACK message's value */
     return (int)ack.content.value;
 }
 
-static inline int _snd_rcv(kernel_pid_t pid, uint16_t type, ng_pktsnip_t *pkt)
+static inline int _snd_rcv(kernel_pid_t pid, uint16_t type, ng_pktsnip_t *pkt,
+                           bool block)
 {
+    kernel_pid_t target = pid;
     msg_t msg;
     /* set the outgoing message's fields */
     msg.type = type;
     msg.content.ptr = (void *)pkt;
+#ifdef MODULE_NG_NETAPI_DIRECT
+    _direct_t *direct = _local(pid);
+
+    if (direct != NULL) {
+        direct->handler(direct->ctx, &msg);
+        return 1;
+    }
+    msg.type = ng_netapi_msg_type(pid, type);
+    target = ng_netapi_msg_pid(pid);
+#endif
     /* send message */
-    return msg_send(&msg, pid);
+    if (block) {
+        return msg_send(&msg, target);
+    }
+    return msg_try_send(&msg, target);
 }
 
 int ng_netapi_send(kernel_pid_t pid, ng_pktsnip_t *pkt)
 {
-    return _snd_rcv(pid, NG_NETAPI_MSG_TYPE_SND, pkt);
+    return _snd_rcv(pid, NG_NETAPI_MSG_TYPE_SND, pkt, true);
+}
+
+int ng_netapi_try_send(kernel_pid_t pid, ng_pktsnip_t *pkt)
+{
+    return _snd_rcv(pid, NG_NETAPI_MSG_TYPE_SND, pkt, false);
 }
 
 int ng_netapi_receive(kernel_pid_t pid, ng_pktsnip_t *pkt)
 {
-    return _snd_rcv(pid, NG_NETAPI_MSG_TYPE_RCV, pkt);
+    volatile tcb_t *thread = thread_get(pid);
+    /* a receiver without a message queue only takes messages while it waits
+     * in msg_receive(), e.g. an application thread in ng_udp_ep_recv() */
+    bool block = (thread != NULL) && (thread->msg_array == NULL);
+    int res = _snd_rcv(pid, NG_NETAPI_MSG_TYPE_RCV, pkt, block);
+
+    if (res == 0) {
+        /* the receiver is busy, do not stall the layer below */
+        ng_netstats_drop_pid(pid, NG_NETSTATS_DROP_QUEUE_FULL);
+        ng_pktbuf_release(pkt);
+    }
+    return res;
 }
 
 int ng_netapi_get(kernel_pid_t pid, ng_netconf_opt_t opt, uint16_t context,
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_ng_netstats
+ * @file
+ * @brief       Registry of network module statistics
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ * @}
+ */
+
+#include <string.h>
+
+#include "irq.h"
+#include "utlist.h"
+#include "net/ng_netstats.h"
+
+static ng_netstats_t *_list;
+
+void ng_netstats_register(ng_netstats_t *stats, kernel_pid_t pid,
+                          const char *name)
+{
+    unsigned state;
+
+    memset(stats, 0, sizeof(ng_netstats_t));
+    stats->pid = pid;
+    stats->name = name;
+    state = disableIRQ();
+    LL_APPEND(_list, stats);
+    restoreIRQ(state);
+}
+
+ng_netstats_t *ng_netstats_list(void)
+{
+    return _list;
+}
+
+void ng_netstats_drop_pid(kernel_pid_t pid, ng_netstats_drop_t reason)
+{
+    ng_netstats_t *stats;
+
+    LL_SEARCH_SCALAR(_list, stats, pid, pid);
+    if (stats != NULL) {
+        stats->drops[reason]++;
+    }
+}
@@ -164,8 +164,10 @@ void *_pktbuf_internal_alloc(size_t size)
     }
 
     while ((node->next != NULL)
-           /* and if space between current and next allocation is not big enough */
-           && ((_start_idx(node->next) - _end_idx(node)) < _total_sz(size))) {
+           /* and if space between current (incl. alignment) and next
+            * allocation is not big enough */
+           && ((_start_idx(node->next) - _start_idx(node)) <
+               (__al_total_sz(node) + _total_sz(size)))) {
         node = node->next;
     }
 
@@ -35,12 +35,24 @@
 
 static mutex_t _pktbuf_mutex = MUTEX_INIT;
 
+#ifdef TEST_SUITES
+static unsigned int _pktbuf_allocs = 0;
+#endif
+
 /* internal ng_pktbuf functions */
 static ng_pktsnip_t *_pktbuf_alloc(size_t size);
 static ng_pktsnip_t *_pktbuf_add_unsafe(ng_pktsnip_t *pkt, void *data,
                                         size_t size, ng_nettype_t type);
 static ng_pktsnip_t *_pktbuf_duplicate(const ng_pktsnip_t *pkt);
 
+static inline void *_alloc(size_t size)
+{
+#ifdef TEST_SUITES
+    _pktbuf_allocs++;
+#endif
+    return _pktbuf_internal_alloc(size);
+}
+
 int ng_pktbuf_realloc_data(ng_pktsnip_t *pkt, size_t size)
 {
     void *new;
@@ -58,6 +70,9 @@ int ng_pktbuf_realloc_data(ng_pktsnip_t *pkt, size_t size)
 
     mutex_lock(&_pktbuf_mutex);
 
+#ifdef TEST_SUITES
+    _pktbuf_allocs++;
+#endif
     new = _pktbuf_internal_realloc(pkt->data, size);
 
     mutex_unlock(&_pktbuf_mutex);
@@ -166,7 +181,7 @@ static ng_pktsnip_t *_pktbuf_alloc(size_t size)
 {
     ng_pktsnip_t *pkt;
 
-    pkt = (ng_pktsnip_t *)_pktbuf_internal_alloc(sizeof(ng_pktsnip_t));
+    pkt = (ng_pktsnip_t *)_alloc(sizeof(ng_pktsnip_t));
     DEBUG("pktbuf: allocated (pkt = %p) ", (void *)pkt);
 
     if (pkt == NULL) {
@@ -176,7 +191,7 @@ static ng_pktsnip_t *_pktbuf_alloc(size_t size)
 
     DEBUG("of size %u\n", (unsigned)sizeof(ng_pktsnip_t));
 
-    pkt->data = _pktbuf_internal_alloc(size);
+    pkt->data = _alloc(size);
     DEBUG("pktbuf: allocated (pkt->data = %p) ", pkt->data);
 
     if (pkt->data == NULL) {
@@ -199,7 +214,7 @@ static ng_pktsnip_t *_pktbuf_add_unsafe(ng_pktsnip_t *pkt, void *data,
 {
     ng_pktsnip_t *new_pktsnip;
 
-    new_pktsnip = (ng_pktsnip_t *)_pktbuf_internal_alloc(sizeof(ng_pktsnip_t));
+    new_pktsnip = (ng_pktsnip_t *)_alloc(sizeof(ng_pktsnip_t));
     DEBUG("pktbuf: allocated (new_pktsnip = %p) ", (void *)pkt);
 
     if (new_pktsnip == NULL) {
@@ -211,7 +226,7 @@ static ng_pktsnip_t *_pktbuf_add_unsafe(ng_pktsnip_t *pkt, void *data,
 
     if (pkt == NULL || pkt->data != data) {
         if ((size != 0) && (!_pktbuf_internal_contains(data))) {
-            new_pktsnip->data = _pktbuf_internal_alloc(size);
+            new_pktsnip->data = _alloc(size);
             DEBUG("pktbuf: allocated (new_pktsnip->data = %p) ", pkt->data);
 
             if (new_pktsnip->data == NULL) {
@@ -329,6 +344,12 @@ bool ng_pktbuf_is_empty(void)
 void ng_pktbuf_reset(void)
 {
     _pktbuf_internal_reset();
+    _pktbuf_allocs = 0;
+}
+
+unsigned int ng_pktbuf_alloc_count(void)
+{
+    return _pktbuf_allocs;
 }
 #endif
 
@@ -60,7 +60,7 @@ extern "C" {
 
 #define CCNL_HEADER_SIZE (40)
 
-#ifdef MODULE_NATIVENET
+#if defined(MODULE_NATIVENET) || defined(MODULE_CCN_LITE_NETAPI)
 /*
  * static content for testing ccn get has this chunk size
  * this test (populate + interest /riot/text) current works
@@ -559,6 +559,17 @@ void ipv6_net_if_get_best_src_addr(ipv6_addr_t *src, const ipv6_addr_t *dest);
  */
 void ipv6_iface_set_routing_provider(ipv6_addr_t *(*next_hop)(ipv6_addr_t *dest));
 
+/**
+ * @brief   Registers a function that takes over locally originated packets
+ *          for which the routing provider knows no next hop yet, e.g. to
+ *          send them once a route discovery has finished. Without such a
+ *          function these packets are discarded.
+ *
+ * @param   buffer      function that returns 0 if it took a copy of the
+ *                      packet and -1 if the packet is to be discarded
+ */
+void ipv6_iface_set_packet_buffer(int (*buffer)(ipv6_hdr_t *packet));
+
 /**
  * @brief   Registers a function that decides if a node in a RPL-network is actually the
  *          root and therefore a source routing header should be integrated.
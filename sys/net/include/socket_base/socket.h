@@ -166,14 +166,23 @@ typedef uint32_t  socklen_t;    ///< POSIX compatible type for address length.
 #define TRANSPORT_LAYER_SOCKET_STATIC_MSS       48  ///< Static TCP maxmimum segment size.
 
 /**
- * Static TCP flow control window for window size 1.
+ * Static TCP flow control window, allows several segments in flight.
  */
-#define TRANSPORT_LAYER_SOCKET_STATIC_WINDOW    1 * TRANSPORT_LAYER_SOCKET_STATIC_MSS
+#ifndef TRANSPORT_LAYER_SOCKET_STATIC_WINDOW
+#define TRANSPORT_LAYER_SOCKET_STATIC_WINDOW    (4 * TRANSPORT_LAYER_SOCKET_STATIC_MSS)
+#endif
 
 /**
- * Maximum size of TCP buffer.
+ * Maximum size of TCP receive buffer.
  */
-#define TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER   1 * TRANSPORT_LAYER_SOCKET_STATIC_WINDOW
+#define TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER   (TRANSPORT_LAYER_SOCKET_STATIC_WINDOW)
+
+/**
+ * Maximum size of TCP send buffer (unacknowledged plus not yet sent data).
+ */
+#ifndef TRANSPORT_LAYER_SOCKET_MAX_TCP_SEND_BUFFER
+#define TRANSPORT_LAYER_SOCKET_MAX_TCP_SEND_BUFFER  (4 * TRANSPORT_LAYER_SOCKET_STATIC_MSS)
+#endif
 
 /**
  * Socket address type for IPv6 communication.
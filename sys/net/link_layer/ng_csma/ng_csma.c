@@ -0,0 +1,823 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_ng_csma
+ * @file
+ * @brief       Implementation of the CSMA/CA MAC protocol
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "kernel.h"
+#include "msg.h"
+#include "thread.h"
+#include "timex.h"
+#include "utlist.h"
+#include "vtimer.h"
+#include "net/ng_csma.h"
+#include "net/ng_ieee802154.h"
+#include "net/ng_netbase.h"
+#include "net/ng_netstats.h"
+#include "net/ng_pktqueue.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* PHY header (preamble, SFD, length) and FCS around every frame on air */
+#define PHY_OVERHEAD        (8U)
+
+/**
+ * @brief   A neighbor with its transmit queue
+ */
+typedef struct {
+    ng_pktqueue_t *queue;           /**< packets waiting for the neighbor */
+    uint8_t addr[8];                /**< address in network byte order */
+    uint8_t addr_len;               /**< address length, 0 for broadcast */
+} _nbr_t;
+
+/**
+ * @brief   Last sequence number received from a neighbor
+ */
+typedef struct {
+    uint8_t addr[8];                /**< address in network byte order */
+    uint8_t addr_len;               /**< address length, 0 if unused */
+    uint8_t seq;                    /**< last sequence number */
+} _dup_t;
+
+/**
+ * @brief   State of one CSMA layer instance
+ */
+typedef struct {
+    ng_netdev_t *dev;               /**< the device, NULL if unused */
+    kernel_pid_t pid;               /**< the MAC thread */
+    _nbr_t nbrs[NG_CSMA_NEIGHBORS_NUMOF];   /**< transmit queues */
+    ng_pktqueue_t pool[NG_CSMA_QUEUE_SIZE]; /**< queue entries */
+    _dup_t dups[NG_CSMA_NEIGHBORS_NUMOF];   /**< duplicate detection */
+    unsigned next_nbr;              /**< queue to serve next */
+    unsigned next_dup;              /**< duplicate entry to replace next */
+    ng_pktsnip_t *tx;               /**< packet currently sent */
+    vtimer_t timer;                 /**< backoff and ACK timer */
+    uint32_t timer_gen;             /**< tells current timer messages from
+                                     *   stale ones */
+    uint32_t rand;                  /**< state of the backoff generator */
+    uint8_t nb;                     /**< NB of the current packet */
+    uint8_t be;                     /**< BE of the current packet */
+    uint8_t retries;                /**< retransmissions of the current packet */
+    bool soft;                      /**< the MAC builds frames and ACKs */
+    bool cca;                       /**< the MAC senses the channel */
+    bool wait_ack;                  /**< waiting for an ACK */
+    /* own parameters, only used if soft is set */
+    ng_nettype_t proto;             /**< type of received payloads */
+    le_uint16_t pan;                /**< PAN ID */
+    uint8_t addr_short[2];          /**< short address, network byte order */
+    uint8_t addr_long[8];           /**< long address, network byte order */
+    uint8_t src_len;                /**< source address length to send with */
+    uint8_t seq;                    /**< next sequence number */
+    timex_t start;                  /**< time the instance started */
+    ng_csma_stats_t stats;          /**< statistics */
+    ng_netstats_t netstats;         /**< packet, drop, queue and latency
+                                     *   counters */
+} _csma_t;
+
+static _csma_t _csma[NG_CSMA_NUMOF];
+
+static void _send_next(_csma_t *csma);
+static void _backoff(_csma_t *csma);
+
+static _csma_t *_get_csma(kernel_pid_t pid)
+{
+    for (unsigned i = 0; i < NG_CSMA_NUMOF; i++) {
+        if ((_csma[i].dev != NULL) && (_csma[i].pid == pid)) {
+            return &_csma[i];
+        }
+    }
+    return NULL;
+}
+
+static inline uint64_t _airtime(size_t len)
+{
+    return (uint64_t)(len + PHY_OVERHEAD) * NG_CSMA_BYTE_US;
+}
+
+static uint32_t _random(_csma_t *csma)
+{
+    /* xorshift32, seeded from the address, so neighbors do not back off in
+     * lockstep */
+    csma->rand ^= csma->rand << 13;
+    csma->rand ^= csma->rand >> 17;
+    csma->rand ^= csma->rand << 5;
+    return csma->rand;
+}
+
+static void _set_timer(_csma_t *csma, uint32_t us, uint16_t type)
+{
+    vtimer_remove(&csma->timer);
+    csma->timer_gen++;
+    vtimer_set_msg(&csma->timer, timex_set(us / SEC_IN_USEC, us % SEC_IN_USEC),
+                   csma->pid, type, (void *)(uintptr_t)csma->timer_gen);
+}
+
+static void _stop_timer(_csma_t *csma)
+{
+    vtimer_remove(&csma->timer);
+    csma->timer_gen++;
+}
+
+/**
+ * @brief   Reads the addresses, PAN ID, and protocol from the device
+ */
+static void _get_own(_csma_t *csma)
+{
+    ng_netdev_t *dev = csma->dev;
+    uint64_t addr_long;
+    uint16_t tmp;
+
+    if (dev->driver->get(dev, NETCONF_OPT_ADDRESS, &tmp, sizeof(tmp)) >= 0) {
+        network_uint16_t addr = byteorder_htons(tmp);
+        memcpy(csma->addr_short, &addr, sizeof(addr));
+    }
+    if (dev->driver->get(dev, NETCONF_OPT_ADDRESS_LONG, &addr_long,
+                         sizeof(addr_long)) >= 0) {
+        network_uint64_t addr = byteorder_htonll(addr_long);
+        memcpy(csma->addr_long, &addr, sizeof(addr));
+    }
+    if (dev->driver->get(dev, NETCONF_OPT_NID, &tmp, sizeof(tmp)) >= 0) {
+        csma->pan = byteorder_btols(byteorder_htons(tmp));
+    }
+    if ((dev->driver->get(dev, NETCONF_OPT_SRC_LEN, &tmp, sizeof(tmp)) >= 0) &&
+        (tmp == sizeof(csma->addr_long))) {
+        csma->src_len = sizeof(csma->addr_long);
+    }
+    else {
+        csma->src_len = sizeof(csma->addr_short);
+    }
+    if (dev->driver->get(dev, NETCONF_OPT_PROTO, &csma->proto,
+                         sizeof(csma->proto)) < 0) {
+        csma->proto = NG_NETTYPE_UNDEF;
+    }
+}
+
+/**
+ * @brief   Senses the channel in software unless the device does CSMA-CA
+ *          itself, e.g. the at86rf2xx in TX_ARET mode
+ */
+static void _get_cca(_csma_t *csma)
+{
+    ng_netdev_t *dev = csma->dev;
+    ng_netconf_enable_t enable;
+
+    csma->cca = !((dev->driver->get(dev, NETCONF_OPT_AUTOCCA, &enable,
+                                    sizeof(enable)) >= 0) &&
+                  (enable == NETCONF_ENABLE));
+}
+
+/**
+ * @brief   Decides what the MAC layer has to do itself
+ */
+static void _setup(_csma_t *csma)
+{
+    ng_netdev_t *dev = csma->dev;
+    ng_netconf_enable_t enable;
+    uint64_t addr_long = 0;
+
+    _get_cca(csma);
+    csma->soft = false;
+    if (dev->driver->get(dev, NETCONF_OPT_AUTOACK, &enable, sizeof(enable)) < 0) {
+        enable = NETCONF_ENABLE;
+        csma->soft = (dev->driver->set(dev, NETCONF_OPT_RAWMODE, &enable,
+                                       sizeof(enable)) >= 0);
+    }
+    if (csma->soft) {
+        _get_own(csma);
+    }
+
+    dev->driver->get(dev, NETCONF_OPT_ADDRESS_LONG, &addr_long, sizeof(addr_long));
+    csma->rand = (uint32_t)(addr_long ^ (addr_long >> 32));
+    if (csma->rand == 0) {
+        csma->rand = 1;
+    }
+    DEBUG("csma: software ACKs: %i, software CCA: %i\n", csma->soft, csma->cca);
+}
+
+/**
+ * @brief   Passes a received packet to everyone interested in it
+ */
+static void _dispatch(_csma_t *csma, ng_pktsnip_t *pkt)
+{
+    ng_netreg_entry_t *sendto;
+
+    /* find out, who to send the packet to */
+    sendto = ng_netreg_lookup(pkt->type, NG_NETREG_DEMUX_CTX_ALL);
+    /* throw away packet if no one is interested */
+    if (sendto == NULL) {
+        DEBUG("csma: unable to forward packet of type %i\n", pkt->type);
+        ng_pktbuf_release(pkt);
+        return;
+    }
+    csma->stats.rx_frames++;
+    /* send the packet to everyone interested in it's type */
+    ng_pktbuf_hold(pkt, ng_netreg_num(pkt->type, NG_NETREG_DEMUX_CTX_ALL) - 1);
+    while (sendto != NULL) {
+        DEBUG("csma: sending pkt %p to PID %u\n", (void*)pkt, sendto->pid);
+        ng_netapi_receive(sendto->pid, pkt);
+        sendto = ng_netreg_getnext(sendto);
+    }
+}
+
+static void _send_ack(_csma_t *csma, uint8_t seq)
+{
+    ng_pktsnip_t *ack = ng_pktbuf_add(NULL, NULL, 3, NG_NETTYPE_UNDEF);
+    uint8_t *data;
+
+    if (ack == NULL) {
+        DEBUG("csma: unable to allocate ACK\n");
+        return;
+    }
+    data = ack->data;
+    data[0] = NG_IEEE802154_FCF_TYPE_ACK;
+    data[1] = 0;
+    data[2] = seq;
+    /* ACKs are sent right away, without CSMA */
+    csma->dev->driver->send_data(csma->dev, ack);
+    csma->stats.acks_sent++;
+    csma->stats.tx_frames++;
+    csma->stats.tx_airtime += _airtime(3);
+}
+
+/**
+ * @brief   Checks if a frame was received before, and remembers it if not
+ */
+static bool _is_dup(_csma_t *csma, const uint8_t *mhr)
+{
+    uint8_t src[8];
+    int src_len = ng_ieee802154_get_src(mhr, src, NULL);
+    _dup_t *dup;
+
+    for (unsigned i = 0; i < NG_CSMA_NEIGHBORS_NUMOF; i++) {
+        dup = &csma->dups[i];
+        if ((dup->addr_len == src_len) && (memcmp(dup->addr, src, src_len) == 0)) {
+            if (dup->seq == mhr[2]) {
+                return true;
+            }
+            dup->seq = mhr[2];
+            return false;
+        }
+    }
+
+    dup = &csma->dups[csma->next_dup];
+    csma->next_dup = (csma->next_dup + 1) % NG_CSMA_NEIGHBORS_NUMOF;
+    memcpy(dup->addr, src, src_len);
+    dup->addr_len = src_len;
+    dup->seq = mhr[2];
+    return false;
+}
+
+/**
+ * @brief   Handles a raw frame, if the MAC layer does the ACKs
+ */
+static void _receive_frame(_csma_t *csma, ng_pktsnip_t *pkt)
+{
+    const ng_ieee802154_mhr_layout_t *layout;
+    uint8_t *mhr = pkt->data;
+    ng_pktsnip_t *hdr, *netif;
+    uint8_t dst[8];
+    le_uint16_t pan;
+    bool bcast;
+
+    if (pkt->size < 3) {
+        ng_pktbuf_release(pkt);
+        return;
+    }
+
+    if ((mhr[0] & NG_IEEE802154_FCF_TYPE_MASK) == NG_IEEE802154_FCF_TYPE_ACK) {
+        if (csma->wait_ack && (mhr[2] == ((uint8_t *)csma->tx->data)[2])) {
+            DEBUG("csma: received ACK for %u\n", mhr[2]);
+            csma->stats.tx_success++;
+            ng_pktbuf_release(pkt);
+            ng_pktbuf_release(csma->tx);
+            csma->tx = NULL;
+            _stop_timer(csma);
+            csma->wait_ack = false;
+            _send_next(csma);
+            return;
+        }
+        ng_pktbuf_release(pkt);
+        return;
+    }
+
+    layout = ng_ieee802154_get_mhr_layout(mhr);
+    if (((mhr[0] & NG_IEEE802154_FCF_TYPE_MASK) != NG_IEEE802154_FCF_TYPE_DATA) ||
+        (layout->len == 0) || (layout->dst_len == 0) ||
+        (layout->src_len == 0) || (pkt->size <= layout->len)) {
+        DEBUG("csma: dropping unsupported frame\n");
+        ng_pktbuf_release(pkt);
+        return;
+    }
+
+    /* address filter */
+    ng_ieee802154_get_dst(mhr, dst, &pan);
+    bcast = (layout->dst_len == 2) && (dst[0] == 0xff) && (dst[1] == 0xff);
+    if (((pan.u16 != csma->pan.u16) && (pan.u16 != 0xffff)) ||
+        (!bcast && (((layout->dst_len == 2) &&
+                     (memcmp(dst, csma->addr_short, 2) != 0)) ||
+                    ((layout->dst_len == 8) &&
+                     (memcmp(dst, csma->addr_long, 8) != 0))))) {
+        ng_pktbuf_release(pkt);
+        return;
+    }
+
+    /* acknowledge duplicates, too: the first ACK may have been lost */
+    if (!bcast && (mhr[0] & NG_IEEE802154_FCF_ACK_REQ)) {
+        _send_ack(csma, mhr[2]);
+    }
+    if (_is_dup(csma, mhr)) {
+        DEBUG("csma: dropping duplicate %u\n", mhr[2]);
+        csma->stats.rx_dups++;
+        ng_pktbuf_release(pkt);
+        return;
+    }
+
+    netif = ng_ieee802154_netif_hdr_build(mhr);
+    if (netif == NULL) {
+        DEBUG("csma: unable to allocate netif header\n");
+        ng_netstats_drop(&csma->netstats, NG_NETSTATS_DROP_NOBUF);
+        ng_pktbuf_release(pkt);
+        return;
+    }
+    ((ng_netif_hdr_t *)netif->data)->if_pid = csma->pid;
+    /* cut the MAC header off and put the netif header in its place */
+    hdr = ng_pktbuf_add(pkt, pkt->data, layout->len, NG_NETTYPE_UNDEF);
+    if (hdr == NULL) {
+        DEBUG("csma: unable to mark MAC header\n");
+        ng_netstats_drop(&csma->netstats, NG_NETSTATS_DROP_NOBUF);
+        ng_pktbuf_release(netif);
+        ng_pktbuf_release(pkt);
+        return;
+    }
+    pkt = ng_pktbuf_remove_snip(pkt, hdr);
+    pkt->type = csma->proto;
+    LL_APPEND(pkt, netif);
+    _dispatch(csma, pkt);
+}
+
+/**
+ * @brief   Function called by the device driver on device events
+ *
+ * @param[in] event         type of event
+ * @param[in] data          optional parameter
+ */
+static void _event_cb(ng_netdev_event_t event, void *data)
+{
+    _csma_t *csma = _get_csma(thread_getpid());
+
+    DEBUG("csma: event triggered -> %i\n", event);
+    if ((event != NETDEV_EVENT_RX_COMPLETE) || (csma == NULL)) {
+        return;
+    }
+    if (csma->soft) {
+        _receive_frame(csma, (ng_pktsnip_t *)data);
+    }
+    else {
+        _dispatch(csma, (ng_pktsnip_t *)data);
+    }
+}
+
+/**
+ * @brief   Replaces the netif header of a packet with a MAC header
+ *
+ * @return  the frame, NULL if it could not be built
+ */
+static ng_pktsnip_t *_build_frame(_csma_t *csma, ng_pktsnip_t *pkt)
+{
+    static const uint8_t bcast[] = NG_IEEE802154_ADDR_BCAST;
+    uint8_t mhr[NG_IEEE802154_MAX_HDR_LEN];
+    uint8_t flags = NG_IEEE802154_FCF_TYPE_DATA | NG_IEEE802154_FCF_PAN_COMP;
+    ng_netif_hdr_t *hdr;
+    ng_pktsnip_t *frame;
+    const uint8_t *dst, *src;
+    size_t dst_len, len;
+
+    if (pkt->type != NG_NETTYPE_NETIF) {
+        /* already a frame */
+        return pkt;
+    }
+
+    hdr = (ng_netif_hdr_t *)pkt->data;
+    if (hdr->flags & (NG_NETIF_HDR_FLAGS_BROADCAST | NG_NETIF_HDR_FLAGS_MULTICAST)) {
+        dst = bcast;
+        dst_len = sizeof(bcast);
+    }
+    else {
+        dst = ng_netif_hdr_get_dst_addr(hdr);
+        dst_len = hdr->dst_l2addr_len;
+        flags |= NG_IEEE802154_FCF_ACK_REQ;
+    }
+    src = (csma->src_len == sizeof(csma->addr_long)) ? csma->addr_long
+                                                     : csma->addr_short;
+    len = ng_ieee802154_set_frame_hdr(mhr, src, csma->src_len, dst, dst_len,
+                                      csma->pan, csma->pan, flags, csma->seq);
+    if (len == 0) {
+        DEBUG("csma: unable to create 802.15.4 header\n");
+        ng_pktbuf_release(pkt);
+        return NULL;
+    }
+    csma->seq++;
+
+    /* the payload moves from the netif header to the MAC header */
+    ng_pktbuf_hold(pkt->next, 1);
+    frame = ng_pktbuf_add(pkt->next, mhr, len, NG_NETTYPE_UNDEF);
+    if (frame == NULL) {
+        DEBUG("csma: unable to allocate 802.15.4 header\n");
+        ng_pktbuf_release(pkt->next);
+    }
+    ng_pktbuf_release(pkt);
+    return frame;
+}
+
+static void _tx_done(_csma_t *csma)
+{
+    _stop_timer(csma);
+    csma->wait_ack = false;
+    ng_pktbuf_release(csma->tx);
+    csma->tx = NULL;
+    _send_next(csma);
+}
+
+static void _transmit(_csma_t *csma)
+{
+    ng_pktsnip_t *pkt = csma->tx;
+    int res;
+
+    /* for a netif packet, the netif header is roughly as long as the MAC
+     * header that replaces it */
+    csma->stats.tx_frames++;
+    csma->stats.tx_airtime += _airtime(ng_pkt_len(pkt));
+
+    if (!csma->soft) {
+        /* the device consumes the packet and does ACKs itself */
+        csma->tx = NULL;
+        res = csma->dev->driver->send_data(csma->dev, pkt);
+        if (res >= 0) {
+            csma->stats.tx_success++;
+        }
+        _send_next(csma);
+        return;
+    }
+
+    /* keep the frame for retransmissions */
+    ng_pktbuf_hold(pkt, 1);
+    res = csma->dev->driver->send_data(csma->dev, pkt);
+    if ((res >= 0) && !(((uint8_t *)pkt->data)[0] & NG_IEEE802154_FCF_ACK_REQ)) {
+        csma->stats.tx_success++;
+        _tx_done(csma);
+        return;
+    }
+    /* a failed transmission is retried like an unacknowledged one */
+    csma->wait_ack = true;
+    _set_timer(csma, NG_CSMA_ACK_TIMEOUT_US, NG_CSMA_MSG_ACK_TIMEOUT);
+}
+
+static void _ack_timeout(_csma_t *csma)
+{
+    csma->wait_ack = false;
+    if (csma->retries < NG_CSMA_MAX_FRAME_RETRIES) {
+        DEBUG("csma: no ACK, retransmitting\n");
+        csma->retries++;
+        csma->stats.tx_retries++;
+        csma->nb = 0;
+        csma->be = NG_CSMA_MIN_BE;
+        _backoff(csma);
+        return;
+    }
+    DEBUG("csma: no ACK, dropping packet\n");
+    csma->stats.tx_noack++;
+    ng_netstats_drop(&csma->netstats, NG_NETSTATS_DROP_TX_FAIL);
+    _tx_done(csma);
+}
+
+static void _cca(_csma_t *csma)
+{
+    ng_netconf_enable_t clear;
+
+    /* devices that can not sense the channel always send */
+    if ((csma->dev->driver->get(csma->dev, NETCONF_OPT_IS_CHANNEL_CLR, &clear,
+                                sizeof(clear)) < 0) ||
+        (clear == NETCONF_ENABLE)) {
+        _transmit(csma);
+        return;
+    }
+
+    csma->nb++;
+    if (csma->be < NG_CSMA_MAX_BE) {
+        csma->be++;
+    }
+    if (csma->nb > NG_CSMA_MAX_BACKOFFS) {
+        DEBUG("csma: channel access failure\n");
+        csma->stats.tx_busy++;
+        ng_netstats_drop(&csma->netstats, NG_NETSTATS_DROP_TX_FAIL);
+        _tx_done(csma);
+        return;
+    }
+    _backoff(csma);
+}
+
+static void _backoff(_csma_t *csma)
+{
+    uint32_t us;
+
+    if (!csma->cca) {
+        /* the device does CSMA/CA itself */
+        _transmit(csma);
+        return;
+    }
+
+    us = (_random(csma) & ((1U << csma->be) - 1)) * NG_CSMA_BACKOFF_PERIOD_US;
+    if (us == 0) {
+        _cca(csma);
+    }
+    else {
+        _set_timer(csma, us, NG_CSMA_MSG_BACKOFF);
+    }
+}
+
+/**
+ * @brief   Starts sending the next queued packet, if nothing is sent yet
+ */
+static void _send_next(_csma_t *csma)
+{
+    while (csma->tx == NULL) {
+        ng_pktqueue_t *node = NULL;
+
+        /* serve the neighbors round robin */
+        for (unsigned i = 0; i < NG_CSMA_NEIGHBORS_NUMOF; i++) {
+            _nbr_t *nbr = &csma->nbrs[csma->next_nbr];
+
+            csma->next_nbr = (csma->next_nbr + 1) % NG_CSMA_NEIGHBORS_NUMOF;
+            if (nbr->queue != NULL) {
+                node = ng_pktqueue_remove_head(&nbr->queue);
+                break;
+            }
+        }
+        if (node == NULL) {
+            return;
+        }
+
+        csma->tx = node->pkt;
+        node->pkt = NULL;
+        if (csma->soft) {
+            csma->tx = _build_frame(csma, csma->tx);
+        }
+        if (csma->tx != NULL) {
+            csma->nb = 0;
+            csma->be = NG_CSMA_MIN_BE;
+            csma->retries = 0;
+            _backoff(csma);
+        }
+        else {
+            ng_netstats_drop(&csma->netstats, NG_NETSTATS_DROP_NOBUF);
+        }
+    }
+}
+
+/**
+ * @brief   Queues a packet for its neighbor
+ */
+static void _queue(_csma_t *csma, ng_pktsnip_t *pkt)
+{
+    ng_netif_hdr_t *hdr = (ng_netif_hdr_t *)pkt->data;
+    ng_pktqueue_t *node = NULL;
+    _nbr_t *nbr = NULL;
+    uint8_t addr[8];
+    uint8_t addr_len = 0;
+
+    if ((pkt->type == NG_NETTYPE_NETIF) &&
+        !(hdr->flags & (NG_NETIF_HDR_FLAGS_BROADCAST | NG_NETIF_HDR_FLAGS_MULTICAST)) &&
+        (hdr->dst_l2addr_len <= sizeof(addr))) {
+        addr_len = hdr->dst_l2addr_len;
+        memcpy(addr, ng_netif_hdr_get_dst_addr(hdr), addr_len);
+    }
+
+    /* find the neighbor's queue, or take over an empty one */
+    for (unsigned i = 0; i < NG_CSMA_NEIGHBORS_NUMOF; i++) {
+        _nbr_t *tmp = &csma->nbrs[i];
+
+        if ((tmp->addr_len == addr_len) &&
+            (memcmp(tmp->addr, addr, addr_len) == 0)) {
+            nbr = tmp;
+            break;
+        }
+        if ((nbr == NULL) && (tmp->queue == NULL)) {
+            nbr = tmp;
+        }
+    }
+    for (unsigned i = 0; i < NG_CSMA_QUEUE_SIZE; i++) {
+        if (csma->pool[i].pkt == NULL) {
+            node = &csma->pool[i];
+            break;
+        }
+    }
+    if ((nbr == NULL) || (node == NULL)) {
+        DEBUG("csma: queues full, dropping packet\n");
+        csma->stats.tx_qfull++;
+        ng_netstats_drop(&csma->netstats, NG_NETSTATS_DROP_QUEUE_FULL);
+        ng_pktbuf_release(pkt);
+        return;
+    }
+
+    memcpy(nbr->addr, addr, addr_len);
+    nbr->addr_len = addr_len;
+    node->pkt = pkt;
+    node->next = NULL;
+    ng_pktqueue_add(&nbr->queue, node);
+    _send_next(csma);
+}
+
+/**
+ * @brief   Handles NETDEV, NETAPI, and timer messages
+ *
+ * @param[in] ctx           the instance
+ * @param[in] msg           the message
+ *
+ * @return                  the reply to get and set messages
+ */
+static int _handle(void *ctx, msg_t *msg)
+{
+    _csma_t *csma = (_csma_t *)ctx;
+    ng_netdev_t *dev = csma->dev;
+    ng_netapi_opt_t *opt;
+    unsigned long start;
+    int res;
+
+    switch (msg->type) {
+        case NG_NETDEV_MSG_TYPE_EVENT:
+            DEBUG("csma: NG_NETDEV_MSG_TYPE_EVENT received\n");
+            dev->driver->isr_event(dev, msg->content.value);
+            return 0;
+        case NG_NETAPI_MSG_TYPE_SND:
+            DEBUG("csma: NG_NETAPI_MSG_TYPE_SND received\n");
+            start = ng_netstats_start();
+            _queue(csma, (ng_pktsnip_t *)msg->content.ptr);
+            ng_netstats_done(&csma->netstats, start);
+            return 0;
+        case NG_CSMA_MSG_BACKOFF:
+            if (msg->content.value == csma->timer_gen) {
+                _cca(csma);
+            }
+            return 0;
+        case NG_CSMA_MSG_ACK_TIMEOUT:
+            if (msg->content.value == csma->timer_gen) {
+                _ack_timeout(csma);
+            }
+            return 0;
+        case NG_NETAPI_MSG_TYPE_SET:
+            DEBUG("csma: NG_NETAPI_MSG_TYPE_SET received\n");
+            opt = (ng_netapi_opt_t *)msg->content.ptr;
+            if (csma->soft && (opt->opt == NETCONF_OPT_RAWMODE)) {
+                /* the MAC layer depends on raw mode */
+                res = -ENOTSUP;
+            }
+            else {
+                res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+                if (csma->soft && (res >= 0)) {
+                    _get_own(csma);
+                }
+                if ((opt->opt == NETCONF_OPT_AUTOCCA) && (res >= 0)) {
+                    _get_cca(csma);
+                }
+            }
+            DEBUG("csma: response of netdev->set: %i\n", res);
+            return res;
+        case NG_NETAPI_MSG_TYPE_GET:
+            DEBUG("csma: NG_NETAPI_MSG_TYPE_GET received\n");
+            opt = (ng_netapi_opt_t *)msg->content.ptr;
+            if (opt->opt == NETCONF_OPT_STATS) {
+                return ng_netstats_get(&csma->netstats, opt);
+            }
+            if (csma->soft && (opt->opt == NETCONF_OPT_RAWMODE) &&
+                (opt->data_len >= sizeof(ng_netconf_enable_t))) {
+                /* upper layers never see raw frames */
+                *((ng_netconf_enable_t *)opt->data) = NETCONF_DISABLE;
+                res = sizeof(ng_netconf_enable_t);
+            }
+            else {
+                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+            }
+            DEBUG("csma: response of netdev->get: %i\n", res);
+            return res;
+        default:
+#ifdef MODULE_NG_NETAPI_DIRECT
+            /* messages for the layers running in this thread */
+            if (ng_netapi_direct_dispatch(msg)) {
+                return 0;
+            }
+#endif
+            DEBUG("csma: Unknown command %" PRIu16 "\n", msg->type);
+            return -ENOTSUP;
+    }
+}
+
+/**
+ * @brief   Startup code and event loop of the CSMA layer
+ *
+ * @param[in] args          expects a pointer to the instance
+ *
+ * @return                  never returns
+ */
+static void *_csma_thread(void *args)
+{
+    _csma_t *csma = (_csma_t *)args;
+    ng_netdev_t *dev = csma->dev;
+    msg_t msg, reply, msg_queue[NG_CSMA_MSG_QUEUE_SIZE];
+
+    /* setup the MAC layers message queue */
+    msg_init_queue(msg_queue, NG_CSMA_MSG_QUEUE_SIZE);
+    /* save the PID to the device descriptor and register the device */
+    csma->pid = thread_getpid();
+    dev->mac_pid = csma->pid;
+    ng_netif_add(dev->mac_pid);
+    ng_netstats_register(&csma->netstats, csma->pid, "csma");
+    vtimer_now(&csma->start);
+    _setup(csma);
+    /* register the event callback with the device driver */
+    dev->driver->add_event_callback(dev, _event_cb);
+#ifdef MODULE_NG_NETAPI_DIRECT
+    /* run the layers above in this thread */
+    ng_netapi_direct_run(_handle, csma);
+#endif
+
+    /* start the event loop */
+    while (1) {
+        DEBUG("csma: waiting for incoming messages\n");
+        msg_receive(&msg);
+        ng_netstats_queue(&csma->netstats);
+        /* dispatch NETDEV, NETAPI, and timer messages */
+        reply.content.value = (uint32_t)_handle(csma, &msg);
+        if ((msg.type == NG_NETAPI_MSG_TYPE_SET) ||
+            (msg.type == NG_NETAPI_MSG_TYPE_GET)) {
+            /* send reply to calling thread */
+            reply.type = NG_NETAPI_MSG_TYPE_ACK;
+            msg_reply(&msg, &reply);
+        }
+    }
+    /* never reached */
+    return NULL;
+}
+
+kernel_pid_t ng_csma_init(char *stack, int stacksize, char priority,
+                          const char *name, ng_netdev_t *dev)
+{
+    _csma_t *csma = NULL;
+    kernel_pid_t res;
+
+    /* check if given netdev device is defined and the driver is set */
+    if (dev == NULL || dev->driver == NULL) {
+        return -ENODEV;
+    }
+    for (unsigned i = 0; i < NG_CSMA_NUMOF; i++) {
+        if (_csma[i].dev == NULL) {
+            csma = &_csma[i];
+            break;
+        }
+    }
+    if (csma == NULL) {
+        return -ENOBUFS;
+    }
+    memset(csma, 0, sizeof(_csma_t));
+    csma->dev = dev;
+    csma->pid = KERNEL_PID_UNDEF;
+    /* create new CSMA thread */
+    res = thread_create(stack, stacksize, priority, CREATE_STACKTEST,
+                        _csma_thread, (void *)csma, name);
+    if (res <= 0) {
+        csma->dev = NULL;
+        return -EINVAL;
+    }
+    return res;
+}
+
+int ng_csma_get_stats(kernel_pid_t pid, ng_csma_stats_t *stats)
+{
+    _csma_t *csma = _get_csma(pid);
+    timex_t now;
+
+    if (csma == NULL) {
+        return -ENOENT;
+    }
+    memcpy(stats, &csma->stats, sizeof(ng_csma_stats_t));
+    vtimer_now(&now);
+    stats->uptime = timex_uint64(timex_sub(now, csma->start));
+    return 0;
+}
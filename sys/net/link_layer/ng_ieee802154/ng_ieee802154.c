@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_ng_ieee802154
+ * @file
+ * @brief       IEEE 802.15.4 header parsing and building
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ * @}
+ */
+
+#include <errno.h>
+
+#include "net/ng_ieee802154.h"
+#include "net/ng_netif/hdr.h"
+#include "net/ng_pktbuf.h"
+
+/* the layout table is generated from its index: bits 0-1 are the destination
+ * addressing mode, bits 2-3 the source addressing mode, and bit 4 the PAN ID
+ * compression flag */
+#define _DST_MODE(i)        ((i) & 0x03)
+#define _SRC_MODE(i)        (((i) >> 2) & 0x03)
+#define _PAN_COMP(i)        ((i) & 0x10)
+#define _ADDR_LEN(mode)     (((mode) == 0x02) ? 2 : (((mode) == 0x03) ? 8 : 0))
+#define _VALID(i)           ((_DST_MODE(i) != 0x01) && (_SRC_MODE(i) != 0x01))
+#define _DST_END(i)         (3 + (_ADDR_LEN(_DST_MODE(i)) ? \
+                                  (2 + _ADDR_LEN(_DST_MODE(i))) : 0))
+#define _SRC_PAN(i)         ((_ADDR_LEN(_SRC_MODE(i)) && !_PAN_COMP(i)) ? \
+                             _DST_END(i) : 0)
+#define _SRC(i)             (_DST_END(i) + (_SRC_PAN(i) ? 2 : 0))
+
+#define _LAYOUT(i)          { \
+        .len = _VALID(i) ? (_SRC(i) + _ADDR_LEN(_SRC_MODE(i))) : 0, \
+        .dst_len = _ADDR_LEN(_DST_MODE(i)), \
+        .src_len = _ADDR_LEN(_SRC_MODE(i)), \
+        .src_pan = _SRC_PAN(i), \
+        .src = _SRC(i), \
+    }
+#define _LAYOUTS(i)         _LAYOUT(i), _LAYOUT(i + 1), _LAYOUT(i + 2), \
+                            _LAYOUT(i + 3)
+
+const ng_ieee802154_mhr_layout_t ng_ieee802154_mhr_layouts[32] = {
+    _LAYOUTS(0),  _LAYOUTS(4),  _LAYOUTS(8),  _LAYOUTS(12),
+    _LAYOUTS(16), _LAYOUTS(20), _LAYOUTS(24), _LAYOUTS(28),
+};
+
+/* copies an address between the (little endian) MHR and the (big endian)
+ * netif header representation, with fixed lengths so the copies unroll */
+static inline void _swap_addr(uint8_t *dst, const uint8_t *src, size_t len)
+{
+    if (len == 2) {
+        dst[0] = src[1];
+        dst[1] = src[0];
+    }
+    else if (len == 8) {
+        for (int i = 0; i < 8; i++) {
+            dst[i] = src[7 - i];
+        }
+    }
+}
+
+static inline uint8_t _addr_mode(size_t len)
+{
+    switch (len) {
+        case 0:
+            return NG_IEEE802154_FCF_DST_ADDR_VOID;
+        case 2:
+            return NG_IEEE802154_FCF_DST_ADDR_SHORT;
+        case 8:
+            return NG_IEEE802154_FCF_DST_ADDR_LONG;
+        default:
+            /* reserved mode, yields an invalid layout */
+            return 0x04;
+    }
+}
+
+size_t ng_ieee802154_set_frame_hdr(uint8_t *buf, const uint8_t *src,
+                                   size_t src_len, const uint8_t *dst,
+                                   size_t dst_len, le_uint16_t src_pan,
+                                   le_uint16_t dst_pan, uint8_t flags,
+                                   uint8_t seq)
+{
+    const ng_ieee802154_mhr_layout_t *layout;
+
+    buf[0] = flags;
+    /* the source mode bits are the destination mode bits shifted by 4 */
+    buf[1] = _addr_mode(dst_len) | (_addr_mode(src_len) << 4);
+    layout = ng_ieee802154_get_mhr_layout(buf);
+    if (layout->len == 0) {
+        return 0;
+    }
+
+    buf[2] = seq;
+    if (dst_len > 0) {
+        buf[3] = dst_pan.u8[0];
+        buf[4] = dst_pan.u8[1];
+        _swap_addr(&buf[5], dst, dst_len);
+    }
+    if (layout->src_pan > 0) {
+        buf[layout->src_pan] = src_pan.u8[0];
+        buf[layout->src_pan + 1] = src_pan.u8[1];
+    }
+    _swap_addr(&buf[layout->src], src, src_len);
+
+    return layout->len;
+}
+
+int ng_ieee802154_get_src(const uint8_t *mhr, uint8_t *src,
+                          le_uint16_t *src_pan)
+{
+    const ng_ieee802154_mhr_layout_t *layout = ng_ieee802154_get_mhr_layout(mhr);
+
+    if (layout->len == 0) {
+        return -EINVAL;
+    }
+    if (src_pan != NULL) {
+        /* a compressed source PAN ID is the destination PAN ID */
+        uint8_t pos = (layout->src_pan > 0) ? layout->src_pan : 3;
+
+        if ((layout->src_pan > 0) || (layout->dst_len > 0)) {
+            src_pan->u8[0] = mhr[pos];
+            src_pan->u8[1] = mhr[pos + 1];
+        }
+    }
+    if (src != NULL) {
+        _swap_addr(src, &mhr[layout->src], layout->src_len);
+    }
+
+    return layout->src_len;
+}
+
+int ng_ieee802154_get_dst(const uint8_t *mhr, uint8_t *dst,
+                          le_uint16_t *dst_pan)
+{
+    const ng_ieee802154_mhr_layout_t *layout = ng_ieee802154_get_mhr_layout(mhr);
+
+    if (layout->len == 0) {
+        return -EINVAL;
+    }
+    if (layout->dst_len > 0) {
+        if (dst_pan != NULL) {
+            dst_pan->u8[0] = mhr[3];
+            dst_pan->u8[1] = mhr[4];
+        }
+        if (dst != NULL) {
+            _swap_addr(dst, &mhr[5], layout->dst_len);
+        }
+    }
+
+    return layout->dst_len;
+}
+
+ng_pktsnip_t *ng_ieee802154_netif_hdr_build(const uint8_t *mhr)
+{
+    const ng_ieee802154_mhr_layout_t *layout = ng_ieee802154_get_mhr_layout(mhr);
+    ng_pktsnip_t *snip;
+    ng_netif_hdr_t *hdr;
+
+    if (layout->len == 0) {
+        return NULL;
+    }
+    snip = ng_pktbuf_add(NULL, NULL, sizeof(ng_netif_hdr_t) + layout->src_len +
+                         layout->dst_len, NG_NETTYPE_NETIF);
+    if (snip == NULL) {
+        return NULL;
+    }
+
+    hdr = (ng_netif_hdr_t *)snip->data;
+    ng_netif_hdr_init(hdr, layout->src_len, layout->dst_len);
+    _swap_addr(ng_netif_hdr_get_src_addr(hdr), &mhr[layout->src],
+               layout->src_len);
+    _swap_addr(ng_netif_hdr_get_dst_addr(hdr), &mhr[5], layout->dst_len);
+
+    return snip;
+}
@@ -23,10 +23,19 @@
 #include "thread.h"
 #include "net/ng_nomac.h"
 #include "net/ng_netbase.h"
+#include "net/ng_netstats.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/**
+ * @brief   State of a NOMAC thread, lives on its stack
+ */
+typedef struct {
+    ng_netdev_t *dev;           /**< the device */
+    ng_netstats_t stats;        /**< packet, drop, queue and latency counters */
+} _nomac_t;
+
 /**
  * @brief   Function called by the device driver on device events
  *
@@ -61,6 +70,68 @@ static void _event_cb(ng_netdev_event_t event, void *data)
     }
 }
 
+/**
+ * @brief   Handles NETDEV and NETAPI messages
+ *
+ * @param[in] ctx           the NOMAC state
+ * @param[in] msg           the message
+ *
+ * @return                  the reply to get and set messages
+ */
+static int _handle(void *ctx, msg_t *msg)
+{
+    _nomac_t *nomac = (_nomac_t *)ctx;
+    ng_netdev_t *dev = nomac->dev;
+    ng_netapi_opt_t *opt;
+    unsigned long start;
+    int res;
+
+    switch (msg->type) {
+        case NG_NETDEV_MSG_TYPE_EVENT:
+            DEBUG("nomac: NG_NETDEV_MSG_TYPE_EVENT received\n");
+            dev->driver->isr_event(dev, msg->content.value);
+            return 0;
+        case NG_NETAPI_MSG_TYPE_SND:
+            DEBUG("nomac: NG_NETAPI_MSG_TYPE_SND received\n");
+            start = ng_netstats_start();
+            dev->driver->send_data(dev, (ng_pktsnip_t *)msg->content.ptr);
+            ng_netstats_done(&nomac->stats, start);
+            return 0;
+        case NG_NETAPI_MSG_TYPE_SET:
+            /* TODO: filter out MAC layer options -> for now forward
+                     everything to the device driver */
+            DEBUG("nomac: NG_NETAPI_MSG_TYPE_SET received\n");
+            /* read incoming options */
+            opt = (ng_netapi_opt_t *)msg->content.ptr;
+            /* set option for device driver */
+            res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+            DEBUG("nomac: response of netdev->set: %i\n", res);
+            return res;
+        case NG_NETAPI_MSG_TYPE_GET:
+            /* TODO: filter out MAC layer options -> for now forward
+                     everything to the device driver */
+            DEBUG("nomac: NG_NETAPI_MSG_TYPE_GET received\n");
+            /* read incoming options */
+            opt = (ng_netapi_opt_t *)msg->content.ptr;
+            if (opt->opt == NETCONF_OPT_STATS) {
+                return ng_netstats_get(&nomac->stats, opt);
+            }
+            /* get option from device driver */
+            res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+            DEBUG("nomac: response of netdev->get: %i\n", res);
+            return res;
+        default:
+#ifdef MODULE_NG_NETAPI_DIRECT
+            /* messages for the layers running in this thread */
+            if (ng_netapi_direct_dispatch(msg)) {
+                return 0;
+            }
+#endif
+            DEBUG("nomac: Unknown command %" PRIu16 "\n", msg->type);
+            return -ENOTSUP;
+    }
+}
+
 /**
  * @brief   Startup code and event loop of the NOMAC layer
  *
@@ -71,8 +142,7 @@ static void _event_cb(ng_netdev_event_t event, void *data)
 static void *_nomac_thread(void *args)
 {
     ng_netdev_t *dev = (ng_netdev_t *)args;
-    ng_netapi_opt_t *opt;
-    int res;
+    _nomac_t nomac;
     msg_t msg, reply, msg_queue[NG_NOMAC_MSG_QUEUE_SIZE];
 
     /* setup the MAC layers message queue */
@@ -80,54 +150,27 @@ static void *_nomac_thread(void *args)
     /* save the PID to the device descriptor and register the device */
     dev->mac_pid = thread_getpid();
     ng_netif_add(dev->mac_pid);
+    nomac.dev = dev;
+    ng_netstats_register(&nomac.stats, dev->mac_pid, "nomac");
     /* register the event callback with the device driver */
     dev->driver->add_event_callback(dev, _event_cb);
+#ifdef MODULE_NG_NETAPI_DIRECT
+    /* run the layers above in this thread */
+    ng_netapi_direct_run(_handle, &nomac);
+#endif
 
     /* start the event loop */
     while (1) {
         DEBUG("nomac: waiting for incoming messages\n");
         msg_receive(&msg);
+        ng_netstats_queue(&nomac.stats);
         /* dispatch NETDEV and NETAPI messages */
-        switch (msg.type) {
-            case NG_NETDEV_MSG_TYPE_EVENT:
-                DEBUG("nomac: NG_NETDEV_MSG_TYPE_EVENT received\n");
-                dev->driver->isr_event(dev, msg.content.value);
-                break;
-            case NG_NETAPI_MSG_TYPE_SND:
-                DEBUG("nomac: NG_NETAPI_MSG_TYPE_SND received\n");
-                dev->driver->send_data(dev, (ng_pktsnip_t *)msg.content.ptr);
-                break;
-            case NG_NETAPI_MSG_TYPE_SET:
-                /* TODO: filter out MAC layer options -> for now forward
-                         everything to the device driver */
-                DEBUG("nomac: NG_NETAPI_MSG_TYPE_SET received\n");
-                /* read incoming options */
-                opt = (ng_netapi_opt_t *)msg.content.ptr;
-                /* set option for device driver */
-                res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
-                DEBUG("nomac: response of netdev->set: %i\n", res);
-                /* send reply to calling thread */
-                reply.type = NG_NETAPI_MSG_TYPE_ACK;
-                reply.content.value = (uint32_t)res;
-                msg_reply(&msg, &reply);
-                break;
-            case NG_NETAPI_MSG_TYPE_GET:
-                /* TODO: filter out MAC layer options -> for now forward
-                         everything to the device driver */
-                DEBUG("nomac: NG_NETAPI_MSG_TYPE_GET received\n");
-                /* read incoming options */
-                opt = (ng_netapi_opt_t *)msg.content.ptr;
-                /* get option from device driver */
-                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
-                DEBUG("nomac: response of netdev->get: %i\n", res);
-                /* send reply to calling thread */
-                reply.type = NG_NETAPI_MSG_TYPE_ACK;
-                reply.content.value = (uint32_t)res;
-                msg_reply(&msg, &reply);
-                break;
-            default:
-                DEBUG("nomac: Unknown command %" PRIu16 "\n", msg.type);
-                break;
+        reply.content.value = (uint32_t)_handle(&nomac, &msg);
+        if ((msg.type == NG_NETAPI_MSG_TYPE_SET) ||
+            (msg.type == NG_NETAPI_MSG_TYPE_GET)) {
+            /* send reply to calling thread */
+            reply.type = NG_NETAPI_MSG_TYPE_ACK;
+            msg_reply(&msg, &reply);
         }
     }
     /* never reached */
@@ -46,6 +46,7 @@
 #define _SLIP_MSG_TYPE          (0xc1dc)    /* chosen randomly */
 #define _SLIP_NAME              "SLIP"
 #define _SLIP_MSG_QUEUE_SIZE    (8U)
+#define _SLIP_TX_CHUNK          (32U)   /* encoded bytes per uart_write_bulk() */
 
 #define _SLIP_DEV(arg)    ((ng_slip_dev_t *)arg)
 
@@ -95,17 +96,6 @@ static void _slip_rx_cb(void *arg, char data)
     }
 }
 
-int _slip_tx_cb(void *arg)
-{
-    if (_SLIP_DEV(arg)->out_buf->avail > 0) {
-        char c = (char)ringbuffer_get_one(_SLIP_DEV(arg)->out_buf);
-        uart_write((uart_t)(_SLIP_DEV(arg)->uart), c);
-        return 1;
-    }
-
-    return 0;
-}
-
 /* SLIP receive handler */
 static void _slip_receive(ng_slip_dev_t *dev, size_t bytes)
 {
@@ -161,39 +151,41 @@ static void _slip_receive(ng_slip_dev_t *dev, size_t bytes)
     }
 }
 
-static inline void _slip_send_char(ng_slip_dev_t *dev, char c)
-{
-    ringbuffer_add_one(dev->out_buf, c);
-    uart_tx_begin(dev->uart);
-}
-
 /* SLIP send handler */
 static void _slip_send(ng_slip_dev_t *dev, ng_pktsnip_t *pkt)
 {
     ng_pktsnip_t *ptr;
+    char out[_SLIP_TX_CHUNK];
+    size_t out_len = 0;
 
     ptr = pkt->next;    /* ignore ng_netif_hdr_t, we don't need it */
 
     while (ptr != NULL) {
-        DEBUG("slip: send pktsnip of length %zu over UART_%d\n", ptr->size, uart);
+        DEBUG("slip: send pktsnip of length %zu over UART_%d\n", ptr->size, dev->uart);
         char *data = ptr->data;
 
         for (size_t i = 0; i < ptr->size; i++) {
+            /* keep room for an escape sequence */
+            if (out_len > sizeof(out) - 2) {
+                uart_write_bulk(dev->uart, out, out_len);
+                out_len = 0;
+            }
+
             switch (data[i]) {
                 case _SLIP_END:
                     DEBUG("slip: encountered END byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_END_ESC);
+                    out[out_len++] = _SLIP_ESC;
+                    out[out_len++] = _SLIP_END_ESC;
                     break;
 
                 case _SLIP_ESC:
                     DEBUG("slip: encountered ESC byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_ESC_ESC);
+                    out[out_len++] = _SLIP_ESC;
+                    out[out_len++] = _SLIP_ESC_ESC;
                     break;
 
                 default:
-                    _slip_send_char(dev, data[i]);
+                    out[out_len++] = data[i];
 
                     break;
             }
@@ -202,7 +194,12 @@ static void _slip_send(ng_slip_dev_t *dev, ng_pktsnip_t *pkt)
         ptr = ptr->next;
     }
 
-    _slip_send_char(dev, _SLIP_END);
+    if (out_len == sizeof(out)) {
+        uart_write_bulk(dev->uart, out, out_len);
+        out_len = 0;
+    }
+    out[out_len++] = _SLIP_END;
+    uart_write_bulk(dev->uart, out, out_len);
 
     ng_pktbuf_release(pkt);
 }
@@ -261,11 +258,10 @@ kernel_pid_t ng_slip_init(ng_slip_dev_t *dev, uart_t uart, uint32_t baudrate,
 
     /* initialize buffers */
     ringbuffer_init(dev->in_buf, dev->rx_mem, sizeof(dev->rx_mem));
-    ringbuffer_init(dev->out_buf, dev->tx_mem, sizeof(dev->tx_mem));
 
     /* initialize UART */
     DEBUG("slip: initialize UART_%d\n", uart);
-    res = uart_init(uart, baudrate, _slip_rx_cb, _slip_tx_cb, dev);
+    res = uart_init_bulk(uart, baudrate, _slip_rx_cb, dev);
     if (res < 0) {
         DEBUG("slip: error initializing UART_%i with baudrate %u\n",
               uart, baudrate);
@@ -218,7 +218,8 @@ ng_ipv6_nc_t *ng_ipv6_nc_still_reachable(const ng_ipv6_addr_t *ipv6_addr)
         timex_t t = iface->reach_time;
 
         vtimer_remove(&entry->nbr_sol_timer);
-        vtimer_set_msg(&entry->nbr_sol_timer, t, ng_ipv6_pid,
+        vtimer_set_msg(&entry->nbr_sol_timer, t,
+                       ng_netapi_msg_pid(ng_ipv6_pid),
                        NG_NDP_MSG_NC_STATE_TIMEOUT, entry);
 #endif
 
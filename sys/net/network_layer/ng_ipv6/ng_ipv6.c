@@ -20,6 +20,7 @@
 #include "kernel_types.h"
 #include "net/ng_icmpv6.h"
 #include "net/ng_netbase.h"
+#include "net/ng_netstats.h"
 #include "net/ng_ndp.h"
 #include "net/ng_protnum.h"
 #include "thread.h"
@@ -35,11 +36,13 @@
 
 #define _MAX_L2_ADDR_LEN    (8U)
 
+#ifndef MODULE_NG_NETAPI_DIRECT
 #if ENABLE_DEBUG
 static char _stack[NG_IPV6_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[NG_IPV6_STACK_SIZE];
 #endif
+#endif
 
 #if ENABLE_DEBUG
 static char addr_str[NG_IPV6_ADDR_MAX_STR_LEN];
@@ -47,6 +50,8 @@ static char addr_str[NG_IPV6_ADDR_MAX_STR_LEN];
 
 kernel_pid_t ng_ipv6_pid = KERNEL_PID_UNDEF;
 
+static ng_netstats_t _stats;
+
 /* handles NG_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(ng_pktsnip_t *pkt);
 /* dispatches received IPv6 packet for upper layer */
@@ -56,8 +61,12 @@ static void _dispatch_rcv_pkt(ng_nettype_t type, uint32_t demux_ctx,
  * prep_hdr: prepare header for sending (call to _fill_ipv6_hdr()), otherwise
  * assume it is already prepared */
 static void _send(ng_pktsnip_t *pkt, bool prep_hdr);
+/* Handles a message to IPv6 */
+static int _handle(void *ctx, msg_t *msg);
+#ifndef MODULE_NG_NETAPI_DIRECT
 /* Main event loop for IPv6 */
 static void *_event_loop(void *args);
+#endif
 
 /* Handles encapsulated IPv6 packets: http://tools.ietf.org/html/rfc2473 */
 static void _decapsulate(ng_pktsnip_t *pkt);
@@ -65,8 +74,20 @@ static void _decapsulate(ng_pktsnip_t *pkt);
 kernel_pid_t ng_ipv6_init(void)
 {
     if (ng_ipv6_pid == KERNEL_PID_UNDEF) {
+#ifdef MODULE_NG_NETAPI_DIRECT
+        static ng_netreg_entry_t me_reg;
+
+        ng_ipv6_pid = ng_netapi_direct_register(_handle, NULL);
+        ng_netstats_register(&_stats, ng_ipv6_pid, "ipv6");
+        me_reg.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
+        me_reg.pid = ng_ipv6_pid;
+
+        /* register interest in all IPv6 packets */
+        ng_netreg_register(NG_NETTYPE_IPV6, &me_reg);
+#else
         ng_ipv6_pid = thread_create(_stack, sizeof(_stack), NG_IPV6_PRIO,
                              CREATE_STACKTEST, _event_loop, NULL, "ipv6");
+#endif
     }
 
     return ng_ipv6_pid;
@@ -123,6 +144,63 @@ void ng_ipv6_demux(kernel_pid_t iface, ng_pktsnip_t *pkt, uint8_t nh)
 }
 
 /* internal functions */
+static int _handle(void *ctx, msg_t *msg)
+{
+    unsigned long start;
+
+    (void)ctx;
+
+    switch (msg->type) {
+        case NG_NETAPI_MSG_TYPE_RCV:
+            DEBUG("ipv6: NG_NETAPI_MSG_TYPE_RCV received\n");
+            start = ng_netstats_start();
+            _receive((ng_pktsnip_t *)msg->content.ptr);
+            ng_netstats_done(&_stats, start);
+            break;
+
+        case NG_NETAPI_MSG_TYPE_SND:
+            DEBUG("ipv6: NG_NETAPI_MSG_TYPE_SND received\n");
+            start = ng_netstats_start();
+            _send((ng_pktsnip_t *)msg->content.ptr, true);
+            ng_netstats_done(&_stats, start);
+            break;
+
+        case NG_NETAPI_MSG_TYPE_GET:
+            return ng_netstats_get(&_stats, (ng_netapi_opt_t *)msg->content.ptr);
+
+        case NG_NETAPI_MSG_TYPE_SET:
+            DEBUG("ipv6: reply to unsupported set\n");
+            return -ENOTSUP;
+
+        case NG_NDP_MSG_RTR_TIMEOUT:
+            DEBUG("ipv6: Router timeout received\n");
+            ((ng_ipv6_nc_t *)msg->content.ptr)->flags &= ~NG_IPV6_NC_IS_ROUTER;
+            break;
+
+        case NG_NDP_MSG_ADDR_TIMEOUT:
+            DEBUG("ipv6: Router advertisement timer event received\n");
+            ng_ipv6_netif_remove_addr(KERNEL_PID_UNDEF,
+                                      (ng_ipv6_addr_t *)msg->content.ptr);
+            break;
+
+        case NG_NDP_MSG_NBR_SOL_RETRANS:
+            DEBUG("ipv6: Neigbor solicitation retransmission timer event received\n");
+            ng_ndp_retrans_nbr_sol((ng_ipv6_nc_t *)msg->content.ptr);
+            break;
+
+        case NG_NDP_MSG_NC_STATE_TIMEOUT:
+            DEBUG("ipv6: Neigbor cace state timeout received\n");
+            ng_ndp_state_timeout((ng_ipv6_nc_t *)msg->content.ptr);
+            break;
+
+        default:
+            return -ENOTSUP;
+    }
+
+    return 0;
+}
+
+#ifndef MODULE_NG_NETAPI_DIRECT
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[NG_IPV6_MSG_QUEUE_SIZE];
@@ -133,6 +211,7 @@ static void *_event_loop(void *args)
 
     me_reg.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
     me_reg.pid = thread_getpid();
+    ng_netstats_register(&_stats, me_reg.pid, "ipv6");
 
     /* register interest in all IPv6 packets */
     ng_netreg_register(NG_NETTYPE_IPV6, &me_reg);
@@ -144,53 +223,18 @@ static void *_event_loop(void *args)
     while (1) {
         DEBUG("ipv6: waiting for incoming message.\n");
         msg_receive(&msg);
+        ng_netstats_queue(&_stats);
 
-        switch (msg.type) {
-            case NG_NETAPI_MSG_TYPE_RCV:
-                DEBUG("ipv6: NG_NETAPI_MSG_TYPE_RCV received\n");
-                _receive((ng_pktsnip_t *)msg.content.ptr);
-                break;
-
-            case NG_NETAPI_MSG_TYPE_SND:
-                DEBUG("ipv6: NG_NETAPI_MSG_TYPE_SND received\n");
-                _send((ng_pktsnip_t *)msg.content.ptr, true);
-                break;
-
-            case NG_NETAPI_MSG_TYPE_GET:
-            case NG_NETAPI_MSG_TYPE_SET:
-                DEBUG("ipv6: reply to unsupported get/set\n");
-                reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
-                break;
-
-            case NG_NDP_MSG_RTR_TIMEOUT:
-                DEBUG("ipv6: Router timeout received\n");
-                ((ng_ipv6_nc_t *)msg.content.ptr)->flags &= ~NG_IPV6_NC_IS_ROUTER;
-                break;
-
-            case NG_NDP_MSG_ADDR_TIMEOUT:
-                DEBUG("ipv6: Router advertisement timer event received\n");
-                ng_ipv6_netif_remove_addr(KERNEL_PID_UNDEF,
-                                          (ng_ipv6_addr_t *)msg.content.ptr);
-                break;
-
-            case NG_NDP_MSG_NBR_SOL_RETRANS:
-                DEBUG("ipv6: Neigbor solicitation retransmission timer event received\n");
-                ng_ndp_retrans_nbr_sol((ng_ipv6_nc_t *)msg.content.ptr);
-                break;
-
-            case NG_NDP_MSG_NC_STATE_TIMEOUT:
-                DEBUG("ipv6: Neigbor cace state timeout received\n");
-                ng_ndp_state_timeout((ng_ipv6_nc_t *)msg.content.ptr);
-                break;
-
-            default:
-                break;
+        reply.content.value = (uint32_t)_handle(NULL, &msg);
+        if ((msg.type == NG_NETAPI_MSG_TYPE_GET) ||
+            (msg.type == NG_NETAPI_MSG_TYPE_SET)) {
+            msg_reply(&msg, &reply);
         }
     }
 
     return NULL;
 }
+#endif
 
 #ifdef MODULE_NG_SIXLOWPAN
 static void _send_to_iface(kernel_pid_t iface, ng_pktsnip_t *pkt)
@@ -250,6 +294,7 @@ static void _send_unicast(kernel_pid_t iface, uint8_t *dst_l2addr,
 
     if (netif == NULL) {
         DEBUG("ipv6: error on interface header allocation, dropping packet\n");
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -356,6 +401,7 @@ static void _send_multicast(kernel_pid_t iface, ng_pktsnip_t *pkt,
         /* throw away packet if no one is interested */
         if (ifnum == 0) {
             DEBUG("ipv6: no interfaces registered, dropping packet\n");
+            ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NO_ROUTE);
             ng_pktbuf_release(pkt);
             return;
         }
@@ -377,6 +423,7 @@ static void _send_multicast(kernel_pid_t iface, ng_pktsnip_t *pkt,
                 if (ipv6 == NULL) {
                     DEBUG("ipv6: unable to get write access to IPv6 header, "
                           "for interface %" PRIkernel_pid "\n", ifs[i]);
+                    ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
                     ng_pktbuf_release(pkt);
                     return;
                 }
@@ -394,6 +441,7 @@ static void _send_multicast(kernel_pid_t iface, ng_pktsnip_t *pkt,
             if (netif == NULL) {
                 DEBUG("ipv6: error on interface header allocation, "
                       "dropping packet\n");
+                ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
                 ng_pktbuf_release(pkt);
                 return;
             }
@@ -427,6 +475,7 @@ static void _send_multicast(kernel_pid_t iface, ng_pktsnip_t *pkt,
         if (netif == NULL) {
             DEBUG("ipv6: error on interface header allocation, "
                   "dropping packet\n");
+            ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
             ng_pktbuf_release(pkt);
             return;
         }
@@ -459,6 +508,7 @@ static void _send(ng_pktsnip_t *pkt, bool prep_hdr)
 
     if (payload == NULL) {
         DEBUG("ipv6: unable to get write access to packet, dropping packet\n");
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -491,6 +541,7 @@ static void _send(ng_pktsnip_t *pkt, bool prep_hdr)
 
         if (iface == KERNEL_PID_UNDEF) {
             DEBUG("ipv6: error determining next hop's link layer address\n");
+            ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NO_ROUTE);
             ng_pktbuf_release(pkt);
             return;
         }
@@ -567,6 +618,7 @@ static void _receive(ng_pktsnip_t *pkt)
 
         if (ipv6 == NULL) {
             DEBUG("ipv6: unable to get write access to packet, drop it\n");
+            ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
             ng_pktbuf_release(pkt);
             return;
         }
@@ -578,6 +630,7 @@ static void _receive(ng_pktsnip_t *pkt)
 
         if (ipv6 == NULL) {
             DEBUG("ipv6: error marking IPv6 header, dropping packet\n");
+            ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
             ng_pktbuf_release(pkt);
             return;
         }
@@ -611,6 +664,7 @@ static void _receive(ng_pktsnip_t *pkt)
 
             if ((ipv6 == NULL) || (pkt == NULL)) {
                 DEBUG("ipv6: unable to get write access to packet: dropping it\n");
+                ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
                 ng_pktbuf_release(tmp);
                 return;
             }
@@ -622,6 +676,7 @@ static void _receive(ng_pktsnip_t *pkt)
         }
         else {
             DEBUG("ipv6: hop limit reached 0: drop packet\n");
+            ng_netstats_drop(&_stats, NG_NETSTATS_DROP_HOP_LIMIT);
             ng_pktbuf_release(pkt);
             return;
         }
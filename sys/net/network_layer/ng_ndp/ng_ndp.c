@@ -69,7 +69,8 @@ static void _set_state(ng_ipv6_nc_t *nc_entry, uint8_t state);
 static inline void _send_delayed(vtimer_t *t, timex_t interval, ng_pktsnip_t *pkt)
 {
     vtimer_remove(t);
-    vtimer_set_msg(t, interval, ng_ipv6_pid, NG_NETAPI_MSG_TYPE_SND, pkt);
+    vtimer_set_msg(t, interval, ng_netapi_msg_pid(ng_ipv6_pid),
+                   ng_netapi_msg_type(ng_ipv6_pid, NG_NETAPI_MSG_TYPE_SND), pkt);
 }
 
 /* packet queue node allocation */
@@ -309,7 +310,8 @@ void ng_ndp_retrans_nbr_sol(ng_ipv6_nc_t *nc_entry)
             }
 
             vtimer_remove(&nc_entry->nbr_sol_timer);
-            vtimer_set_msg(&nc_entry->nbr_sol_timer, t, ng_ipv6_pid,
+            vtimer_set_msg(&nc_entry->nbr_sol_timer, t,
+                           ng_netapi_msg_pid(ng_ipv6_pid),
                            NG_NDP_MSG_NBR_SOL_RETRANS, nc_entry);
         }
         else {
@@ -320,7 +322,8 @@ void ng_ndp_retrans_nbr_sol(ng_ipv6_nc_t *nc_entry)
             mutex_lock(&ipv6_iface->mutex);
             vtimer_remove(&nc_entry->nbr_sol_timer);
             vtimer_set_msg(&nc_entry->nbr_sol_timer,
-                           ipv6_iface->retrans_timer, ng_ipv6_pid,
+                           ipv6_iface->retrans_timer,
+                           ng_netapi_msg_pid(ng_ipv6_pid),
                            NG_NDP_MSG_NBR_SOL_RETRANS, nc_entry);
             mutex_unlock(&ipv6_iface->mutex);
         }
@@ -472,15 +475,17 @@ kernel_pid_t ng_ndp_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
                 return KERNEL_PID_UNDEF;
             }
 
-            pkt_node = _alloc_pkt_node(pkt);
+            if (pkt != NULL) {
+                pkt_node = _alloc_pkt_node(pkt);
 
-            if (pkt_node == NULL) {
-                DEBUG("ndp: could not add packet to packet queue\n");
-            }
-            else {
-                /* prevent packet from being released by IPv6 */
-                ng_pktbuf_hold(pkt_node->pkt, 1);
-                ng_pktqueue_add(&nc_entry->pkts, pkt_node);
+                if (pkt_node == NULL) {
+                    DEBUG("ndp: could not add packet to packet queue\n");
+                }
+                else {
+                    /* prevent packet from being released by IPv6 */
+                    ng_pktbuf_hold(pkt_node->pkt, 1);
+                    ng_pktqueue_add(&nc_entry->pkts, pkt_node);
+                }
             }
 
             /* address resolution */
@@ -496,7 +501,8 @@ kernel_pid_t ng_ndp_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
                 }
 
                 vtimer_remove(&nc_entry->nbr_sol_timer);
-                vtimer_set_msg(&nc_entry->nbr_sol_timer, t, ng_ipv6_pid,
+                vtimer_set_msg(&nc_entry->nbr_sol_timer, t,
+                               ng_netapi_msg_pid(ng_ipv6_pid),
                                NG_NDP_MSG_NBR_SOL_RETRANS, nc_entry);
             }
             else {
@@ -507,7 +513,8 @@ kernel_pid_t ng_ndp_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
                 mutex_lock(&ipv6_iface->mutex);
                 vtimer_remove(&nc_entry->nbr_sol_timer);
                 vtimer_set_msg(&nc_entry->nbr_sol_timer,
-                               ipv6_iface->retrans_timer, ng_ipv6_pid,
+                               ipv6_iface->retrans_timer,
+                               ng_netapi_msg_pid(ng_ipv6_pid),
                                NG_NDP_MSG_NBR_SOL_RETRANS, nc_entry);
                 mutex_unlock(&ipv6_iface->mutex);
             }
@@ -929,7 +936,8 @@ static void _set_state(ng_ipv6_nc_t *nc_entry, uint8_t state)
             /* we intentionally fall through here to set the desired timeout t */
         case NG_IPV6_NC_STATE_DELAY:
             vtimer_remove(&nc_entry->nbr_sol_timer);
-            vtimer_set_msg(&nc_entry->nbr_sol_timer, t, ng_ipv6_pid,
+            vtimer_set_msg(&nc_entry->nbr_sol_timer, t,
+                           ng_netapi_msg_pid(ng_ipv6_pid),
                            NG_NDP_MSG_NC_STATE_TIMEOUT, nc_entry);
             break;
 
@@ -943,7 +951,8 @@ static void _set_state(ng_ipv6_nc_t *nc_entry, uint8_t state)
             mutex_lock(&ipv6_iface->mutex);
             vtimer_remove(&nc_entry->nbr_sol_timer);
             vtimer_set_msg(&nc_entry->nbr_sol_timer,
-                           ipv6_iface->retrans_timer, ng_ipv6_pid,
+                           ipv6_iface->retrans_timer,
+                           ng_netapi_msg_pid(ng_ipv6_pid),
                            NG_NDP_MSG_NBR_SOL_RETRANS, nc_entry);
             mutex_unlock(&ipv6_iface->mutex);
             break;
@@ -26,8 +26,20 @@ static ng_sixlowpan_ctx_t _ctxs[NG_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[NG_SIXLOWPAN_CTX_SIZE];
 static mutex_t _ctx_mutex = MUTEX_INIT;
 
+/**
+ * @brief   Identifiers of all contexts with a lifetime > 0, sorted by
+ *          descending prefix length.
+ *
+ * Rebuilt on every update, so an address lookup can stop at the first
+ * matching context (which then has the longest matching prefix) instead of
+ * comparing the address against every context.
+ */
+static uint8_t _ctx_idx[NG_SIXLOWPAN_CTX_SIZE];
+static unsigned int _ctx_idx_len = 0;
+
 static uint32_t _current_minute(void);
 static void _update_lifetime(unsigned int id);
+static void _index_rebuild(void);
 
 #if ENABLE_DEBUG
 static char ipv6str[NG_IPV6_ADDR_MAX_STR_LEN];
@@ -41,19 +53,17 @@ static inline bool _still_valid(unsigned int id)
 
 ng_sixlowpan_ctx_t *ng_sixlowpan_ctx_lookup_addr(const ng_ipv6_addr_t *addr)
 {
-    uint8_t best = 0;
     ng_sixlowpan_ctx_t *res = NULL;
 
     mutex_lock(&_ctx_mutex);
 
-    for (unsigned int id = 0; id < NG_SIXLOWPAN_CTX_SIZE; id++) {
-        if (_still_valid(id)) {
-            uint8_t match = ng_ipv6_addr_match_prefix(&_ctxs[id].prefix, addr);
+    for (unsigned int i = 0; i < _ctx_idx_len; i++) {
+        unsigned int id = _ctx_idx[i];
 
-            if ((_ctxs[id].prefix_len <= match) && (match > best)) {
-                best = match;
-                res = &(_ctxs[id]);
-            }
+        if (_still_valid(id) &&
+            (ng_ipv6_addr_match_prefix(&_ctxs[id].prefix, addr) >= _ctxs[id].prefix_len)) {
+            res = &(_ctxs[id]);
+            break;
         }
     }
 
@@ -104,6 +114,7 @@ ng_sixlowpan_ctx_t *ng_sixlowpan_ctx_update(uint8_t id, const ng_ipv6_addr_t *pr
     _ctxs[id].ltime = ltime;
 
     if (ltime == 0) {
+        _index_rebuild();
         mutex_unlock(&_ctx_mutex);
         DEBUG("6lo ctx: remove context (%u, %s/%" PRIu8 ")\n", id,
               ng_ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
@@ -114,8 +125,9 @@ ng_sixlowpan_ctx_t *ng_sixlowpan_ctx_update(uint8_t id, const ng_ipv6_addr_t *pr
     /* test prefix_len now so that invalidation is possible regardless of the
      * value. */
     if (prefix_len == 0) {
-        mutex_unlock(&_ctx_mutex);
         _ctxs[id].ltime = 0;
+        _index_rebuild();
+        mutex_unlock(&_ctx_mutex);
         return NULL;
     }
 
@@ -137,6 +149,7 @@ ng_sixlowpan_ctx_t *ng_sixlowpan_ctx_update(uint8_t id, const ng_ipv6_addr_t *pr
           id, ng_ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    _index_rebuild();
 
     mutex_unlock(&_ctx_mutex);
 
@@ -169,12 +182,39 @@ static void _update_lifetime(unsigned int id)
     }
 }
 
+static void _index_rebuild(void)
+{
+    _ctx_idx_len = 0;
+
+    for (unsigned int id = 0; id < NG_SIXLOWPAN_CTX_SIZE; id++) {
+        unsigned int pos;
+
+        if (_ctxs[id].ltime == 0) {
+            continue;
+        }
+
+        /* insertion sort, contexts with equal prefix length stay in order
+         * of their identifiers */
+        for (pos = _ctx_idx_len; pos > 0; pos--) {
+            if (_ctxs[_ctx_idx[pos - 1]].prefix_len >= _ctxs[id].prefix_len) {
+                break;
+            }
+
+            _ctx_idx[pos] = _ctx_idx[pos - 1];
+        }
+
+        _ctx_idx[pos] = (uint8_t)id;
+        _ctx_idx_len++;
+    }
+}
+
 #ifdef TEST_SUITES
 #include <string.h>
 
 void ng_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    _ctx_idx_len = 0;
 }
 #endif
 
@@ -21,6 +21,9 @@
 #include "utlist.h"
 
 #include "rbuf.h"
+#ifdef MODULE_NG_SIXLOWPAN_FRAG_FWD
+#include "vrb.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -234,6 +237,13 @@ void ng_sixlowpan_frag_send(kernel_pid_t pid, ng_pktsnip_t *pkt,
     _tag++;
 }
 
+#ifdef MODULE_NG_SIXLOWPAN_FRAG_FWD
+uint16_t ng_sixlowpan_frag_next_tag(void)
+{
+    return _tag++;
+}
+#endif
+
 void ng_sixlowpan_frag_handle_pkt(ng_pktsnip_t *pkt)
 {
     ng_netif_hdr_t *hdr = pkt->next->data;
@@ -258,6 +268,12 @@ void ng_sixlowpan_frag_handle_pkt(ng_pktsnip_t *pkt)
             return;
     }
 
+#ifdef MODULE_NG_SIXLOWPAN_FRAG_FWD
+    if (vrb_forward(pkt, offset)) {
+        return;
+    }
+#endif
+
     rbuf_add(hdr, frag, frag_size, offset);
 
     ng_pktbuf_release(pkt);
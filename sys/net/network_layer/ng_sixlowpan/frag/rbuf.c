@@ -19,6 +19,7 @@
 #include "net/ng_netapi.h"
 #include "net/ng_netif.h"
 #include "net/ng_netif/hdr.h"
+#include "net/ng_netstats.h"
 #include "net/ng_pktbuf.h"
 #include "net/ng_ipv6/netif.h"
 #include "net/ng_sixlowpan.h"
@@ -167,7 +168,8 @@ void rbuf_add(ng_netif_hdr_t *netif_hdr, ng_sixlowpan_frag_t *frag,
         LL_APPEND(entry->pkt, netif);
 
         DEBUG("6lo rbuf: datagram complete, send to self\n");
-        ng_netapi_receive(thread_getpid(), entry->pkt);
+        /* not the calling thread, 6LoWPAN may run without thread */
+        ng_netapi_receive(ng_sixlowpan_init(), entry->pkt);
         _rbuf_rem(entry);
     }
 }
@@ -252,6 +254,8 @@ static void _rbuf_gc(void)
                                        rbuf[i].dst_len),
                   rbuf[i].datagram_size, rbuf[i].tag);
 
+            ng_netstats_drop_pid(ng_sixlowpan_init(),
+                                 NG_NETSTATS_DROP_REASS_TIMEOUT);
             ng_pktbuf_release(rbuf[i].pkt);
             _rbuf_rem(&(rbuf[i]));
         }
@@ -262,6 +266,7 @@ static void _rbuf_gc(void)
 
     if ((i >= RBUF_SIZE) && (oldest != NULL) && (oldest->pkt != NULL)) {
         DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
+        ng_netstats_drop_pid(ng_sixlowpan_init(), NG_NETSTATS_DROP_NOBUF);
         ng_pktbuf_release(oldest->pkt);
         _rbuf_rem(oldest);
     }
@@ -0,0 +1,391 @@
+/*
+ * Copyright (C) 2015 Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#ifdef MODULE_NG_SIXLOWPAN_FRAG_FWD
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "vrb.h"
+#include "net/ng_ipv6/addr.h"
+#include "net/ng_ipv6/hdr.h"
+#include "net/ng_ipv6/netif.h"
+#include "net/ng_ndp.h"
+#include "net/ng_netapi.h"
+#include "net/ng_netif.h"
+#include "net/ng_netif/hdr.h"
+#include "net/ng_pktbuf.h"
+#include "net/ng_sixlowpan.h"
+#include "net/ng_sixlowpan/frag.h"
+#include "net/ng_sixlowpan/iphc.h"
+#include "net/ng_sixlowpan/netif.h"
+#include "timex.h"
+#include "vtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static vrb_t vrb[VRB_SIZE];
+
+#if ENABLE_DEBUG
+static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
+#endif
+
+/* ------------------------------------
+ * internal function definitions
+ * ------------------------------------*/
+/* removes timed out entries */
+static void _vrb_gc(uint32_t now);
+/* gets an entry identified by its tupel */
+static vrb_t *_vrb_get(const void *src, size_t src_len, size_t size,
+                       uint16_t tag);
+/* gets a free entry (oldest if full) */
+static vrb_t *_vrb_get_free(void);
+/* turns a copy of the first fragment's payload into an IPv6 header snip */
+static ng_pktsnip_t *_decompress(ng_pktsnip_t *payload);
+/* turns an IPv6 header snip behind netif into a 6LoWPAN dispatch */
+static bool _compress(ng_sixlowpan_netif_t *iface, ng_pktsnip_t *netif);
+/* makes the forwarding decision for a datagram and sends its first fragment */
+static bool _forward_1st(ng_pktsnip_t *pkt, uint16_t size, uint16_t tag,
+                         uint32_t now);
+/* sends subsequent fragment of a datagram to the next hop */
+static bool _forward_nth(vrb_t *entry, ng_pktsnip_t *pkt, size_t offset);
+
+bool vrb_forward(ng_pktsnip_t *pkt, size_t offset)
+{
+    ng_netif_hdr_t *netif_hdr = pkt->next->data;
+    ng_sixlowpan_frag_t *frag = pkt->data;
+    uint16_t size = byteorder_ntohs(frag->disp_size) & NG_SIXLOWPAN_FRAG_SIZE_MASK;
+    uint16_t tag = byteorder_ntohs(frag->tag);
+    vrb_t *entry;
+    timex_t now;
+
+    vtimer_now(&now);
+    _vrb_gc(now.seconds);
+    entry = _vrb_get(ng_netif_hdr_get_src_addr(netif_hdr),
+                     netif_hdr->src_l2addr_len, size, tag);
+
+    if ((frag->disp_size.u8[0] & NG_SIXLOWPAN_FRAG_DISP_MASK) ==
+        NG_SIXLOWPAN_FRAG_1_DISP) {
+        if (entry != NULL) {
+            /* retransmission or reused tag: decide again */
+            entry->src_len = 0;
+        }
+
+        return _forward_1st(pkt, size, tag, now.seconds);
+    }
+
+    if (entry == NULL) {
+        /* first fragment was not forwarded (or got lost) */
+        return false;
+    }
+
+    entry->arrival = now.seconds;
+
+    return _forward_nth(entry, pkt, offset);
+}
+
+static void _vrb_gc(uint32_t now)
+{
+    for (unsigned int i = 0; i < VRB_SIZE; i++) {
+        if ((vrb[i].src_len > 0) && ((now - vrb[i].arrival) > VRB_TIMEOUT)) {
+            DEBUG("6lo vrb: entry (%s, %u, %" PRIu16 ") timed out\n",
+                  ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                       vrb[i].src, vrb[i].src_len),
+                  vrb[i].datagram_size, vrb[i].tag);
+            vrb[i].src_len = 0;
+        }
+    }
+}
+
+static vrb_t *_vrb_get(const void *src, size_t src_len, size_t size,
+                       uint16_t tag)
+{
+    for (unsigned int i = 0; i < VRB_SIZE; i++) {
+        if ((vrb[i].src_len == src_len) && (src_len > 0) &&
+            (vrb[i].datagram_size == size) && (vrb[i].tag == tag) &&
+            (memcmp(vrb[i].src, src, src_len) == 0)) {
+            return &(vrb[i]);
+        }
+    }
+
+    return NULL;
+}
+
+static vrb_t *_vrb_get_free(void)
+{
+    vrb_t *oldest = NULL;
+
+    for (unsigned int i = 0; i < VRB_SIZE; i++) {
+        if (vrb[i].src_len == 0) {
+            return &(vrb[i]);
+        }
+        else if ((oldest == NULL) || (vrb[i].arrival < oldest->arrival)) {
+            oldest = &(vrb[i]);
+        }
+    }
+
+    DEBUG("6lo vrb: virtual reassembly buffer full, remove oldest entry\n");
+
+    return oldest;
+}
+
+static ng_pktsnip_t *_decompress(ng_pktsnip_t *payload)
+{
+    uint8_t *dispatch = payload->data;
+
+    if ((payload->size > sizeof(ng_ipv6_hdr_t)) &&
+        (dispatch[0] == NG_SIXLOWPAN_UNCOMPRESSED)) {
+        ng_pktsnip_t *sixlowpan;
+
+        /* packet is uncompressed: just mark and remove the dispatch */
+        sixlowpan = ng_pktbuf_add(payload, payload->data, sizeof(uint8_t),
+                                  NG_NETTYPE_SIXLOWPAN);
+
+        if (sixlowpan == NULL) {
+            return NULL;
+        }
+
+        payload = ng_pktbuf_remove_snip(payload, sixlowpan);
+
+        return ng_pktbuf_add(payload, payload->data, sizeof(ng_ipv6_hdr_t),
+                             NG_NETTYPE_IPV6);
+    }
+#ifdef MODULE_NG_SIXLOWPAN_IPHC
+    else if (ng_sixlowpan_iphc_is(dispatch)) {
+        if (!ng_sixlowpan_iphc_decode(payload)) {
+            return NULL;
+        }
+
+        return payload->next;
+    }
+#endif
+
+    return NULL;
+}
+
+static bool _compress(ng_sixlowpan_netif_t *iface, ng_pktsnip_t *netif)
+{
+    ng_pktsnip_t *sixlowpan;
+    uint8_t *disp;
+
+#ifdef MODULE_NG_SIXLOWPAN_IPHC
+    if (iface->iphc_enabled) {
+        return ng_sixlowpan_iphc_encode(netif);
+    }
+#else
+    (void)iface;
+#endif
+
+    sixlowpan = ng_pktbuf_add(NULL, NULL, sizeof(uint8_t), NG_NETTYPE_SIXLOWPAN);
+
+    if (sixlowpan == NULL) {
+        return false;
+    }
+
+    sixlowpan->next = netif->next;
+    netif->next = sixlowpan;
+    disp = sixlowpan->data;
+    disp[0] = NG_SIXLOWPAN_UNCOMPRESSED;
+
+    return true;
+}
+
+static bool _forward_1st(ng_pktsnip_t *pkt, uint16_t size, uint16_t tag,
+                         uint32_t now)
+{
+    ng_netif_hdr_t *netif_hdr = pkt->next->data;
+    ng_pktsnip_t *payload, *ipv6, *netif, *frag;
+    ng_ipv6_hdr_t *ipv6_hdr;
+    ng_sixlowpan_netif_t *sixlowpan_iface;
+    ng_sixlowpan_frag_t *frag_hdr;
+    vrb_t *entry;
+    uint8_t l2addr[RBUF_L2ADDR_MAX_LEN];
+    uint8_t l2addr_len = sizeof(l2addr);
+    kernel_pid_t iface;
+
+    if ((pkt->size <= sizeof(ng_sixlowpan_frag_t)) ||
+        (netif_hdr->src_l2addr_len > RBUF_L2ADDR_MAX_LEN)) {
+        return false;
+    }
+
+    /* decompress a copy: the fragment itself is still needed if the
+     * datagram turns out to require reassembly */
+    payload = ng_pktbuf_add(NULL, NULL, pkt->size - sizeof(ng_sixlowpan_frag_t),
+                            NG_NETTYPE_SIXLOWPAN);
+
+    if (payload == NULL) {
+        DEBUG("6lo vrb: no space left in packet buffer\n");
+        return false;
+    }
+
+    memcpy(payload->data, ((uint8_t *)pkt->data) + sizeof(ng_sixlowpan_frag_t),
+           payload->size);
+    ng_pktbuf_hold(pkt->next, 1);
+    payload->next = pkt->next;
+
+    if ((ipv6 = _decompress(payload)) == NULL) {
+        DEBUG("6lo vrb: can not decompress first fragment\n");
+        ng_pktbuf_release(payload);
+        return false;
+    }
+
+    ipv6_hdr = ipv6->data;
+
+    /* datagrams for this node, multicasts, and datagrams without a known
+     * next hop are left to reassembly and the IPv6 layer */
+    if (ng_ipv6_addr_is_multicast(&ipv6_hdr->dst) ||
+        (ng_ipv6_netif_find_by_addr(NULL, &ipv6_hdr->dst) != KERNEL_PID_UNDEF) ||
+        (ipv6_hdr->hl <= 1) ||
+        ((iface = ng_ndp_next_hop_l2addr(l2addr, &l2addr_len, KERNEL_PID_UNDEF,
+                                         &ipv6_hdr->dst, NULL)) <= KERNEL_PID_UNDEF) ||
+        ((sixlowpan_iface = ng_sixlowpan_netif_get(iface)) == NULL)) {
+        DEBUG("6lo vrb: datagram can not be forwarded, reassemble\n");
+        ng_pktbuf_release(payload);
+        return false;
+    }
+
+    /* from here on the datagram is forwarded or dropped as a whole, so the
+     * subsequent fragments must find an entry in either case */
+    entry = _vrb_get_free();
+    entry->arrival = now;
+    memcpy(entry->src, ng_netif_hdr_get_src_addr(netif_hdr),
+           netif_hdr->src_l2addr_len);
+    entry->src_len = netif_hdr->src_l2addr_len;
+    memcpy(entry->dst, l2addr, l2addr_len);
+    entry->dst_len = l2addr_len;
+    entry->iface = iface;
+    entry->tag = tag;
+    entry->datagram_size = size;
+    entry->discard = true;
+
+    /* the received fragment is not needed anymore */
+    ng_pktbuf_release(pkt);
+    ng_pktbuf_release(ipv6->next);      /* incoming interface header */
+    ipv6->next = payload;
+    payload->next = NULL;
+    ipv6_hdr->hl--;
+
+    netif = ng_netif_hdr_build(NULL, 0, l2addr, l2addr_len);
+
+    if (netif == NULL) {
+        DEBUG("6lo vrb: error allocating link-layer header\n");
+        ng_pktbuf_release(ipv6);
+        return true;
+    }
+
+    ((ng_netif_hdr_t *)netif->data)->if_pid = iface;
+    netif->next = ipv6;
+
+    if (!_compress(sixlowpan_iface, netif)) {
+        DEBUG("6lo vrb: error on compression\n");
+        ng_pktbuf_release(netif);
+        return true;
+    }
+
+    frag = ng_pktbuf_add(NULL, NULL, sizeof(ng_sixlowpan_frag_t),
+                         NG_NETTYPE_SIXLOWPAN);
+
+    if (frag == NULL) {
+        DEBUG("6lo vrb: error allocating fragmentation header\n");
+        ng_pktbuf_release(netif);
+        return true;
+    }
+
+    frag->next = netif->next;
+    netif->next = frag;
+
+    if (ng_pkt_len(frag) > sixlowpan_iface->max_frag_size) {
+        DEBUG("6lo vrb: first fragment too big for interface %"
+              PRIkernel_pid "\n", iface);
+        ng_pktbuf_release(netif);
+        return true;
+    }
+
+    entry->out_tag = ng_sixlowpan_frag_next_tag();
+    entry->discard = false;
+
+    frag_hdr = frag->data;
+    frag_hdr->disp_size = byteorder_htons(size);
+    frag_hdr->disp_size.u8[0] |= NG_SIXLOWPAN_FRAG_1_DISP;
+    frag_hdr->tag = byteorder_htons(entry->out_tag);
+
+    DEBUG("6lo vrb: forward first fragment (%s, %u, %" PRIu16 ") as %" PRIu16
+          " over interface %" PRIkernel_pid "\n",
+          ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), entry->src,
+                               entry->src_len),
+          entry->datagram_size, entry->tag, entry->out_tag, iface);
+    ng_netapi_send(iface, netif);
+
+    return true;
+}
+
+static bool _forward_nth(vrb_t *entry, ng_pktsnip_t *pkt, size_t offset)
+{
+    ng_sixlowpan_frag_n_t *frag = pkt->data;
+    ng_sixlowpan_netif_t *sixlowpan_iface = ng_sixlowpan_netif_get(entry->iface);
+    size_t frag_size = pkt->size - sizeof(ng_sixlowpan_frag_n_t);
+    kernel_pid_t iface = entry->iface;
+    ng_pktsnip_t *netif;
+
+    if ((offset + frag_size) >= entry->datagram_size) {
+        /* last fragment: datagram is done */
+        entry->src_len = 0;
+    }
+
+    if (entry->discard) {
+        DEBUG("6lo vrb: first fragment was dropped, drop fragment "
+              "(offset: %u)\n", (unsigned int)offset);
+        ng_pktbuf_release(pkt);
+        return true;
+    }
+
+    if ((sixlowpan_iface == NULL) || (pkt->size > sixlowpan_iface->max_frag_size)) {
+        DEBUG("6lo vrb: fragment too big for interface %" PRIkernel_pid "\n",
+              iface);
+        ng_pktbuf_release(pkt);
+        return true;
+    }
+
+    netif = ng_netif_hdr_build(NULL, 0, entry->dst, entry->dst_len);
+
+    if (netif == NULL) {
+        DEBUG("6lo vrb: error allocating link-layer header\n");
+        ng_pktbuf_release(pkt);
+        return true;
+    }
+
+    ((ng_netif_hdr_t *)netif->data)->if_pid = iface;
+
+    /* 6LoWPAN already got write access on the fragment, so the payload can
+     * just be moved to the new link-layer header */
+    frag->tag = byteorder_htons(entry->out_tag);
+    ng_pktbuf_release(pkt->next);       /* incoming interface header */
+    pkt->next = NULL;
+    netif->next = pkt;
+
+    DEBUG("6lo vrb: forward fragment (offset: %u, fragment size: %u) as %"
+          PRIu16 " over interface %" PRIkernel_pid "\n", (unsigned int)offset,
+          (unsigned int)frag_size, entry->out_tag, iface);
+    ng_netapi_send(iface, netif);
+
+    return true;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NG_SIXLOWPAN_FRAG_FWD */
+
+/** @} */
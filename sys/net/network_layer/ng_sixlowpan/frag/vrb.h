@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2015 Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_ng_sixlowpan_frag
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief   6LoWPAN virtual reassembly buffer for fragment forwarding
+ *
+ * @details Instead of reassembling a datagram that is not destined to this
+ *          node, only the first fragment is decompressed to find the next
+ *          hop. Its forwarding decision is remembered, so all subsequent
+ *          fragments of the datagram can be sent to the next hop as soon as
+ *          they arrive, with only their datagram tag rewritten.
+ *
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NG_SIXLOWPAN_FRAG_VRB_H_
+#define NG_SIXLOWPAN_FRAG_VRB_H_
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "kernel_types.h"
+#include "net/ng_pkt.h"
+
+#include "rbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VRB_SIZE            (RBUF_SIZE)     /**< size of the virtual reassembly buffer */
+#define VRB_TIMEOUT         (RBUF_TIMEOUT)  /**< timeout for a forwarded datagram
+                                             *   in seconds */
+
+/**
+ * @brief   An entry in the 6LoWPAN virtual reassembly buffer.
+ *
+ * @details A fragment is identified by the source address, the datagram size,
+ *          and the datagram tag of the incoming link (the destination address
+ *          is always this node). It is forwarded to the next hop with a new
+ *          datagram tag.
+ */
+typedef struct {
+    uint32_t arrival;                   /**< time in seconds of arrival of last
+                                         *   received fragment */
+    uint8_t src[RBUF_L2ADDR_MAX_LEN];   /**< source address */
+    uint8_t dst[RBUF_L2ADDR_MAX_LEN];   /**< link-layer address of the next hop */
+    uint8_t src_len;                    /**< length of source address, 0 if
+                                         *   entry is unused */
+    uint8_t dst_len;                    /**< length of destination address */
+    kernel_pid_t iface;                 /**< interface to the next hop */
+    uint16_t tag;                       /**< the datagram's tag on the incoming link */
+    uint16_t out_tag;                   /**< the datagram's tag towards the next hop */
+    uint16_t datagram_size;             /**< the datagram's size (without 6lo dispatches) */
+    bool discard;                       /**< the first fragment could not be
+                                         *   forwarded, drop the others */
+} vrb_t;
+
+/**
+ * @brief   Tries to forward a fragment without reassembling its datagram.
+ *
+ * @param[in] pkt       The fragment, the 6LoWPAN fragmentation header in
+ *                      pkt::data and the interface header of the fragment in
+ *                      pkt::next.
+ * @param[in] offset    The fragment's offset.
+ *
+ * @return  true, if @p pkt was consumed (forwarded or dropped).
+ * @return  false, if the datagram of @p pkt needs to be reassembled. @p pkt
+ *          is left untouched in this case.
+ */
+bool vrb_forward(ng_pktsnip_t *pkt, size_t offset);
+
+/**
+ * @brief   Gets a datagram tag for a new datagram.
+ *
+ * @details Defined in ng_sixlowpan_frag.c, so locally originated and
+ *          forwarded datagrams share one tag space.
+ *
+ * @return  An unused datagram tag.
+ */
+uint16_t ng_sixlowpan_frag_next_tag(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NG_SIXLOWPAN_FRAG_VRB_H_ */
+/** @} */
@@ -13,6 +13,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 
 #include "byteorder.h"
 #include "net/ng_ipv6/hdr.h"
@@ -67,6 +68,11 @@
 #define IPHC_M_DAC_DAM_M_8          (0x0b)
 #define IPHC_M_DAC_DAM_M_UC_PREFIX  (0x0c)
 
+/* maximum length of LOWPAN_IPHC dispatch with all fields inline */
+#define IPHC_HDR_MAX_LEN            (NG_SIXLOWPAN_IPHC_HDR_LEN + \
+                                     NG_SIXLOWPAN_IPHC_CID_EXT_LEN + \
+                                     sizeof(ng_ipv6_hdr_t))
+
 static network_uint64_t _init_iid(uint8_t *l2addr, size_t l2addr_len)
 {
     network_uint64_t res = { 0 };
@@ -121,20 +127,14 @@ static inline bool _context_overlaps_iid(ng_sixlowpan_ctx_t *ctx,
 bool ng_sixlowpan_iphc_decode(ng_pktsnip_t *pkt)
 {
     ng_netif_hdr_t *netif_hdr = pkt->next->data;
-    ng_ipv6_hdr_t *ipv6_hdr;
+    ng_ipv6_hdr_t hdr;
+    ng_ipv6_hdr_t *ipv6_hdr = &hdr;
     uint8_t *iphc_hdr = pkt->data;
     uint16_t payload_offset = NG_SIXLOWPAN_IPHC_HDR_LEN;
     ng_sixlowpan_ctx_t *ctx = NULL;
-    ng_pktsnip_t *payload;
-    ng_pktsnip_t *ipv6 = ng_pktbuf_add(NULL, NULL, sizeof(ng_ipv6_hdr_t),
-                                       NG_NETTYPE_IPV6);
+    ng_pktsnip_t *dispatch, *ipv6;
 
-    if (ipv6 == NULL) {
-        DEBUG("6lo iphc: error allocating ipv6 header space\n");
-        return false;
-    }
-
-    ipv6_hdr = ipv6->data;
+    memset(&hdr, 0, sizeof(hdr));
 
     if (iphc_hdr[IPHC2_IDX] & NG_SIXLOWPAN_IPHC2_CID_EXT) {
         payload_offset++;
@@ -304,8 +304,8 @@ bool ng_sixlowpan_iphc_decode(ng_pktsnip_t *pkt)
 
         case IPHC_M_DAC_DAM_U_L2:
             ng_ipv6_addr_set_link_local_prefix(&ipv6_hdr->dst);
-            ipv6_hdr->dst.u64[1] = _init_iid(ng_netif_hdr_get_src_addr(netif_hdr),
-                                             netif_hdr->src_l2addr_len);
+            ipv6_hdr->dst.u64[1] = _init_iid(ng_netif_hdr_get_dst_addr(netif_hdr),
+                                             netif_hdr->dst_l2addr_len);
             break;
 
         case IPHC_M_DAC_DAM_U_CTX_64:
@@ -325,8 +325,8 @@ bool ng_sixlowpan_iphc_decode(ng_pktsnip_t *pkt)
             break;
 
         case IPHC_M_DAC_DAM_U_CTX_L2:
-            ipv6_hdr->dst.u64[1] = _init_iid(ng_netif_hdr_get_src_addr(netif_hdr),
-                                             netif_hdr->src_l2addr_len);
+            ipv6_hdr->dst.u64[1] = _init_iid(ng_netif_hdr_get_dst_addr(netif_hdr),
+                                             netif_hdr->dst_l2addr_len);
             ng_ipv6_addr_init_prefix(&ipv6_hdr->dst, &ctx->prefix,
                                      ctx->prefix_len);
             break;
@@ -393,11 +393,37 @@ bool ng_sixlowpan_iphc_decode(ng_pktsnip_t *pkt)
 
     /* TODO: add next header decoding */
 
-    /* remove 6LoWPAN dispatch */
-    payload = ng_pktbuf_add(pkt, pkt->data, payload_offset, NG_NETTYPE_SIXLOWPAN);
-    pkt = ng_pktbuf_remove_snip(pkt, payload);
+    /* mark 6LoWPAN dispatch */
+    dispatch = ng_pktbuf_add(pkt, pkt->data, payload_offset, NG_NETTYPE_SIXLOWPAN);
+
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error marking dispatch\n");
+        return false;
+    }
 
-    /* insert IPv6 header */
+    if (dispatch->size >= sizeof(ng_ipv6_hdr_t)) {
+        /* the inline fields already took the room of the decompressed
+         * header: expand it in place */
+        memcpy(dispatch->data, &hdr, sizeof(ng_ipv6_hdr_t));
+        dispatch->size = sizeof(ng_ipv6_hdr_t);
+        dispatch->type = NG_NETTYPE_IPV6;
+
+        return true;
+    }
+
+    /* The received frame is one packet buffer chunk shared by the dispatch
+     * and the payload snip, so the dispatch can neither grow in place nor be
+     * reallocated without truncating the payload. The IPv6 header needs its
+     * own snip and data. */
+    ipv6 = ng_pktbuf_add(NULL, &hdr, sizeof(ng_ipv6_hdr_t), NG_NETTYPE_IPV6);
+
+    if (ipv6 == NULL) {
+        DEBUG("6lo iphc: error allocating ipv6 header space\n");
+        return false;
+    }
+
+    /* replace 6LoWPAN dispatch with IPv6 header */
+    pkt = ng_pktbuf_remove_snip(pkt, dispatch);
     ipv6->next = pkt->next;
     pkt->next = ipv6;
 
@@ -407,24 +433,17 @@ bool ng_sixlowpan_iphc_decode(ng_pktsnip_t *pkt)
 bool ng_sixlowpan_iphc_encode(ng_pktsnip_t *pkt)
 {
     ng_netif_hdr_t *netif_hdr = pkt->data;
-    ng_ipv6_hdr_t *ipv6_hdr = pkt->next->data;
-    uint8_t *iphc_hdr;
+    ng_pktsnip_t *ipv6 = pkt->next;
+    ng_ipv6_hdr_t *ipv6_hdr = ipv6->data;
+    uint8_t iphc_hdr[IPHC_HDR_MAX_LEN];
     uint16_t inline_pos = NG_SIXLOWPAN_IPHC_HDR_LEN;
     bool addr_comp = false;
     ng_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    ng_pktsnip_t *dispatch = ng_pktbuf_add(NULL, NULL, pkt->next->size,
-                                           NG_NETTYPE_SIXLOWPAN);
-
-    if (dispatch == NULL) {
-        DEBUG("6lo iphc: error allocating dispatch space\n");
-        return false;
-    }
-
-    iphc_hdr = dispatch->data;
+    ng_pktsnip_t *dispatch;
 
     /* set initial dispatch value*/
     iphc_hdr[IPHC1_IDX] = NG_SIXLOWPAN_IPHC1_DISP;
-    iphc_hdr[2] = 0;
+    iphc_hdr[IPHC2_IDX] = 0;
 
     /* check for available contexts */
     if (!ng_ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
@@ -680,12 +699,26 @@ bool ng_sixlowpan_iphc_encode(ng_pktsnip_t *pkt)
         inline_pos += 16;
     }
 
-    /* shrink dispatch allocation to final size */
-    /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
-    ng_pktbuf_realloc_data(dispatch, (size_t)inline_pos);
+    if ((ipv6->users == 1) && (inline_pos <= ipv6->size)) {
+        /* compress in place: the IPv6 header is not needed anymore and its
+         * snip has room for the dispatch. Shrinking the snip does not
+         * change which packet buffer chunk it is freed with. */
+        memcpy(ipv6->data, iphc_hdr, inline_pos);
+        ipv6->size = inline_pos;
+        ipv6->type = NG_NETTYPE_SIXLOWPAN;
+
+        return true;
+    }
+
+    dispatch = ng_pktbuf_add(NULL, iphc_hdr, inline_pos, NG_NETTYPE_SIXLOWPAN);
+
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error allocating dispatch space\n");
+        return false;
+    }
 
     /* remove IPv6 header */
-    pkt = ng_pktbuf_remove_snip(pkt, pkt->next);
+    pkt = ng_pktbuf_remove_snip(pkt, ipv6);
 
     /* insert dispatch into packet */
     dispatch->next = pkt->next;
@@ -14,6 +14,7 @@
 
 #include "kernel_types.h"
 #include "net/ng_netbase.h"
+#include "net/ng_netstats.h"
 #include "thread.h"
 #include "utlist.h"
 
@@ -26,20 +27,27 @@
 #include "debug.h"
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static ng_netstats_t _stats;
 
+#ifndef MODULE_NG_NETAPI_DIRECT
 #if ENABLE_DEBUG
 static char _stack[NG_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[NG_SIXLOWPAN_STACK_SIZE];
 #endif
+#endif
 
 
 /* handles NG_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(ng_pktsnip_t *pkt);
 /* handles NG_NETAPI_MSG_TYPE_SND commands */
 static void _send(ng_pktsnip_t *pkt);
+/* Handles a message to 6LoWPAN */
+static int _handle(void *ctx, msg_t *msg);
+#ifndef MODULE_NG_NETAPI_DIRECT
 /* Main event loop for 6LoWPAN */
 static void *_event_loop(void *args);
+#endif
 
 kernel_pid_t ng_sixlowpan_init(void)
 {
@@ -47,8 +55,20 @@ kernel_pid_t ng_sixlowpan_init(void)
         return _pid;
     }
 
+#ifdef MODULE_NG_NETAPI_DIRECT
+    static ng_netreg_entry_t me_reg;
+
+    _pid = ng_netapi_direct_register(_handle, NULL);
+    ng_netstats_register(&_stats, _pid, "6lo");
+    me_reg.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
+    me_reg.pid = _pid;
+
+    /* register interest in all 6LoWPAN packets */
+    ng_netreg_register(NG_NETTYPE_SIXLOWPAN, &me_reg);
+#else
     _pid = thread_create(_stack, sizeof(_stack), NG_SIXLOWPAN_PRIO,
                          CREATE_STACKTEST, _event_loop, NULL, "6lo");
+#endif
 
     return _pid;
 }
@@ -68,6 +88,7 @@ static void _receive(ng_pktsnip_t *pkt)
 #if defined(DEVELHELP) && defined(ENABLE_DEBUG)
         ng_pktbuf_stats();
 #endif
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -94,6 +115,7 @@ static void _receive(ng_pktsnip_t *pkt)
 #if defined(DEVELHELP) && defined(ENABLE_DEBUG)
             ng_pktbuf_stats();
 #endif
+            ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
             ng_pktbuf_release(pkt);
             return;
         }
@@ -104,6 +126,7 @@ static void _receive(ng_pktsnip_t *pkt)
 
         if (sixlowpan == NULL) {
             DEBUG("6lo: can not mark 6LoWPAN dispatch\n");
+            ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
             ng_pktbuf_release(pkt);
             return;
         }
@@ -197,6 +220,7 @@ static void _send(ng_pktsnip_t *pkt)
 
     if (sixlowpan == NULL) {
         DEBUG("6lo: no space left in packet buffer\n");
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -236,6 +260,7 @@ static void _send(ng_pktsnip_t *pkt)
 
         if (sixlowpan == NULL) {
             DEBUG("6lo: no space left in packet buffer\n");
+            ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
             ng_pktbuf_release(pkt);
             return;
         }
@@ -253,6 +278,7 @@ static void _send(ng_pktsnip_t *pkt)
 
     if (sixlowpan == NULL) {
         DEBUG("6lo: no space left in packet buffer\n");
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -289,6 +315,39 @@ static void _send(ng_pktsnip_t *pkt)
 #endif
 }
 
+static int _handle(void *ctx, msg_t *msg)
+{
+    unsigned long start = ng_netstats_start();
+
+    (void)ctx;
+
+    switch (msg->type) {
+        case NG_NETAPI_MSG_TYPE_RCV:
+            DEBUG("6lo: NG_NETDEV_MSG_TYPE_RCV received\n");
+            _receive((ng_pktsnip_t *)msg->content.ptr);
+            ng_netstats_done(&_stats, start);
+            return 0;
+
+        case NG_NETAPI_MSG_TYPE_SND:
+            DEBUG("6lo: NG_NETDEV_MSG_TYPE_SND received\n");
+            _send((ng_pktsnip_t *)msg->content.ptr);
+            ng_netstats_done(&_stats, start);
+            return 0;
+
+        case NG_NETAPI_MSG_TYPE_GET:
+            return ng_netstats_get(&_stats, (ng_netapi_opt_t *)msg->content.ptr);
+
+        case NG_NETAPI_MSG_TYPE_SET:
+            DEBUG("6lo: reply to unsupported set\n");
+            return -ENOTSUP;
+
+        default:
+            DEBUG("6lo: operation not supported\n");
+            return -ENOTSUP;
+    }
+}
+
+#ifndef MODULE_NG_NETAPI_DIRECT
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[NG_SIXLOWPAN_MSG_QUEUE_SIZE];
@@ -299,6 +358,7 @@ static void *_event_loop(void *args)
 
     me_reg.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
     me_reg.pid = thread_getpid();
+    ng_netstats_register(&_stats, me_reg.pid, "6lo");
 
     /* register interest in all 6LoWPAN packets */
     ng_netreg_register(NG_NETTYPE_SIXLOWPAN, &me_reg);
@@ -310,32 +370,17 @@ static void *_event_loop(void *args)
     while (1) {
         DEBUG("6lo: waiting for incoming message.\n");
         msg_receive(&msg);
+        ng_netstats_queue(&_stats);
 
-        switch (msg.type) {
-            case NG_NETAPI_MSG_TYPE_RCV:
-                DEBUG("6lo: NG_NETDEV_MSG_TYPE_RCV received\n");
-                _receive((ng_pktsnip_t *)msg.content.ptr);
-                break;
-
-            case NG_NETAPI_MSG_TYPE_SND:
-                DEBUG("6lo: NG_NETDEV_MSG_TYPE_SND received\n");
-                _send((ng_pktsnip_t *)msg.content.ptr);
-                break;
-
-            case NG_NETAPI_MSG_TYPE_GET:
-            case NG_NETAPI_MSG_TYPE_SET:
-                DEBUG("6lo: reply to unsupported get/set\n");
-                reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
-                break;
-
-            default:
-                DEBUG("6lo: operation not supported\n");
-                break;
+        reply.content.value = (uint32_t)_handle(NULL, &msg);
+        if ((msg.type == NG_NETAPI_MSG_TYPE_GET) ||
+            (msg.type == NG_NETAPI_MSG_TYPE_SET)) {
+            msg_reply(&msg, &reply);
         }
     }
 
     return NULL;
 }
+#endif
 
 /** @} */
@@ -63,6 +63,7 @@ static volatile kernel_pid_t _rpl_process_pid = KERNEL_PID_UNDEF;
 ipv6_addr_t *(*ip_get_next_hop)(ipv6_addr_t *);
 #endif
 uint8_t (*ip_srh_indicator)(void);
+int (*ip_buffer_packet)(ipv6_hdr_t *);
 
 static ipv6_net_if_ext_t ipv6_net_if_ext[NET_IF_MAX];
 static ipv6_net_if_addr_t ipv6_net_if_addr_buffer[IPV6_NET_IF_ADDR_BUFFER_LEN];
@@ -135,6 +136,9 @@ int ipv6_send_packet(ipv6_hdr_t *packet, ipv6_addr_t *next_hop)
             ipv6_addr_t *dest = ip_get_next_hop(&packet->destaddr);
 
             if (dest == NULL) {
+                if ((ip_buffer_packet != NULL) && (ip_buffer_packet(packet) == 0)) {
+                    return length;
+                }
                 return -1;
             }
 #endif
@@ -911,6 +915,12 @@ void ipv6_iface_set_routing_provider(ipv6_addr_t *(*next_hop)(ipv6_addr_t *dest)
 #endif
 }
 
+/* register function buffering packets without next hop */
+void ipv6_iface_set_packet_buffer(int (*buffer)(ipv6_hdr_t *packet))
+{
+    ip_buffer_packet = buffer;
+}
+
 #ifdef MODULE_RPL
 /* register source-routing indicator function */
 void ipv6_iface_set_srh_indicator(uint8_t (*srh_indi)(void))
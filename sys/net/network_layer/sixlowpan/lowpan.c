@@ -25,6 +25,7 @@
 #include <limits.h>
 #include <errno.h>
 
+#include "event.h"
 #include "vtimer.h"
 #include "timex.h"
 #include "thread.h"
@@ -52,7 +53,6 @@ static char addr_str[IPV6_MAX_ADDR_STR_LEN];
 #endif
 #include "debug.h"
 
-#define CON_STACKSIZE                   (THREAD_STACKSIZE_DEFAULT)
 #define LOWPAN_TRANSFER_BUF_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
 
 #define SIXLOWPAN_MAX_REGISTERED        (4)
@@ -124,7 +124,6 @@ mutex_t fifo_mutex = MUTEX_INIT;
 
 kernel_pid_t ip_process_pid = KERNEL_PID_UNDEF;
 kernel_pid_t nd_nbr_cache_rem_pid = KERNEL_PID_UNDEF;
-kernel_pid_t contexts_rem_pid = KERNEL_PID_UNDEF;
 kernel_pid_t transfer_pid = KERNEL_PID_UNDEF;
 
 mutex_t lowpan_context_mutex = MUTEX_INIT;
@@ -134,7 +133,6 @@ kernel_pid_t sixlowpan_reg[SIXLOWPAN_MAX_REGISTERED];
 static sixlowpan_lowpan_frame_t current_frame;
 
 char ip_process_buf[IP_PROCESS_STACKSIZE];
-char con_buf[CON_STACKSIZE];
 char lowpan_transfer_buf[LOWPAN_TRANSFER_BUF_STACKSIZE];
 lowpan_context_t contexts[NDP_6LOWPAN_CONTEXT_MAX];
 uint8_t context_len = 0;
@@ -1594,33 +1592,36 @@ lowpan_context_t *lowpan_context_num_lookup(uint8_t num)
     return NULL;
 }
 
-static void *lowpan_context_auto_remove(void *arg)
+static void lowpan_context_auto_remove(void *arg);
+
+static event_t contexts_rem_event = { .handler = lowpan_context_auto_remove };
+static event_timeout_t contexts_rem_timeout;
+
+/* run by the event thread once a minute */
+static void lowpan_context_auto_remove(void *arg)
 {
     (void) arg;
 
-    timex_t minute = timex_set(60, 0);
     int i;
     int8_t to_remove[NDP_6LOWPAN_CONTEXT_MAX];
+    int8_t to_remove_size = 0;
 
-    while (1) {
-        vtimer_sleep(minute);
-        int8_t to_remove_size = 0;
-        mutex_lock(&lowpan_context_mutex);
-
-        for (i = 0; i < lowpan_context_len(); i++) {
-            if (--(contexts[i].lifetime) == 0) {
-                to_remove[to_remove_size++] = contexts[i].num;
-            }
-        }
+    mutex_lock(&lowpan_context_mutex);
 
-        for (i = 0; i < to_remove_size; i++) {
-            lowpan_context_remove(to_remove[i]);
+    for (i = 0; i < lowpan_context_len(); i++) {
+        if (--(contexts[i].lifetime) == 0) {
+            to_remove[to_remove_size++] = contexts[i].num;
         }
+    }
 
-        mutex_unlock(&lowpan_context_mutex);
+    for (i = 0; i < to_remove_size; i++) {
+        lowpan_context_remove(to_remove[i]);
     }
 
-    return NULL;
+    mutex_unlock(&lowpan_context_mutex);
+
+    event_timeout_set(&contexts_rem_timeout, &contexts_rem_event,
+                      timex_set(60, 0));
 }
 
 void init_reas_bufs(lowpan_reas_buf_t *buf)
@@ -1758,13 +1759,8 @@ int sixlowpan_lowpan_init(void)
 
     nbr_cache_auto_rem();
 
-    contexts_rem_pid = thread_create(con_buf, CON_STACKSIZE,
-                                     THREAD_PRIORITY_MAIN + 1, CREATE_STACKTEST,
-                                     lowpan_context_auto_remove, NULL, "lowpan_context_rem");
-
-    if (contexts_rem_pid == KERNEL_PID_UNDEF) {
-        return 0;
-    }
+    event_timeout_set(&contexts_rem_timeout, &contexts_rem_event,
+                      timex_set(60, 0));
 
     transfer_pid = thread_create(lowpan_transfer_buf, LOWPAN_TRANSFER_BUF_STACKSIZE,
                                  THREAD_PRIORITY_MAIN - 1, CREATE_STACKTEST,
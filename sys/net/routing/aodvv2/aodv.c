@@ -83,6 +83,7 @@ void aodv_init(void)
     /* every node is its own client. */
     clienttable_add_client(&na_local);
     rreqtable_init();
+    pktbuffer_init();
 
     /* init reader and writer */
     aodv_packet_reader_init();
@@ -98,6 +99,8 @@ void aodv_init(void)
 
     /* register aodv for routing */
     ipv6_iface_set_routing_provider(aodv_get_next_hop);
+    /* hold back packets while their route is discovered */
+    ipv6_iface_set_packet_buffer(pktbuffer_add);
 
 }
 
@@ -400,17 +403,16 @@ ipv6_addr_t *aodv_get_next_hop(ipv6_addr_t *dest)
             rt_entry->state = ROUTE_STATE_ACTIVE;
         }
 
-        /* Currently, there is no way to do this, so I'm doing it the worst
-         * possible, but safe way: I can't make sure that the current call to
-         * aodv_get_next_hop() is overridden by another call to aodv_get_next_hop()
-         * by a thread with higher priority, thus messing up return values if I just
-         * use a static ipv6_addr_t.
-         * The following malloc will never be free()'d. TODO: FIX THIS ASAP.
-        */
-        ipv6_addr_t *next_hop = (ipv6_addr_t *) malloc(sizeof(ipv6_addr_t));
-        netaddr_to_ipv6_addr_t(&rt_entry->nextHopAddr, next_hop);
-
-        return next_hop;
+        /* The entry keeps its own copy of the next hop as ipv6_addr_t, so
+         * concurrent calls from threads of different priority can't mess
+         * up each other's return values. */
+        return &rt_entry->nextHopIpv6Addr;
+    }
+
+    if (pktbuffer_is_pending(dest)) {
+        DEBUG("	Route discovery towards %s in progress\n",
+              ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, dest));
+        return NULL;
     }
 
     aodvv2_seqnum_t seqnum = seqnum_get();
@@ -32,6 +32,7 @@
 #include "constants.h"
 #include "seqnum.h"
 #include "routingtable.h"
+#include "pktbuffer.h"
 #include "utils.h"
 #include "reader.h"
 #include "writer.h"
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2014 Freie Universität Berlin
+ * Copyright (C) 2014 Lotte Steenbrink <lotte.steenbrink@fu-berlin.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     aodvv2
+ * @{
+ *
+ * @file
+ * @brief       buffer for packets waiting for a route discovery
+ *
+ * @author      Lotte Steenbrink <lotte.steenbrink@fu-berlin.de>
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "vtimer.h"
+
+#include "pktbuffer.h"
+#include "utils.h"
+#include "aodv_debug.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * all packets buffered for one destination
+ */
+struct pktbuffer_entry
+{
+    ipv6_addr_t dest;                               /**< destination of the packets */
+    timex_t started;                                /**< time the first packet was buffered */
+    ipv6_hdr_t *packets[AODVV2_PKTBUFFER_LEN];      /**< buffered packets, oldest first */
+    uint8_t len;                                    /**< number of buffered packets,
+                                                     *   0 if the entry is unused */
+};
+
+/**
+ * room for one buffered packet
+ */
+union pktbuffer_slot
+{
+    ipv6_hdr_t hdr;                                 /**< the packet */
+    uint8_t data[AODVV2_PKTBUFFER_SLOT_SIZE];       /**< space for its payload */
+};
+
+static struct pktbuffer_entry _entries[AODVV2_PKTBUFFER_DESTS];
+static union pktbuffer_slot _slots[AODVV2_PKTBUFFER_SLOTS];
+static bool _slot_used[AODVV2_PKTBUFFER_SLOTS];
+static mutex_t _mutex = MUTEX_INIT;
+static timex_t _wait_time;
+
+static struct pktbuffer_entry *_get_entry(ipv6_addr_t *dest);
+static void _drop_entry(struct pktbuffer_entry *entry);
+static ipv6_hdr_t *_slot_alloc(void);
+static void _slot_free(ipv6_hdr_t *packet);
+
+void pktbuffer_init(void)
+{
+    mutex_lock(&_mutex);
+    _wait_time = timex_set(AODVV2_RREQ_WAIT_TIME, 0);
+    memset(_entries, 0, sizeof(_entries));
+    memset(_slot_used, 0, sizeof(_slot_used));
+    mutex_unlock(&_mutex);
+}
+
+int pktbuffer_add(ipv6_hdr_t *packet)
+{
+    size_t size = sizeof(ipv6_hdr_t) + NTOHS(packet->length);
+    struct pktbuffer_entry *entry;
+    ipv6_hdr_t *copy;
+
+    mutex_lock(&_mutex);
+    entry = _get_entry(&packet->destaddr);
+
+    if (entry == NULL) {
+        /* start buffering for a new destination */
+        for (unsigned i = 0; i < AODVV2_PKTBUFFER_DESTS; i++) {
+            if (_entries[i].len == 0) {
+                entry = &_entries[i];
+                entry->dest = packet->destaddr;
+                vtimer_now(&entry->started);
+                break;
+            }
+        }
+    }
+
+    if ((entry == NULL) || (size > AODVV2_PKTBUFFER_SLOT_SIZE)) {
+        AODV_DEBUG("pktbuffer: no space left, dropping packet\n");
+        mutex_unlock(&_mutex);
+        return -1;
+    }
+
+    if (entry->len == AODVV2_PKTBUFFER_LEN) {
+        /* keep the most recent packets */
+        _slot_free(entry->packets[0]);
+        memmove(&entry->packets[0], &entry->packets[1],
+                (AODVV2_PKTBUFFER_LEN - 1) * sizeof(entry->packets[0]));
+        entry->len--;
+    }
+
+    if ((copy = _slot_alloc()) == NULL) {
+        AODV_DEBUG("pktbuffer: no space left, dropping packet\n");
+        mutex_unlock(&_mutex);
+        return -1;
+    }
+    memcpy(copy, packet, size);
+    entry->packets[entry->len++] = copy;
+
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+bool pktbuffer_is_pending(ipv6_addr_t *dest)
+{
+    mutex_lock(&_mutex);
+    bool pending = (_get_entry(dest) != NULL);
+    mutex_unlock(&_mutex);
+    return pending;
+}
+
+void pktbuffer_flush(struct netaddr *dest)
+{
+    ipv6_hdr_t *packets[AODVV2_PKTBUFFER_LEN];
+    struct pktbuffer_entry *entry;
+    ipv6_addr_t addr;
+    uint8_t len = 0;
+
+    netaddr_to_ipv6_addr_t(dest, &addr);
+
+    /* take the packets out first: sending may buffer them again if the route
+     * is unusable after all */
+    mutex_lock(&_mutex);
+    entry = _get_entry(&addr);
+    if (entry != NULL) {
+        len = entry->len;
+        memcpy(packets, entry->packets, len * sizeof(packets[0]));
+        entry->len = 0;
+    }
+    mutex_unlock(&_mutex);
+
+    for (unsigned i = 0; i < len; i++) {
+        AODV_DEBUG("pktbuffer: sending buffered packet %u/%u\n", i + 1, len);
+        ipv6_send_packet(packets[i], NULL);
+        mutex_lock(&_mutex);
+        _slot_free(packets[i]);
+        mutex_unlock(&_mutex);
+    }
+}
+
+/*
+ * retrieve the entry buffering packets for dest, if its route discovery is
+ * still in progress, and NULL otherwise. Stale entries are dropped.
+ */
+static struct pktbuffer_entry *_get_entry(ipv6_addr_t *dest)
+{
+    timex_t now;
+    vtimer_now(&now);
+
+    for (unsigned i = 0; i < AODVV2_PKTBUFFER_DESTS; i++) {
+        if (_entries[i].len == 0) {
+            continue;
+        }
+        if (timex_cmp(timex_sub(now, _entries[i].started), _wait_time) > 0) {
+            /* the route discovery failed */
+            _drop_entry(&_entries[i]);
+            continue;
+        }
+        if (ipv6_addr_is_equal(&_entries[i].dest, dest)) {
+            return &_entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void _drop_entry(struct pktbuffer_entry *entry)
+{
+    DEBUG("pktbuffer: dropping %u packets\n", entry->len);
+    for (unsigned i = 0; i < entry->len; i++) {
+        _slot_free(entry->packets[i]);
+    }
+    entry->len = 0;
+}
+
+static ipv6_hdr_t *_slot_alloc(void)
+{
+    for (unsigned i = 0; i < AODVV2_PKTBUFFER_SLOTS; i++) {
+        if (!_slot_used[i]) {
+            _slot_used[i] = true;
+            return &_slots[i].hdr;
+        }
+    }
+
+    return NULL;
+}
+
+static void _slot_free(ipv6_hdr_t *packet)
+{
+    _slot_used[(union pktbuffer_slot *)packet - _slots] = false;
+}
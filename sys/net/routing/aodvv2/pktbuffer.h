@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2014 Freie Universität Berlin
+ * Copyright (C) 2014 Lotte Steenbrink <lotte.steenbrink@fu-berlin.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     aodvv2
+ * @{
+ *
+ * @file
+ * @brief       buffer for packets waiting for a route discovery
+ *
+ * @author      Lotte Steenbrink <lotte.steenbrink@fu-berlin.de>
+ */
+
+#ifndef AODVV2_PKTBUFFER_H_
+#define AODVV2_PKTBUFFER_H_
+
+#include <stdbool.h>
+
+#include "ipv6.h"
+
+#include "common/netaddr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef AODVV2_PKTBUFFER_DESTS
+#define AODVV2_PKTBUFFER_DESTS 4    /** destinations with a route discovery in progress */
+#endif
+#ifndef AODVV2_PKTBUFFER_LEN
+#define AODVV2_PKTBUFFER_LEN 3      /** packets buffered per destination */
+#endif
+#ifndef AODVV2_PKTBUFFER_SLOTS
+#define AODVV2_PKTBUFFER_SLOTS 6    /** packets buffered for all destinations */
+#endif
+#ifndef AODVV2_PKTBUFFER_SLOT_SIZE
+#define AODVV2_PKTBUFFER_SLOT_SIZE IPV6_MTU /** largest packet that is buffered */
+#endif
+
+/**
+ * Initialize the packet buffer.
+ */
+void pktbuffer_init(void);
+
+/**
+ * Buffer a copy of a packet until a route to its destination is found.
+ * If all packets for the destination are buffered already, the oldest one
+ * is dropped. The copies are kept in a static pool of
+ * AODVV2_PKTBUFFER_SLOTS slots shared by all destinations, packets larger
+ * than AODVV2_PKTBUFFER_SLOT_SIZE are not buffered.
+ * @param packet    packet to buffer
+ * @return          0 if the packet was buffered, -1 otherwise
+ */
+int pktbuffer_add(ipv6_hdr_t *packet);
+
+/**
+ * Find out if a route discovery towards a destination was started less than
+ * AODVV2_RREQ_WAIT_TIME seconds ago, i.e. packets are buffered for it.
+ * @param dest      destination in question
+ */
+bool pktbuffer_is_pending(ipv6_addr_t *dest);
+
+/**
+ * Send all packets buffered for a destination a route was found to.
+ * @param dest      the destination
+ */
+void pktbuffer_flush(struct netaddr *dest);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* AODVV2_PKTBUFFER_H_ */
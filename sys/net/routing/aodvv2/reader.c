@@ -574,6 +574,8 @@ static enum rfc5444_result _cb_rrep_end_callback(
         DEBUG("\t{%" PRIu32 ":%" PRIu32 "} %s:  This is my RREP (SeqNum: %d). We are done here, thanks %s!\n",
               now.seconds, now.microseconds, netaddr_to_string(&nbuf, &packet_data.origNode.addr),
               packet_data.origNode.seqnum, netaddr_to_string(&nbuf2, &packet_data.targNode.addr));
+
+        pktbuffer_flush(&packet_data.targNode.addr);
     }
 
     else {
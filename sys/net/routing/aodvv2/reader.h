@@ -28,6 +28,7 @@
 
 #include "utils.h"
 #include "routingtable.h"
+#include "pktbuffer.h"
 #include "constants.h"
 #include "seqnum.h"
 #include "aodv.h"
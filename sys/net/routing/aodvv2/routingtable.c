@@ -18,15 +18,25 @@
  */
 
 #include "routingtable.h"
+#include "utils.h"
 #include "aodv_debug.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#define RT_BUCKETS  (16)                          /* number of hash buckets */
+#define RT_NONE     (AODVV2_MAX_ROUTING_ENTRIES)  /* end of a chain */
+
 /* helper functions */
 static void _reset_entry_if_stale(uint8_t i);
+static void _clear_entry(uint8_t i);
 
 static struct aodvv2_routing_entry_t routing_table[AODVV2_MAX_ROUTING_ENTRIES];
+/* entries are chained into the hash bucket of their address, free entries
+ * into _free, so neither lookups nor insertions need to scan the table */
+static uint8_t _buckets[RT_BUCKETS];
+static uint8_t _chain[AODVV2_MAX_ROUTING_ENTRIES];
+static uint8_t _free;
 static timex_t null_time, max_seqnum_lifetime, active_interval, max_idletime, validity_t;
 timex_t now;
 #if ENABLE_DEBUG
@@ -42,6 +52,11 @@ void routingtable_init(void)
     validity_t = timex_set(AODVV2_ACTIVE_INTERVAL + AODVV2_MAX_IDLETIME, 0);
 
     memset(&routing_table, 0, sizeof(routing_table));
+    memset(_buckets, RT_NONE, sizeof(_buckets));
+    for (unsigned i = 0; i < AODVV2_MAX_ROUTING_ENTRIES; i++) {
+        _chain[i] = i + 1;
+    }
+    _free = 0;
     AODV_DEBUG("routing table initialized.\n");
 }
 
@@ -60,19 +75,26 @@ void routingtable_add_entry(struct aodvv2_routing_entry_t *entry)
     if (routingtable_get_entry(&(entry->addr), entry->metricType)) {
         return;
     }
-    /*find free spot in RT and place rt_entry there */
-    for (unsigned i = 0; i < AODVV2_MAX_ROUTING_ENTRIES; i++) {
-        if (routing_table[i].addr._type == AF_UNSPEC) {
-            memcpy(&routing_table[i], entry, sizeof(struct aodvv2_routing_entry_t));
-            return;
-        }
+    /* take a free spot in RT and place rt_entry there */
+    uint8_t i = _free;
+    if (i == RT_NONE) {
+        return;
     }
+    _free = _chain[i];
+    memcpy(&routing_table[i], entry, sizeof(struct aodvv2_routing_entry_t));
+
+    uint8_t bucket = netaddr_hash(&routing_table[i].addr) % RT_BUCKETS;
+    _chain[i] = _buckets[bucket];
+    _buckets[bucket] = i;
 }
 
 struct aodvv2_routing_entry_t *routingtable_get_entry(struct netaddr *addr,
                                                       aodvv2_metric_t metricType)
 {
-    for (unsigned i = 0; i < AODVV2_MAX_ROUTING_ENTRIES; i++) {
+    uint8_t next;
+
+    for (uint8_t i = _buckets[netaddr_hash(addr) % RT_BUCKETS]; i != RT_NONE; i = next) {
+        next = _chain[i];
         _reset_entry_if_stale(i);
 
         if (!netaddr_cmp(&routing_table[i].addr, addr)
@@ -89,14 +111,10 @@ struct aodvv2_routing_entry_t *routingtable_get_entry(struct netaddr *addr,
 
 void routingtable_delete_entry(struct netaddr *addr, aodvv2_metric_t metricType)
 {
-    for (unsigned i = 0; i < AODVV2_MAX_ROUTING_ENTRIES; i++) {
-        _reset_entry_if_stale(i);
+    struct aodvv2_routing_entry_t *entry = routingtable_get_entry(addr, metricType);
 
-        if (!netaddr_cmp(&routing_table[i].addr, addr)
-                && routing_table[i].metricType == metricType) {
-            memset(&routing_table[i], 0, sizeof(routing_table[i]));
-            return;
-        }
+    if (entry) {
+        _clear_entry(entry - routing_table);
     }
 }
 
@@ -109,7 +127,8 @@ void routingtable_break_and_get_all_hopping_over(struct netaddr *hop,
     for (unsigned i = 0; i < AODVV2_MAX_ROUTING_ENTRIES; i++) {
         _reset_entry_if_stale(i);
 
-        if (netaddr_cmp(&routing_table[i].nextHopAddr, hop) == 0) {
+        if (routing_table[i].addr._type != AF_UNSPEC
+            && netaddr_cmp(&routing_table[i].nextHopAddr, hop) == 0) {
             if (routing_table[i].state == ROUTE_STATE_ACTIVE &&
                     *len < AODVV2_MAX_UNREACHABLE_NODES) {
                 /* when the max number of unreachable nodes is reached we're screwed.
@@ -187,10 +206,30 @@ static void _reset_entry_if_stale(uint8_t i)
     if (timex_cmp(timex_sub(now, lastUsed), max_seqnum_lifetime) >= 0) {
         DEBUG("\t[routing] Expunged routing table entry for %s at %i\n",
               netaddr_to_string(&nbuf, &routing_table[i].addr), i);
-        memset(&routing_table[i], 0, sizeof(routing_table[i]));
+        _clear_entry(i);
     }
 }
 
+/*
+ * Remove the entry at index i from its hash bucket and return it to the
+ * free entries
+ */
+static void _clear_entry(uint8_t i)
+{
+    uint8_t *link = &_buckets[netaddr_hash(&routing_table[i].addr) % RT_BUCKETS];
+
+    while (*link != RT_NONE && *link != i) {
+        link = &_chain[*link];
+    }
+    if (*link == i) {
+        *link = _chain[i];
+    }
+
+    memset(&routing_table[i], 0, sizeof(routing_table[i]));
+    _chain[i] = _free;
+    _free = i;
+}
+
 bool routingtable_offers_improvement(struct aodvv2_routing_entry_t *rt_entry,
                                      struct node_data *node_data)
 {
@@ -215,6 +254,7 @@ void routingtable_fill_routing_entry_t_rreq(struct aodvv2_packet_data *packet_da
     rt_entry->addr = packet_data->origNode.addr;
     rt_entry->seqnum = packet_data->origNode.seqnum;
     rt_entry->nextHopAddr = packet_data->sender;
+    netaddr_to_ipv6_addr_t(&rt_entry->nextHopAddr, &rt_entry->nextHopIpv6Addr);
     rt_entry->lastUsed = packet_data->timestamp;
     rt_entry->expirationTime = timex_add(packet_data->timestamp, validity_t);
     rt_entry->metricType = packet_data->metricType;
@@ -228,6 +268,7 @@ void routingtable_fill_routing_entry_t_rrep(struct aodvv2_packet_data *packet_da
     rt_entry->addr = packet_data->targNode.addr;
     rt_entry->seqnum = packet_data->targNode.seqnum;
     rt_entry->nextHopAddr = packet_data->sender;
+    netaddr_to_ipv6_addr_t(&rt_entry->nextHopAddr, &rt_entry->nextHopIpv6Addr);
     rt_entry->lastUsed = packet_data->timestamp;
     rt_entry->expirationTime = timex_add(packet_data->timestamp, validity_t);
     rt_entry->metricType = packet_data->metricType;
@@ -22,6 +22,8 @@
 
 #include <string.h>
 
+#include "ipv6.h"
+
 #include "common/netaddr.h"
 
 #include "aodvv2/types.h"
@@ -53,6 +55,8 @@ struct aodvv2_routing_entry_t
                                          *   last packet that updated the entry */
     struct netaddr nextHopAddr;         /**< IP address of the the next hop towards
                                          *   the destination */
+    ipv6_addr_t nextHopIpv6Addr;        /**< nextHopAddr as handed out to the
+                                         *   network stack */
     timex_t lastUsed;                   /**< IP address of this route's destination */
     timex_t expirationTime;             /**< Time at which this route expires */
     aodvv2_metric_t metricType;         /**< Metric type of this route */
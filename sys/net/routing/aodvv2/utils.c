@@ -28,13 +28,21 @@
 static mutex_t clientt_mutex;
 static mutex_t rreqt_mutex;
 
+#define RREQ_NONE   (AODVV2_RREQ_BUF)   /* end of a chain */
+
 /* helper functions */
 static struct aodvv2_rreq_entry *_get_comparable_rreq(struct aodvv2_packet_data *packet_data);
 static void _add_rreq(struct aodvv2_packet_data *packet_data);
 static void _reset_entry_if_stale(uint8_t i);
+static uint8_t _rreq_bucket(struct netaddr *origNode, struct netaddr *targNode);
 
 static struct netaddr client_table[AODVV2_MAX_CLIENTS];
 static struct aodvv2_rreq_entry rreq_table[AODVV2_RREQ_BUF];
+/* RREQs are chained into the hash bucket of their OrigNode and TargNode,
+ * free entries into _rreq_free */
+static uint8_t _rreq_buckets[AODVV2_RREQ_BUCKETS];
+static uint8_t _rreq_chain[AODVV2_RREQ_BUF];
+static uint8_t _rreq_free;
 
 #if ENABLE_DEBUG
 static struct netaddr_str nbuf;
@@ -109,6 +117,11 @@ void rreqtable_init(void)
     _max_idletime = timex_set(AODVV2_MAX_IDLETIME, 0);
 
     memset(&rreq_table, 0, sizeof(rreq_table));
+    memset(_rreq_buckets, RREQ_NONE, sizeof(_rreq_buckets));
+    for (unsigned i = 0; i < AODVV2_RREQ_BUF; i++) {
+        _rreq_chain[i] = i + 1;
+    }
+    _rreq_free = 0;
     mutex_unlock(&rreqt_mutex);
     AODV_DEBUG("RREQ table initialized.\n");
 }
@@ -174,7 +187,11 @@ bool rreqtable_is_redundant(struct aodvv2_packet_data *packet_data)
  */
 static struct aodvv2_rreq_entry *_get_comparable_rreq(struct aodvv2_packet_data *packet_data)
 {
-    for (unsigned i = 0; i < AODVV2_RREQ_BUF; i++) {
+    uint8_t next;
+    uint8_t bucket = _rreq_bucket(&packet_data->origNode.addr, &packet_data->targNode.addr);
+
+    for (uint8_t i = _rreq_buckets[bucket]; i != RREQ_NONE; i = next) {
+        next = _rreq_chain[i];
         _reset_entry_if_stale(i);
 
         if (!netaddr_cmp(&rreq_table[i].origNode, &packet_data->origNode.addr)
@@ -193,20 +210,32 @@ static void _add_rreq(struct aodvv2_packet_data *packet_data)
     if (_get_comparable_rreq(packet_data)) {
         return;
     }
-    /*find empty rreq and fill it with packet_data */
-
-    for (unsigned i = 0; i < AODVV2_RREQ_BUF; i++) {
-        if (!rreq_table[i].timestamp.seconds &&
-            !rreq_table[i].timestamp.microseconds) {
-            rreq_table[i].origNode = packet_data->origNode.addr;
-            rreq_table[i].targNode = packet_data->targNode.addr;
-            rreq_table[i].metricType = packet_data->metricType;
-            rreq_table[i].metric = packet_data->origNode.metric;
-            rreq_table[i].seqnum = packet_data->origNode.seqnum;
-            rreq_table[i].timestamp = packet_data->timestamp;
-            return;
-        }
+    /* take an empty rreq and fill it with packet_data */
+    uint8_t i = _rreq_free;
+    if (i == RREQ_NONE) {
+        return;
+    }
+    _rreq_free = _rreq_chain[i];
+
+    rreq_table[i].origNode = packet_data->origNode.addr;
+    rreq_table[i].targNode = packet_data->targNode.addr;
+    rreq_table[i].metricType = packet_data->metricType;
+    rreq_table[i].metric = packet_data->origNode.metric;
+    rreq_table[i].seqnum = packet_data->origNode.seqnum;
+    rreq_table[i].timestamp = packet_data->timestamp;
+    /* a zero timestamp would mark the entry as unused and keep it from expiring */
+    if (timex_cmp(rreq_table[i].timestamp, null_time) == 0) {
+        vtimer_now(&rreq_table[i].timestamp);
     }
+
+    uint8_t bucket = _rreq_bucket(&rreq_table[i].origNode, &rreq_table[i].targNode);
+    _rreq_chain[i] = _rreq_buckets[bucket];
+    _rreq_buckets[bucket] = i;
+}
+
+static uint8_t _rreq_bucket(struct netaddr *origNode, struct netaddr *targNode)
+{
+    return (netaddr_hash(origNode) ^ netaddr_hash(targNode)) % AODVV2_RREQ_BUCKETS;
 }
 
 /*
@@ -224,8 +253,30 @@ static void _reset_entry_if_stale(uint8_t i)
         /* timestamp+expiration time is in the past: this entry is stale */
         DEBUG("\treset rreq table entry %s\n",
               netaddr_to_string(&nbuf, &rreq_table[i].origNode));
+
+        uint8_t *link = &_rreq_buckets[_rreq_bucket(&rreq_table[i].origNode,
+                                                     &rreq_table[i].targNode)];
+        while (*link != RREQ_NONE && *link != i) {
+            link = &_rreq_chain[*link];
+        }
+        if (*link == i) {
+            *link = _rreq_chain[i];
+        }
+
         memset(&rreq_table[i], 0, sizeof(rreq_table[i]));
+        _rreq_chain[i] = _rreq_free;
+        _rreq_free = i;
+    }
+}
+
+uint8_t netaddr_hash(struct netaddr *addr)
+{
+    /* the interface identifier is what tells the nodes of one network apart */
+    uint8_t hash = 0;
+    for (unsigned i = NETADDR_MAX_LENGTH / 2; i < NETADDR_MAX_LENGTH; i++) {
+        hash ^= addr->_addr[i];
     }
+    return hash;
 }
 
 void ipv6_addr_t_to_netaddr(ipv6_addr_t *src, struct netaddr *dst)
@@ -36,6 +36,7 @@ extern "C" {
 
 #define AODVV2_MAX_CLIENTS 1        /** multiple clients are currently not supported. */
 #define AODVV2_RREQ_BUF 128         /** should be enough for now... */
+#define AODVV2_RREQ_BUCKETS 16      /** number of hash buckets indexing the RREQ table */
 #define AODVV2_RREQ_WAIT_TIME 2     /** seconds */
 #define AODVV2_RIOT_PREFIXLEN  128  /** Prefix length of the IPv6 addresses
                                      *  used in the network served by AODVv2 () */
@@ -95,6 +96,13 @@ void rreqtable_init(void);
  */
 bool rreqtable_is_redundant(struct aodvv2_packet_data *packet_data);
 
+/**
+ * Hash an address, used to index the routing and RREQ tables
+ * @param addr      address to hash
+ * @return          hash of addr
+ */
+uint8_t netaddr_hash(struct netaddr *addr);
+
 /**
  * Convert an IP stored as an ipv6_addr_t to a netaddr
  * @param src       ipv6_addr_t to convert
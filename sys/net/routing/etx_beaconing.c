@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "event.h"
 #include "mutex.h"
 #include "hwtimer.h"
 #include "vtimer.h"
@@ -37,14 +38,13 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+/* asks etx_radio to send a beacon */
+#define ETX_MSG_TYPE_BEACON     (0x0520)
+
 #if ENABLE_DEBUG
-#define ETX_BEACON_STACKSIZE    (THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF_FLOAT)
 #define ETX_RADIO_STACKSIZE     (THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF_FLOAT)
-#define ETX_CLOCK_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
 #else
-#define ETX_BEACON_STACKSIZE    (THREAD_STACKSIZE_MAIN)
 #define ETX_RADIO_STACKSIZE     (THREAD_STACKSIZE_MAIN)
-#define ETX_CLOCK_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
 #endif
 
 /* prototytpes */
@@ -52,22 +52,30 @@ static uint8_t etx_count_packet_tx(etx_neighbor_t *candidate);
 static void etx_set_packets_received(void);
 static bool etx_equal_id(ipv6_addr_t *id1, ipv6_addr_t *id2);
 
-static void *etx_beacon(void *);
-static void *etx_clock(void *);
+static void etx_beacon(void *);
+static void etx_send_beacon(void);
 static void *etx_radio(void *);
 
 /* Buffer */
-static char etx_beacon_buf[ETX_BEACON_STACKSIZE];
 static char etx_radio_buf[ETX_RADIO_STACKSIZE];
-static char etx_clock_buf[ETX_CLOCK_STACKSIZE];
 
 static uint8_t etx_send_buf[ETX_BUF_SIZE];
 static uint8_t etx_rec_buf[ETX_BUF_SIZE];
 
 /* PIDs */
-static kernel_pid_t etx_beacon_pid = KERNEL_PID_UNDEF;
 static kernel_pid_t etx_radio_pid = KERNEL_PID_UNDEF;
-static kernel_pid_t etx_clock_pid = KERNEL_PID_UNDEF;
+
+/* beacons are timed by the event thread and sent by etx_radio, so the event
+ * thread neither waits for etx_mutex nor for the radio */
+static event_t etx_beacon_event = { .handler = etx_beacon };
+static event_timeout_t etx_beacon_timeout;
+
+/*
+ * The jittercorrection and jitter variables keep usecond values divided
+ * through 1000 to fit into uint8 variables.
+ */
+static uint8_t jittercorrection = ETX_DEF_JIT_CORRECT;
+static uint8_t jitter;
 
 /* Message queue for radio */
 static msg_t msg_que[ETX_RCV_QUEUE_SIZE];
@@ -147,73 +155,82 @@ void etx_init_beaconing(ipv6_addr_t *address)
     DEBUGF("ETX BEACON INIT");
     etx_send_buf[0] = ETX_PKT_OPTVAL;
 
-    etx_beacon_pid = thread_create(etx_beacon_buf, sizeof(etx_beacon_buf),
-                                   THREAD_PRIORITY_MAIN - 1, CREATE_STACKTEST,
-                                   etx_beacon, NULL, "etx_beacon");
-
     etx_radio_pid = thread_create(etx_radio_buf, sizeof(etx_radio_buf),
                                   THREAD_PRIORITY_MAIN - 1, CREATE_STACKTEST,
                                   etx_radio, NULL, "etx_radio");
 
-    etx_clock_pid = thread_create(etx_clock_buf, sizeof(etx_clock_buf),
-                                  THREAD_PRIORITY_MAIN - 1, CREATE_STACKTEST,
-                                  etx_clock, NULL, "etx_clock");
+    jitter = (uint8_t)(rand() % ETX_JITTER_MOD);
+    event_post(&etx_beacon_event);
     //register at transceiver
     transceiver_register(TRANSCEIVER_CC1100, etx_radio_pid);
     DEBUG("...[DONE]\n");
 }
 
-static void *etx_beacon(void *arg)
+static void etx_beacon(void *arg)
 {
     (void) arg;
 
     /*
-     * Sends a message every ETX_INTERVAL +/- a jitter-value (default is 10%) .
+     * Asks etx_radio for a beacon every ETX_INTERVAL +/- a jitter-value
+     * (default is 10%).
      * A correcting variable is needed to stay at a base interval of
      * ETX_INTERVAL between the wakeups. It takes the old jittervalue in account
      * and modifies the time to wait accordingly.
      */
+    msg_t m;
+
+    event_timeout_set(&etx_beacon_timeout, &etx_beacon_event,
+                      timex_from_uint64(((ETX_INTERVAL - ETX_MAX_JITTER) * MS) +
+                                        jittercorrection * MS + jitter * MS -
+                                        ETX_CLOCK_ADJUST));
+
+    jittercorrection = (ETX_MAX_JITTER) - jitter;
+    jitter = (uint8_t)(rand() % ETX_JITTER_MOD);
+
+    m.type = ETX_MSG_TYPE_BEACON;
+    if (msg_try_send(&m, etx_radio_pid) < 1) {
+        DEBUG("etx_radio busy, skipping beacon\n");
+    }
+}
+
+static void etx_send_beacon(void)
+{
     etx_probe_t *packet = etx_get_send_buf();
 
-    while (true) {
-        thread_sleep();
-        mutex_lock(&etx_mutex);
-        //Build etx packet
-        uint8_t p_length = 0;
-
-        for (uint8_t i = 0; i < ETX_BEST_CANDIDATES; i++) {
-            if (candidates[i].used != 0) {
-                packet->data[i * ETX_TUPLE_SIZE] =
-                    candidates[i].addr.uint8[ETX_IPV6_LAST_BYTE];
-                packet->data[i * ETX_TUPLE_SIZE + ETX_PKT_REC_OFFSET] =
-                    etx_count_packet_tx(&candidates[i]);
-                p_length = p_length + ETX_PKT_HDR_LEN;
-            }
+    mutex_lock(&etx_mutex);
+    //Build etx packet
+    uint8_t p_length = 0;
+
+    for (uint8_t i = 0; i < ETX_BEST_CANDIDATES; i++) {
+        if (candidates[i].used != 0) {
+            packet->data[i * ETX_TUPLE_SIZE] =
+                candidates[i].addr.uint8[ETX_IPV6_LAST_BYTE];
+            packet->data[i * ETX_TUPLE_SIZE + ETX_PKT_REC_OFFSET] =
+                etx_count_packet_tx(&candidates[i]);
+            p_length = p_length + ETX_PKT_HDR_LEN;
         }
+    }
 
-        packet->length = p_length;
-        /* will be send broadcast, so if_id and destination address will be
-         * ignored (see documentation)
-         */
-        sixlowpan_mac_send_ieee802154_frame(0, NULL, 8, &etx_send_buf[0],
-                                            ETX_DATA_MAXLEN + ETX_PKT_HDR_LEN, 1);
-        DEBUG("sent beacon!\n");
-        etx_set_packets_received();
-        cur_round++;
-
-        if (cur_round == ETX_WINDOW) {
-            if (reached_window != 1) {
-                //first round is through
-                reached_window = 1;
-            }
-
-            cur_round = 0;
+    packet->length = p_length;
+    /* will be send broadcast, so if_id and destination address will be
+     * ignored (see documentation)
+     */
+    sixlowpan_mac_send_ieee802154_frame(0, NULL, 8, &etx_send_buf[0],
+                                        ETX_DATA_MAXLEN + ETX_PKT_HDR_LEN, 1);
+    DEBUG("sent beacon!\n");
+    etx_set_packets_received();
+    cur_round++;
+
+    if (cur_round == ETX_WINDOW) {
+        if (reached_window != 1) {
+            //first round is through
+            reached_window = 1;
         }
 
-        mutex_unlock(&etx_mutex);
+        cur_round = 0;
     }
 
-    return NULL;
+    mutex_unlock(&etx_mutex);
 }
 
 etx_neighbor_t *etx_find_candidate(ipv6_addr_t *address)
@@ -232,43 +249,6 @@ etx_neighbor_t *etx_find_candidate(ipv6_addr_t *address)
     return NULL ;
 }
 
-static void *etx_clock(void *arg)
-{
-    (void) arg;
-
-    /*
-     * Manages the etx_beacon thread to wake up every full second +- jitter
-     */
-
-    /*
-     * The jittercorrection and jitter variables keep usecond values divided
-     * through 1000 to fit into uint8 variables.
-     *
-     * That is why they are multiplied by 1000 when used for hwtimer_wait.
-     */
-    uint8_t jittercorrection = ETX_DEF_JIT_CORRECT;
-    uint8_t jitter = (uint8_t)(rand() % ETX_JITTER_MOD);
-
-    while (true) {
-        thread_wakeup(etx_beacon_pid);
-
-        /*
-         * Vtimer is buggy, but I seem to have no hwtimers left, so using this
-         * for now.
-         */
-        vtimer_usleep(
-            ((ETX_INTERVAL - ETX_MAX_JITTER)*MS) + jittercorrection * MS + jitter * MS - ETX_CLOCK_ADJUST);
-
-        //hwtimer_wait(
-        //        HWTIMER_TICKS(((ETX_INTERVAL - ETX_MAX_JITTER)*MS) + jittercorrection*MS + jitter*MS - ETX_CLOCK_ADJUST));
-
-        jittercorrection = (ETX_MAX_JITTER) - jitter;
-        jitter = (uint8_t)(rand() % ETX_JITTER_MOD);
-    }
-
-    return NULL;
-}
-
 double etx_get_metric(ipv6_addr_t *address)
 {
     etx_neighbor_t *candidate = etx_find_candidate(address);
@@ -429,6 +409,9 @@ static void *etx_radio(void *arg)
 
             p->processing--;
         }
+        else if (m.type == ETX_MSG_TYPE_BEACON) {
+            etx_send_beacon();
+        }
         else if (m.type == ENOBUFFER) {
             DEBUGF("Transceiver buffer full\n");
         }
@@ -39,10 +39,8 @@
 /* Internal variables */
 static mutex_t mtx_iib_access = MUTEX_INIT;
 static iib_base_entry_t *iib_base_entry_head = NULL;
-
-#if (NHDP_METRIC == NHDP_LMT_DAT)
-static const double const_dat = (((double)DAT_CONSTANT) / DAT_MAXIMUM_LOSS);
-#endif
+/* Earliest time at which the status of a link tuple may change */
+static timex_t lt_next_event;
 
 /* Internal function prototypes */
 static void rem_link_set_entry(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry);
@@ -67,12 +65,14 @@ static void update_nb_tuple_symmetry(iib_base_entry_t *base_entry,
                                      iib_link_set_entry_t *ls_entry, timex_t *now);
 static void rem_not_heard_nb_tuple(iib_link_set_entry_t *ls_entry, timex_t *now);
 
+static void add_lt_events(iib_link_set_entry_t *ls_entry, timex_t *next_event);
 static inline timex_t get_max_timex(timex_t time_one, timex_t time_two);
 static iib_link_tuple_status_t get_tuple_status(iib_link_set_entry_t *ls_entry, timex_t *now);
 
 #if (NHDP_METRIC == NHDP_LMT_DAT)
-static void queue_rem(uint8_t *queue);
-static uint16_t queue_sum(uint8_t *queue);
+static inline int metric_changed(uint32_t old_metric, uint32_t new_metric);
+static void dat_queue_set(iib_link_set_entry_t *ls_entry, uint8_t received, uint8_t total);
+static void dat_queue_shift(iib_link_set_entry_t *ls_entry);
 static void dat_metric_refresh(void);
 #endif
 
@@ -139,15 +139,9 @@ void iib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
     iib_base_entry_t *base_elt;
     iib_link_set_entry_t *ls_elt;
     nhdp_addr_entry_t *addr_elt;
-    timex_t now;
 
     mutex_lock(&mtx_iib_access);
 
-    vtimer_now(&now);
-
-    /* Before adding addresses first update the status of all link tuples */
-    iib_update_lt_status(&now);
-
     /* Add all addresses of Link Tuples of the given interface's Link Set to the current HELLO */
     LL_FOREACH(iib_base_entry_head, base_elt) {
         if (base_elt->if_pid == if_pid) {
@@ -214,10 +208,21 @@ void iib_update_lt_status(timex_t *now)
     iib_base_entry_t *base_elt;
     iib_link_set_entry_t *ls_elt, *ls_tmp;
 
+    if (timex_cmp(lt_next_event, *now) == 1) {
+        /* No link tuple changes its status before the next event */
+        return;
+    }
+
+    lt_next_event.seconds = UINT32_MAX;
+    lt_next_event.microseconds = 0;
+
     LL_FOREACH(iib_base_entry_head, base_elt) {
         LL_FOREACH_SAFE(base_elt->link_set_head, ls_elt, ls_tmp) {
             wr_update_ls_status(base_elt, ls_elt, now);
         }
+        LL_FOREACH(base_elt->link_set_head, ls_elt) {
+            add_lt_events(ls_elt, &lt_next_event);
+        }
     }
 }
 
@@ -250,10 +255,10 @@ void iib_process_metric_msg(iib_link_set_entry_t *ls_entry, uint64_t int_time)
     ls_entry->hello_interval = rfc5444_timetlv_encode(int_time);
     if (ls_entry->last_seq_no == 0) {
         timex_t now, i_time;
+        uint8_t pos = ls_entry->dat_q_pos;
         vtimer_now(&now);
         i_time = timex_from_uint64(int_time * MS_IN_USEC * DAT_HELLO_TIMEOUT_FACTOR);
-        ls_entry->dat_received[0]++;
-        ls_entry->dat_total[0]++;
+        dat_queue_set(ls_entry, ls_entry->dat_received[pos] + 1, ls_entry->dat_total[pos] + 1);
         ls_entry->dat_time = timex_add(now, i_time);
     }
 #else
@@ -272,22 +277,24 @@ void iib_process_metric_pckt(iib_link_set_entry_t *ls_entry, uint32_t metric_out
     (void)metric_out;
     (void)seq_no;
 #elif (NHDP_METRIC == NHDP_LMT_DAT)
+    uint32_t nb_metric_out = NHDP_METRIC_UNKNOWN;
+
     /* Metric packet processing */
     if (ls_entry->last_seq_no == 0) {
-        ls_entry->dat_received[0] = 1;
-        ls_entry->dat_total[0] = 1;
+        dat_queue_set(ls_entry, 1, 1);
     }
     /* Don't add values to the queue for duplicate packets */
     else if (seq_no != ls_entry->last_seq_no) {
         uint16_t seq_diff;
+        uint8_t pos = ls_entry->dat_q_pos;
         if (seq_no < ls_entry->last_seq_no) {
             seq_diff = (uint16_t) ((((uint32_t) seq_no) + 0xFFFF) - ls_entry->last_seq_no);
         }
         else {
             seq_diff = seq_no - ls_entry->last_seq_no;
         }
-        ls_entry->dat_total[0] += (seq_diff > NHDP_SEQNO_RESTART_DETECT) ? 1 : seq_diff;
-        ls_entry->dat_received[0]++;
+        dat_queue_set(ls_entry, ls_entry->dat_received[pos] + 1, ls_entry->dat_total[pos]
+                      + ((seq_diff > NHDP_SEQNO_RESTART_DETECT) ? 1 : seq_diff));
     }
 
     ls_entry->last_seq_no = seq_no;
@@ -303,6 +310,7 @@ void iib_process_metric_pckt(iib_link_set_entry_t *ls_entry, uint32_t metric_out
 
     /* Refresh metric value for link tuple and corresponding neighbor tuple */
     if (ls_entry->nb_elt) {
+        nb_metric_out = ls_entry->nb_elt->metric_out;
         if ((metric_out <= ls_entry->nb_elt->metric_out) ||
                 (ls_entry->nb_elt->metric_out == NHDP_METRIC_UNKNOWN)) {
             /* Better value, use it also for your neighbor */
@@ -325,6 +333,13 @@ void iib_process_metric_pckt(iib_link_set_entry_t *ls_entry, uint32_t metric_out
                 }
             }
         }
+
+        if (metric_changed(nb_metric_out, ls_entry->nb_elt->metric_out)) {
+            nhdp_writer_invalidate();
+        }
+    }
+    if (metric_changed(ls_entry->metric_out, metric_out)) {
+        nhdp_writer_invalidate();
     }
     ls_entry->metric_out = metric_out;
 #else
@@ -348,6 +363,45 @@ void iib_process_metric_refresh(void)
 #endif
 }
 
+#if (NHDP_METRIC == NHDP_LMT_DAT)
+uint32_t iib_dat_metric(iib_link_set_entry_t *ls_entry)
+{
+    uint32_t sum_total, sum_rcvd, loss, bitrate, metric;
+
+    /* Sums are scaled by DAT_MEMORY_LENGTH to apply the lost time proportion */
+    sum_rcvd = ((uint32_t)ls_entry->dat_received_sum) * DAT_MEMORY_LENGTH;
+    sum_total = ((uint32_t)ls_entry->dat_total_sum) * DAT_MEMORY_LENGTH;
+
+    if ((ls_entry->hello_interval != 0) && (ls_entry->lost_hellos > 0)) {
+        /* Compute lost time proportion (in units of 1 / DAT_MEMORY_LENGTH) */
+        uint32_t lost = ((uint32_t)ls_entry->hello_interval) * ls_entry->lost_hellos;
+        if (lost >= DAT_MEMORY_LENGTH) {
+            sum_rcvd = 0;
+        }
+        else {
+            sum_rcvd = ((uint32_t)ls_entry->dat_received_sum) * (DAT_MEMORY_LENGTH - lost);
+        }
+    }
+
+    if (sum_rcvd < DAT_MEMORY_LENGTH) {
+        return NHDP_METRIC_MAXIMUM;
+    }
+
+    /* Fixed-point loss with DAT_LOSS_FRAC_BITS fractional bits */
+    if (sum_total >= sum_rcvd * DAT_MAXIMUM_LOSS) {
+        loss = DAT_MAXIMUM_LOSS << DAT_LOSS_FRAC_BITS;
+    }
+    else {
+        loss = (sum_total << DAT_LOSS_FRAC_BITS) / sum_rcvd;
+    }
+    bitrate = ls_entry->rx_bitrate / DAT_MINIMUM_BITRATE;
+    metric = (((DAT_CONSTANT / DAT_MAXIMUM_LOSS) >> DAT_LOSS_FRAC_BITS) * loss)
+             / (bitrate ? bitrate : 1);
+
+    return (metric > NHDP_METRIC_MAXIMUM) ? NHDP_METRIC_MAXIMUM : metric;
+}
+#endif
+
 
 /*------------------------------------------------------------------------------------*/
 /*                                Internal functions                                  */
@@ -403,8 +457,10 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
     iib_link_set_entry_t *ls_elt, *ls_tmp;
     iib_link_set_entry_t *matching_lt = NULL;
     nhdp_addr_entry_t *lt_elt;
+    iib_link_tuple_status_t old_status = IIB_LT_STATUS_UNKNOWN;
     timex_t v_time, l_hold;
     uint8_t matches = 0;
+    int old_addr_count = -1, new_addr_count = 0;
 
     /* Loop through every link tuple of the interface to update the link set */
     LL_FOREACH_SAFE(base_entry->link_set_head, ls_elt, ls_tmp) {
@@ -439,6 +495,16 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
     }
     else if (matches == 1) {
         /* A single matching link tuple, only release the address list */
+        old_status = matching_lt->last_status;
+        old_addr_count = 0;
+        LL_FOREACH(matching_lt->address_list_head, lt_elt) {
+            if (!NHDP_ADDR_TMP_IN_SEND_LIST(lt_elt->address)) {
+                /* The address list changed */
+                old_addr_count = -1;
+                break;
+            }
+            old_addr_count++;
+        }
         release_link_tuple_addresses(matching_lt);
     }
     else {
@@ -463,6 +529,7 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
         return NULL;
     }
 
+    LL_COUNT(matching_lt->address_list_head, lt_elt, new_addr_count);
     matching_lt->nb_elt = nb_elt;
 
     /* Set values dependent on link status */
@@ -510,6 +577,12 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
         }
     }
 
+    if ((old_addr_count != new_addr_count) || (old_status != matching_lt->last_status)) {
+        /* The link tuple's addresses or its status in HELLOs changed */
+        nhdp_writer_invalidate();
+    }
+    add_lt_events(matching_lt, &lt_next_event);
+
     return matching_lt;
 }
 
@@ -535,6 +608,7 @@ static void wr_update_ls_status(iib_base_entry_t *base_entry,
         /* Status changed from SYMMETRIC to HEARD */
         update_nb_tuple_symmetry(base_entry, ls_elt, now);
         ls_elt->last_status = IIB_LT_STATUS_HEARD;
+        nhdp_writer_invalidate();
 
         if (timex_cmp(ls_elt->heard_time, *now) != 1) {
             /* New status is LOST (equals IIB_LT_STATUS_UNKNOWN) */
@@ -549,6 +623,7 @@ static void wr_update_ls_status(iib_base_entry_t *base_entry,
         rem_not_heard_nb_tuple(ls_elt, now);
         ls_elt->nb_elt = NULL;
         ls_elt->last_status = IIB_LT_STATUS_UNKNOWN;
+        nhdp_writer_invalidate();
     }
 }
 
@@ -596,6 +671,9 @@ static void reset_link_set_entry(iib_link_set_entry_t *ls_entry, timex_t *now, u
 #if (NHDP_METRIC == NHDP_LMT_DAT)
     memset(ls_entry->dat_received, 0, NHDP_Q_MEM_LENGTH);
     memset(ls_entry->dat_total, 0, NHDP_Q_MEM_LENGTH);
+    ls_entry->dat_received_sum = 0;
+    ls_entry->dat_total_sum = 0;
+    ls_entry->dat_q_pos = 0;
     ls_entry->dat_time.microseconds = 0;
     ls_entry->dat_time.seconds = 0;
     ls_entry->hello_interval = 0;
@@ -613,6 +691,7 @@ static void rem_link_set_entry(iib_base_entry_t *base_entry, iib_link_set_entry_
     LL_DELETE(base_entry->link_set_head, ls_entry);
     release_link_tuple_addresses(ls_entry);
     free(ls_entry);
+    nhdp_writer_invalidate();
 }
 
 /**
@@ -798,6 +877,27 @@ static iib_link_tuple_status_t get_tuple_status(iib_link_set_entry_t *ls_entry,
     return IIB_LT_STATUS_UNKNOWN;
 }
 
+/**
+ * Lower next_event to the earliest time at which the status of a link tuple may change
+ */
+static void add_lt_events(iib_link_set_entry_t *ls_entry, timex_t *next_event)
+{
+    if (timex_cmp(ls_entry->exp_time, *next_event) == -1) {
+        *next_event = ls_entry->exp_time;
+    }
+
+    if ((ls_entry->last_status == IIB_LT_STATUS_SYM)
+        && (timex_cmp(ls_entry->sym_time, *next_event) == -1)) {
+        *next_event = ls_entry->sym_time;
+    }
+
+    if (((ls_entry->last_status == IIB_LT_STATUS_SYM)
+         || (ls_entry->last_status == IIB_LT_STATUS_HEARD))
+        && (timex_cmp(ls_entry->heard_time, *next_event) == -1)) {
+        *next_event = ls_entry->heard_time;
+    }
+}
+
 /**
  * Get the later one of two timex representation
  */
@@ -812,36 +912,34 @@ static inline timex_t get_max_timex(timex_t time_one, timex_t time_two)
 
 #if (NHDP_METRIC == NHDP_LMT_DAT)
 /**
- * Sum all elements in the queue
+ * Check whether the encoded representation of a metric value changed
  */
-static uint16_t queue_sum(uint8_t *queue)
+static inline int metric_changed(uint32_t old_metric, uint32_t new_metric)
 {
-    uint16_t sum = 0;
-
-    for (int i = 0; i < NHDP_Q_MEM_LENGTH; i++) {
-        sum += queue[i];
-    }
-
-    return sum;
+    return rfc5444_metric_encode(old_metric) != rfc5444_metric_encode(new_metric);
 }
 
 /**
- * Remove the oldest element in the queue
+ * Set the newest elements of the DAT queues and keep the queue sums up to date
  */
-static void queue_rem(uint8_t *queue)
+static void dat_queue_set(iib_link_set_entry_t *ls_entry, uint8_t received, uint8_t total)
 {
-    uint8_t temp;
-    uint8_t prev_value = queue[0];
+    uint8_t pos = ls_entry->dat_q_pos;
 
-    /* Clear spot for a new element */
-    queue[0] = 0;
+    ls_entry->dat_received_sum += received - ls_entry->dat_received[pos];
+    ls_entry->dat_total_sum += total - ls_entry->dat_total[pos];
+    ls_entry->dat_received[pos] = received;
+    ls_entry->dat_total[pos] = total;
+}
 
-    /* Shift elements */
-    for (int i = 1; i < NHDP_Q_MEM_LENGTH; i++) {
-        temp = queue[i];
-        queue[i] = prev_value;
-        prev_value = temp;
-    }
+/**
+ * Remove the oldest elements of the DAT queues to clear a spot for new elements
+ */
+static void dat_queue_shift(iib_link_set_entry_t *ls_entry)
+{
+    /* The queues are rings, the oldest elements follow the newest ones */
+    ls_entry->dat_q_pos = (ls_entry->dat_q_pos + 1) % NHDP_Q_MEM_LENGTH;
+    dat_queue_set(ls_entry, 0, 0);
 }
 
 /**
@@ -851,42 +949,19 @@ static void dat_metric_refresh(void)
 {
     iib_base_entry_t *base_elt;
     iib_link_set_entry_t *ls_elt;
-    uint32_t metric_temp;
-    double sum_total, sum_rcvd, loss;
+    uint32_t metric_temp, nb_metric_temp;
 
     LL_FOREACH(iib_base_entry_head, base_elt) {
         LL_FOREACH(base_elt->link_set_head, ls_elt) {
-            sum_rcvd = queue_sum(ls_elt->dat_received);
-            sum_total = queue_sum(ls_elt->dat_total);
             metric_temp = ls_elt->metric_in;
+            ls_elt->metric_in = iib_dat_metric(ls_elt);
 
-            if ((ls_elt->hello_interval != 0) && (ls_elt->lost_hellos > 0)) {
-                /* Compute lost time proportion */
-                loss = (((double)ls_elt->hello_interval) * ((double)ls_elt->lost_hellos))
-                        / DAT_MEMORY_LENGTH;
-                if (loss >= 1.0) {
-                    sum_rcvd = 0.0;
-                }
-                else {
-                    sum_rcvd *= (1.0 - loss);
-                }
-            }
-
-            if (sum_rcvd < 1.0) {
-                ls_elt->metric_in = NHDP_METRIC_MAXIMUM;
-            }
-            else {
-                loss = sum_total / sum_rcvd;
-                if (loss > DAT_MAXIMUM_LOSS) {
-                    loss = DAT_MAXIMUM_LOSS;
-                }
-                ls_elt->metric_in = (const_dat * loss) / (ls_elt->rx_bitrate / DAT_MINIMUM_BITRATE);
-                if (ls_elt->metric_in > NHDP_METRIC_MAXIMUM) {
-                    ls_elt->metric_in = NHDP_METRIC_MAXIMUM;
-                }
+            if (metric_changed(metric_temp, ls_elt->metric_in)) {
+                nhdp_writer_invalidate();
             }
 
             if (ls_elt->nb_elt) {
+                nb_metric_temp = ls_elt->nb_elt->metric_in;
                 if (ls_elt->metric_in <= ls_elt->nb_elt->metric_in ||
                         (ls_elt->nb_elt->metric_in == NHDP_METRIC_UNKNOWN)) {
                     /* Better value, use it also for your neighbor */
@@ -909,10 +984,13 @@ static void dat_metric_refresh(void)
                         }
                     }
                 }
+
+                if (metric_changed(nb_metric_temp, ls_elt->nb_elt->metric_in)) {
+                    nhdp_writer_invalidate();
+                }
             }
 
-            queue_rem(ls_elt->dat_received);
-            queue_rem(ls_elt->dat_total);
+            dat_queue_shift(ls_elt);
         }
     }
 }
@@ -58,6 +58,9 @@ typedef struct iib_link_set_entry_t {
 #if (NHDP_METRIC == NHDP_LMT_DAT)
     uint8_t dat_received[NHDP_Q_MEM_LENGTH];    /**< Queue for containing sums of rcvd packets */
     uint8_t dat_total[NHDP_Q_MEM_LENGTH];       /**< Queue for containing sums of xpctd packets */
+    uint16_t dat_received_sum;                  /**< Sum of all elements of dat_received */
+    uint16_t dat_total_sum;                     /**< Sum of all elements of dat_total */
+    uint8_t dat_q_pos;                          /**< Position of the newest queue elements */
     timex_t dat_time;                           /**< Time next HELLO is expected */
     uint8_t hello_interval;                     /**< Encoded HELLO interval value */
     uint8_t lost_hellos;                        /**< Lost HELLO count after last received HELLO */
@@ -137,6 +140,7 @@ void iib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr);
  *
  * @note
  * If a status change appears the steps described in section 13 of RFC 6130 are executed.
+ * Returns immediately if no Link Tuple times out before @p now.
  *
  * @param[in] now           Pointer to current time timex representation
  */
@@ -181,6 +185,21 @@ void iib_process_metric_pckt(iib_link_set_entry_t *ls_entry, uint32_t metric_out
  */
 void iib_process_metric_refresh(void);
 
+#if (NHDP_METRIC == NHDP_LMT_DAT)
+/**
+ * @brief                   Compute the incoming DAT metric value of a Link Tuple
+ *
+ * The loss is computed in fixed point with DAT_LOSS_FRAC_BITS fractional bits
+ * from the sums of the Link Tuple's DAT queues and its lost HELLOs.
+ *
+ * @param[in] ls_entry      Pointer to the Link Tuple
+ *
+ * @return                  The incoming DAT metric value, NHDP_METRIC_MAXIMUM
+ *                          if (almost) nothing was received on the link
+ */
+uint32_t iib_dat_metric(iib_link_set_entry_t *ls_entry);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -90,6 +90,7 @@ void lib_rem_if(kernel_pid_t if_pid)
             nhdp_free_addr_list(lib_elt->if_addr_list_head);
             LL_DELETE(lib_entry_head, lib_elt);
             free(lib_elt);
+            nhdp_writer_invalidate();
             break;
         }
     }
@@ -206,6 +207,7 @@ static int add_address_to_if(lib_entry_t *if_entry, nhdp_addr_t *addr)
     addr->usg_count++;
     new_entry->address = addr;
     LL_PREPEND(if_entry->if_addr_list_head, new_entry);
+    nhdp_writer_invalidate();
 
     return 0;
 }
@@ -23,7 +23,7 @@
 #include "net/ng_netif.h"
 #include "thread.h"
 #include "utlist.h"
-#include "mutex.h"
+#include "kernel_macros.h"
 
 #include "rfc5444/rfc5444_writer.h"
 
@@ -35,6 +35,15 @@
 #include "nhdp_writer.h"
 #include "nhdp_reader.h"
 
+/* Message type for a received packet handed to the NHDP thread */
+#define NHDP_MSG_PACKET     (5446)
+
+/* A received packet handed to the NHDP thread */
+typedef struct {
+    void *buffer;
+    size_t length;
+} nhdp_rcv_pkt_t;
+
 char nhdp_stack[NHDP_STACK_SIZE];
 char nhdp_rcv_stack[NHDP_STACK_SIZE];
 
@@ -43,7 +52,6 @@ static kernel_pid_t nhdp_pid = KERNEL_PID_UNDEF;
 static kernel_pid_t nhdp_rcv_pid = KERNEL_PID_UNDEF;
 static kernel_pid_t helper_pid = KERNEL_PID_UNDEF;
 static nhdp_if_entry_t nhdp_if_table[NG_NETIF_NUMOF];
-static mutex_t send_rcv_mutex = MUTEX_INIT;
 static sockaddr6_t sa_bcast;
 static int sock_rcv;
 
@@ -74,6 +82,8 @@ void nhdp_init(void)
     for (int i = 0; i < NG_NETIF_NUMOF; i++) {
         nhdp_if_table[i].if_pid = KERNEL_PID_UNDEF;
         memset(&nhdp_if_table[i].wr_target, 0, sizeof(struct rfc5444_writer_target));
+        nhdp_if_table[i].hello_buf = NULL;
+        nhdp_if_table[i].hello_len = 0;
     }
 
     /* Initialize reader and writer */
@@ -147,6 +157,14 @@ int nhdp_register_if(kernel_pid_t if_pid, uint8_t *addr, size_t addr_size, uint8
         return -1;
     }
 
+    if_entry->hello_buf = (uint8_t *) calloc(payload_size, sizeof(uint8_t));
+
+    if (!if_entry->hello_buf) {
+        /* Insufficient memory */
+        free(if_entry->wr_target.packet_buffer);
+        return -1;
+    }
+
     if_entry->wr_target.packet_size = payload_size;
     if_entry->wr_target.sendPacket = write_packet;
 
@@ -156,12 +174,14 @@ int nhdp_register_if(kernel_pid_t if_pid, uint8_t *addr, size_t addr_size, uint8
     if (!nhdp_addr) {
         /* Insufficient memory */
         free(if_entry->wr_target.packet_buffer);
+        free(if_entry->hello_buf);
         return -1;
     }
 
     /* Add the interface to the LIB */
     if (lib_add_if_addr(if_pid, nhdp_addr) != 0) {
         free(if_entry->wr_target.packet_buffer);
+        free(if_entry->hello_buf);
         nhdp_decrement_addr_usage(nhdp_addr);
         return -1;
     }
@@ -170,6 +190,7 @@ int nhdp_register_if(kernel_pid_t if_pid, uint8_t *addr, size_t addr_size, uint8
     if (iib_register_if(if_pid) != 0) {
         /* TODO: Cleanup lib entry */
         free(if_entry->wr_target.packet_buffer);
+        free(if_entry->hello_buf);
         nhdp_decrement_addr_usage(nhdp_addr);
         return -1;
     }
@@ -185,6 +206,7 @@ int nhdp_register_if(kernel_pid_t if_pid, uint8_t *addr, size_t addr_size, uint8
     timex_normalize(&if_entry->validity_time);
     /* Reset sequence number */
     if_entry->seq_no = 0;
+    if_entry->hello_len = 0;
 
     /* Everything went well */
     nhdp_decrement_addr_usage(nhdp_addr);
@@ -234,6 +256,8 @@ int nhdp_add_address(kernel_pid_t if_pid, uint8_t *addr, size_t addr_size, uint8
 
 /**
  * Function executed by NHDP thread receiving messages in an endless loop
+ * All processing of the information bases is done in this thread, so sending
+ * and receiving never need to be synchronized.
  */
 static void *_nhdp_runner(void *arg)
 {
@@ -248,7 +272,6 @@ static void *_nhdp_runner(void *arg)
 
         switch (msg_rcvd.type) {
             case MSG_TIMER:
-                mutex_lock(&send_rcv_mutex);
                 if_entry = (nhdp_if_entry_t *) msg_rcvd.content.ptr;
 
                 nhdp_writer_send_hello(if_entry);
@@ -258,19 +281,25 @@ static void *_nhdp_runner(void *arg)
                 /* Schedule next sending */
                 vtimer_set_msg(&if_entry->if_timer, if_entry->hello_interval,
                                thread_getpid(), MSG_TIMER, (void *) if_entry);
-                mutex_unlock(&send_rcv_mutex);
                 break;
 
+            case NHDP_MSG_PACKET: {
+                /* Packet received, let the reader handle it */
+                nhdp_rcv_pkt_t *pkt = (nhdp_rcv_pkt_t *) msg_rcvd.content.ptr;
+                nhdp_reader_handle_packet(helper_pid, pkt->buffer, pkt->length);
+                /* Reply to release the receive buffer */
+                msg_reply(&msg_rcvd, &msg_rcvd);
+                break;
+            }
+
 #if (NHDP_METRIC_NEEDS_TIMER)
             case NHDP_METRIC_TIMER:
-                mutex_lock(&send_rcv_mutex);
                 /* Process necessary metric computations */
                 iib_process_metric_refresh();
 
                 /* Schedule next sending */
                 vtimer_set_msg(&metric_timer, metric_interval,
                                thread_getpid(), NHDP_METRIC_TIMER, NULL);
-                mutex_unlock(&send_rcv_mutex);
                 break;
 #endif
             default:
@@ -282,13 +311,15 @@ static void *_nhdp_runner(void *arg)
 }
 
 /**
- * Receive HELLOs over the configured socket and handle them
+ * Receive HELLOs over the configured socket and pass them to the NHDP thread
  */
 static void *_nhdp_receiver(void *arg __attribute__((unused)))
 {
     uint32_t fromlen;
     char nhdp_rcv_buf[NHDP_MAX_RFC5444_PACKET_SZ];
+    nhdp_rcv_pkt_t pkt = { .buffer = nhdp_rcv_buf };
     msg_t msg_q[NHDP_MSG_QUEUE_SIZE];
+    msg_t msg;
 
     msg_init_queue(msg_q, NHDP_MSG_QUEUE_SIZE);
 
@@ -309,10 +340,11 @@ static void *_nhdp_receiver(void *arg __attribute__((unused)))
                                                 NHDP_MAX_RFC5444_PACKET_SZ, 0, &sa_rcv, &fromlen);
 
         if (rcv_size > 0) {
-            /* Packet received, let the reader handle it */
-            mutex_lock(&send_rcv_mutex);
-            nhdp_reader_handle_packet(helper_pid, (void *)nhdp_rcv_buf, rcv_size);
-            mutex_unlock(&send_rcv_mutex);
+            /* Packet received, wait until the NHDP thread handled it */
+            pkt.length = rcv_size;
+            msg.type = NHDP_MSG_PACKET;
+            msg.content.ptr = (char *) &pkt;
+            msg_send_receive(&msg, &msg, nhdp_pid);
         }
     }
 
@@ -325,8 +357,9 @@ static void *_nhdp_receiver(void *arg __attribute__((unused)))
  * Called by oonf_api to send packet over the configured socket
  */
 static void write_packet(struct rfc5444_writer *wr __attribute__((unused)),
-                         struct rfc5444_writer_target *iface __attribute__((unused)),
+                         struct rfc5444_writer_target *iface,
                          void *buffer, size_t length)
 {
+    nhdp_writer_keep_packet(container_of(iface, nhdp_if_entry_t, wr_target), buffer, length);
     socket_base_sendto(sock_rcv, buffer, length, 0, &sa_bcast, sizeof(sa_bcast));
 }
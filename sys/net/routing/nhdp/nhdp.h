@@ -95,6 +95,11 @@ typedef struct nhdp_if_entry_t {
     timex_t validity_time;                      /**< Validity time for propagated information */
     uint16_t seq_no;                            /**< Sequence number of last send RFC5444 packet */
     struct rfc5444_writer_target wr_target;     /**< Interface specific writer target */
+    uint8_t *hello_buf;                         /**< Copy of the last HELLO packet sent */
+    uint16_t hello_len;                         /**< Length of the copied HELLO packet, 0 if
+                                                 *   it can not be resent */
+    uint32_t hello_version;                     /**< Information base version the copied
+                                                 *   HELLO packet was built from */
 } nhdp_if_entry_t;
 
 /**
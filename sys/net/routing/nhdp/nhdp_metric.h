@@ -40,8 +40,10 @@ extern "C" {
 /** @brief DAT metric extension value for metric TLV extension field */
 #define NHDP_LMT_DAT                (165)
 
-/** @brief Used metric (change to switch to another metric type) */
+/** @brief Used metric (change or define externally to switch to another metric type) */
+#ifndef NHDP_METRIC
 #define NHDP_METRIC                 (NHDP_LMT_HOP_COUNT)
+#endif
 
 /** @brief Randomly chosen number for NHDP's metric timer event */
 #define NHDP_METRIC_TIMER           (5445)
@@ -84,6 +86,11 @@ extern "C" {
 #define DAT_MAXIMUM_LOSS            (8)
 /** @brief Constant value needed for DAT metric computation (should not be changed) */
 #define DAT_CONSTANT                (16777216)
+/**
+ * @brief Number of fractional bits of the fixed-point loss value in DAT metric computation
+ *        (all intermediate values must fit into 32 bit)
+ */
+#define DAT_LOSS_FRAC_BITS          (11)
 /** @} */
 
 #ifdef __cplusplus
@@ -22,6 +22,7 @@
 
 #include "timex.h"
 #include "mutex.h"
+#include "vtimer.h"
 
 #include "rfc5444/rfc5444.h"
 #include "rfc5444/rfc5444_iana.h"
@@ -40,6 +41,10 @@ static struct rfc5444_writer nhdp_writer;
 static nhdp_if_entry_t *nhdp_wr_curr_if_entry;
 static uint8_t msg_buffer[NHDP_WR_MSG_BUF_SIZE];
 static uint8_t msg_addrtlvs[NHDP_WR_TLV_BUF_SIZE];
+/* Version of the information advertised in HELLOs, changed on every modification */
+static uint32_t hello_version = 1;
+/* Number of packets sent since the last HELLO was created */
+static uint8_t hello_pkt_count;
 
 /* Internal function prototypes */
 static void _nhdp_add_hello_msg_header_cb(struct rfc5444_writer *wr,
@@ -121,19 +126,61 @@ void nhdp_writer_register_if(struct rfc5444_writer_target *new_if)
 
 void nhdp_writer_send_hello(nhdp_if_entry_t *if_entry)
 {
-    mutex_lock(&mtx_packet_write);
+    timex_t now;
 
-    /* Register interface as current sending interface */
-    nhdp_wr_curr_if_entry = if_entry;
+    mutex_lock(&mtx_packet_write);
 
-    /* Create HELLO message and send it using the given interface */
-    rfc5444_writer_create_message(&nhdp_writer, RFC5444_MSGTYPE_HELLO,
-                                  rfc5444_writer_singletarget_selector, &if_entry->wr_target);
-    rfc5444_writer_flush(&nhdp_writer, &if_entry->wr_target, false);
+    /* Remove timed out information first, it must not be advertised anymore */
+    vtimer_now(&now);
+    iib_update_lt_status(&now);
+    nib_update_lost_addresses(&now);
+
+    if ((if_entry->hello_len > 0) && (if_entry->hello_version == hello_version)) {
+        /* Nothing changed since the last HELLO, only set the new packet sequence number */
+        if_entry->seq_no++;
+        if_entry->hello_buf[1] = (uint8_t)(if_entry->seq_no >> 8);
+        if_entry->hello_buf[2] = (uint8_t)(if_entry->seq_no);
+        if_entry->wr_target.sendPacket(&nhdp_writer, &if_entry->wr_target,
+                                       if_entry->hello_buf, if_entry->hello_len);
+    }
+    else {
+        /* Register interface as current sending interface */
+        nhdp_wr_curr_if_entry = if_entry;
+        if_entry->hello_len = 0;
+        if_entry->hello_version = hello_version;
+        hello_pkt_count = 0;
+
+        /* Create HELLO message and send it using the given interface */
+        rfc5444_writer_create_message(&nhdp_writer, RFC5444_MSGTYPE_HELLO,
+                                      rfc5444_writer_singletarget_selector, &if_entry->wr_target);
+        rfc5444_writer_flush(&nhdp_writer, &if_entry->wr_target, false);
+    }
 
     mutex_unlock(&mtx_packet_write);
 }
 
+void nhdp_writer_invalidate(void)
+{
+    hello_version++;
+}
+
+void nhdp_writer_keep_packet(nhdp_if_entry_t *if_entry, void *buffer, size_t length)
+{
+    if (buffer == if_entry->hello_buf) {
+        /* Packet is already the kept one */
+        return;
+    }
+
+    if ((hello_pkt_count++ == 0) && (length <= if_entry->wr_target.packet_size)) {
+        memcpy(if_entry->hello_buf, buffer, length);
+        if_entry->hello_len = length;
+    }
+    else {
+        /* HELLO was split into multiple packets, do not resend it */
+        if_entry->hello_len = 0;
+    }
+}
+
 void nhdp_writer_add_addr(struct rfc5444_writer *wr, nhdp_addr_t *addr,
                           enum rfc5444_addrtlv_iana type, uint8_t value,
                           uint16_t metric_in, uint16_t metric_out)
@@ -51,10 +51,33 @@ void nhdp_writer_register_if(struct rfc5444_writer_target *new_if);
 /**
  * @brief                   Construct and send a HELLO message using the given interface
  *
+ * Timed out information is removed from the information bases first. If the
+ * information bases did not change since the last HELLO of the interface,
+ * the last HELLO packet is sent again with a new packet sequence number.
+ *
  * @param[in] if_entry      Pointer to NHDP interface entry the message must be created for
  */
 void nhdp_writer_send_hello(nhdp_if_entry_t *if_entry);
 
+/**
+ * @brief                   Signal a change of the information advertised in HELLOs
+ *
+ * Must be called whenever an address, a link status or an encoded metric value
+ * included in HELLO messages changes.
+ */
+void nhdp_writer_invalidate(void);
+
+/**
+ * @brief                   Keep a copy of a packet sent for the given interface
+ *
+ * Must be called by the send function of the interface's writer target.
+ *
+ * @param[in] if_entry      Pointer to the NHDP interface entry the packet was sent for
+ * @param[in] buffer        The packet
+ * @param[in] length        Length of the packet in bytes
+ */
+void nhdp_writer_keep_packet(nhdp_if_entry_t *if_entry, void *buffer, size_t length);
+
 /**
  * @brief                   Add a NHDP address to the currently constructed message
  *
@@ -39,7 +39,7 @@ static nib_lost_address_entry_t *nib_lost_address_entry_head = NULL;
 /* Internal function prototypes */
 static nib_entry_t *add_nib_entry_for_nb_addr_list(void);
 static void rem_nib_entry(nib_entry_t *nib_entry, timex_t *now);
-static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now);
+static int clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now);
 static int add_lost_neighbor_address(nhdp_addr_t *lost_addr, timex_t *now);
 static void rem_ln_entry(nib_lost_address_entry_t *ln_entry);
 
@@ -80,8 +80,15 @@ nib_entry_t *nib_process_hello(void)
 
     /* Add or update nb tuple */
     if (matches > 0) {
+        nhdp_addr_entry_t *addr_elt;
+        int old_addr_count, new_addr_count;
+
         /* We found matching nb tuples, reuse the last one */
-        clear_nb_addresses(nb_match, &now);
+        LL_COUNT(nb_match->address_list_head, addr_elt, old_addr_count);
+        if (clear_nb_addresses(nb_match, &now) > 0) {
+            /* Force a change, addresses were removed */
+            old_addr_count = -1;
+        }
 
         if (matches > 1) {
             nb_match->symmetric = 0;
@@ -94,6 +101,14 @@ nib_entry_t *nib_process_hello(void)
             LL_DELETE(nib_entry_head, nb_match);
             free(nb_match);
             nb_match = NULL;
+            nhdp_writer_invalidate();
+        }
+        else {
+            LL_COUNT(nb_match->address_list_head, addr_elt, new_addr_count);
+            if ((matches > 1) || (old_addr_count != new_addr_count)) {
+                /* The neighbor's address list changed */
+                nhdp_writer_invalidate();
+            }
         }
     }
     else {
@@ -108,13 +123,10 @@ void nib_fill_wr_addresses(struct rfc5444_writer *wr)
 {
     nib_entry_t *nib_elt;
     nhdp_addr_entry_t *addr_elt;
-    nib_lost_address_entry_t *lost_elt, *lost_tmp;
-    timex_t now;
+    nib_lost_address_entry_t *lost_elt;
 
     mutex_lock(&mtx_nib_access);
 
-    vtimer_now(&now);
-
     /* Add addresses of symmetric neighbors to HELLO msg */
     LL_FOREACH(nib_entry_head, nib_elt) {
         if (nib_elt->symmetric) {
@@ -132,20 +144,30 @@ void nib_fill_wr_addresses(struct rfc5444_writer *wr)
     }
 
     /* Add lost addresses of neighbors to HELLO msg */
+    LL_FOREACH(nib_lost_address_entry_head, lost_elt) {
+        /* Check if address is not already present in one of the temporary lists */
+        if (!NHDP_ADDR_TMP_IN_ANY(lost_elt->address)) {
+            /* Address is not present in one of the lists, add it */
+            nhdp_writer_add_addr(wr, lost_elt->address, RFC5444_ADDRTLV_OTHER_NEIGHB,
+                                 RFC5444_OTHERNEIGHB_LOST, NHDP_METRIC_UNKNOWN,
+                                 NHDP_METRIC_UNKNOWN);
+        }
+    }
+
+    mutex_unlock(&mtx_nib_access);
+}
+
+void nib_update_lost_addresses(timex_t *now)
+{
+    nib_lost_address_entry_t *lost_elt, *lost_tmp;
+
+    mutex_lock(&mtx_nib_access);
+
     LL_FOREACH_SAFE(nib_lost_address_entry_head, lost_elt, lost_tmp) {
-        if (timex_cmp(lost_elt->expiration_time, now) != 1) {
+        if (timex_cmp(lost_elt->expiration_time, *now) != 1) {
             /* Entry expired, remove it */
             rem_ln_entry(lost_elt);
         }
-        else {
-            /* Check if address is not already present in one of the temporary lists */
-            if (!NHDP_ADDR_TMP_IN_ANY(lost_elt->address)) {
-                /* Address is not present in one of the lists, add it */
-                nhdp_writer_add_addr(wr, lost_elt->address, RFC5444_ADDRTLV_OTHER_NEIGHB,
-                                     RFC5444_OTHERNEIGHB_LOST, NHDP_METRIC_UNKNOWN,
-                                     NHDP_METRIC_UNKNOWN);
-            }
-        }
     }
 
     mutex_unlock(&mtx_nib_access);
@@ -156,6 +178,7 @@ void nib_rem_nb_entry(nib_entry_t *nib_entry)
     nhdp_free_addr_list(nib_entry->address_list_head);
     LL_DELETE(nib_entry_head, nib_entry);
     free(nib_entry);
+    nhdp_writer_invalidate();
 }
 
 void nib_set_nb_entry_sym(nib_entry_t *nib_entry)
@@ -163,6 +186,10 @@ void nib_set_nb_entry_sym(nib_entry_t *nib_entry)
     nib_lost_address_entry_t *ln_elt, *ln_tmp;
     nhdp_addr_entry_t *nb_elt;
 
+    if (!nib_entry->symmetric) {
+        nhdp_writer_invalidate();
+    }
+
     nib_entry->symmetric = 1;
     LL_FOREACH(nib_entry->address_list_head, nb_elt) {
         LL_FOREACH_SAFE(nib_lost_address_entry_head, ln_elt, ln_tmp) {
@@ -179,6 +206,10 @@ void nib_reset_nb_entry_sym(nib_entry_t *nib_entry, timex_t *now)
 {
     nhdp_addr_entry_t *nb_elt;
 
+    if (nib_entry->symmetric) {
+        nhdp_writer_invalidate();
+    }
+
     nib_entry->symmetric = 0;
     LL_FOREACH(nib_entry->address_list_head, nb_elt) {
         /* Add a Lost Neighbor Tuple for each address of the neighbor */
@@ -233,15 +264,18 @@ static void rem_nib_entry(nib_entry_t *nib_entry, timex_t *now)
     clear_nb_addresses(nib_entry, now);
     LL_DELETE(nib_entry_head, nib_entry);
     free(nib_entry);
+    nhdp_writer_invalidate();
 }
 
 /**
  * Clear address list of a Neighbor Tuple and add Lost Neighbor Tuple for addresses
  * no longer used by this neighbor
+ * Returns the number of addresses no longer used by this neighbor
  */
-static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now)
+static int clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now)
 {
     nhdp_addr_entry_t *nib_elt, *nib_tmp;
+    int removed = 0;
 
     LL_FOREACH_SAFE(nib_entry->address_list_head, nib_elt, nib_tmp) {
         /* Check whether address is still present in the new neighbor address list */
@@ -251,6 +285,7 @@ static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now)
             nib_elt->address->in_tmp_table |= NHDP_ADDR_TMP_REM_LIST;
             /* Increment usage counter of address in central NHDP address storage */
             nib_elt->address->usg_count++;
+            removed++;
 
             if (nib_entry->symmetric) {
                 /* Additionally create a Lost Neighbor Tuple for symmetric neighbors */
@@ -262,6 +297,8 @@ static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now)
         nhdp_free_addr_entry(nib_elt);
     }
     nib_entry->address_list_head = NULL;
+
+    return removed;
 }
 
 /**
@@ -297,6 +334,7 @@ static int add_lost_neighbor_address(nhdp_addr_t *lost_addr, timex_t *now)
     elt->address = lost_addr;
     elt->expiration_time = timex_add(*now, n_hold);
     LL_PREPEND(nib_lost_address_entry_head, elt);
+    nhdp_writer_invalidate();
 
     return 0;
 }
@@ -309,4 +347,5 @@ static void rem_ln_entry(nib_lost_address_entry_t *ln_entry)
     nhdp_decrement_addr_usage(ln_entry->address);
     LL_DELETE(nib_lost_address_entry_head, ln_entry);
     free(ln_entry);
+    nhdp_writer_invalidate();
 }
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_ng_udp_ep
+ * @{
+ *
+ * @file
+ * @brief       UDP endpoint implementation
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "timex.h"
+#include "utlist.h"
+#include "vtimer.h"
+#include "net/ng_ipv6/hdr.h"
+#include "net/ng_netbase.h"
+#include "net/ng_udp.h"
+#include "net/ng_udp/ep.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* all created endpoints */
+static ng_udp_ep_t *_eps;
+static mutex_t _eps_lock = MUTEX_INIT;
+
+/**
+ * @brief   Get the time left of @p timeout since @p start
+ */
+static uint32_t _left(uint32_t timeout, timex_t *start)
+{
+    timex_t now;
+    uint64_t passed;
+
+    if ((timeout == 0) || (timeout == NG_UDP_EP_TIMEOUT_FOREVER)) {
+        return timeout;
+    }
+    vtimer_now(&now);
+    passed = timex_uint64(timex_sub(now, *start));
+    return (passed < timeout) ? (uint32_t)(timeout - passed) : 0;
+}
+
+/**
+ * @brief   Get the next message for the calling thread
+ *
+ * @return  1 if a message was received
+ * @return  0 on timeout
+ */
+static int _get_msg(msg_t *msg, uint32_t timeout)
+{
+    if (timeout == 0) {
+        return (msg_try_receive(msg) > 0);
+    }
+    if (timeout == NG_UDP_EP_TIMEOUT_FOREVER) {
+        msg_receive(msg);
+        return 1;
+    }
+    return (vtimer_msg_receive_timeout(msg, timex_set(timeout / SEC_IN_USEC,
+                                                      timeout % SEC_IN_USEC)) > 0);
+}
+
+/**
+ * @brief   Find the endpoint of the calling thread a received packet is for
+ *
+ * @return  the endpoint
+ * @return  NULL if no endpoint of the calling thread takes the packet
+ */
+static ng_udp_ep_t *_find(ng_pktsnip_t *pkt)
+{
+    kernel_pid_t me = thread_getpid();
+    ng_udp_ep_t *ep;
+    ng_pktsnip_t *udp;
+    uint16_t port;
+
+    LL_SEARCH_SCALAR(pkt, udp, type, NG_NETTYPE_UDP);
+    if (udp == NULL) {
+        return NULL;
+    }
+    port = byteorder_ntohs(((ng_udp_hdr_t *)udp->data)->dst_port);
+
+    mutex_lock(&_eps_lock);
+    LL_FOREACH(_eps, ep) {
+        if ((ep->netreg.pid == me) && (ep->netreg.demux_ctx == port)) {
+            break;
+        }
+    }
+    mutex_unlock(&_eps_lock);
+    return ep;
+}
+
+/**
+ * @brief   Fill a datagram descriptor from a received packet
+ *
+ * @return  0 on success
+ * @return  -1 if the packet has no UDP or IPv6 header
+ */
+static int _fill_dgram(ng_pktsnip_t *pkt, ng_udp_ep_dgram_t *dgram)
+{
+    ng_pktsnip_t *udp, *ipv6;
+
+    LL_SEARCH_SCALAR(pkt, udp, type, NG_NETTYPE_UDP);
+    LL_SEARCH_SCALAR(pkt, ipv6, type, NG_NETTYPE_IPV6);
+    if ((udp == NULL) || (ipv6 == NULL)) {
+        DEBUG("udp ep: received packet without UDP or IPv6 header\n");
+        return -1;
+    }
+
+    dgram->pkt = pkt;
+    dgram->addr = ((ng_ipv6_hdr_t *)ipv6->data)->src;
+    dgram->port = byteorder_ntohs(((ng_udp_hdr_t *)udp->data)->src_port);
+    return 0;
+}
+
+int ng_udp_ep_create(ng_udp_ep_t *ep, uint16_t port)
+{
+    if ((ep == NULL) || (port == 0)) {
+        return -EINVAL;
+    }
+    if (ng_netreg_lookup(NG_NETTYPE_UDP, NG_NETREG_DEMUX_CTX_ALL) == NULL) {
+        return -ENOTCONN;
+    }
+
+    ep->netreg.next = NULL;
+    ep->netreg.demux_ctx = (uint32_t)port;
+    ep->netreg.pid = thread_getpid();
+    cib_init(&ep->cib, NG_UDP_EP_QUEUE_SIZE);
+    mutex_lock(&_eps_lock);
+    LL_PREPEND(_eps, ep);
+    mutex_unlock(&_eps_lock);
+    ng_netreg_register(NG_NETTYPE_UDP, &ep->netreg);
+    return 0;
+}
+
+void ng_udp_ep_close(ng_udp_ep_t *ep)
+{
+    int i;
+
+    if ((ep != NULL) && (ep->netreg.pid != KERNEL_PID_UNDEF)) {
+        ng_netreg_unregister(NG_NETTYPE_UDP, &ep->netreg);
+        mutex_lock(&_eps_lock);
+        LL_DELETE(_eps, ep);
+        mutex_unlock(&_eps_lock);
+        ep->netreg.pid = KERNEL_PID_UNDEF;
+        while ((i = cib_get(&ep->cib)) >= 0) {
+            ng_pktbuf_release(ep->queue[i]);
+        }
+    }
+}
+
+int ng_udp_ep_send(ng_udp_ep_t *ep, ng_udp_ep_dgram_t *dgrams, size_t num)
+{
+    ng_netreg_entry_t *sendto;
+    uint16_t src_port;
+    size_t sent = 0;
+
+    if ((ep == NULL) || (dgrams == NULL)) {
+        return -EINVAL;
+    }
+    sendto = ng_netreg_lookup(NG_NETTYPE_UDP, NG_NETREG_DEMUX_CTX_ALL);
+    if (sendto == NULL) {
+        DEBUG("udp ep: unable to locate UDP thread\n");
+        for (size_t i = 0; i < num; i++) {
+            ng_pktbuf_release(dgrams[i].pkt);
+        }
+        return -ENOTCONN;
+    }
+
+    src_port = (uint16_t)ep->netreg.demux_ctx;
+    for (size_t i = 0; i < num; i++) {
+        ng_pktsnip_t *udp, *ip;
+
+        /* allocate headers in front of the payload */
+        udp = ng_udp_hdr_build(dgrams[i].pkt, (uint8_t *)&src_port,
+                               sizeof(src_port), (uint8_t *)&dgrams[i].port,
+                               sizeof(dgrams[i].port));
+        if (udp == NULL) {
+            DEBUG("udp ep: unable to allocate UDP header\n");
+            ng_pktbuf_release(dgrams[i].pkt);
+            continue;
+        }
+        ip = ng_ipv6_hdr_build(udp, NULL, 0, (uint8_t *)&dgrams[i].addr,
+                               sizeof(dgrams[i].addr));
+        if (ip == NULL) {
+            DEBUG("udp ep: unable to allocate IPv6 header\n");
+            ng_pktbuf_release(udp);
+            continue;
+        }
+        /* only the headers are new, the payload is passed on as it is */
+        if (ng_netapi_send(sendto->pid, ip) < 1) {
+            DEBUG("udp ep: UDP thread did not take the datagram\n");
+            ng_pktbuf_release(ip);
+            while (++i < num) {
+                ng_pktbuf_release(dgrams[i].pkt);
+            }
+            return -ENOTCONN;
+        }
+        sent++;
+    }
+
+    return ((sent == 0) && (num > 0)) ? -ENOBUFS : (int)sent;
+}
+
+int ng_udp_ep_recv(ng_udp_ep_t *ep, ng_udp_ep_dgram_t *dgrams, size_t num,
+                   uint32_t timeout)
+{
+    msg_t msg;
+    timex_t start = timex_set(0, 0);
+    size_t received = 0;
+    int i;
+
+    if ((ep == NULL) || (dgrams == NULL)) {
+        return -EINVAL;
+    }
+
+    /* datagrams another endpoint of this thread already took for us */
+    while ((received < num) && ((i = cib_get(&ep->cib)) >= 0)) {
+        if (_fill_dgram(ep->queue[i], &dgrams[received]) < 0) {
+            ng_pktbuf_release(ep->queue[i]);
+            continue;
+        }
+        received++;
+    }
+
+    if ((timeout != 0) && (timeout != NG_UDP_EP_TIMEOUT_FOREVER)) {
+        vtimer_now(&start);
+    }
+
+    /* wait for the first datagram, then take what is already queued */
+    while ((received < num) &&
+           _get_msg(&msg, (received == 0) ? _left(timeout, &start) : 0)) {
+        ng_pktsnip_t *pkt = (ng_pktsnip_t *)msg.content.ptr;
+        ng_udp_ep_t *dst = NULL;
+
+        if ((msg.type != NG_NETAPI_MSG_TYPE_RCV) ||
+            ((dst = _find(pkt)) == NULL)) {
+            /* not ours: leave it to the thread */
+            DEBUG("udp ep: put back message of type %" PRIu16 "\n", msg.type);
+            if (msg_send_to_self(&msg) < 1) {
+                DEBUG("udp ep: message queue full, message lost\n");
+                if (msg.type == NG_NETAPI_MSG_TYPE_RCV) {
+                    ng_pktbuf_release(pkt);
+                }
+            }
+            return (received == 0) ? -EINTR : (int)received;
+        }
+        if (dst != ep) {
+            if ((i = cib_put(&dst->cib)) < 0) {
+                DEBUG("udp ep: queue of port %" PRIu32 " full, drop datagram\n",
+                      dst->netreg.demux_ctx);
+                ng_pktbuf_release(pkt);
+                continue;
+            }
+            dst->queue[i] = pkt;
+            continue;
+        }
+        if (_fill_dgram(pkt, &dgrams[received]) < 0) {
+            ng_pktbuf_release(pkt);
+            continue;
+        }
+        received++;
+    }
+
+    return (int)received;
+}
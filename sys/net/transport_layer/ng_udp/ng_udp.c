@@ -27,6 +27,7 @@
 #include "utlist.h"
 #include "net/ng_udp.h"
 #include "net/ng_netbase.h"
+#include "net/ng_netstats.h"
 #include "net/ng_inet_csum.h"
 
 #ifdef MODULE_NG_IPV6
@@ -41,6 +42,12 @@
  */
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 
+/**
+ * @brief   Packet, drop, queue and latency counters
+ */
+static ng_netstats_t _stats;
+
+#ifndef MODULE_NG_NETAPI_DIRECT
 /**
  * @brief   Allocate memory for the UDP thread's stack
  */
@@ -49,6 +56,7 @@ static char _stack[NG_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[NG_UDP_STACK_SIZE];
 #endif
+#endif
 
 /**
  * @brief   Calculate the UDP checksum dependent on the network protocol
@@ -104,6 +112,7 @@ static void _receive(ng_pktsnip_t *pkt)
     udp = ng_pktbuf_start_write(pkt);
     if (udp == NULL) {
         DEBUG("udp: unable to get write access to packet\n");
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -111,6 +120,7 @@ static void _receive(ng_pktsnip_t *pkt)
     udp = ng_pktbuf_add(pkt, pkt->data, sizeof(ng_udp_hdr_t), NG_NETTYPE_UDP);
     if (udp == NULL) {
         DEBUG("udp: error marking UDP header, dropping packet\n");
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -124,6 +134,7 @@ static void _receive(ng_pktsnip_t *pkt)
     /* validate checksum */
     if (_calc_csum(udp, ipv6, pkt)) {
         DEBUG("udp: received packet with invalid checksum, dropping it\n");
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_CSUM);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -156,6 +167,7 @@ static void _send(ng_pktsnip_t *pkt)
     udp_snip = ng_pktbuf_start_write(udp_snip);
     if (udp_snip == NULL) {
         DEBUG("udp: cannot send packet: unable to allocate packet\n");
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NOBUF);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -168,6 +180,7 @@ static void _send(ng_pktsnip_t *pkt)
     /* throw away packet if no one is interested */
     if (sendto == NULL) {
         DEBUG("udp: cannot send packet: network layer not found\n");
+        ng_netstats_drop(&_stats, NG_NETSTATS_DROP_NO_ROUTE);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -179,6 +192,32 @@ static void _send(ng_pktsnip_t *pkt)
     }
 }
 
+static int _handle(void *ctx, msg_t *msg)
+{
+    unsigned long start = ng_netstats_start();
+
+    (void)ctx;
+
+    switch (msg->type) {
+        case NG_NETAPI_MSG_TYPE_RCV:
+            DEBUG("udp: NG_NETAPI_MSG_TYPE_RCV\n");
+            _receive((ng_pktsnip_t *)msg->content.ptr);
+            ng_netstats_done(&_stats, start);
+            return 0;
+        case NG_NETAPI_MSG_TYPE_SND:
+            DEBUG("udp: NG_NETAPI_MSG_TYPE_SND\n");
+            _send((ng_pktsnip_t *)msg->content.ptr);
+            ng_netstats_done(&_stats, start);
+            return 0;
+        case NG_NETAPI_MSG_TYPE_GET:
+            return ng_netstats_get(&_stats, (ng_netapi_opt_t *)msg->content.ptr);
+        default:
+            DEBUG("udp: received unidentified message\n");
+            return -ENOTSUP;
+    }
+}
+
+#ifndef MODULE_NG_NETAPI_DIRECT
 static void *_event_loop(void *arg)
 {
     (void)arg;
@@ -188,39 +227,29 @@ static void *_event_loop(void *arg)
 
     /* preset reply message */
     reply.type = NG_NETAPI_MSG_TYPE_ACK;
-    reply.content.value = (uint32_t)-ENOTSUP;
     /* initialize message queue */
     msg_init_queue(msg_queue, NG_UDP_MSG_QUEUE_SIZE);
     /* register UPD at netreg */
     netreg.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
     netreg.pid = thread_getpid();
     ng_netreg_register(NG_NETTYPE_UDP, &netreg);
+    ng_netstats_register(&_stats, netreg.pid, "udp");
 
     /* dispatch NETAPI messages */
     while (1) {
         msg_receive(&msg);
-        switch (msg.type) {
-            case NG_NETAPI_MSG_TYPE_RCV:
-                DEBUG("udp: NG_NETAPI_MSG_TYPE_RCV\n");
-                _receive((ng_pktsnip_t *)msg.content.ptr);
-                break;
-            case NG_NETAPI_MSG_TYPE_SND:
-                DEBUG("udp: NG_NETAPI_MSG_TYPE_SND\n");
-                _send((ng_pktsnip_t *)msg.content.ptr);
-                break;
-            case NG_NETAPI_MSG_TYPE_SET:
-            case NG_NETAPI_MSG_TYPE_GET:
-                msg_reply(&msg, &reply);
-                break;
-            default:
-                DEBUG("udp: received unidentified message\n");
-                break;
+        ng_netstats_queue(&_stats);
+        reply.content.value = (uint32_t)_handle(NULL, &msg);
+        if ((msg.type == NG_NETAPI_MSG_TYPE_SET) ||
+            (msg.type == NG_NETAPI_MSG_TYPE_GET)) {
+            msg_reply(&msg, &reply);
         }
     }
 
     /* never reached */
     return NULL;
 }
+#endif
 
 int ng_udp_calc_csum(ng_pktsnip_t *hdr, ng_pktsnip_t *pseudo_hdr)
 {
@@ -270,9 +299,20 @@ int ng_udp_init(void)
 {
     /* check if thread is already running */
     if (_pid == KERNEL_PID_UNDEF) {
+#ifdef MODULE_NG_NETAPI_DIRECT
+        static ng_netreg_entry_t netreg;
+
+        /* run in the thread of the network stack */
+        _pid = ng_netapi_direct_register(_handle, NULL);
+        netreg.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
+        netreg.pid = _pid;
+        ng_netreg_register(NG_NETTYPE_UDP, &netreg);
+        ng_netstats_register(&_stats, _pid, "udp");
+#else
         /* start UDP thread */
         _pid = thread_create(_stack, sizeof(_stack), NG_UDP_PRIO,
                              CREATE_STACKTEST, _event_loop, NULL, "udp");
+#endif
     }
     return _pid;
 }
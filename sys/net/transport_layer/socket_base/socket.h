@@ -10,6 +10,7 @@
 #define _SOCKET_BASE_SOCKET
 
 #include "cpu.h"
+#include "ringbuffer.h"
 
 #include "socket_base/socket.h"
 
@@ -59,6 +60,16 @@ typedef struct __attribute__((packed)) {
     double              rttvar;
     double              rto;
 
+    uint32_t            rtt_seq;        // sequence number timed for RTT sample
+    timex_t             rtt_start;
+    uint8_t             rtt_active;
+
+    uint32_t            cwnd;           // congestion window (bytes)
+    uint32_t            ssthresh;       // slow start threshold (bytes)
+    uint32_t            recover;        // NewReno: send_nxt at loss detection
+    uint8_t             dup_acks;
+    uint8_t             in_recovery;
+
 #ifdef TCP_HC
     tcp_hc_context_t    tcp_context;
 #endif
@@ -82,9 +93,12 @@ typedef struct {
     uint8_t             send_pid;
     socket_t            socket_values;
 #ifdef MODULE_TCP
-    uint8_t             tcp_input_buffer_end;
     mutex_t             tcp_buffer_mutex;
-    uint8_t             tcp_input_buffer[TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER];
+    mutex_t             tcp_send_mutex;
+    ringbuffer_t        tcp_input_buffer;
+    ringbuffer_t        tcp_send_buffer;    // unacknowledged and unsent data, starts at send_una
+    char                tcp_input_buffer_data[TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER];
+    char                tcp_send_buffer_data[TRANSPORT_LAYER_SOCKET_MAX_TCP_SEND_BUFFER];
 #endif
 } socket_internal_t;
 
@@ -31,6 +31,7 @@
 
 #include "msg_help.h"
 #include "socket.h"
+#include "tcp_cc.h"
 #include "tcp_hc.h"
 #include "tcp_timer.h"
 
@@ -47,6 +48,11 @@ uint32_t            global_sequence_counter;
 char tcp_stack_buffer[TCP_STACK_SIZE];
 char tcp_timer_stack[TCP_TIMER_STACKSIZE];
 
+/* Shared buffer for data segments built from a socket's send buffer, used by
+ * the application, packet handler and timer threads alike */
+static uint8_t tcp_output_buffer[BUFFER_SIZE];
+static mutex_t tcp_output_mutex = MUTEX_INIT;
+
 void set_socket_address(sockaddr6_t *sockaddr, uint8_t sin6_family,
                         uint16_t sin6_port, uint32_t sin6_flowinfo, ipv6_addr_t *sin6_addr)
 {
@@ -170,19 +176,23 @@ uint16_t tcp_csum(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header)
 int check_tcp_consistency(socket_t *current_tcp_socket, tcp_hdr_t *tcp_header, uint8_t tcp_payload_len)
 {
     if (tcp_payload_len == 0) {
-        if (tcp_header->ack_nr > (current_tcp_socket->tcp_control.send_nxt)) {
+        if (TCP_SEQ_GT(tcp_header->ack_nr, current_tcp_socket->tcp_control.send_nxt)) {
             /* ACK of not yet sent byte, discard */
             return ACK_NO_TOO_BIG;
         }
-        else if (tcp_header->ack_nr <= (current_tcp_socket->tcp_control.send_una)) {
+        else if (TCP_SEQ_LEQ(tcp_header->ack_nr, current_tcp_socket->tcp_control.send_una)) {
             /* ACK of previous segments, maybe dropped? */
             return ACK_NO_TOO_SMALL;
         }
     }
-    else if ((current_tcp_socket->tcp_control.rcv_nxt > 0) && (tcp_header->seq_nr < current_tcp_socket->tcp_control.rcv_nxt)) {
+    else if ((current_tcp_socket->tcp_control.rcv_nxt > 0) && TCP_SEQ_LT(tcp_header->seq_nr, current_tcp_socket->tcp_control.rcv_nxt)) {
         /* segment repetition, maybe ACK got lost? */
         return SEQ_NO_TOO_SMALL;
     }
+    else if ((current_tcp_socket->tcp_control.rcv_nxt > 0) && TCP_SEQ_GT(tcp_header->seq_nr, current_tcp_socket->tcp_control.rcv_nxt)) {
+        /* preceding segment is missing, answer with a duplicate ACK */
+        return SEQ_NO_TOO_BIG;
+    }
 
     return PACKET_OK;
 }
@@ -238,8 +248,9 @@ void set_tcp_packet(tcp_hdr_t *tcp_hdr, uint16_t src_port, uint16_t dst_port,
     tcp_hdr->window         = window;
 }
 
-int send_tcp(socket_internal_t *current_socket, tcp_hdr_t *current_tcp_packet,
-             ipv6_hdr_t *temp_ipv6_header, uint8_t flags, uint8_t payload_length)
+static int _send_tcp(socket_internal_t *current_socket, tcp_hdr_t *current_tcp_packet,
+                     ipv6_hdr_t *temp_ipv6_header, uint8_t flags, uint32_t seq_nr,
+                     uint8_t payload_length)
 {
     socket_t *current_tcp_socket = &current_socket->socket_values;
     uint8_t header_length = TCP_HDR_LEN / 4;
@@ -257,7 +268,7 @@ int send_tcp(socket_internal_t *current_socket, tcp_hdr_t *current_tcp_packet,
 
     set_tcp_packet(current_tcp_packet, current_tcp_socket->local_address.sin6_port,
                    current_tcp_socket->foreign_address.sin6_port,
-                   current_tcp_socket->tcp_control.send_una,
+                   seq_nr,
                    (IS_TCP_ACK(flags) ? current_tcp_socket->tcp_control.rcv_nxt : 0x00), header_length, flags,
                    current_tcp_socket->tcp_control.rcv_wnd, 0, 0);
 
@@ -294,6 +305,181 @@ int send_tcp(socket_internal_t *current_socket, tcp_hdr_t *current_tcp_packet,
 #endif
 }
 
+int send_tcp(socket_internal_t *current_socket, tcp_hdr_t *current_tcp_packet,
+             ipv6_hdr_t *temp_ipv6_header, uint8_t flags, uint8_t payload_length)
+{
+    return _send_tcp(current_socket, current_tcp_packet, temp_ipv6_header, flags,
+                     current_socket->socket_values.tcp_control.send_una,
+                     payload_length);
+}
+
+void tcp_init_buffers(socket_internal_t *current_socket)
+{
+    ringbuffer_init(&current_socket->tcp_input_buffer,
+                    current_socket->tcp_input_buffer_data,
+                    sizeof(current_socket->tcp_input_buffer_data));
+    ringbuffer_init(&current_socket->tcp_send_buffer,
+                    current_socket->tcp_send_buffer_data,
+                    sizeof(current_socket->tcp_send_buffer_data));
+}
+
+/* Copy n bytes starting offset bytes behind the read position of rb into
+ * dst, without consuming them */
+static void _send_buffer_peek(const ringbuffer_t *rb, unsigned offset,
+                              uint8_t *dst, unsigned n)
+{
+    unsigned pos = (rb->start + offset) % rb->size;
+    unsigned first = rb->size - pos;
+
+    if (first > n) {
+        first = n;
+    }
+
+    memcpy(dst, &rb->buf[pos], first);
+    memcpy(dst + first, rb->buf, n - first);
+}
+
+/* Send the data segment [seq_nr, seq_nr + len) out of the send buffer,
+ * tcp_send_mutex has to be held by the caller */
+static int _send_data_segment(socket_internal_t *current_socket, uint32_t seq_nr,
+                              uint8_t len)
+{
+    tcp_cb_t *tcp_control = &current_socket->socket_values.tcp_control;
+    ipv6_hdr_t *temp_ipv6_header = ((ipv6_hdr_t *)(&tcp_output_buffer));
+    tcp_hdr_t *current_tcp_packet = ((tcp_hdr_t *)(&tcp_output_buffer[IPV6_HDR_LEN]));
+    int res;
+
+    mutex_lock(&tcp_output_mutex);
+    _send_buffer_peek(&current_socket->tcp_send_buffer, seq_nr - tcp_control->send_una,
+                      &tcp_output_buffer[IPV6_HDR_LEN + TCP_HDR_LEN], len);
+#ifdef TCP_HC
+    tcp_control->tcp_context.hc_type = (seq_nr == tcp_control->send_nxt) ?
+                                       COMPRESSED_HEADER : FULL_HEADER;
+#endif
+    res = _send_tcp(current_socket, current_tcp_packet, temp_ipv6_header, TCP_ACK,
+                    seq_nr, len);
+    mutex_unlock(&tcp_output_mutex);
+
+    return res;
+}
+
+static uint8_t _segment_len(socket_internal_t *current_socket, uint32_t seq_nr)
+{
+    tcp_cb_t *tcp_control = &current_socket->socket_values.tcp_control;
+    uint32_t len = current_socket->tcp_send_buffer.avail -
+                   (seq_nr - tcp_control->send_una);
+
+    return (len > tcp_control->mss) ? tcp_control->mss : len;
+}
+
+/* Send as much new data as the send and congestion window allow,
+ * tcp_send_mutex has to be held by the caller */
+void tcp_output(socket_internal_t *current_socket)
+{
+    tcp_cb_t *tcp_control = &current_socket->socket_values.tcp_control;
+    uint32_t window = tcp_cc_window(tcp_control);
+
+    while (1) {
+        uint32_t in_flight = tcp_control->send_nxt - tcp_control->send_una;
+        uint32_t len = _segment_len(current_socket, tcp_control->send_nxt);
+
+        if ((len == 0) || (in_flight >= window)) {
+            break;
+        }
+
+        if (len > (window - in_flight)) {
+            len = window - in_flight;
+        }
+
+        if (_send_data_segment(current_socket, tcp_control->send_nxt, len) < 0) {
+            break;
+        }
+
+        if (in_flight == 0) {
+            /* (re)start the retransmission timer */
+            vtimer_now(&tcp_control->last_packet_time);
+        }
+
+        if (!tcp_control->rtt_active) {
+            tcp_control->rtt_active = 1;
+            tcp_control->rtt_seq = tcp_control->send_nxt + len;
+            vtimer_now(&tcp_control->rtt_start);
+        }
+
+        tcp_control->send_nxt += len;
+    }
+}
+
+/* Retransmit the first unacknowledged segment after the retransmission
+ * timer expired. Doubles as zero window probe, since it ignores the peer's
+ * window. tcp_send_mutex has to be held by the caller */
+void tcp_retransmit_timeout(socket_internal_t *current_socket)
+{
+    tcp_cb_t *tcp_control = &current_socket->socket_values.tcp_control;
+    uint8_t len;
+
+    tcp_cc_timeout(tcp_control);
+    /* go back N: the receiver drops out of order segments anyway */
+    tcp_control->send_nxt = tcp_control->send_una;
+    len = _segment_len(current_socket, tcp_control->send_una);
+
+    if ((len > 0) && (_send_data_segment(current_socket, tcp_control->send_una, len) >= 0)) {
+        tcp_control->send_nxt += len;
+    }
+
+    vtimer_now(&tcp_control->last_packet_time);
+}
+
+/* Process the acknowledgement number and window of an incoming segment on an
+ * established connection */
+static void _process_ack(socket_internal_t *current_socket, tcp_hdr_t *tcp_header,
+                         uint8_t tcp_payload_len)
+{
+    tcp_cb_t *tcp_control = &current_socket->socket_values.tcp_control;
+
+    mutex_lock(&current_socket->tcp_send_mutex);
+
+    tcp_control->send_wnd = tcp_header->window;
+
+    if (TCP_SEQ_GT(tcp_header->ack_nr, tcp_control->send_una) &&
+        TCP_SEQ_LEQ(tcp_header->ack_nr, tcp_control->send_nxt)) {
+        bool partial_ack = tcp_cc_new_ack(tcp_control, tcp_header->ack_nr);
+
+        if (tcp_control->rtt_active &&
+            TCP_SEQ_GEQ(tcp_header->ack_nr, tcp_control->rtt_seq)) {
+            timex_t now;
+            vtimer_now(&now);
+            calculate_rto(tcp_control, now);
+            tcp_control->rtt_active = 0;
+        }
+
+        ringbuffer_remove(&current_socket->tcp_send_buffer,
+                          tcp_header->ack_nr - tcp_control->send_una);
+        tcp_control->send_una = tcp_header->ack_nr;
+        tcp_control->no_of_retries = 0;
+        vtimer_now(&tcp_control->last_packet_time);
+
+        if (partial_ack) {
+            _send_data_segment(current_socket, tcp_control->send_una,
+                               _segment_len(current_socket, tcp_control->send_una));
+        }
+
+        /* send buffer has room again */
+        tcp_wakeup_sender(current_socket);
+    }
+    else if ((tcp_header->ack_nr == tcp_control->send_una) && (tcp_payload_len == 0) &&
+             (tcp_control->send_nxt != tcp_control->send_una)) {
+        if (tcp_cc_dup_ack(tcp_control)) {
+            _send_data_segment(current_socket, tcp_control->send_una,
+                               _segment_len(current_socket, tcp_control->send_una));
+        }
+    }
+
+    tcp_output(current_socket);
+
+    mutex_unlock(&current_socket->tcp_send_mutex);
+}
+
 bool is_four_touple(socket_internal_t *current_socket, ipv6_hdr_t *ipv6_header,
                     tcp_hdr_t *tcp_header)
 {
@@ -367,6 +553,8 @@ socket_internal_t *new_tcp_queued_socket(ipv6_hdr_t *ipv6_header,
         current_queued_socket->socket_values.tcp_control.mss = TRANSPORT_LAYER_SOCKET_STATIC_MSS;
     }
 
+    tcp_init_buffers(current_queued_socket);
+    current_queued_socket->socket_values.tcp_control.rto = TCP_INITIAL_ACK_TIMEOUT;
     current_queued_socket->socket_values.tcp_control.rcv_irs =
         tcp_header->seq_nr;
     mutex_lock(&global_sequence_counter_mutex);
@@ -429,26 +617,13 @@ uint8_t handle_payload(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
     uint8_t tcp_payload_len = NTOHS(ipv6_header->length) - TCP_HDR_LEN;
     uint8_t acknowledged_bytes = 0;
 
-    if (tcp_payload_len > tcp_socket->socket_values.tcp_control.rcv_wnd) {
-        mutex_lock(&tcp_socket->tcp_buffer_mutex);
-        memcpy(tcp_socket->tcp_input_buffer, payload,
-               tcp_socket->socket_values.tcp_control.rcv_wnd);
-        acknowledged_bytes = tcp_socket->socket_values.tcp_control.rcv_wnd;
-        tcp_socket->socket_values.tcp_control.rcv_wnd = 0;
-        tcp_socket->tcp_input_buffer_end = tcp_socket->tcp_input_buffer_end +
-                                           tcp_socket->socket_values.tcp_control.rcv_wnd;
-        mutex_unlock(&tcp_socket->tcp_buffer_mutex);
-    }
-    else {
-        mutex_lock(&tcp_socket->tcp_buffer_mutex);
-        memcpy(tcp_socket->tcp_input_buffer, payload, tcp_payload_len);
-        tcp_socket->socket_values.tcp_control.rcv_wnd =
-            tcp_socket->socket_values.tcp_control.rcv_wnd - tcp_payload_len;
-        acknowledged_bytes = tcp_payload_len;
-        tcp_socket->tcp_input_buffer_end = tcp_socket->tcp_input_buffer_end +
-                                           tcp_payload_len;
-        mutex_unlock(&tcp_socket->tcp_buffer_mutex);
-    }
+    /* only as much as fits into the receive buffer gets acknowledged */
+    mutex_lock(&tcp_socket->tcp_buffer_mutex);
+    acknowledged_bytes = ringbuffer_add(&tcp_socket->tcp_input_buffer,
+                                        (char *) payload, tcp_payload_len);
+    tcp_socket->socket_values.tcp_control.rcv_wnd =
+        ringbuffer_get_free(&tcp_socket->tcp_input_buffer);
+    mutex_unlock(&tcp_socket->tcp_buffer_mutex);
 
     if (thread_getstatus(tcp_socket->recv_pid) == STATUS_RECEIVE_BLOCKED) {
         socket_base_net_msg_send_recv(&m_send_tcp, &m_recv_tcp, tcp_socket->recv_pid, UNDEFINED);
@@ -470,7 +645,9 @@ void handle_tcp_ack_packet(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
     }
     else if (tcp_socket->socket_values.tcp_control.state == TCP_CLOSING) {
         msg_try_send(&m_send_tcp, tcp_socket->recv_pid);
-        msg_try_send(&m_send_tcp, tcp_socket->send_pid);
+        if (tcp_socket->send_pid != KERNEL_PID_UNDEF) {
+            msg_try_send(&m_send_tcp, tcp_socket->send_pid);
+        }
         return;
     }
     else if (get_waiting_connection_socket(tcp_socket->socket_id, ipv6_header,
@@ -480,11 +657,16 @@ void handle_tcp_ack_packet(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
         return;
     }
     else if (tcp_socket->socket_values.tcp_control.state == TCP_ESTABLISHED) {
-        if (check_tcp_consistency(&tcp_socket->socket_values, tcp_header, 0) == PACKET_OK) {
-            m_send_tcp.content.ptr = (char *)tcp_header;
-            socket_base_net_msg_send(&m_send_tcp, tcp_socket->send_pid, 0, TCP_ACK);
-            return;
+        /* new and duplicate ACKs drive the send window, ACKs of data not yet
+         * sent and older ACKs are dropped */
+        int res = check_tcp_consistency(&tcp_socket->socket_values, tcp_header, 0);
+
+        if ((res == PACKET_OK) ||
+            ((res == ACK_NO_TOO_SMALL) &&
+             (tcp_header->ack_nr == tcp_socket->socket_values.tcp_control.send_una))) {
+            _process_ack(tcp_socket, tcp_header, 0);
         }
+        return;
     }
 
     printf("NO WAY OF HANDLING THIS ACK!\n");
@@ -575,6 +757,11 @@ void handle_tcp_fin_packet(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
         send_tcp(tcp_socket, current_tcp_packet, temp_ipv6_header, TCP_FIN_ACK, 0);
     }
 
+    /* a thread in tcp_send() gives up on the connection */
+    mutex_lock(&tcp_socket->tcp_send_mutex);
+    tcp_wakeup_sender(tcp_socket);
+    mutex_unlock(&tcp_socket->tcp_send_mutex);
+
     socket_base_net_msg_send(&m_send, tcp_socket->recv_pid, 0, CLOSE_CONN);
 }
 
@@ -601,7 +788,14 @@ void handle_tcp_fin_ack_packet(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
 
     send_tcp(tcp_socket, current_tcp_packet, temp_ipv6_header, TCP_ACK, 0);
 
-    msg_try_send(&m_send, tcp_socket->send_pid);
+    mutex_lock(&tcp_socket->tcp_send_mutex);
+    /* a thread in tcp_send() gives up on the connection */
+    tcp_wakeup_sender(tcp_socket);
+    mutex_unlock(&tcp_socket->tcp_send_mutex);
+
+    if (tcp_socket->send_pid != KERNEL_PID_UNDEF) {
+        msg_try_send(&m_send, tcp_socket->send_pid);
+    }
     msg_try_send(&m_send, tcp_socket->recv_pid);
 }
 
@@ -614,7 +808,12 @@ void handle_tcp_no_flags_packet(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
     tcp_hdr_t *current_tcp_packet = ((tcp_hdr_t *)(&send_buffer[IPV6_HDR_LEN]));
 
     if (check_tcp_consistency(current_tcp_socket, tcp_header, tcp_payload_len) == PACKET_OK) {
-        uint8_t read_bytes = handle_payload(ipv6_header, tcp_header, tcp_socket, payload);
+        uint8_t read_bytes;
+
+        /* data segments piggyback acknowledgements for our own data */
+        _process_ack(tcp_socket, tcp_header, tcp_payload_len);
+
+        read_bytes = handle_payload(ipv6_header, tcp_header, tcp_socket, payload);
 
         /* Refresh TCP status values */
         current_tcp_socket->tcp_control.state = TCP_ESTABLISHED;
@@ -633,7 +832,7 @@ void handle_tcp_no_flags_packet(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
 #endif
         send_tcp(tcp_socket, current_tcp_packet, temp_ipv6_header, TCP_ACK, 0);
     }
-    /* ACK packet probably got lost */
+    /* ACK packet probably got lost, or a preceding segment is missing */
     else {
         //      block_continue_thread();
 #ifdef TCP_HC
@@ -781,6 +980,7 @@ int tcp_bind_socket(int s, sockaddr6_t *name, int namelen, uint8_t pid)
     (void) namelen;
     sock->socket_values.local_address = *name;
     sock->socket_values.tcp_control.rto = TCP_INITIAL_ACK_TIMEOUT;
+    tcp_init_buffers(sock);
     sock->recv_pid = pid;
 
     return 0;
@@ -788,7 +988,7 @@ int tcp_bind_socket(int s, sockaddr6_t *name, int namelen, uint8_t pid)
 
 void calculate_rto(tcp_cb_t *tcp_control, timex_t current_time)
 {
-    double rtt = (double) timex_uint64(timex_sub(current_time, tcp_control->last_packet_time));
+    double rtt = (double) timex_uint64(timex_sub(current_time, tcp_control->rtt_start));
     double srtt = tcp_control->srtt;
     double rttvar = tcp_control->rttvar;
     double rto = tcp_control->rto;
@@ -817,6 +1017,33 @@ void calculate_rto(tcp_cb_t *tcp_control, timex_t current_time)
     tcp_control->rto = rto;
 }
 
+/* Retransmission timeout of the oldest unacknowledged segment, doubled for
+ * every retransmission */
+double tcp_ack_timeout(socket_internal_t *current_socket)
+{
+    double current_timeout = current_socket->socket_values.tcp_control.rto;
+
+    if (current_timeout < SECOND) {
+        current_timeout = SECOND;
+    }
+
+    for (uint8_t i = 0; i < current_socket->socket_values.tcp_control.no_of_retries; i++) {
+        current_timeout *= 2;
+    }
+
+    return current_timeout;
+}
+
+/* Wake up a thread waiting in tcp_send() or tcp_teardown() to check the send
+ * buffer and connection state again, tcp_send_mutex has to be held by the
+ * caller */
+void tcp_wakeup_sender(socket_internal_t *current_socket)
+{
+    if (current_socket->send_pid != KERNEL_PID_UNDEF) {
+        thread_wakeup(current_socket->send_pid);
+    }
+}
+
 int handle_new_tcp_connection(socket_internal_t *current_queued_int_socket,
                               socket_internal_t *server_socket, uint8_t pid)
 {
@@ -884,6 +1111,7 @@ int handle_new_tcp_connection(socket_internal_t *current_queued_int_socket,
 #endif
 
     /* Update connection status information */
+    tcp_cc_init(&current_queued_socket->tcp_control);
     current_queued_socket->tcp_control.state = TCP_ESTABLISHED;
 
     /* Set status of internal socket back to TCP_LISTEN */
@@ -909,15 +1137,9 @@ int32_t tcp_send(int s, const void *buf, uint32_t len, int flags)
     (void) flags;
 
     /* Variables */
-    msg_t recv_msg;
-    int32_t sent_bytes = 0;
     uint32_t total_sent_bytes = 0;
     socket_internal_t *current_int_tcp_socket;
     socket_t *current_tcp_socket;
-    uint8_t send_buffer[BUFFER_SIZE];
-    memset(send_buffer, 0, BUFFER_SIZE);
-    ipv6_hdr_t *temp_ipv6_header = ((ipv6_hdr_t *)(&send_buffer));
-    tcp_hdr_t *current_tcp_packet = ((tcp_hdr_t *)(&send_buffer[IPV6_HDR_LEN]));
 
     /* Check if socket exists and is TCP socket */
     if (!tcp_socket_compliancy(s)) {
@@ -932,150 +1154,53 @@ int32_t tcp_send(int s, const void *buf, uint32_t len, int flags)
         return -1;
     }
 
+    mutex_lock(&current_int_tcp_socket->tcp_send_mutex);
+
     /* Add thread PID */
     current_int_tcp_socket->send_pid = thread_getpid();
 
-    recv_msg.type = UNDEFINED;
-
     while (1) {
-        current_tcp_socket->tcp_control.no_of_retries = 0;
-
-#ifdef TCP_HC
-        current_tcp_socket->tcp_control.tcp_context.hc_type = COMPRESSED_HEADER;
-        /* Remember TCP Context for possible TCP_RETRY */
-        tcp_hc_context_t saved_tcp_context;
-        memcpy(&saved_tcp_context, &current_tcp_socket->tcp_control.tcp_context,
-               sizeof(tcp_hc_context_t) - 1);
-#endif
-
-        while (recv_msg.type != TCP_ACK) {
-            /* Add packet data */
-            if (current_tcp_socket->tcp_control.send_wnd >
-                current_tcp_socket->tcp_control.mss) {
-                /* Window size > Maximum Segment Size */
-                if ((len - total_sent_bytes) > current_tcp_socket->tcp_control.mss) {
-                    memcpy(&send_buffer[IPV6_HDR_LEN + TCP_HDR_LEN], buf,
-                           current_tcp_socket->tcp_control.mss);
-                    sent_bytes = current_tcp_socket->tcp_control.mss;
-                    total_sent_bytes += sent_bytes;
-                }
-                else {
-                    memcpy(&send_buffer[IPV6_HDR_LEN + TCP_HDR_LEN],
-                           (uint8_t *) buf + total_sent_bytes, len - total_sent_bytes);
-                    sent_bytes = len - total_sent_bytes;
-                    total_sent_bytes = len;
-                }
-            }
-            else {
-                /* Window size <= Maximum Segment Size */
-                if ((len - total_sent_bytes) > current_tcp_socket->tcp_control.send_wnd) {
-                    memcpy(&send_buffer[IPV6_HDR_LEN + TCP_HDR_LEN], buf,
-                           current_tcp_socket->tcp_control.send_wnd);
-                    sent_bytes = current_tcp_socket->tcp_control.send_wnd;
-                    total_sent_bytes += sent_bytes;
-                }
-                else {
-                    memcpy(&send_buffer[IPV6_HDR_LEN + TCP_HDR_LEN],
-                           (uint8_t *) buf + total_sent_bytes, len - total_sent_bytes);
-                    sent_bytes = len - total_sent_bytes;
-                    total_sent_bytes = len;
-                }
-            }
-
-            current_tcp_socket->tcp_control.send_nxt += sent_bytes;
-            current_tcp_socket->tcp_control.send_wnd -= sent_bytes;
-
-            if (send_tcp(current_int_tcp_socket, current_tcp_packet,
-                         temp_ipv6_header, TCP_ACK, sent_bytes) < 0) {
-                /* Error while sending tcp data */
-                current_tcp_socket->tcp_control.send_nxt -= sent_bytes;
-                current_tcp_socket->tcp_control.send_wnd += sent_bytes;
-#ifdef TCP_HC
-                memcpy(&current_tcp_socket->tcp_control.tcp_context,
-                       &saved_tcp_context, sizeof(tcp_hc_context_t));
-                current_tcp_socket->tcp_control.tcp_context.hc_type =
-                    COMPRESSED_HEADER;
-#endif
-                printf("Error while sending, returning to application thread!\n");
-                return -1;
-            }
-
-            /* Remember current time */
-            vtimer_now(&current_tcp_socket->tcp_control.last_packet_time);
-            socket_base_net_msg_receive(&recv_msg);
-
-            switch (recv_msg.type) {
-                case TCP_ACK: {
-                    if (current_tcp_socket->tcp_control.no_of_retries == 0) {
-                        calculate_rto(&current_tcp_socket->tcp_control,
-                                      current_tcp_socket->tcp_control.last_packet_time);
-                    }
-
-                    tcp_hdr_t *tcp_header = ((tcp_hdr_t *)(recv_msg.content.ptr));
-
-                    if ((current_tcp_socket->tcp_control.send_nxt ==
-                         tcp_header->ack_nr) && (total_sent_bytes == len)) {
-                        current_tcp_socket->tcp_control.send_una = tcp_header->ack_nr;
-                        current_tcp_socket->tcp_control.send_nxt = tcp_header->ack_nr;
-                        current_tcp_socket->tcp_control.send_wnd = tcp_header->window;
-                        /* Got ACK for every sent byte */
-#ifdef TCP_HC
-                        current_tcp_socket->tcp_control.tcp_context.hc_type =
-                            COMPRESSED_HEADER;
-#endif
-                        return sent_bytes;
-                    }
-                    else if ((current_tcp_socket->tcp_control.send_nxt ==
-                              tcp_header->ack_nr) && (total_sent_bytes != len)) {
-                        current_tcp_socket->tcp_control.send_una = tcp_header->ack_nr;
-                        current_tcp_socket->tcp_control.send_nxt = tcp_header->ack_nr;
-                        current_tcp_socket->tcp_control.send_wnd = tcp_header->window;
-                        /* Got ACK for every sent byte */
-#ifdef TCP_HC
-                        current_tcp_socket->tcp_control.tcp_context.hc_type =
-                            COMPRESSED_HEADER;
-#endif
-                        break;
-                    }
-
-                    /* else {
-                     *     TODO: If window size > MSS, ACK was valid only for
-                     *     a few segments, handle retransmit of missing
-                     *     segments
-                     *  break;
-                     * } */
-                    break;
-                }
+        /* Queue as much data as fits into the send buffer and push out what
+         * the send and congestion window allow, the rest is clocked out by
+         * incoming ACKs */
+        total_sent_bytes += ringbuffer_add(&current_int_tcp_socket->tcp_send_buffer,
+                                           (const char *) buf + total_sent_bytes,
+                                           len - total_sent_bytes);
+        tcp_output(current_int_tcp_socket);
+
+        /* Return only after the peer acknowledged all data, a caller
+         * retrying after an error would otherwise send it twice */
+        if ((total_sent_bytes == len) &&
+            ringbuffer_empty(&current_int_tcp_socket->tcp_send_buffer)) {
+            break;
+        }
 
-                case TCP_RETRY: {
-                    current_tcp_socket->tcp_control.send_nxt -= sent_bytes;
-                    current_tcp_socket->tcp_control.send_wnd += sent_bytes;
-                    total_sent_bytes -= sent_bytes;
-#ifdef TCP_HC
-                    memcpy(&current_tcp_socket->tcp_control.tcp_context,
-                           $&saved_tcp_context, sizeof(tcp_hc_context_t));
-                    current_tcp_socket->tcp_control.tcp_context.hc_type =
-                        MOSTLY_COMPRESSED_HEADER;
-#endif
-                    break;
-                }
+        if (tcp_ack_timeout(current_int_tcp_socket) > TCP_ACK_MAX_TIMEOUT) {
+            current_int_tcp_socket->send_pid = KERNEL_PID_UNDEF;
+            mutex_unlock(&current_int_tcp_socket->tcp_send_mutex);
+            printf("Connection timed out, returning to application thread!\n");
+            return -1;
+        }
 
-                case TCP_TIMEOUT: {
-                    current_tcp_socket->tcp_control.send_nxt -= sent_bytes;
-                    current_tcp_socket->tcp_control.send_wnd += sent_bytes;
-#ifdef TCP_HC
-                    memcpy(&current_tcp_socket->tcp_control.tcp_context,
-                           &saved_tcp_context, sizeof(tcp_hc_context_t));
-                    current_tcp_socket->tcp_control.tcp_context.hc_type =
-                        COMPRESSED_HEADER;
-#endif
-                    return -1;
-                }
-            }
+        if ((current_tcp_socket->tcp_control.state != TCP_ESTABLISHED) &&
+            (current_tcp_socket->tcp_control.state != TCP_CLOSE_WAIT)) {
+            /* connection was closed or reset meanwhile */
+            current_int_tcp_socket->send_pid = KERNEL_PID_UNDEF;
+            mutex_unlock(&current_int_tcp_socket->tcp_send_mutex);
+            return -1;
         }
+
+        /* Sleep until an ACK, the retransmission timer or a state change
+         * wakes us up. They wake us up with tcp_send_mutex held, so none
+         * of them gets lost between the checks above and going to sleep. */
+        mutex_unlock_and_sleep(&current_int_tcp_socket->tcp_send_mutex);
+        mutex_lock(&current_int_tcp_socket->tcp_send_mutex);
     }
 
-    return sent_bytes;
+    current_int_tcp_socket->send_pid = KERNEL_PID_UNDEF;
+    mutex_unlock(&current_int_tcp_socket->tcp_send_mutex);
+
+    return total_sent_bytes;
 }
 
 int tcp_accept(int s, sockaddr6_t *addr, uint32_t *addrlen)
@@ -1136,6 +1261,11 @@ int tcp_connect(int socket, sockaddr6_t *addr, uint32_t addrlen)
     current_tcp_socket = &current_int_tcp_socket->socket_values;
 
     current_int_tcp_socket->recv_pid = thread_getpid();
+    tcp_init_buffers(current_int_tcp_socket);
+
+    if (current_tcp_socket->tcp_control.rto == 0) {
+        current_tcp_socket->tcp_control.rto = TCP_INITIAL_ACK_TIMEOUT;
+    }
 
     /* Local address information */
     ipv6_net_if_get_best_src_addr(&src_addr, &addr->sin6_addr);
@@ -1270,6 +1400,7 @@ int tcp_connect(int socket, sockaddr6_t *addr, uint32_t addrlen)
 #endif
     }
 
+    tcp_cc_init(&current_tcp_socket->tcp_control);
     current_tcp_socket->tcp_control.state = TCP_ESTABLISHED;
 
     current_int_tcp_socket->recv_pid = 255;
@@ -1278,31 +1409,16 @@ int tcp_connect(int socket, sockaddr6_t *addr, uint32_t addrlen)
     return 0;
 }
 
-uint8_t read_from_socket(socket_internal_t *current_int_tcp_socket,
-                         void *buf, int len)
+uint16_t read_from_socket(socket_internal_t *current_int_tcp_socket,
+                          void *buf, int len)
 {
-    if (len >= current_int_tcp_socket->tcp_input_buffer_end) {
-        mutex_lock(&current_int_tcp_socket->tcp_buffer_mutex);
-        uint8_t read_bytes = current_int_tcp_socket->tcp_input_buffer_end;
-        memcpy(buf, current_int_tcp_socket->tcp_input_buffer,
-               current_int_tcp_socket->tcp_input_buffer_end);
-        current_int_tcp_socket->tcp_input_buffer_end = 0;
-        current_int_tcp_socket->socket_values.tcp_control.rcv_wnd += read_bytes;
-        mutex_unlock(&current_int_tcp_socket->tcp_buffer_mutex);
-        return read_bytes;
-    }
-    else {
-        mutex_lock(&current_int_tcp_socket->tcp_buffer_mutex);
-        memcpy(buf, current_int_tcp_socket->tcp_input_buffer, len);
-        memmove(current_int_tcp_socket->tcp_input_buffer,
-                (current_int_tcp_socket->tcp_input_buffer + len),
-                current_int_tcp_socket->tcp_input_buffer_end - len);
-        current_int_tcp_socket->tcp_input_buffer_end =
-            current_int_tcp_socket->tcp_input_buffer_end - len;
-        current_int_tcp_socket->socket_values.tcp_control.rcv_wnd += len;
-        mutex_unlock(&current_int_tcp_socket->tcp_buffer_mutex);
-        return len;
-    }
+    mutex_lock(&current_int_tcp_socket->tcp_buffer_mutex);
+    uint16_t read_bytes = ringbuffer_get(&current_int_tcp_socket->tcp_input_buffer,
+                                         buf, len);
+    current_int_tcp_socket->socket_values.tcp_control.rcv_wnd =
+        ringbuffer_get_free(&current_int_tcp_socket->tcp_input_buffer);
+    mutex_unlock(&current_int_tcp_socket->tcp_buffer_mutex);
+    return read_bytes;
 }
 
 int32_t tcp_recv(int s, void *buf, uint32_t len, int flags)
@@ -1324,14 +1440,15 @@ int32_t tcp_recv(int s, void *buf, uint32_t len, int flags)
     /* Setting Thread PID */
     current_int_tcp_socket->recv_pid = thread_getpid();
 
-    if (current_int_tcp_socket->tcp_input_buffer_end > 0) {
+    if (!ringbuffer_empty(&current_int_tcp_socket->tcp_input_buffer)) {
         return read_from_socket(current_int_tcp_socket, buf, len);
     }
 
     msg_receive(&m_recv);
 
-    if ((socket_base_exists_socket(s)) && (current_int_tcp_socket->tcp_input_buffer_end > 0)) {
-        uint8_t read_bytes = read_from_socket(current_int_tcp_socket, buf, len);
+    if ((socket_base_exists_socket(s)) &&
+        !ringbuffer_empty(&current_int_tcp_socket->tcp_input_buffer)) {
+        uint16_t read_bytes = read_from_socket(current_int_tcp_socket, buf, len);
         socket_base_net_msg_reply(&m_recv, &m_send, UNDEFINED);
         return read_bytes;
     }
@@ -1376,8 +1493,18 @@ int tcp_teardown(socket_internal_t *current_socket)
         return 0;
     }
 
+    mutex_lock(&current_socket->tcp_send_mutex);
     current_socket->send_pid = thread_getpid();
 
+    /* Wait until all queued data is acknowledged before sending FIN */
+    while (!ringbuffer_empty(&current_socket->tcp_send_buffer) &&
+           (tcp_ack_timeout(current_socket) <= TCP_ACK_MAX_TIMEOUT)) {
+        mutex_unlock_and_sleep(&current_socket->tcp_send_mutex);
+        mutex_lock(&current_socket->tcp_send_mutex);
+    }
+
+    mutex_unlock(&current_socket->tcp_send_mutex);
+
     /* Refresh local TCP socket information */
     current_socket->socket_values.tcp_control.state = TCP_FIN_WAIT_1;
 #ifdef TCP_HC
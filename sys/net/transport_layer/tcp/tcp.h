@@ -66,7 +66,8 @@ enum tcp_codes {
     CLOSE_CONN          = 2,
     SEQ_NO_TOO_SMALL    = 3,
     ACK_NO_TOO_SMALL    = 4,
-    ACK_NO_TOO_BIG      = 5
+    ACK_NO_TOO_BIG      = 5,
+    SEQ_NO_TOO_BIG      = 6
 };
 
 #define REMOVE_RESERVED         (0xFC)
@@ -112,6 +113,14 @@ int32_t tcp_recv(int s, void *buf, uint32_t len, int flags);
 bool tcp_socket_compliancy(int s);
 int tcp_teardown(socket_internal_t *current_socket);
 
+/* methods used by tcp_timer */
+void tcp_init_buffers(socket_internal_t *current_socket);
+void tcp_output(socket_internal_t *current_socket);
+void tcp_retransmit_timeout(socket_internal_t *current_socket);
+void calculate_rto(tcp_cb_t *tcp_control, timex_t current_time);
+double tcp_ack_timeout(socket_internal_t *current_socket);
+void tcp_wakeup_sender(socket_internal_t *current_socket);
+
 #ifdef __cplusplus
 }
 #endif
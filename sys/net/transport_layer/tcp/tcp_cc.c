@@ -0,0 +1,126 @@
+/**
+ * TCP congestion control
+ *
+ * Copyright (C) 2015  Freie Universität Berlin.
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup transport_layer
+ * @{
+ * @file
+ * @brief   TCP congestion control (RFC 5681, NewReno as of RFC 6582)
+ * @}
+ */
+
+#include "tcp_cc.h"
+
+static uint32_t _flight_size(const tcp_cb_t *tcp_control)
+{
+    return tcp_control->send_nxt - tcp_control->send_una;
+}
+
+static void _enter_loss_state(tcp_cb_t *tcp_control)
+{
+    uint32_t half_flight = _flight_size(tcp_control) / 2;
+
+    tcp_control->ssthresh = (half_flight > 2 * tcp_control->mss) ?
+                            half_flight : 2 * tcp_control->mss;
+    tcp_control->recover = tcp_control->send_nxt;
+}
+
+void tcp_cc_init(tcp_cb_t *tcp_control)
+{
+    /* initial window as of RFC 5681, section 3.1 */
+    if (tcp_control->mss > 2190) {
+        tcp_control->cwnd = 2 * tcp_control->mss;
+    }
+    else if (tcp_control->mss > 1095) {
+        tcp_control->cwnd = 3 * tcp_control->mss;
+    }
+    else {
+        tcp_control->cwnd = 4 * tcp_control->mss;
+    }
+
+    tcp_control->ssthresh = UINT16_MAX;
+    tcp_control->recover = tcp_control->send_una;
+    tcp_control->dup_acks = 0;
+    tcp_control->in_recovery = 0;
+    tcp_control->rtt_active = 0;
+}
+
+uint32_t tcp_cc_window(const tcp_cb_t *tcp_control)
+{
+    return (tcp_control->cwnd < tcp_control->send_wnd) ?
+           tcp_control->cwnd : tcp_control->send_wnd;
+}
+
+bool tcp_cc_new_ack(tcp_cb_t *tcp_control, uint32_t ack_nr)
+{
+    uint32_t acked = ack_nr - tcp_control->send_una;
+
+    tcp_control->dup_acks = 0;
+
+    if (tcp_control->in_recovery) {
+        if (TCP_SEQ_GEQ(ack_nr, tcp_control->recover)) {
+            /* full acknowledgement: deflate the window and leave recovery */
+            tcp_control->cwnd = tcp_control->ssthresh;
+            tcp_control->in_recovery = 0;
+            return false;
+        }
+
+        /* partial acknowledgement: deflate by the amount of new data, add
+         * back one segment for the retransmission that follows */
+        tcp_control->cwnd = (tcp_control->cwnd > acked) ?
+                            tcp_control->cwnd - acked : 0;
+
+        if (acked >= tcp_control->mss) {
+            tcp_control->cwnd += tcp_control->mss;
+        }
+
+        return true;
+    }
+
+    if (tcp_control->cwnd < tcp_control->ssthresh) {
+        /* slow start */
+        tcp_control->cwnd += (acked < tcp_control->mss) ? acked : tcp_control->mss;
+    }
+    else {
+        /* congestion avoidance: roughly one segment per RTT */
+        uint32_t inc = (tcp_control->mss * tcp_control->mss) / tcp_control->cwnd;
+        tcp_control->cwnd += (inc > 0) ? inc : 1;
+    }
+
+    return false;
+}
+
+bool tcp_cc_dup_ack(tcp_cb_t *tcp_control)
+{
+    if (tcp_control->in_recovery) {
+        /* inflate the window for every segment that has left the network */
+        tcp_control->cwnd += tcp_control->mss;
+        return false;
+    }
+
+    if ((++tcp_control->dup_acks == TCP_CC_DUP_ACK_THRESHOLD) &&
+        TCP_SEQ_GEQ(tcp_control->send_una, tcp_control->recover)) {
+        _enter_loss_state(tcp_control);
+        tcp_control->cwnd = tcp_control->ssthresh +
+                            TCP_CC_DUP_ACK_THRESHOLD * tcp_control->mss;
+        tcp_control->in_recovery = 1;
+        return true;
+    }
+
+    return false;
+}
+
+void tcp_cc_timeout(tcp_cb_t *tcp_control)
+{
+    _enter_loss_state(tcp_control);
+    tcp_control->cwnd = tcp_control->mss;
+    tcp_control->dup_acks = 0;
+    tcp_control->in_recovery = 0;
+    /* Karn's algorithm: never take RTT samples from retransmitted data */
+    tcp_control->rtt_active = 0;
+}
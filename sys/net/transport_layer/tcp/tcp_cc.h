@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2015  Freie Universität Berlin.
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup transport_layer
+ * @{
+ * @file
+ * @brief   TCP congestion control (slow start, congestion avoidance and
+ *          NewReno fast retransmit/fast recovery)
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc5681">RFC 5681</a>
+ * @see <a href="https://tools.ietf.org/html/rfc6582">RFC 6582</a>
+ */
+#ifndef TCP_CC_H_
+#define TCP_CC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "socket.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TCP_CC_DUP_ACK_THRESHOLD    (3)
+
+/* sequence number comparison modulo 2^32 */
+#define TCP_SEQ_LT(a, b)            ((int32_t)((a) - (b)) < 0)
+#define TCP_SEQ_LEQ(a, b)           ((int32_t)((a) - (b)) <= 0)
+#define TCP_SEQ_GT(a, b)            ((int32_t)((a) - (b)) > 0)
+#define TCP_SEQ_GEQ(a, b)           ((int32_t)((a) - (b)) >= 0)
+
+/**
+ * @brief   Resets congestion state of a freshly established connection.
+ *          Requires send_una, send_nxt and mss to be set.
+ */
+void tcp_cc_init(tcp_cb_t *tcp_control);
+
+/**
+ * @brief   Returns the number of bytes that may be in flight, i.e. the
+ *          minimum of congestion window and the peer's receive window.
+ */
+uint32_t tcp_cc_window(const tcp_cb_t *tcp_control);
+
+/**
+ * @brief   Updates the congestion window for an ACK of new data.
+ *          Must be called before send_una is advanced to @p ack_nr.
+ *
+ * @return  true if @p ack_nr is a partial ACK during fast recovery and the
+ *          first unacknowledged segment has to be retransmitted.
+ */
+bool tcp_cc_new_ack(tcp_cb_t *tcp_control, uint32_t ack_nr);
+
+/**
+ * @brief   Updates the congestion state for a duplicate ACK.
+ *
+ * @return  true if the first unacknowledged segment has to be fast
+ *          retransmitted.
+ */
+bool tcp_cc_dup_ack(tcp_cb_t *tcp_control);
+
+/**
+ * @brief   Collapses the congestion window after a retransmission timeout.
+ *          Must be called before send_nxt is reset to send_una.
+ */
+void tcp_cc_timeout(tcp_cb_t *tcp_control);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TCP_CC_H_ */
+/**
+ * @}
+ */
@@ -61,34 +61,27 @@ void handle_synchro_timeout(socket_internal_t *current_socket)
 
 void handle_established(socket_internal_t *current_socket)
 {
-    msg_t send;
-    double current_timeout = current_socket->socket_values.tcp_control.rto;
-
-    if (current_timeout < SECOND) {
-        current_timeout = SECOND;
-    }
-
-
-    if ((current_socket->socket_values.tcp_control.send_nxt >
-         current_socket->socket_values.tcp_control.send_una) &&
-        (thread_getstatus(current_socket->send_pid) == STATUS_RECEIVE_BLOCKED)) {
-        for (uint8_t i = 0; i < current_socket->socket_values.tcp_control.no_of_retries;
-             i++) {
-            current_timeout *= 2;
-        }
+    mutex_lock(&current_socket->tcp_send_mutex);
 
+    /* Unacknowledged data in flight, or queued data held back by a zero
+     * window */
+    if (!ringbuffer_empty(&current_socket->tcp_send_buffer)) {
+        double current_timeout = tcp_ack_timeout(current_socket);
         timex_t now;
         vtimer_now(&now);
 
         if (current_timeout > TCP_ACK_MAX_TIMEOUT) {
-            socket_base_net_msg_send(&send, current_socket->send_pid, 0, TCP_TIMEOUT);
+            /* the sending thread finds out about the timeout itself */
+            tcp_wakeup_sender(current_socket);
         }
         else if (timex_uint64(timex_sub(now, current_socket->socket_values.tcp_control.last_packet_time)) >
                  current_timeout) {
             current_socket->socket_values.tcp_control.no_of_retries++;
-            socket_base_net_msg_send(&send, current_socket->send_pid, 0, TCP_RETRY);
+            tcp_retransmit_timeout(current_socket);
         }
     }
+
+    mutex_unlock(&current_socket->tcp_send_mutex);
 }
 
 void check_sockets(void)
@@ -85,7 +85,11 @@ void _init(void)
     mutex_lock(&uart_rx_mutex);
     ringbuffer_init(&rx_buf, rx_buf_mem, STDIO_RX_BUFSIZE);
 #endif
+#ifdef MODULE_STDIO_UART_BULK
+    uart_init_bulk(STDIO, STDIO_BAUDRATE, rx_cb, 0);
+#else
     uart_init(STDIO, STDIO_BAUDRATE, rx_cb, 0, 0);
+#endif
 }
 
 /**
@@ -211,9 +215,7 @@ int _read_r(struct _reent *r, int fd, void *buffer, unsigned int count)
     restoreIRQ(state);
     return res;
 #else
-    char *res = (char*)buffer;
-    res[0] = (char)uart0_readc();
-    return 1;
+    return uart0_read((char*)buffer, count);
 #endif
 }
 
@@ -236,6 +238,9 @@ int _write_r(struct _reent *r, int fd, const void *data, unsigned int count)
 {
     (void) r;
     (void) fd;
+#ifdef MODULE_STDIO_UART_BULK
+    return uart_write_bulk(STDIO, data, count);
+#else
     unsigned int i = 0;
 
     while (i < count) {
@@ -243,6 +248,7 @@ int _write_r(struct _reent *r, int fd, const void *data, unsigned int count)
     }
 
     return (int)i;
+#endif
 }
 
 /**
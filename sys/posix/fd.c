@@ -36,6 +36,20 @@
 
 static fd_t fd_table[FD_MAX];
 
+#ifdef MODULE_UART0_DIRECT
+static ssize_t _uart0_read(int fd, void *buf, size_t n)
+{
+    (void)fd;
+    return uart0_read(buf, n);
+}
+
+static ssize_t _uart0_write(int fd, const void *buf, size_t n)
+{
+    (void)fd;
+    return uart0_write(buf, n);
+}
+#endif
+
 int fd_init(void)
 {
     memset(fd_table, 0, sizeof(fd_t) * FD_MAX);
@@ -45,8 +59,13 @@ int fd_init(void)
     fd_t fd = {
         .internal_active = 1,
         .internal_fd = (int)uart0_handler_pid,
+#ifdef MODULE_UART0_DIRECT
+        .read = _uart0_read,
+        .write = _uart0_write,
+#else
         .read = (ssize_t ( *)(int, void *, size_t))posix_read,
         .write = (ssize_t ( *)(int, const void *, size_t))posix_write,
+#endif
         .close = posix_close
     };
     memcpy(&fd_table[STDIN_FILENO], &fd, sizeof(fd_t));
@@ -100,6 +119,30 @@ fd_t *fd_get(int fd)
     return NULL;
 }
 
+ssize_t fd_read(int fd, void *buf, size_t n)
+{
+    fd_t *fd_obj = fd_get(fd);
+
+    if (!fd_obj || !fd_obj->internal_active || !fd_obj->read) {
+        errno = EBADF;
+        return -1;
+    }
+
+    return fd_obj->read(fd_obj->internal_fd, buf, n);
+}
+
+ssize_t fd_write(int fd, const void *buf, size_t n)
+{
+    fd_t *fd_obj = fd_get(fd);
+
+    if (!fd_obj || !fd_obj->internal_active || !fd_obj->write) {
+        errno = EBADF;
+        return -1;
+    }
+
+    return fd_obj->write(fd_obj->internal_fd, buf, n);
+}
+
 void fd_destroy(int fd)
 {
     fd_t *cur = fd_get(fd);
@@ -10,15 +10,248 @@
  * @{
  * @file
  * @brief   Providing implementation for POSIX socket wrapper.
+ *
+ * With the module ng_udp_ep, UDP sockets are served by @ref net_ng_udp_ep
+ * instead of socket_base. All other socket types still need socket_base.
+ *
  * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
  */
 #include <errno.h>
+#include <string.h>
 
 #include "socket_base/socket.h"
 #include "fd.h"
 
 #include "sys/socket.h"
 
+#ifdef MODULE_NG_UDP_EP
+#include "byteorder.h"
+#include "net/ng_udp/ep.h"
+
+#ifndef PNET_UDP_SOCKET_NUMOF
+#define PNET_UDP_SOCKET_NUMOF   (4)         /**< number of UDP sockets */
+#endif
+#define PNET_UDP_PORT_MIN       (0xc000)    /**< first ephemeral port */
+
+typedef struct {
+    ng_udp_ep_t ep;             /* netreg.pid is KERNEL_PID_UNDEF if unbound */
+    ng_ipv6_addr_t remote;      /* peer of a connected socket */
+    uint16_t remote_port;       /* 0 if not connected */
+    uint8_t used;
+} udp_socket_t;
+
+static udp_socket_t _udp_sockets[PNET_UDP_SOCKET_NUMOF];
+static uint16_t _udp_port_next = PNET_UDP_PORT_MIN;
+
+static ssize_t _udp_read(int s, void *buf, size_t len);
+
+static udp_socket_t *_udp_socket_get(int socket)
+{
+    fd_t *fd = fd_get(socket);
+
+    if ((fd == NULL) || (fd->read != _udp_read)) {
+        return NULL;
+    }
+
+    return &_udp_sockets[fd->internal_fd];
+}
+
+static int _udp_addr_check(const sockaddr6_t *addr, socklen_t addr_len)
+{
+    if ((addr == NULL) || (addr_len < sizeof(sockaddr6_t)) ||
+        (addr->sin6_family != AF_INET6)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static int _udp_bind_port(udp_socket_t *sock, uint16_t port)
+{
+    if (sock->ep.netreg.pid != KERNEL_PID_UNDEF) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (port == 0) {
+        port = _udp_port_next++;
+
+        if (_udp_port_next == 0) {
+            _udp_port_next = PNET_UDP_PORT_MIN;
+        }
+    }
+
+    if (ng_udp_ep_create(&sock->ep, port) < 0) {
+        errno = EADDRNOTAVAIL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static int _udp_bind(udp_socket_t *sock, const sockaddr6_t *addr,
+                     socklen_t addr_len)
+{
+    if (_udp_addr_check(addr, addr_len) < 0) {
+        return -1;
+    }
+
+    return _udp_bind_port(sock, NTOHS(addr->sin6_port));
+}
+
+static int _udp_connect(udp_socket_t *sock, const sockaddr6_t *addr,
+                        socklen_t addr_len)
+{
+    if (_udp_addr_check(addr, addr_len) < 0) {
+        return -1;
+    }
+
+    if (addr->sin6_port == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    memcpy(&sock->remote, &addr->sin6_addr, sizeof(sock->remote));
+    sock->remote_port = NTOHS(addr->sin6_port);
+
+    return 0;
+}
+
+static ssize_t _udp_sendto(udp_socket_t *sock, const void *buf, size_t len,
+                           const sockaddr6_t *addr, socklen_t addr_len)
+{
+    ng_udp_ep_dgram_t dgram;
+
+    if (addr != NULL) {
+        if (_udp_addr_check(addr, addr_len) < 0) {
+            return -1;
+        }
+
+        memcpy(&dgram.addr, &addr->sin6_addr, sizeof(dgram.addr));
+        dgram.port = NTOHS(addr->sin6_port);
+    }
+    else if (sock->remote_port != 0) {
+        dgram.addr = sock->remote;
+        dgram.port = sock->remote_port;
+    }
+    else {
+        errno = ENOTCONN;
+        return -1;
+    }
+
+    if ((sock->ep.netreg.pid == KERNEL_PID_UNDEF) &&
+        (_udp_bind_port(sock, 0) < 0)) {
+        return -1;
+    }
+
+    /* the only copy on the way down: from the user's buffer to pktbuf */
+    dgram.pkt = ng_pktbuf_add(NULL, (void *)buf, len, NG_NETTYPE_UNDEF);
+
+    if ((dgram.pkt == NULL) || (ng_udp_ep_send(&sock->ep, &dgram, 1) < 1)) {
+        errno = ENOBUFS;
+        return -1;
+    }
+
+    return (ssize_t)len;
+}
+
+static ssize_t _udp_recvfrom(udp_socket_t *sock, void *buf, size_t len,
+                             sockaddr6_t *addr, socklen_t *addr_len)
+{
+    ng_udp_ep_dgram_t dgram;
+
+    if (sock->ep.netreg.pid == KERNEL_PID_UNDEF) {
+        errno = ENOTCONN;
+        return -1;
+    }
+
+    while (1) {
+        int res = ng_udp_ep_recv(&sock->ep, &dgram, 1, NG_UDP_EP_TIMEOUT_FOREVER);
+
+        if (res < 1) {
+            errno = (res == -EINTR) ? EINTR : EAGAIN;
+            return -1;
+        }
+
+        /* connected sockets only take datagrams from their peer */
+        if ((sock->remote_port == 0) ||
+            ((dgram.port == sock->remote_port) &&
+             ng_ipv6_addr_equal(&dgram.addr, &sock->remote))) {
+            break;
+        }
+
+        ng_pktbuf_release(dgram.pkt);
+    }
+
+    if (len > dgram.pkt->size) {
+        len = dgram.pkt->size;
+    }
+
+    memcpy(buf, dgram.pkt->data, len);
+
+    if ((addr != NULL) && (addr_len != NULL) &&
+        (*addr_len >= sizeof(sockaddr6_t))) {
+        memset(addr, 0, sizeof(sockaddr6_t));
+        addr->sin6_family = AF_INET6;
+        addr->sin6_port = HTONS(dgram.port);
+        memcpy(&addr->sin6_addr, &dgram.addr, sizeof(dgram.addr));
+        *addr_len = sizeof(sockaddr6_t);
+    }
+
+    ng_pktbuf_release(dgram.pkt);
+
+    return (ssize_t)len;
+}
+
+static ssize_t _udp_read(int s, void *buf, size_t len)
+{
+    return _udp_recvfrom(&_udp_sockets[s], buf, len, NULL, NULL);
+}
+
+static ssize_t _udp_write(int s, const void *buf, size_t len)
+{
+    return _udp_sendto(&_udp_sockets[s], buf, len, NULL, 0);
+}
+
+static int _udp_close(int s)
+{
+    ng_udp_ep_close(&_udp_sockets[s].ep);
+    _udp_sockets[s].used = 0;
+
+    return 0;
+}
+
+static int _udp_socket(void)
+{
+    for (int i = 0; i < PNET_UDP_SOCKET_NUMOF; i++) {
+        if (!_udp_sockets[i].used) {
+            int res;
+
+            memset(&_udp_sockets[i], 0, sizeof(udp_socket_t));
+            _udp_sockets[i].ep.netreg.pid = KERNEL_PID_UNDEF;
+
+            if ((res = fd_new(i, _udp_read, _udp_write, _udp_close)) >= 0) {
+                _udp_sockets[i].used = 1;
+            }
+
+            return res;
+        }
+    }
+
+    errno = ENFILE;
+    return -1;
+}
+
+#define udp_func_wrapper(func, sockfd, ...) \
+    if (_udp_socket_get(sockfd) != NULL) { \
+        return func(_udp_socket_get(sockfd), __VA_ARGS__); \
+    }
+#else
+#define udp_func_wrapper(func, sockfd, ...)
+#endif
+
+#ifdef MODULE_SOCKET_BASE
 int flagless_send(int fd, const void *buf, size_t len)
 {
     return (int)socket_base_send(fd, buf, (uint32_t)len, 0);
@@ -29,8 +262,32 @@ int flagless_recv(int fd, void *buf, size_t len)
     return (int)socket_base_recv(fd, buf, (uint32_t)len, 0);
 }
 
+#define sock_func_wrapper(func, sockfd, ...) \
+    ((fd_get(sockfd)) ? \
+        func(fd_get(sockfd)->internal_fd, __VA_ARGS__) : \
+        (errno = EBADF, -1))
+#else
+/* without socket_base there are only UDP sockets */
+static int _no_socket_base(int sockfd, ...)
+{
+    (void)sockfd;
+    errno = EBADF;
+    return -1;
+}
+
+#define sock_func_wrapper(func, sockfd, ...) \
+    _no_socket_base(sockfd, __VA_ARGS__)
+#endif
+
 int socket(int domain, int type, int protocol)
 {
+#ifdef MODULE_NG_UDP_EP
+    if ((domain == AF_INET6) && (type == SOCK_DGRAM) &&
+        ((protocol == 0) || (protocol == IPPROTO_UDP))) {
+        return _udp_socket();
+    }
+#endif
+#ifdef MODULE_SOCKET_BASE
     int internal_socket = socket_base_socket(domain, type, protocol);
 
     if (internal_socket < 0) {
@@ -40,17 +297,19 @@ int socket(int domain, int type, int protocol)
 
     return fd_new(internal_socket, flagless_recv, flagless_send,
                   socket_base_close);
+#else
+    (void)domain;
+    (void)type;
+    (void)protocol;
+    errno = EPROTONOSUPPORT;
+    return -1;
+#endif
 }
 
-
-#define sock_func_wrapper(func, sockfd, ...) \
-    ((fd_get(sockfd)) ? \
-        func(fd_get(sockfd)->internal_fd, __VA_ARGS__) : \
-        (errno = EBADF, -1))
-
 int accept(int socket, struct sockaddr *restrict address,
            socklen_t *restrict address_len)
 {
+#ifdef MODULE_SOCKET_BASE
     int res = sock_func_wrapper(socket_base_accept, socket,
                                 (sockaddr6_t *)address,
                                 (socklen_t *)address_len);
@@ -63,10 +322,21 @@ int accept(int socket, struct sockaddr *restrict address,
 
     return fd_new(res, flagless_recv, flagless_send,
                   socket_base_close);
+#else
+    /* UDP sockets can not accept connections */
+    (void)socket;
+    (void)address;
+    (void)address_len;
+    errno = EOPNOTSUPP;
+    return -1;
+#endif
 }
 
 int bind(int socket, const struct sockaddr *address, socklen_t address_len)
 {
+    udp_func_wrapper(_udp_bind, socket, (const sockaddr6_t *)address,
+                     address_len);
+
     int res = sock_func_wrapper(socket_base_bind, socket,
                                 (sockaddr6_t *)address, address_len);
 
@@ -81,6 +351,9 @@ int bind(int socket, const struct sockaddr *address, socklen_t address_len)
 
 int connect(int socket, const struct sockaddr *address, socklen_t address_len)
 {
+    udp_func_wrapper(_udp_connect, socket, (const sockaddr6_t *)address,
+                     address_len);
+
     int res = sock_func_wrapper(socket_base_connect, socket,
                                 (sockaddr6_t *)address, address_len);
 
@@ -121,6 +394,8 @@ int listen(int socket, int backlog)
 
 ssize_t recv(int socket, void *buffer, size_t length, int flags)
 {
+    udp_func_wrapper(_udp_recvfrom, socket, buffer, length, NULL, NULL);
+
     int32_t res = sock_func_wrapper(socket_base_recv, socket, buffer,
                                     (uint32_t) length, flags);
 
@@ -137,6 +412,9 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
                  struct sockaddr *restrict address,
                  socklen_t *restrict address_len)
 {
+    udp_func_wrapper(_udp_recvfrom, socket, buffer, length,
+                     (sockaddr6_t *)address, (socklen_t *)address_len);
+
     int32_t res = sock_func_wrapper(socket_base_recvfrom, socket, buffer,
                                     (uint32_t) length, flags,
                                     (sockaddr6_t *)address,
@@ -153,6 +431,8 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
 
 ssize_t send(int socket, const void *buffer, size_t length, int flags)
 {
+    udp_func_wrapper(_udp_sendto, socket, buffer, length, NULL, 0);
+
     int32_t res = sock_func_wrapper(socket_base_send, socket, buffer,
                                     (uint32_t) length, flags);
 
@@ -168,6 +448,9 @@ ssize_t send(int socket, const void *buffer, size_t length, int flags)
 ssize_t sendto(int socket, const void *message, size_t length, int flags,
                const struct sockaddr *dest_addr, socklen_t dest_len)
 {
+    udp_func_wrapper(_udp_sendto, socket, message, length,
+                     (const sockaddr6_t *)dest_addr, dest_len);
+
     int32_t res = sock_func_wrapper(socket_base_sendto, socket, message,
                                     (uint32_t) length, flags,
                                     (sockaddr6_t *)dest_addr,
@@ -19,6 +19,9 @@
 #include "msg.h"
 
 #include "posix_io.h"
+#ifdef MODULE_UART0_DIRECT
+#include "board_uart0.h"
+#endif
 
 
 static int _posix_fileop(kernel_pid_t pid, int op, int flags)
@@ -47,20 +50,40 @@ static int _posix_fileop_data(kernel_pid_t pid, int op, char *buffer, int nbytes
 
 int posix_open(int pid, int flags)
 {
+#ifdef MODULE_UART0_DIRECT
+    if (pid == uart0_handler_pid) {
+        return 0;
+    }
+#endif
     return _posix_fileop((kernel_pid_t) pid, OPEN, flags);
 }
 
 int posix_close(int pid)
 {
+#ifdef MODULE_UART0_DIRECT
+    if (pid == uart0_handler_pid) {
+        return 0;
+    }
+#endif
     return _posix_fileop((kernel_pid_t) pid, CLOSE, 0);
 }
 
 int posix_read(int pid, char *buffer, int bufsize)
 {
+#ifdef MODULE_UART0_DIRECT
+    if (pid == uart0_handler_pid) {
+        return uart0_read(buffer, bufsize);
+    }
+#endif
     return _posix_fileop_data((kernel_pid_t) pid, READ, buffer, bufsize);
 }
 
 int posix_write(int pid, char *buffer, int bufsize)
 {
+#ifdef MODULE_UART0_DIRECT
+    if (pid == uart0_handler_pid) {
+        return uart0_write(buffer, bufsize);
+    }
+#endif
     return _posix_fileop_data((kernel_pid_t) pid, WRITE, buffer, bufsize);
 }
@@ -32,7 +32,7 @@ int close(int fildes)
         return -1;
     }
 
-    fd_destroy(fd_obj->internal_fd);
+    fd_destroy(fildes);
 
     return 0;
 }
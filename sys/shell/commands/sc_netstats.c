@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands.h
+ * @{
+ *
+ * @file
+ * @brief       Shell command printing the statistics of network modules
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/ng_netapi.h"
+#include "net/ng_netstats.h"
+
+static const char *_drop_names[NG_NETSTATS_DROP_NUMOF] = {
+    "queue", "nobuf", "csum", "noroute", "hoplim", "reass", "txfail"
+};
+
+int _netstats(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    puts("module   pid  packets  queue  lat_avg  lat_max  drops");
+
+    for (ng_netstats_t *entry = ng_netstats_list(); entry != NULL;
+         entry = entry->next) {
+        ng_netstats_t stats;
+
+        /* get a consistent copy from the module itself */
+        if (ng_netapi_get(entry->pid, NETCONF_OPT_STATS, 0, &stats,
+                          sizeof(stats)) < 0) {
+            printf("%-7s %4" PRIkernel_pid "  error\n", entry->name, entry->pid);
+            continue;
+        }
+
+        printf("%-7s %4" PRIkernel_pid " %8" PRIu32 " %6u %8" PRIu32 " %8"
+               PRIu32 " ", entry->name, entry->pid, stats.packets,
+               (unsigned)stats.queue_max,
+               (stats.packets > 0) ? (stats.latency_sum / stats.packets) : 0,
+               stats.latency_max);
+        for (unsigned i = 0; i < NG_NETSTATS_DROP_NUMOF; i++) {
+            if (stats.drops[i] > 0) {
+                printf(" %s:%" PRIu32, _drop_names[i], stats.drops[i]);
+            }
+        }
+        puts("");
+    }
+
+    return 0;
+}
+
+/**
+ * @}
+ */
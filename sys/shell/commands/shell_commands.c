@@ -169,6 +169,10 @@ extern int _netif_send(int argc, char **argv);
 extern int _fib_route_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_NG_NETSTATS
+extern int _netstats(int argc, char **argv);
+#endif
+
 #ifdef MODULE_NG_IPV6_NC
 extern int _ipv6_nc_manage(int argc, char **argv);
 extern int _ipv6_nc_routers(int argc, char **argv);
@@ -283,6 +287,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_FIB
     {"fibroute", "Manipulate the FIB (info: 'fibroute [add|del]')", _fib_route_handler},
 #endif
+#ifdef MODULE_NG_NETSTATS
+    {"netstats", "network stack statistics", _netstats },
+#endif
 #ifdef MODULE_NG_IPV6_NC
     {"ncache", "manage neighbor cache by hand", _ipv6_nc_manage },
     {"routers", "IPv6 default router list", _ipv6_nc_routers },
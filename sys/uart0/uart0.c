@@ -28,6 +28,7 @@
 #include "msg.h"
 #include "posix_io.h"
 #include "irq.h"
+#include "mutex.h"
 
 #include "board_uart0.h"
 
@@ -43,6 +44,52 @@ kernel_pid_t uart0_handler_pid = KERNEL_PID_UNDEF;
 
 static char buffer[UART0_BUFSIZE];
 
+void uart0_handle_incoming(int c)
+{
+    ringbuffer_add_one(&uart0_ringbuffer, c);
+}
+
+#ifdef MODULE_UART0_DIRECT
+/* locked while the ringbuffer is empty, unlocked by uart0_notify_thread() */
+static mutex_t rx_wait = MUTEX_INIT;
+
+void board_uart0_init(void)
+{
+    ringbuffer_init(&uart0_ringbuffer, buffer, UART0_BUFSIZE);
+    mutex_lock(&rx_wait);
+    /* there is no thread, the PID only has to differ from KERNEL_PID_UNDEF
+     * for the interrupt handlers and identifies the UART to posix_read() and
+     * friends */
+    uart0_handler_pid = thread_reserve_pid();
+    puts("uart0_init() [OK]");
+}
+
+void uart0_notify_thread(void)
+{
+    mutex_unlock(&rx_wait);
+}
+
+int uart0_read(char *buf, int n)
+{
+    if (n <= 0) {
+        return 0;
+    }
+
+    while (1) {
+        unsigned state = disableIRQ();
+
+        if (uart0_ringbuffer.avail) {
+            int res = ringbuffer_get(&uart0_ringbuffer, buf, n);
+            restoreIRQ(state);
+            return res;
+        }
+        restoreIRQ(state);
+        /* an earlier notification may have left the mutex unlocked while the
+         * ringbuffer is empty, so it is checked again after waking up */
+        mutex_lock(&rx_wait);
+    }
+}
+#else
 static char uart0_thread_stack[UART0_STACKSIZE];
 
 void board_uart0_init(void)
@@ -62,11 +109,6 @@ void board_uart0_init(void)
     puts("uart0_init() [OK]");
 }
 
-void uart0_handle_incoming(int c)
-{
-    ringbuffer_add_one(&uart0_ringbuffer, c);
-}
-
 void uart0_notify_thread(void)
 {
     msg_t m;
@@ -74,13 +116,27 @@ void uart0_notify_thread(void)
     msg_send_int(&m, uart0_handler_pid);
 }
 
+int uart0_read(char *buf, int n)
+{
+    return posix_read(uart0_handler_pid, buf, n);
+}
+#endif
+
 int uart0_readc(void)
 {
     char c = 0;
-    posix_read(uart0_handler_pid, &c, 1);
+    uart0_read(&c, 1);
     return c;
 }
 
+int uart0_write(const char *buf, int n)
+{
+    for (int i = 0; i < n; i++) {
+        uart0_putc(buf[i]);
+    }
+    return n;
+}
+
 int uart0_putc(int c)
 {
     return putchar(c);
@@ -401,6 +401,14 @@ void vtimer_set_msg(vtimer_t *t, timex_t interval, kernel_pid_t pid, uint16_t ty
     vtimer_set(t);
 }
 
+int vtimer_set_cb(vtimer_t *t, timex_t interval, void (*cb)(vtimer_t *), void *arg)
+{
+    t->action = cb;
+    t->arg = arg;
+    t->absolute = interval;
+    return vtimer_set(t);
+}
+
 int vtimer_msg_receive_timeout(msg_t *m, timex_t timeout) {
     msg_t timeout_message;
     timeout_message.type = MSG_TIMER;
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for the packet buffer of AODVv2
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "vtimer.h"
+
+#include "pktbuffer.h"
+#include "utils.h"
+
+#define PAYLOAD_LEN     (16U)
+
+static uint8_t buf[AODVV2_PKTBUFFER_SLOT_SIZE + 1];
+static ipv6_hdr_t *packet = (ipv6_hdr_t *)buf;
+
+static void _set_dest(uint8_t dest)
+{
+    memset(&packet->destaddr, 0, sizeof(packet->destaddr));
+    packet->destaddr.uint8[0] = 0x20;
+    packet->destaddr.uint8[1] = 0x01;
+    packet->destaddr.uint8[2] = 0x0d;
+    packet->destaddr.uint8[3] = 0xb8;
+    packet->destaddr.uint8[15] = dest;
+}
+
+static int _add(uint8_t dest, uint16_t payload_len)
+{
+    _set_dest(dest);
+    packet->length = HTONS(payload_len);
+    return pktbuffer_add(packet);
+}
+
+static void _flush(uint8_t dest)
+{
+    struct netaddr addr;
+
+    _set_dest(dest);
+    ipv6_addr_t_to_netaddr(&packet->destaddr, &addr);
+    pktbuffer_flush(&addr);
+}
+
+static int _pending(uint8_t dest)
+{
+    _set_dest(dest);
+    return pktbuffer_is_pending(&packet->destaddr);
+}
+
+static int _check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAILED: %s\n", what);
+    }
+    return cond;
+}
+
+int main(void)
+{
+    unsigned dest, queued = 0;
+    int ok = 1;
+
+    puts("AODVv2 packet buffer test");
+
+    memset(buf, 0, sizeof(buf));
+    packet->version_trafficclass = 0x60;
+    pktbuffer_init();
+
+    ok &= _check(!_pending(1), "nothing pending after init");
+    ok &= _check(_add(1, PAYLOAD_LEN) == 0, "buffer a packet");
+    ok &= _check(_pending(1), "destination pending");
+    ok &= _check(_add(2, AODVV2_PKTBUFFER_SLOT_SIZE - sizeof(ipv6_hdr_t) + 1) < 0,
+                 "drop a packet larger than a slot");
+    ok &= _check(!_pending(2), "destination of a dropped packet not pending");
+
+    /* fill the pool, the last destination with room takes the rest */
+    queued = 1;
+    for (dest = 1; queued < AODVV2_PKTBUFFER_SLOTS; dest++) {
+        unsigned n = (dest == 1) ? 1 : 0;
+
+        for (; (n < AODVV2_PKTBUFFER_LEN) && (queued < AODVV2_PKTBUFFER_SLOTS); n++) {
+            ok &= _check(_add(dest, PAYLOAD_LEN) == 0, "fill the pool");
+            queued++;
+        }
+    }
+    ok &= _check(_add(dest, PAYLOAD_LEN) < 0, "drop a packet on a full pool");
+    ok &= _check(!_pending(dest), "new destination not pending on a full pool");
+
+    /* a full destination makes room for its newest packet itself */
+    ok &= _check(_add(1, PAYLOAD_LEN) == 0, "replace the oldest packet");
+
+    /* sending the packets returns their slots */
+    _flush(1);
+    ok &= _check(!_pending(1), "destination not pending after flush");
+    for (unsigned n = 0; n < AODVV2_PKTBUFFER_LEN; n++) {
+        ok &= _check(_add(dest, PAYLOAD_LEN) == 0, "reuse the slots");
+    }
+
+    /* failed route discoveries drop their packets */
+    vtimer_usleep((AODVV2_RREQ_WAIT_TIME + 1) * 1000U * 1000U);
+    ok &= _check(!_pending(dest), "destination not pending after timeout");
+    for (unsigned n = 0; n < AODVV2_PKTBUFFER_SLOTS; n++) {
+        ok &= _check(_add(AODVV2_PKTBUFFER_DESTS + 1 + n / AODVV2_PKTBUFFER_LEN,
+                          PAYLOAD_LEN) == 0, "reuse the slots after timeout");
+    }
+
+    puts(ok ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,13 @@
+#! /usr/bin/env python
+
+import sys
+from pexpect import spawn
+
+if __name__ == "__main__":
+    term = spawn("bin/native/aodvv2_pktbuffer.elf", timeout=10)
+
+    term.expect("SUCCESS")
+
+    if not term.terminate():
+        term.terminate(force=True)
+    sys.exit(0)
@@ -22,7 +22,11 @@
  * @{
  *
  * @file
- * @brief     Measure the speed of the function in bitarithm.c
+ * @brief     Measure the speed of the functions in bitarithm.h
+ *
+ * The functions selected for the CPU are compared against the table-driven
+ * fallbacks and against the shift loops bitarithm used to have, so the
+ * output shows the gain on each CPU family.
  *
  * @author    René Kijewski <rene.kijewski@fu-berlin.de>
  *
@@ -39,6 +43,58 @@
 #define TIMEOUT (HWTIMER_TICKS(TIMEOUT_US))
 #define PER_ITERATION (4)
 
+/* reference: former implementations, one bit per loop iteration */
+static unsigned loop_msb(unsigned v)
+{
+    unsigned r = 0;
+
+    while (v >>= 1) {
+        r++;
+    }
+
+    return r;
+}
+
+static unsigned loop_lsb(unsigned v)
+{
+    unsigned r = 0;
+
+    while ((v & 0x01) == 0) {
+        v >>= 1;
+        r++;
+    }
+
+    return r;
+}
+
+static unsigned loop_bits_set(unsigned v)
+{
+    unsigned c;
+
+    for (c = 0; v; c++) {
+        v &= v - 1;
+    }
+
+    return c;
+}
+
+/* wrappers, so the inline functions are called through a pointer like the
+ * others */
+static unsigned inline_msb(unsigned v)
+{
+    return bitarithm_msb(v);
+}
+
+static unsigned inline_lsb(unsigned v)
+{
+    return bitarithm_lsb(v);
+}
+
+static unsigned inline_bits_set(unsigned v)
+{
+    return bitarithm_bits_set(v);
+}
+
 static void callback(void *done_)
 {
     volatile int *done = done_;
@@ -81,9 +137,18 @@ int main(void)
 {
     printf("Start.\r\n");
 
-    run_test(bitarithm_msb);
-    run_test(bitarithm_lsb);
-    run_test(bitarithm_bits_set);
+    printf("CLZ: %i, popcount: %i\r\n", BITARITHM_HAS_CLZ,
+           BITARITHM_HAS_POPCOUNT);
+
+    run_test(loop_msb);
+    run_test(bitarithm_msb_generic);
+    run_test(inline_msb);
+    run_test(loop_lsb);
+    run_test(bitarithm_lsb_generic);
+    run_test(inline_lsb);
+    run_test(loop_bits_set);
+    run_test(bitarithm_bits_set_generic);
+    run_test(inline_bits_set);
 
     printf("Done.\r\n");
     return 0;
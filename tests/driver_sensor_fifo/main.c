@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for sensor FIFO batching, with a model of the
+ *          L3G4200D on the native I2C bus
+ *
+ * @author  Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "irq.h"
+#include "hwtimer.h"
+#include "native_i2c.h"
+#include "periph/gpio.h"
+#include "l3g4200d.h"
+#include "l3g4200d-regs.h"
+#include "sensor_fifo.h"
+
+#define TEST_I2C        (I2C_0)
+#define TEST_ADDR       (0x68)
+#define TEST_INT        (GPIO(0, 0))
+#define TEST_DRDY       (GPIO(0, 1))
+
+#define MODE            L3G4200D_MODE_800_50
+#define SCALE           L3G4200D_SCALE_500DPS
+#define SCALE_DPS       (500)
+
+#define WATERMARK       (16U)
+#define BLOCK           (64U)
+#define BLOCKS          (4U)
+
+/* 800 Hz, produced in batches of 8 samples every 10 ms */
+#define TICK_US         (10000U)
+#define TICK_SAMPLES    (8U)
+
+/**
+ * @brief   Model of the L3G4200D registers and FIFO
+ */
+static struct {
+    uint8_t regs[0x40];
+    int16_t fifo[L3G4200D_FIFO_SIZE][3];
+    unsigned head;
+    unsigned level;
+    unsigned ovrn;
+    unsigned produced;
+} gyro;
+
+static native_i2c_slave_t slave;
+static unsigned transactions;
+static gpio_cb_t drdy_cb;
+static void *drdy_arg;
+
+static l3g4200d_t dev;
+static sensor_fifo_t fifo;
+static l3g4200d_data_t buf[BLOCK];
+
+/* the board has no GPIOs, the model raises the interrupt itself */
+int gpio_init_int(gpio_t pin, gpio_pp_t pullup, gpio_flank_t flank,
+                  gpio_cb_t cb, void *arg)
+{
+    (void)pullup;
+    (void)flank;
+
+    if (pin != TEST_DRDY) {
+        return -1;
+    }
+    drdy_cb = cb;
+    drdy_arg = arg;
+    return 0;
+}
+
+static int16_t _raw(unsigned n, unsigned axis)
+{
+    return (int16_t)(n * (37 + axis * 11));
+}
+
+static int _streaming(void)
+{
+    return (gyro.regs[L3G4200D_REG_CTRL5] & L3G4200D_CTRL5_FIFO_EN) &&
+           ((gyro.regs[L3G4200D_REG_FIFO_CTRL] & ~L3G4200D_FIFO_CTRL_WTM_MASK) ==
+            L3G4200D_FIFO_CTRL_STREAM);
+}
+
+static void _produce(void *arg)
+{
+    unsigned wtm = gyro.regs[L3G4200D_REG_FIFO_CTRL] & L3G4200D_FIFO_CTRL_WTM_MASK;
+    unsigned before = gyro.level;
+
+    (void)arg;
+
+    if (_streaming()) {
+        for (unsigned i = 0; i < TICK_SAMPLES; i++) {
+            unsigned tail = (gyro.head + gyro.level) % L3G4200D_FIFO_SIZE;
+
+            for (unsigned axis = 0; axis < 3; axis++) {
+                gyro.fifo[tail][axis] = _raw(gyro.produced, axis);
+            }
+            gyro.produced++;
+            if (gyro.level < L3G4200D_FIFO_SIZE) {
+                gyro.level++;
+            }
+            else {
+                /* stream mode drops the oldest sample */
+                gyro.head = (gyro.head + 1) % L3G4200D_FIFO_SIZE;
+                gyro.ovrn = 1;
+            }
+        }
+        if ((before < wtm) && (gyro.level >= wtm) &&
+            (gyro.regs[L3G4200D_REG_CTRL3] & L3G4200D_CTRL3_I2_WTM) &&
+            (drdy_cb != NULL)) {
+            drdy_cb(drdy_arg);
+        }
+    }
+
+    hwtimer_set(HWTIMER_TICKS(TICK_US), _produce, NULL);
+}
+
+static int _read(native_i2c_slave_t *s, uint8_t reg, char *data, int len)
+{
+    unsigned state = disableIRQ();
+    int autoinc = reg & L3G4200D_AUTOINC;
+
+    (void)s;
+    transactions++;
+    reg &= ~L3G4200D_AUTOINC;
+
+    if ((reg == L3G4200D_REG_OUT_X_L) && autoinc && _streaming()) {
+        /* burst from the FIFO, wrapping at OUT_Z_H */
+        for (int i = 0; i < len; i += 6) {
+            for (unsigned axis = 0; axis < 3; axis++) {
+                int16_t v = gyro.fifo[gyro.head][axis];
+
+                data[i + 2 * axis] = (char)(v & 0xff);
+                data[i + 2 * axis + 1] = (char)((v >> 8) & 0xff);
+            }
+            if (gyro.level > 0) {
+                gyro.head = (gyro.head + 1) % L3G4200D_FIFO_SIZE;
+                gyro.level--;
+                gyro.ovrn = 0;
+            }
+        }
+    }
+    else if (reg == L3G4200D_REG_FIFO_SRC) {
+        unsigned wtm = gyro.regs[L3G4200D_REG_FIFO_CTRL] & L3G4200D_FIFO_CTRL_WTM_MASK;
+
+        data[0] = (gyro.level == 0) ? L3G4200D_FIFO_SRC_EMPTY :
+                  ((gyro.level >= wtm) ? L3G4200D_FIFO_SRC_WTM : 0);
+        if (gyro.level == L3G4200D_FIFO_SIZE) {
+            data[0] |= L3G4200D_FIFO_SRC_OVRN | (L3G4200D_FIFO_SIZE - 1);
+        }
+        else {
+            data[0] |= gyro.level;
+        }
+    }
+    else {
+        for (int i = 0; i < len; i++) {
+            data[i] = gyro.regs[(reg + (autoinc ? i : 0)) % sizeof(gyro.regs)];
+        }
+    }
+
+    restoreIRQ(state);
+    return len;
+}
+
+static int _write(native_i2c_slave_t *s, uint8_t reg, const char *data, int len)
+{
+    unsigned state = disableIRQ();
+    int autoinc = reg & L3G4200D_AUTOINC;
+
+    (void)s;
+    transactions++;
+    reg &= ~L3G4200D_AUTOINC;
+
+    for (int i = 0; i < len; i++) {
+        gyro.regs[(reg + (autoinc ? i : 0)) % sizeof(gyro.regs)] = data[i];
+    }
+    if ((reg == L3G4200D_REG_FIFO_CTRL) &&
+        ((data[0] & ~L3G4200D_FIFO_CTRL_WTM_MASK) == L3G4200D_FIFO_CTRL_BYPASS)) {
+        gyro.head = gyro.level = gyro.ovrn = gyro.produced = 0;
+    }
+
+    restoreIRQ(state);
+    return len;
+}
+
+int main(void)
+{
+    unsigned next = 0;
+    int failed = 0;
+
+    puts("Sensor FIFO batching test application\n");
+
+    slave.addr = TEST_ADDR;
+    slave.read = _read;
+    slave.write = _write;
+    native_i2c_attach(TEST_I2C, &slave);
+
+    if (l3g4200d_init(&dev, TEST_I2C, TEST_ADDR, TEST_INT, TEST_DRDY, MODE,
+                      SCALE) < 0) {
+        puts("l3g4200d_init failed");
+        return 1;
+    }
+    if (l3g4200d_fifo_init(&dev, &fifo, WATERMARK) < 0) {
+        puts("l3g4200d_fifo_init failed");
+        return 1;
+    }
+    hwtimer_set(HWTIMER_TICKS(TICK_US), _produce, NULL);
+    puts("started");
+
+    for (unsigned block = 0; block < BLOCKS; block++) {
+        unsigned t0 = transactions, b0 = fifo.bursts;
+
+        if (sensor_fifo_read(&fifo, buf, BLOCK) != BLOCK) {
+            puts("sensor_fifo_read failed");
+            return 1;
+        }
+        printf("block %u: %u samples, %u bursts, %u transactions\n", block,
+               BLOCK, (unsigned)(fifo.bursts - b0), transactions - t0);
+
+        for (unsigned i = 0; i < BLOCK; i++, next++) {
+            int16_t v[3] = { buf[i].acc_x, buf[i].acc_y, buf[i].acc_z };
+
+            for (unsigned axis = 0; axis < 3; axis++) {
+                int16_t expect = (int16_t)((SCALE_DPS * _raw(next, axis)) / 0x7fff);
+
+                if (v[axis] != expect) {
+                    printf("sample %u axis %u: got %i, expected %i\n", next,
+                           axis, v[axis], expect);
+                    failed = 1;
+                }
+            }
+        }
+        if (gyro.ovrn) {
+            puts("FIFO overrun");
+            failed = 1;
+        }
+    }
+
+    puts(failed ? "FAILURE" : "SUCCESS");
+    return 0;
+}
@@ -0,0 +1,23 @@
+#! /usr/bin/env python
+
+import sys
+from pexpect import spawn
+
+if __name__ == "__main__":
+    term = spawn("bin/native/driver_sensor_fifo.elf", timeout=10)
+
+    term.expect("started")
+    for block in range(4):
+        term.expect(r"block %d: (\d+) samples, (\d+) bursts, (\d+) transactions"
+                    % block)
+        samples = int(term.match.group(1))
+        transactions = int(term.match.group(3))
+        if transactions * 4 > samples:
+            print("block %d: too many bus transactions" % block)
+            sys.exit(1)
+
+    term.expect("SUCCESS")
+
+    if not term.terminate():
+        term.terminate(force=True)
+    sys.exit(0)
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for the order of posted and delayed events
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "event.h"
+#include "vtimer.h"
+
+#define RAN_LEN         (32)
+#define MS              (1000U)
+/* more timeouts than the event thread's message queue holds */
+#define BURST_NUMOF     (EVENT_MSG_QUEUE_SIZE + 4)
+
+static char ran[RAN_LEN];
+static unsigned ran_len;
+
+static void _record(void *arg)
+{
+    if (ran_len < RAN_LEN - 1) {
+        ran[ran_len++] = *(const char *)arg;
+    }
+}
+
+static void _ran_reset(void)
+{
+    memset(ran, 0, sizeof(ran));
+    ran_len = 0;
+}
+
+static int _check(const char *expected, const char *what)
+{
+    if (strcmp(ran, expected) != 0) {
+        printf("FAILED: %s, ran \"%s\" instead of \"%s\"\n", what, ran,
+               expected);
+        return 0;
+    }
+    return 1;
+}
+
+static event_t ev_a = { .handler = _record, .arg = "a" };
+static event_t ev_b = { .handler = _record, .arg = "b" };
+static event_t ev_c = { .handler = _record, .arg = "c" };
+static event_t ev_d = { .handler = _record, .arg = "d" };
+
+static event_timeout_t to_a, to_b, to_c, to_d;
+
+/* posts from the event thread, so nothing runs before it returns */
+static void _post_cancel(void *arg)
+{
+    (void)arg;
+    event_post(&ev_a);
+    event_post(&ev_b);
+    event_post(&ev_c);
+    event_post(&ev_a);
+    event_cancel(&ev_b);
+    event_post(&ev_d);
+    event_cancel(&ev_d);
+    event_post(&ev_d);
+}
+
+static event_t ev_post_cancel = { .handler = _post_cancel };
+
+/* blocks the event thread while the burst of timeouts expires */
+static void _block(void *arg)
+{
+    (void)arg;
+    vtimer_usleep(50 * MS);
+}
+
+static event_t ev_block = { .handler = _block };
+static char burst_names[BURST_NUMOF];
+static event_t ev_burst[BURST_NUMOF];
+static event_timeout_t to_burst[BURST_NUMOF];
+
+int main(void)
+{
+    char expected[BURST_NUMOF + 1];
+    int ok = 1;
+
+    puts("event test");
+
+    /* handlers run in the order of the posts, a queued event is queued only
+     * once and a cancelled one does not run */
+    _ran_reset();
+    event_post(&ev_post_cancel);
+    vtimer_usleep(10 * MS);
+    ok &= _check("acd", "post and cancel");
+
+    /* timeouts run in the order they expire, not the order they were set */
+    _ran_reset();
+    event_timeout_set(&to_a, &ev_a, timex_set(0, 30 * MS));
+    event_timeout_set(&to_b, &ev_b, timex_set(0, 10 * MS));
+    event_timeout_set(&to_c, &ev_c, timex_set(0, 20 * MS));
+    vtimer_usleep(50 * MS);
+    ok &= _check("bca", "timeout order");
+
+    /* a cleared timeout does not post, setting it again replaces the delay */
+    _ran_reset();
+    event_timeout_set(&to_a, &ev_a, timex_set(0, 10 * MS));
+    event_timeout_clear(&to_a);
+    event_timeout_set(&to_b, &ev_b, timex_set(0, 10 * MS));
+    event_timeout_set(&to_b, &ev_b, timex_set(0, 40 * MS));
+    event_timeout_set(&to_c, &ev_c, timex_set(0, 20 * MS));
+    event_timeout_set(&to_d, &ev_d, timex_set(0, 30 * MS));
+    vtimer_usleep(20 * MS + 5 * MS);
+    ok &= _check("c", "timeout clear and replace, before");
+    vtimer_usleep(30 * MS);
+    ok &= _check("cdb", "timeout clear and replace, after");
+
+    /* all timeouts of a burst run, even when more of them expire while a
+     * handler blocks than the message queue of the event thread holds */
+    _ran_reset();
+    for (unsigned i = 0; i < BURST_NUMOF; i++) {
+        burst_names[i] = 'A' + i;
+        expected[i] = burst_names[i];
+        ev_burst[i].handler = _record;
+        ev_burst[i].arg = &burst_names[i];
+        event_timeout_set(&to_burst[i], &ev_burst[i],
+                          timex_set(0, (10 + i) * MS));
+    }
+    expected[BURST_NUMOF] = '\0';
+    event_post(&ev_block);
+    vtimer_usleep(100 * MS);
+    ok &= _check(expected, "timeout burst");
+
+    puts(ok ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Speed of the fix16_dsp kernels compared to plain
+ *              libfixmath, tests/unittests/tests-fix16_dsp checks their
+ *              accuracy
+ *
+ * @author      René Kijewski <rene.kijewski@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "fix16.h"
+#include "fix16_dsp.h"
+
+#define BLOCK       (64)
+#define TAPS        (16)
+
+static fix16_t a[BLOCK], b[BLOCK], out[BLOCK];
+static int16_t raw[BLOCK];
+static fix16_t coeffs[TAPS], state[2 * TAPS], window[TAPS];
+static int16_t coeffs_q15[TAPS], state_q15[2 * TAPS];
+static fix16_t gyro[BLOCK][3];
+static fix16_dsp_fir_t fir;
+static fix16_dsp_fir_q15_t fir_q15;
+static fix16_dsp_quat_t quat;
+static volatile fix16_t sink;
+
+static uint32_t _rand_state = 1;
+
+static int32_t _rand(void)
+{
+    _rand_state = _rand_state * 1103515245 + 12345;
+    return (int32_t)_rand_state;
+}
+
+static void _init(void)
+{
+    for (unsigned i = 0; i < BLOCK; i++) {
+        a[i] = _rand() >> 12;
+        b[i] = _rand() >> 14;
+        raw[i] = (int16_t)(_rand() >> 16);
+        gyro[i][0] = _rand() >> 15;
+        gyro[i][1] = _rand() >> 15;
+        gyro[i][2] = _rand() >> 15;
+    }
+    for (unsigned i = 0; i < TAPS; i++) {
+        coeffs[i] = fix16_one / TAPS;
+        coeffs_q15[i] = 0x8000 / TAPS;
+    }
+    fix16_dsp_fir_init(&fir, coeffs, state, TAPS);
+    fix16_dsp_fir_q15_init(&fir_q15, coeffs_q15, state_q15, TAPS);
+    quat.w = fix16_one;
+    quat.x = quat.y = quat.z = 0;
+}
+
+static fix16_t _dot_ref(const fix16_t *x, const fix16_t *y, unsigned n)
+{
+    fix16_t acc = 0;
+
+    for (unsigned i = 0; i < n; i++) {
+        acc = fix16_add(acc, fix16_mul(x[i], y[i]));
+    }
+    return acc;
+}
+
+static int32_t _abs(int32_t v)
+{
+    return (v < 0) ? -v : v;
+}
+
+static void bench_mul_libfixmath(void)
+{
+    for (unsigned i = 0; i < BLOCK; i++) {
+        out[i] = fix16_mul(a[i], b[i]);
+    }
+}
+
+static void bench_mul(void)
+{
+    fix16_dsp_mul(out, a, b, BLOCK);
+}
+
+static void bench_dot_libfixmath(void)
+{
+    sink = _dot_ref(a, b, BLOCK);
+}
+
+static void bench_dot(void)
+{
+    sink = fix16_dsp_dot(a, b, BLOCK);
+}
+
+static void bench_fir_libfixmath(void)
+{
+    /* shift the window by one sample each time */
+    for (unsigned i = 0; i < BLOCK; i++) {
+        for (unsigned j = TAPS - 1; j > 0; j--) {
+            window[j] = window[j - 1];
+        }
+        window[0] = a[i];
+        out[i] = _dot_ref(coeffs, window, TAPS);
+    }
+}
+
+static void bench_fir(void)
+{
+    fix16_dsp_fir(&fir, out, a, BLOCK);
+}
+
+static void bench_fir_q15(void)
+{
+    fix16_dsp_fir_q15(&fir_q15, out, raw, BLOCK);
+}
+
+static void bench_sqrt_libfixmath(void)
+{
+    for (unsigned i = 0; i < BLOCK; i++) {
+        out[i] = fix16_sqrt(_abs(a[i]));
+    }
+}
+
+static void bench_sqrt(void)
+{
+    for (unsigned i = 0; i < BLOCK; i++) {
+        out[i] = fix16_dsp_sqrt(_abs(a[i]));
+    }
+}
+
+static void bench_atan2_libfixmath(void)
+{
+    for (unsigned i = 0; i < BLOCK; i++) {
+        out[i] = fix16_atan2(a[i], b[i]);
+    }
+}
+
+static void bench_atan2(void)
+{
+    for (unsigned i = 0; i < BLOCK; i++) {
+        out[i] = fix16_dsp_atan2(a[i], b[i]);
+    }
+}
+
+static void bench_quat_integrate(void)
+{
+    fix16_dsp_quat_integrate(&quat, (const fix16_t (*)[3])gyro, BLOCK,
+                             fix16_one / 100);
+}
+
+static void _bench(const char *name, void (*func)(void))
+{
+    benchmark_result_t result;
+
+    benchmark_run(func, &result);
+    benchmark_print("fix16_dsp", name, &result);
+}
+
+int main(void)
+{
+    puts("fix16_dsp test application, times are per block of "
+         "64 samples\n");
+
+    _init();
+
+    _bench("mul_libfixmath", bench_mul_libfixmath);
+    _bench("mul", bench_mul);
+    _bench("dot_libfixmath", bench_dot_libfixmath);
+    _bench("dot", bench_dot);
+    _bench("fir_libfixmath", bench_fir_libfixmath);
+    _bench("fir", bench_fir);
+    _bench("fir_q15", bench_fir_q15);
+    _bench("sqrt_libfixmath", bench_sqrt_libfixmath);
+    _bench("sqrt", bench_sqrt);
+    _bench("atan2_libfixmath", bench_atan2_libfixmath);
+    _bench("atan2", bench_atan2);
+    _bench("quat_integrate", bench_quat_integrate);
+
+    puts("done");
+    return 0;
+}
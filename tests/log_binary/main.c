@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for the log_binary module
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "log.h"
+#include "vtimer.h"
+
+#define ENABLE_DEBUG    (1)
+#include "debug.h"
+
+/* longer than the thread writing the records needs for a full buffer */
+#define WAIT_US         (5 * LOG_BINARY_POLL_US)
+
+static const char text[] = "constant";
+
+int main(void)
+{
+    puts("log_binary test");
+
+    LOG_INFO("info: %d %u 0x%08x %c %s\n", -42, 42U, 0xdeadbeefU, 'x', text);
+    LOG_WARNING("max: %u %u %u %u %u %u %u %u\n", 1, 2, 3, 4, 5, 6, 7, 8);
+    LOG_ERROR("no arguments\n");
+    DEBUG("debug: %i\n", 7);
+    vtimer_usleep(WAIT_US);
+
+    /* the writing thread runs only while main sleeps, so the buffer
+     * overflows */
+    for (unsigned i = 0; i < LOG_BINARY_BUFSIZE; i++) {
+        LOG_INFO("burst %u\n", i);
+    }
+    vtimer_usleep(WAIT_US);
+
+    puts("SUCCESS");
+    fflush(stdout);
+    return 0;
+}
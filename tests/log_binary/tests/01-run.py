@@ -0,0 +1,27 @@
+#! /usr/bin/env python
+
+import os
+import sys
+from pexpect import spawn
+
+DECODER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                       "..", "..", "..", "dist", "tools", "log_binary",
+                       "log_binary.py")
+ELF = "bin/native/log_binary.elf"
+
+if __name__ == "__main__":
+    term = spawn("/bin/sh", ["-c", "%s | %s -l %s" % (ELF, DECODER, ELF)],
+                 timeout=10)
+
+    term.expect("log_binary test")
+    term.expect_exact("[INFO] info: -42 42 0xdeadbeef x constant")
+    term.expect_exact("[WARNING] max: 1 2 3 4 5 6 7 8")
+    term.expect_exact("[ERROR] no arguments")
+    term.expect_exact("[DEBUG] debug: 7")
+    term.expect_exact("[INFO] burst 0")
+    term.expect(r"\[WARNING\] log_binary: \d+ records dropped")
+    term.expect("SUCCESS")
+
+    if not term.terminate():
+        term.terminate(force=True)
+    sys.exit(0)
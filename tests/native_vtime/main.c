@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for the native virtual time mode
+ *
+ * Sleeps a full day in hourly steps, which should only take a fraction of
+ * a second of real time.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "vtimer.h"
+
+#define HOURS   (24U)
+
+int main(void)
+{
+    timex_t start, now;
+
+    puts("native virtual time test");
+
+    vtimer_now(&start);
+
+    for (unsigned h = 1; h <= HOURS; h++) {
+        vtimer_usleep(3600U * SEC_IN_USEC);
+        vtimer_now(&now);
+        now = timex_sub(now, start);
+        printf("hour %u: %" PRIu32 " s\n", h, now.seconds);
+    }
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,19 @@
+#! /usr/bin/env python
+
+import sys
+from pexpect import spawn
+
+if __name__ == "__main__":
+    term = spawn("bin/native/native_vtime.elf", timeout=10)
+
+    for hour in range(1, 25):
+        term.expect(r"hour %d: (\d+) s" % hour)
+        if int(term.match.group(1)) < hour * 3600:
+            print("woke up too early")
+            sys.exit(1)
+
+    term.expect("SUCCESS")
+
+    if not term.terminate():
+        term.terminate(force=True)
+    sys.exit(0)
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the CSMA/CA MAC layer on the native
+ *              medium
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "shell.h"
+#include "shell_commands.h"
+#include "posix_io.h"
+#include "board_uart0.h"
+#include "net/ng_csma.h"
+#include "net/ng_pktdump.h"
+#include "net/ng_netbase.h"
+
+/**
+ * @brief   Buffer size used by the shell
+ */
+#define SHELL_BUFSIZE           (64U)
+
+static int _csma_stats(int argc, char **argv)
+{
+    kernel_pid_t ifs[NG_NETIF_NUMOF];
+    size_t numof = ng_netif_get(ifs);
+    ng_csma_stats_t stats;
+
+    (void)argc;
+    (void)argv;
+    for (size_t i = 0; i < numof; i++) {
+        if (ng_csma_get_stats(ifs[i], &stats) < 0) {
+            continue;
+        }
+        printf("Iface %2" PRIkernel_pid "\n", ifs[i]);
+        printf("  TX frames: %" PRIu32 ", success: %" PRIu32 ", retries: %"
+               PRIu32 "\n", stats.tx_frames, stats.tx_success, stats.tx_retries);
+        printf("  dropped: no ACK: %" PRIu32 ", channel busy: %" PRIu32
+               ", queue full: %" PRIu32 "\n", stats.tx_noack, stats.tx_busy,
+               stats.tx_qfull);
+        printf("  RX frames: %" PRIu32 ", duplicates: %" PRIu32 ", ACKs sent: %"
+               PRIu32 "\n", stats.rx_frames, stats.rx_dups, stats.acks_sent);
+        printf("  duty cycle: %" PRIu32 "/%" PRIu32 " ms (%" PRIu32 " per mille)\n",
+               (uint32_t)(stats.tx_airtime / 1000), (uint32_t)(stats.uptime / 1000),
+               (stats.uptime > 0) ? (uint32_t)((stats.tx_airtime * 1000) / stats.uptime) : 0);
+    }
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "csma", "print statistics of the CSMA layer", _csma_stats },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    shell_t shell;
+    ng_netreg_entry_t dump;
+
+    puts("CSMA/CA MAC layer test");
+
+    /* register the pktdump thread */
+    puts("Register the packet dump thread for NG_NETTYPE_UNDEF packets");
+    dump.pid = ng_pktdump_getpid();
+    dump.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
+    ng_netreg_register(NG_NETTYPE_UNDEF, &dump);
+
+    /* start the shell */
+    puts("Initialization successful - starting the shell now");
+    (void) posix_open(uart0_handler_pid, 0);
+    shell_init(&shell, shell_commands, SHELL_BUFSIZE, uart0_readc, uart0_putc);
+    shell_run(&shell);
+
+    return 0;
+}
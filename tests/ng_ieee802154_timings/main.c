@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the speed of IEEE 802.15.4 header parsing and building
+ *
+ * The table-driven functions of ng_ieee802154 are compared against the
+ * field-by-field implementations the radio drivers used to have, for a mix
+ * of the addressing modes seen in practice.
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hwtimer.h"
+#include "net/ng_ieee802154.h"
+
+#define TIMEOUT_S       (5)
+#define TIMEOUT_US      (TIMEOUT_S * 1000 * 1000)
+#define TIMEOUT         (HWTIMER_TICKS(TIMEOUT_US))
+
+#define FRAMES_NUMOF    (4)
+
+static const uint8_t _src[] = { 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 };
+static const uint8_t _dst[] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+static const le_uint16_t _pan = { .u8 = { 0x23, 0x00 } };
+
+/* source and destination address lengths and FCF flags of the test frames */
+static const struct {
+    uint8_t src_len;
+    uint8_t dst_len;
+    uint8_t flags;
+} _frames[FRAMES_NUMOF] = {
+    { 2, 2, NG_IEEE802154_FCF_TYPE_DATA | NG_IEEE802154_FCF_PAN_COMP },
+    { 8, 8, NG_IEEE802154_FCF_TYPE_DATA | NG_IEEE802154_FCF_PAN_COMP },
+    { 8, 2, NG_IEEE802154_FCF_TYPE_DATA },
+    { 2, 8, NG_IEEE802154_FCF_TYPE_DATA | NG_IEEE802154_FCF_ACK_REQ },
+};
+
+static uint8_t _mhrs[FRAMES_NUMOF][NG_IEEE802154_MAX_HDR_LEN];
+
+/* reference: former implementations, one branch per field */
+static size_t loop_set_frame_hdr(uint8_t *buf, unsigned frame)
+{
+    size_t src_len = _frames[frame].src_len, dst_len = _frames[frame].dst_len;
+    size_t pos = 3;
+
+    buf[0] = _frames[frame].flags;
+    buf[1] = 0;
+    buf[pos++] = _pan.u8[0];
+    buf[pos++] = _pan.u8[1];
+    if (dst_len == 2) {
+        buf[1] |= NG_IEEE802154_FCF_DST_ADDR_SHORT;
+        buf[pos++] = _dst[1];
+        buf[pos++] = _dst[0];
+    }
+    else if (dst_len == 8) {
+        buf[1] |= NG_IEEE802154_FCF_DST_ADDR_LONG;
+        for (int i = 7; i >= 0; i--) {
+            buf[pos++] = _dst[i];
+        }
+    }
+    else {
+        return 0;
+    }
+    if (!(buf[0] & NG_IEEE802154_FCF_PAN_COMP)) {
+        buf[pos++] = _pan.u8[0];
+        buf[pos++] = _pan.u8[1];
+    }
+    if (src_len == 8) {
+        buf[1] |= NG_IEEE802154_FCF_SRC_ADDR_LONG;
+        for (int i = 7; i >= 0; i--) {
+            buf[pos++] = _src[i];
+        }
+    }
+    else {
+        buf[1] |= NG_IEEE802154_FCF_SRC_ADDR_SHORT;
+        buf[pos++] = _src[1];
+        buf[pos++] = _src[0];
+    }
+    buf[2] = 0;
+    return pos;
+}
+
+static size_t loop_get_addrs(const uint8_t *mhr, uint8_t *src, uint8_t *dst)
+{
+    uint8_t tmp, src_len, dst_len, pos;
+
+    tmp = mhr[1] & NG_IEEE802154_FCF_SRC_ADDR_MASK;
+    if (tmp == NG_IEEE802154_FCF_SRC_ADDR_SHORT) {
+        src_len = 2;
+    }
+    else if (tmp == NG_IEEE802154_FCF_SRC_ADDR_LONG) {
+        src_len = 8;
+    }
+    else if (tmp == 0) {
+        src_len = 0;
+    }
+    else {
+        return 0;
+    }
+    tmp = mhr[1] & NG_IEEE802154_FCF_DST_ADDR_MASK;
+    if (tmp == NG_IEEE802154_FCF_DST_ADDR_SHORT) {
+        dst_len = 2;
+    }
+    else if (tmp == NG_IEEE802154_FCF_DST_ADDR_LONG) {
+        dst_len = 8;
+    }
+    else if (tmp == 0) {
+        dst_len = 0;
+    }
+    else {
+        return 0;
+    }
+    if (dst_len > 0) {
+        pos = 5 + dst_len;
+        for (int i = 0; i < dst_len; i++) {
+            dst[i] = mhr[5 + (dst_len - i) - 1];
+        }
+    }
+    else {
+        pos = 3;
+    }
+    if (!(mhr[0] & NG_IEEE802154_FCF_PAN_COMP)) {
+        pos += 2;
+    }
+    for (int i = 0; i < src_len; i++) {
+        src[i] = mhr[pos + (src_len - i) - 1];
+    }
+    return pos + src_len;
+}
+
+/* wrappers, so all variants are called through a pointer */
+static size_t table_set_frame_hdr(uint8_t *buf, unsigned frame)
+{
+    return ng_ieee802154_set_frame_hdr(buf, _src, _frames[frame].src_len,
+                                       _dst, _frames[frame].dst_len, _pan,
+                                       _pan, _frames[frame].flags, 0);
+}
+
+static size_t table_get_addrs(const uint8_t *mhr, uint8_t *src, uint8_t *dst)
+{
+    ng_ieee802154_get_dst(mhr, dst, NULL);
+    ng_ieee802154_get_src(mhr, src, NULL);
+    return ng_ieee802154_get_frame_hdr_len(mhr);
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_set(const char *name, size_t (*test)(uint8_t *, unsigned))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    uint8_t buf[NG_IEEE802154_MAX_HDR_LEN];
+
+    hwtimer_set(TIMEOUT, callback, (void *) &done);
+    do {
+        for (unsigned i = 0; i < FRAMES_NUMOF; i++) {
+            volatile size_t r = test(buf, i);
+            (void) r;
+        }
+        ++count;
+    } while (done == 0);
+
+    printf("+ %s: %lu headers per second\r\n", name,
+           FRAMES_NUMOF * count / TIMEOUT_S);
+}
+
+static void run_get(const char *name,
+                    size_t (*test)(const uint8_t *, uint8_t *, uint8_t *))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    uint8_t src[8], dst[8];
+
+    hwtimer_set(TIMEOUT, callback, (void *) &done);
+    do {
+        for (unsigned i = 0; i < FRAMES_NUMOF; i++) {
+            volatile size_t r = test(_mhrs[i], src, dst);
+            (void) r;
+        }
+        ++count;
+    } while (done == 0);
+
+    printf("+ %s: %lu headers per second\r\n", name,
+           FRAMES_NUMOF * count / TIMEOUT_S);
+}
+
+#define run_set(test) run_set(#test, test)
+#define run_get(test) run_get(#test, test)
+
+int main(void)
+{
+    printf("Start.\r\n");
+
+    for (unsigned i = 0; i < FRAMES_NUMOF; i++) {
+        uint8_t ref[NG_IEEE802154_MAX_HDR_LEN];
+        size_t len = table_set_frame_hdr(_mhrs[i], i);
+
+        if ((loop_set_frame_hdr(ref, i) != len) ||
+            (memcmp(ref, _mhrs[i], len) != 0)) {
+            printf("Headers of frame %u differ.\r\n", i);
+            return 1;
+        }
+    }
+
+    run_set(loop_set_frame_hdr);
+    run_set(table_set_frame_hdr);
+    run_get(loop_get_addrs);
+    run_get(table_get_addrs);
+
+    printf("Done.\r\n");
+    return 0;
+}
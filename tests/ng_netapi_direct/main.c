@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for network modules running without a thread
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "net/ng_netapi.h"
+
+#define STACK_QUEUE_SIZE    (8U)
+#define MSG_TYPE_UNKNOWN    (0x1234)
+
+/**
+ * @brief   What a module without a thread was called with last
+ */
+typedef struct {
+    int value;              /**< returned for get and set */
+    unsigned calls;         /**< number of calls */
+    kernel_pid_t thread;    /**< thread of the last call */
+    uint16_t type;          /**< message type of the last call */
+    void *ptr;              /**< message content of the last call */
+} _mod_t;
+
+static _mod_t mod_a = { .value = 23 };
+static _mod_t mod_b = { .value = 42 };
+static _mod_t mod_runner = { .value = 5 };
+
+static char stack[THREAD_STACKSIZE_MAIN];
+static unsigned unknown;
+
+static ng_pktsnip_t pkt;
+
+static int _check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAILED: %s\n", what);
+    }
+    return cond;
+}
+
+static int _handler(void *ctx, msg_t *msg)
+{
+    _mod_t *mod = ctx;
+
+    switch (msg->type) {
+        case NG_NETAPI_MSG_TYPE_SND:
+        case NG_NETAPI_MSG_TYPE_RCV:
+        case NG_NETAPI_MSG_TYPE_GET:
+        case NG_NETAPI_MSG_TYPE_SET:
+            break;
+        default:
+            return -ENOTSUP;
+    }
+    mod->calls++;
+    mod->thread = thread_getpid();
+    mod->type = msg->type;
+    mod->ptr = msg->content.ptr;
+    return mod->value;
+}
+
+/* runs the stack, like the thread of a MAC layer */
+static void *_stack(void *arg)
+{
+    msg_t msg, queue[STACK_QUEUE_SIZE];
+
+    (void)arg;
+    msg_init_queue(queue, STACK_QUEUE_SIZE);
+    ng_netapi_direct_run(_handler, &mod_runner);
+
+    while (1) {
+        msg_receive(&msg);
+        if (!ng_netapi_direct_dispatch(&msg)) {
+            unknown++;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    kernel_pid_t me = thread_getpid(), pid_a, pid_b, stack_pid;
+    uint16_t val = 0;
+    msg_t msg;
+    int ok = 1;
+
+    puts("ng_netapi_direct test");
+
+    pid_a = ng_netapi_direct_register(_handler, &mod_a);
+    pid_b = ng_netapi_direct_register(_handler, &mod_b);
+    ok &= _check(pid_a != KERNEL_PID_UNDEF, "register a");
+    ok &= _check(pid_b != KERNEL_PID_UNDEF, "register b");
+    ok &= _check(pid_a != pid_b, "distinct PIDs");
+    ok &= _check(!pid_is_valid(pid_a) && (pid_a != KERNEL_PID_ISR),
+                 "PID names no thread");
+    ok &= _check(msg_send(&msg, pid_a) == -1, "plain msg_send() fails");
+
+    /* no thread runs the stack yet, the handlers are called directly */
+    ok &= _check(ng_netapi_send(pid_a, &pkt) == 1, "send, direct");
+    ok &= _check((mod_a.calls == 1) && (mod_a.thread == me) &&
+                 (mod_a.type == NG_NETAPI_MSG_TYPE_SND) && (mod_a.ptr == &pkt),
+                 "send reached a in the caller");
+    ok &= _check(ng_netapi_get(pid_b, NETCONF_OPT_CHANNEL, 0, &val,
+                               sizeof(val)) == mod_b.value, "get, direct");
+    ok &= _check((mod_b.calls == 1) && (mod_b.thread == me) &&
+                 (mod_b.type == NG_NETAPI_MSG_TYPE_GET), "get reached b");
+
+    /* a thread of higher priority runs the stack from now on, messages from
+     * main are forwarded to it */
+    stack_pid = thread_create(stack, sizeof(stack), THREAD_PRIORITY_MAIN - 1,
+                              CREATE_STACKTEST, _stack, NULL, "stack");
+    ok &= _check(ng_netapi_direct_pid == stack_pid, "stack thread runs");
+    ok &= _check(ng_netapi_msg_pid(pid_a) == stack_pid, "messages go to it");
+    ok &= _check(ng_netapi_msg_pid(me) == me, "threads keep their PID");
+
+    ok &= _check(ng_netapi_receive(pid_a, &pkt) == 1, "receive, forwarded");
+    ok &= _check((mod_a.calls == 2) && (mod_a.thread == stack_pid) &&
+                 (mod_a.type == NG_NETAPI_MSG_TYPE_RCV) && (mod_a.ptr == &pkt),
+                 "receive reached a in the stack thread");
+    ok &= _check(ng_netapi_set(pid_b, NETCONF_OPT_CHANNEL, 0, &val,
+                               sizeof(val)) == mod_b.value, "set, forwarded");
+    ok &= _check((mod_b.calls == 2) && (mod_b.thread == stack_pid) &&
+                 (mod_b.type == NG_NETAPI_MSG_TYPE_SET),
+                 "set reached b in the stack thread");
+
+    /* messages no module knows are left to the stack thread */
+    msg.type = MSG_TYPE_UNKNOWN;
+    msg_send(&msg, stack_pid);
+    ok &= _check(unknown == 1, "unknown message not dispatched");
+    ok &= _check((mod_a.calls == 2) && (mod_b.calls == 2) &&
+                 (mod_runner.calls == 0), "no handler called for it");
+
+    puts(ok ? "SUCCESS" : "FAILURE");
+    return 0;
+}
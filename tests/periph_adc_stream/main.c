@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for continuous ADC sampling
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "hwtimer.h"
+#include "msg.h"
+#include "thread.h"
+#include "timex.h"
+#include "vtimer.h"
+#include "periph/adc.h"
+
+#if ADC_NUMOF < 1
+#error "Please enable at least 1 ADC device to run this test"
+#endif
+
+#define RES             ADC_RES_10BIT
+#define RATE            (1000U)
+#define BLOCK_LEN       (100U)
+#define BLOCKS          (20U)
+#define MSG_TYPE_TIMER  (0x0001)
+
+static uint16_t buf[2 * BLOCK_LEN];
+static adc_stats_t stats[BLOCKS];
+static volatile unsigned blocks;
+static kernel_pid_t main_pid;
+
+static void block_cb(void *arg, const uint16_t *block, unsigned len,
+                     const adc_stats_t *s)
+{
+    msg_t msg;
+
+    (void)arg;
+    (void)len;
+
+    if (block == NULL) {
+        /* the stream stopped itself */
+        msg.content.value = BLOCKS;
+        msg_send_int(&msg, main_pid);
+        return;
+    }
+    if (blocks < BLOCKS) {
+        stats[blocks] = *s;
+        msg.content.value = blocks++;
+        msg_send_int(&msg, main_pid);
+    }
+    if (blocks == BLOCKS) {
+        adc_stream_stop(ADC_0);
+    }
+}
+
+static void timer_cb(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    msg.type = MSG_TYPE_TIMER;
+    msg_send_int(&msg, main_pid);
+}
+
+int main(void)
+{
+    timex_t t0, t1;
+    uint64_t us;
+    msg_t msg;
+
+    main_pid = thread_getpid();
+
+    if (adc_init(ADC_0, RES) < 0) {
+        puts("adc_init failed");
+        return 1;
+    }
+
+    /* stopping a stream that never started must leave other hwtimers alone */
+    if (hwtimer_set(HWTIMER_TICKS(1000), timer_cb, NULL) < 0) {
+        puts("hwtimer_set failed");
+        return 1;
+    }
+    adc_stream_stop(ADC_0);
+    msg_receive(&msg);
+    if (msg.type != MSG_TYPE_TIMER) {
+        puts("stop before start: FAILED");
+        return 1;
+    }
+    puts("stop before start: OK");
+
+    vtimer_now(&t0);
+    if (adc_stream_start(ADC_0, 0, RATE, buf, BLOCK_LEN, block_cb, NULL) < 0) {
+        puts("adc_stream_start failed");
+        return 1;
+    }
+
+    do {
+        msg_receive(&msg);
+        if (msg.content.value == BLOCKS) {
+            puts("stream stopped");
+            return 1;
+        }
+        printf("block %u: min %u max %u mean %u\n", (unsigned)msg.content.value,
+               stats[msg.content.value].min, stats[msg.content.value].max,
+               stats[msg.content.value].mean);
+    } while (msg.content.value < BLOCKS - 1);
+    vtimer_now(&t1);
+
+    us = timex_uint64(timex_sub(t1, t0));
+    printf("%u samples in %lu us: %lu Hz\n", BLOCKS * BLOCK_LEN,
+           (unsigned long)us,
+           (unsigned long)((uint64_t)BLOCKS * BLOCK_LEN * 1000000 / us));
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+#! /usr/bin/env python
+
+import os
+import sys
+import tempfile
+from pexpect import spawn
+
+BLOCK_LEN = 100
+BLOCKS = 20
+
+if __name__ == "__main__":
+    fd, path = tempfile.mkstemp(suffix=".adc")
+    with os.fdopen(fd, "w") as f:
+        f.write("# ramp, one block long\n")
+        for i in range(BLOCK_LEN):
+            f.write("%d\n" % i)
+
+    term = spawn("bin/native/periph_adc_stream.elf", ["-A", path], timeout=10)
+    term.expect("stop before start: OK")
+    for block in range(BLOCKS):
+        term.expect(r"block %d: min (\d+) max (\d+) mean (\d+)" % block)
+        stats = tuple(int(v) for v in term.match.groups())
+        if stats != (0, BLOCK_LEN - 1, (BLOCK_LEN - 1) // 2):
+            print("unexpected statistics for block %d: %s" % (block, stats))
+            sys.exit(1)
+    term.expect(r"samples in \d+ us: (\d+) Hz")
+    print("effective rate: %s Hz" % term.match.group(1))
+
+    os.unlink(path)
+    if not term.terminate():
+        term.terminate(force=True)
+    sys.exit(0)
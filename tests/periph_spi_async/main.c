@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for asynchronous SPI transfers
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "periph/spi.h"
+
+#define TEST_SPI    (SPI_0)
+#define TEST_LEN    (32U)
+
+static char tx[TEST_LEN];
+static char rx[TEST_LEN];
+static char echo[TEST_LEN];
+
+static mutex_t done = MUTEX_INIT;
+static int results[3];
+static unsigned completed;
+
+static void _cb(void *arg, int res)
+{
+    unsigned idx = (unsigned)(uintptr_t)arg;
+
+    results[idx] = res;
+    if (completed++ != idx) {
+        results[idx] = -2;
+    }
+    /* a failed transfer ends the chain */
+    if ((idx == 2) || (res < 0)) {
+        mutex_unlock(&done);
+    }
+}
+
+static void _poweroff_cb(void *arg, int res)
+{
+    _cb(arg, res);
+    /* makes the next transfer of the chain fail */
+    spi_poweroff(TEST_SPI);
+}
+
+/* powers the bus off after the first transfer, the second one must fail
+ * and the third one must not be started */
+static int _test_error(spi_transfer_t *chain)
+{
+    memset(results, 0, sizeof(results));
+    completed = 0;
+    chain[0].cb = _poweroff_cb;
+
+    if (spi_transfer_async(TEST_SPI, chain) == 0) {
+        mutex_lock(&done);
+    }
+    spi_poweron(TEST_SPI);
+
+    printf("error chain: %i %i %i, %u callbacks\n", results[0], results[1],
+           results[2], completed);
+
+    return (results[0] == (int)TEST_LEN / 2) && (results[1] == -1) &&
+           (completed == 2);
+}
+
+int main(void)
+{
+    spi_transfer_t chain[3];
+
+    for (unsigned i = 0; i < TEST_LEN; i++) {
+        tx[i] = (char)(i * 7 + 1);
+    }
+
+    if (spi_init_master(TEST_SPI, SPI_CONF_FIRST_RISING, SPI_SPEED_1MHZ) < 0) {
+        puts("spi_init_master failed");
+        return 1;
+    }
+
+    /* register write, result ends up in echo */
+    chain[0] = (spi_transfer_t) {
+        .next = &chain[1], .reg = 0x42, .out = tx, .in = echo,
+        .length = TEST_LEN / 2, .cb = _cb, .arg = (void *)0
+    };
+    /* plain write of the second half */
+    chain[1] = (spi_transfer_t) {
+        .next = &chain[2], .reg = SPI_REG_NONE, .out = &tx[TEST_LEN / 2],
+        .in = &echo[TEST_LEN / 2], .length = TEST_LEN / 2, .cb = _cb,
+        .arg = (void *)1
+    };
+    /* read back the whole buffer by sending it again */
+    chain[2] = (spi_transfer_t) {
+        .next = NULL, .reg = SPI_REG_NONE, .out = echo, .in = rx,
+        .length = TEST_LEN, .cb = _cb, .arg = (void *)2
+    };
+
+    mutex_lock(&done);
+    spi_acquire(TEST_SPI);
+    if (spi_transfer_async(TEST_SPI, chain) < 0) {
+        puts("spi_transfer_async failed");
+        return 1;
+    }
+    printf("started, %u transfers completed so far\n", completed);
+
+    /* blocks until the last callback unlocked the mutex */
+    mutex_lock(&done);
+
+    for (unsigned i = 0; i < 3; i++) {
+        printf("transfer %u: %i\n", i, results[i]);
+    }
+
+    int ok = (results[0] == (int)TEST_LEN / 2) &&
+             (results[1] == (int)TEST_LEN / 2) &&
+             (results[2] == (int)TEST_LEN) && (memcmp(tx, rx, TEST_LEN) == 0);
+
+    ok = _test_error(chain) && ok;
+    spi_release(TEST_SPI);
+
+    if (ok) {
+        puts("SUCCESS");
+    }
+    else {
+        puts("FAILURE");
+    }
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#! /usr/bin/env python
+
+import sys
+from pexpect import spawn
+
+if __name__ == "__main__":
+    term = spawn("bin/native/periph_spi_async.elf", timeout=10)
+
+    term.expect("started")
+    for idx, length in enumerate((16, 16, 32)):
+        term.expect(r"transfer %d: (-?\d+)" % idx)
+        if int(term.match.group(1)) != length:
+            print("transfer %d failed" % idx)
+            sys.exit(1)
+
+    term.expect(r"error chain: 16 -1 0, 2 callbacks")
+    term.expect("SUCCESS")
+
+    if not term.terminate():
+        term.terminate(force=True)
+    sys.exit(0)
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for the emulation of asynchronous SPI
+ *          transfers
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "periph/spi.h"
+
+#ifdef HAVE_SPI_ASYNC
+#error "this test needs the spi_async emulation"
+#endif
+
+#define TEST_SPI    (SPI_0)
+#define TEST_LEN    (16U)
+
+static char tx[TEST_LEN];
+static char rx[TEST_LEN];
+
+static int results[2];
+static unsigned completed;
+
+static void _cb(void *arg, int res)
+{
+    results[(uintptr_t)arg] = res;
+    completed++;
+}
+
+static void _poweroff_cb(void *arg, int res)
+{
+    _cb(arg, res);
+    /* makes the next transfer of the chain fail */
+    spi_poweroff(TEST_SPI);
+}
+
+int main(void)
+{
+    spi_transfer_t chain[2];
+    int res, ok;
+
+    for (unsigned i = 0; i < TEST_LEN; i++) {
+        tx[i] = (char)(i * 7 + 1);
+    }
+
+    if (spi_init_master(TEST_SPI, SPI_CONF_FIRST_RISING, SPI_SPEED_1MHZ) < 0) {
+        puts("spi_init_master failed");
+        return 1;
+    }
+
+    chain[0] = (spi_transfer_t) {
+        .next = &chain[1], .reg = 0x42, .out = tx, .in = rx,
+        .length = TEST_LEN / 2, .cb = _cb, .arg = (void *)0
+    };
+    chain[1] = (spi_transfer_t) {
+        .next = NULL, .reg = SPI_REG_NONE, .out = &tx[TEST_LEN / 2],
+        .in = &rx[TEST_LEN / 2], .length = TEST_LEN / 2, .cb = _cb,
+        .arg = (void *)1
+    };
+
+    spi_acquire(TEST_SPI);
+
+    /* the emulation completes the whole chain before returning */
+    res = spi_transfer_async(TEST_SPI, chain);
+    printf("chain: %i, %u callbacks: %i %i\n", res, completed, results[0],
+           results[1]);
+    ok = (res == 0) && (completed == 2) &&
+         (results[0] == (int)TEST_LEN / 2) && (results[1] == (int)TEST_LEN / 2) &&
+         (memcmp(tx, rx, TEST_LEN) == 0);
+
+    /* a failed transfer ends the chain and is reported to the caller */
+    memset(results, 0, sizeof(results));
+    completed = 0;
+    chain[0].cb = _poweroff_cb;
+    res = spi_transfer_async(TEST_SPI, chain);
+    spi_poweron(TEST_SPI);
+    printf("error chain: %i, %u callbacks: %i %i\n", res, completed,
+           results[0], results[1]);
+    ok = ok && (res == -1) && (completed == 2) &&
+         (results[0] == (int)TEST_LEN / 2) && (results[1] == -1);
+
+    spi_release(TEST_SPI);
+
+    puts(ok ? "SUCCESS" : "FAILURE");
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+#! /usr/bin/env python
+
+import sys
+from pexpect import spawn
+
+if __name__ == "__main__":
+    term = spawn("bin/native/periph_spi_async_emulated.elf", timeout=10)
+
+    term.expect(r"chain: 0, 2 callbacks: 8 8")
+    term.expect(r"error chain: -1, 2 callbacks: 8 -1")
+    term.expect("SUCCESS")
+
+    if not term.terminate():
+        term.terminate(force=True)
+    sys.exit(0)
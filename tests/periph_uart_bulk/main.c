@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for buffered UART writes
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "timex.h"
+#include "vtimer.h"
+#include "periph/uart.h"
+
+#if UART_NUMOF
+
+#define DEV             (UART_0)
+#define BAUD            (115200U)
+
+#ifndef TEST_BYTES
+#define TEST_BYTES      (16384U)
+#endif
+#define TEST_BLOCK      (256U)
+
+static mutex_t start = MUTEX_INIT;
+
+static void rx(void *arg, char data)
+{
+    (void)arg;
+    (void)data;
+
+    mutex_unlock(&start);
+}
+
+int main(void)
+{
+    char block[TEST_BLOCK];
+    timex_t t0, t1;
+    uint64_t us;
+
+    for (unsigned i = 0; i < TEST_BLOCK; i++) {
+        block[i] = (char)i;
+    }
+
+    mutex_lock(&start);
+    if (uart_init_bulk(DEV, BAUD, rx, NULL) < 0) {
+        puts("uart_init_bulk failed");
+        return 1;
+    }
+    puts("waiting for input on UART_0");
+    mutex_lock(&start);
+
+    vtimer_now(&t0);
+    for (unsigned sent = 0; sent < TEST_BYTES; sent += TEST_BLOCK) {
+        if (uart_write_bulk(DEV, block, TEST_BLOCK) != (int)TEST_BLOCK) {
+            puts("uart_write_bulk failed");
+            return 1;
+        }
+    }
+    vtimer_now(&t1);
+
+    us = timex_uint64(timex_sub(t1, t0));
+    printf("wrote %u bytes in %lu us\n", TEST_BYTES, (unsigned long)us);
+
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    puts("This platform does not support the low-level UART driver");
+
+    return 0;
+}
+
+#endif /* UART_NUMOF */
@@ -0,0 +1,35 @@
+#! /usr/bin/env python
+
+import os
+import sys
+import time
+from pexpect import spawn
+
+if __name__ == "__main__":
+    term = spawn("bin/native/periph_uart_bulk.elf", timeout=10)
+    term.expect(r"UART_0: (\S+)")
+    pty = os.open(term.match.group(1), os.O_RDWR | os.O_NOCTTY)
+    term.expect("waiting for input")
+
+    length = 16384
+    start = time.time()
+    os.write(pty, b"s")
+
+    data = b""
+    while len(data) < length:
+        data += os.read(pty, length - len(data))
+    elapsed = time.time() - start
+
+    for i, c in enumerate(bytearray(data)):
+        if c != i % 256:
+            print("mismatch at byte %d" % i)
+            sys.exit(1)
+
+    term.expect(r"wrote %d bytes in (\d+) us" % length)
+    print("received %d bytes in %.3f s (%.1f kB/s)" %
+          (length, elapsed, length / elapsed / 1024))
+
+    os.close(pty)
+    if not term.terminate():
+        term.terminate(force=True)
+    sys.exit(0)
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief TCP throughput test application
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net_if.h"
+#include "sixlowpan.h"
+#include "socket_base.h"
+#include "timex.h"
+#include "vtimer.h"
+
+#define SERVER_ADDR         (1)
+#define CLIENT_ADDR         (2)
+#define SERVER_PORT         (4711)
+
+#ifndef TRANSFER_SIZE
+#define TRANSFER_SIZE       (16 * 1024)
+#endif
+
+#define CHUNK_SIZE          (256)
+
+static char buffer[CHUNK_SIZE];
+
+static int init_local_address(uint16_t r_addr)
+{
+    ipv6_addr_t std_addr;
+    ipv6_addr_init(&std_addr, 0xabcd, 0xef12, 0, 0, 0x1034, 0x00ff, 0xfe00,
+                   0);
+    net_if_set_src_address_mode(0, NET_IF_TRANS_ADDR_M_SHORT);
+    return net_if_set_hardware_address(0, r_addr) &&
+           sixlowpan_lowpan_init_adhoc_interface(0, &std_addr);
+}
+
+static void print_result(const char *role, uint32_t bytes, timex_t start)
+{
+    timex_t now;
+    vtimer_now(&now);
+    uint64_t us = timex_uint64(timex_sub(now, start));
+
+    printf("%s: %" PRIu32 " bytes in %" PRIu32 " ms, %" PRIu32 " byte/s\n", role,
+           bytes, (uint32_t)(us / 1000),
+           (us > 0) ? (uint32_t)((uint64_t) bytes * SEC_IN_USEC / us) : 0);
+}
+
+#ifdef CLIENT
+static int run(void)
+{
+    sockaddr6_t addr;
+    uint32_t total = 0;
+    timex_t start;
+    int s;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_port = HTONS(SERVER_PORT);
+    ipv6_addr_init(&addr.sin6_addr, 0xabcd, 0xef12, 0, 0, 0x1034, 0x00ff,
+                   0xfe00, SERVER_ADDR);
+
+    s = socket_base_socket(PF_INET6, SOCK_STREAM, IPPROTO_TCP);
+
+    if ((s < 0) || (socket_base_connect(s, &addr, sizeof(addr)) < 0)) {
+        puts("ERROR: connect failed");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        buffer[i] = (char) i;
+    }
+
+    puts("Start sending");
+    vtimer_now(&start);
+
+    while (total < TRANSFER_SIZE) {
+        uint32_t len = TRANSFER_SIZE - total;
+        int32_t res = socket_base_send(s, buffer, (len > CHUNK_SIZE) ? CHUNK_SIZE : len, 0);
+
+        if (res < 0) {
+            puts("ERROR: send failed");
+            return 1;
+        }
+
+        total += res;
+    }
+
+    socket_base_close(s);
+    print_result("sent", total, start);
+    return 0;
+}
+#else
+static int run(void)
+{
+    sockaddr6_t addr;
+    socklen_t addr_len = sizeof(addr);
+    uint32_t total = 0;
+    timex_t start;
+    int s, c;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_port = HTONS(SERVER_PORT);
+
+    s = socket_base_socket(PF_INET6, SOCK_STREAM, IPPROTO_TCP);
+
+    if ((s < 0) || (socket_base_bind(s, &addr, sizeof(addr)) < 0) ||
+        (socket_base_listen(s, 1) < 0)) {
+        puts("ERROR: listen failed");
+        return 1;
+    }
+
+    puts("Waiting for connection");
+    c = socket_base_accept(s, &addr, &addr_len);
+
+    if (c < 0) {
+        puts("ERROR: accept failed");
+        return 1;
+    }
+
+    puts("Start receiving");
+    vtimer_now(&start);
+
+    while (total < TRANSFER_SIZE) {
+        int32_t res = socket_base_recv(c, buffer, sizeof(buffer), 0);
+
+        if (res < 0) {
+            break;
+        }
+
+        total += res;
+    }
+
+    print_result("received", total, start);
+    return (total == TRANSFER_SIZE) ? 0 : 1;
+}
+#endif
+
+int main(void)
+{
+#ifdef CLIENT
+    uint16_t r_addr = CLIENT_ADDR;
+#else
+    uint16_t r_addr = SERVER_ADDR;
+#endif
+
+    if (!init_local_address(r_addr)) {
+        printf("ERROR: can not initialize IP for hardware address %u\n", r_addr);
+        return 1;
+    }
+
+#ifdef CLIENT
+    /* give the server some time to start listening */
+    vtimer_usleep(SEC_IN_USEC);
+#endif
+
+    return run();
+}
@@ -0,0 +1,21 @@
+#! /usr/bin/env python
+
+import sys
+from pexpect import spawn
+
+if __name__ == "__main__":
+    server = spawn("bin/native/tcp_throughput.elf tap0", timeout=120)
+    client = spawn("bin/native/tcp_throughput_client.elf tap1", timeout=120)
+
+    server.expect("Waiting for connection")
+    client.expect("Start sending")
+    server.expect("Start receiving")
+
+    server.expect(r"received: (\d+) bytes in (\d+) ms, (\d+) byte/s")
+    print("throughput: %s byte/s" % server.match.group(3))
+
+    if not client.terminate():
+        client.terminate(force=True)
+    if not server.terminate():
+        server.terminate(force=True)
+    sys.exit(0)
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for reading UART0 without the chardev thread
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "board_uart0.h"
+#include "fd.h"
+#include "msg.h"
+#include "posix_io.h"
+#include "thread.h"
+#include "unistd.h"
+
+#define LINE_LEN        (32)
+
+static char line[LINE_LEN];
+
+static int _check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAILED: %s\n", what);
+    }
+    return cond;
+}
+
+/* reads up to a newline, returns the number of reads it took */
+static int _read_line(int (*read_func)(char *buf, int n))
+{
+    int len = 0, reads = 0;
+
+    memset(line, 0, sizeof(line));
+    while ((len < LINE_LEN - 1) && ((len == 0) || (line[len - 1] != '\n'))) {
+        int res = read_func(&line[len], LINE_LEN - 1 - len);
+
+        if (res <= 0) {
+            return -1;
+        }
+        len += res;
+        reads++;
+    }
+    return reads;
+}
+
+static int _posix_read(char *buf, int n)
+{
+    return posix_read(uart0_handler_pid, buf, n);
+}
+
+static int _fd_read(char *buf, int n)
+{
+    return fd_read(STDIN_FILENO, buf, n);
+}
+
+int main(void)
+{
+    msg_t msg;
+    int reads, ok = 1;
+
+    puts("uart0_direct test");
+
+    /* there is no chardev thread behind the PID */
+    ok &= _check(uart0_handler_pid != KERNEL_PID_UNDEF, "PID set");
+    ok &= _check(!pid_is_valid(uart0_handler_pid), "PID names no thread");
+    ok &= _check(uart0_handler_pid != KERNEL_PID_ISR, "PID is not the ISR's");
+    ok &= _check(thread_get(uart0_handler_pid) == NULL, "no thread to get");
+    ok &= _check(msg_send(&msg, uart0_handler_pid) == -1,
+                 "sending to the PID fails");
+    ok &= _check(posix_open(uart0_handler_pid, 0) == 0, "posix_open()");
+
+    /* uart0_read() blocks until the line arrives and takes all of it from
+     * the ringbuffer at once */
+    puts("enter: abcdef");
+    reads = _read_line(uart0_read);
+    ok &= _check(strcmp(line, "abcdef\n") == 0, "uart0_read() line");
+    ok &= _check((reads > 0) && (reads < 7), "uart0_read() reads in bulk");
+    printf("got %s", line);
+
+    /* the same through posix_read() on uart0_handler_pid */
+    puts("enter: ghi");
+    reads = _read_line(_posix_read);
+    ok &= _check(strcmp(line, "ghi\n") == 0, "posix_read() line");
+    printf("got %s", line);
+
+    /* the same through the stdin entry of the fd table */
+    fd_init();
+    puts("enter: lmn");
+    reads = _read_line(_fd_read);
+    ok &= _check(strcmp(line, "lmn\n") == 0, "fd_read() line");
+    printf("got %s", line);
+
+    /* single characters, the rest stays in the ringbuffer */
+    puts("enter: jk");
+    ok &= _check(uart0_readc() == 'j', "uart0_readc() first");
+    ok &= _check(uart0_readc() == 'k', "uart0_readc() second");
+    ok &= _check(uart0_readc() == '\n', "uart0_readc() newline");
+
+    ok &= _check(posix_close(uart0_handler_pid) == 0, "posix_close()");
+
+    puts(ok ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,24 @@
+#! /usr/bin/env python
+
+import sys
+from pexpect import spawn
+
+if __name__ == "__main__":
+    term = spawn("bin/native/uart0_direct.elf", timeout=10)
+
+    term.expect("enter: abcdef")
+    term.sendline("abcdef")
+    term.expect("got abcdef")
+    term.expect("enter: ghi")
+    term.sendline("ghi")
+    term.expect("got ghi")
+    term.expect("enter: lmn")
+    term.sendline("lmn")
+    term.expect("got lmn")
+    term.expect("enter: jk")
+    term.sendline("jk")
+    term.expect("SUCCESS")
+
+    if not term.terminate():
+        term.terminate(force=True)
+    sys.exit(0)
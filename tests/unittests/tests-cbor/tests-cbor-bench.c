@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+#ifdef MODULE_BENCHMARK
+
+#include "benchmark.h"
+#include "embUnit.h"
+
+#include "cbor.h"
+
+static unsigned char bench_data[256];
+static cbor_stream_t bench_stream = {bench_data, sizeof(bench_data), 0};
+/* [1, 1000, 1000000, "RIOT", {1: true}] */
+static unsigned char bench_encoded[] = {
+    0x85, 0x01, 0x19, 0x03, 0xe8, 0x1a, 0x00, 0x0f, 0x42, 0x40,
+    0x64, 0x52, 0x49, 0x4f, 0x54, 0xa1, 0x01, 0xf5,
+};
+static cbor_stream_t bench_encoded_stream = {
+    bench_encoded, sizeof(bench_encoded), sizeof(bench_encoded)
+};
+
+static void bench_cbor_serialize_int(void)
+{
+    cbor_clear(&bench_stream);
+    cbor_serialize_int(&bench_stream, 1000000);
+}
+
+static void bench_cbor_serialize_array(void)
+{
+    cbor_clear(&bench_stream);
+    cbor_serialize_array(&bench_stream, 5);
+    cbor_serialize_int(&bench_stream, 1);
+    cbor_serialize_int(&bench_stream, 1000);
+    cbor_serialize_int(&bench_stream, 1000000);
+    cbor_serialize_unicode_string(&bench_stream, "RIOT");
+    cbor_serialize_map(&bench_stream, 1);
+    cbor_serialize_int(&bench_stream, 1);
+    cbor_serialize_bool(&bench_stream, true);
+}
+
+static void bench_cbor_deserialize_array(void)
+{
+    char str[8];
+    size_t offset, len;
+    int val;
+    bool b;
+
+    offset = cbor_deserialize_array(&bench_encoded_stream, 0, &len);
+    offset += cbor_deserialize_int(&bench_encoded_stream, offset, &val);
+    offset += cbor_deserialize_int(&bench_encoded_stream, offset, &val);
+    offset += cbor_deserialize_int(&bench_encoded_stream, offset, &val);
+    offset += cbor_deserialize_unicode_string(&bench_encoded_stream, offset,
+                                              str, sizeof(str));
+    offset += cbor_deserialize_map(&bench_encoded_stream, offset, &len);
+    offset += cbor_deserialize_int(&bench_encoded_stream, offset, &val);
+    cbor_deserialize_bool(&bench_encoded_stream, offset, &b);
+}
+
+TestRef tests_cbor_bench(void)
+{
+    BENCHMARK_FIXTURES(fixtures) {
+        BENCHMARK_FIXTURE(bench_cbor_serialize_int),
+        BENCHMARK_FIXTURE(bench_cbor_serialize_array),
+        BENCHMARK_FIXTURE(bench_cbor_deserialize_array),
+    };
+
+    BENCHMARK_CALLER(CborBench, NULL, NULL, fixtures);
+    return (TestRef)&CborBench;
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_BENCHMARK */
@@ -790,6 +790,10 @@ TestRef tests_cbor_all(void)
     return (TestRef)&CborTest;
 }
 
+#ifdef MODULE_BENCHMARK
+TestRef tests_cbor_bench(void);
+#endif
+
 void tests_cbor(void)
 {
 #ifndef CBOR_NO_PRINT
@@ -797,4 +801,7 @@ void tests_cbor(void)
 #endif /* CBOR_NO_PRINT */
 
     TESTS_RUN(tests_cbor_all());
+#ifdef MODULE_BENCHMARK
+    TESTS_RUN(tests_cbor_bench());
+#endif
 }
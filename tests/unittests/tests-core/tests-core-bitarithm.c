@@ -211,6 +211,35 @@ static void test_bitarithm_bits_set_random(void)
                                                         dice roll ;-) */
 }
 
+static void test_bitarithm_msb_generic_all(void)
+{
+    for (unsigned i = 1; i < UINT16_MAX; i++) {
+        TEST_ASSERT_EQUAL_INT(bitarithm_msb(i), bitarithm_msb_generic(i));
+    }
+    TEST_ASSERT_EQUAL_INT(0, bitarithm_msb_generic(0));
+    TEST_ASSERT_EQUAL_INT(sizeof(unsigned) * 8 - 1,
+                          bitarithm_msb_generic(UINT_MAX));
+}
+
+static void test_bitarithm_lsb_generic_all(void)
+{
+    for (unsigned i = 1; i < UINT16_MAX; i++) {
+        TEST_ASSERT_EQUAL_INT(bitarithm_lsb(i), bitarithm_lsb_generic(i));
+    }
+    TEST_ASSERT_EQUAL_INT(sizeof(unsigned) * 8 - 1,
+                          bitarithm_lsb_generic(1u << (sizeof(unsigned) * 8 - 1)));
+}
+
+static void test_bitarithm_bits_set_generic_all(void)
+{
+    for (unsigned i = 0; i < UINT16_MAX; i++) {
+        TEST_ASSERT_EQUAL_INT(bitarithm_bits_set(i),
+                              bitarithm_bits_set_generic(i));
+    }
+    TEST_ASSERT_EQUAL_INT(sizeof(unsigned) * 8,
+                          bitarithm_bits_set_generic(UINT_MAX));
+}
+
 Test *tests_core_bitarithm_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -244,6 +273,10 @@ Test *tests_core_bitarithm_tests(void)
         new_TestFixture(test_bitarithm_bits_set_one),
         new_TestFixture(test_bitarithm_bits_set_limit),
         new_TestFixture(test_bitarithm_bits_set_random),
+
+        new_TestFixture(test_bitarithm_msb_generic_all),
+        new_TestFixture(test_bitarithm_lsb_generic_all),
+        new_TestFixture(test_bitarithm_bits_set_generic_all),
     };
 
     EMB_UNIT_TESTCALLER(core_bitarithm_tests, NULL, NULL, fixtures);
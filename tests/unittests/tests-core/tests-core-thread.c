@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include "embUnit.h"
+
+#include "kernel_types.h"
+#include "msg.h"
+#include "thread.h"
+
+#include "tests-core.h"
+
+#define RESERVED_PID_FIRST  (KERNEL_PID_LAST + 2)
+
+static void test_thread_reserve_pid(void)
+{
+    kernel_pid_t pid = thread_reserve_pid();
+
+    /* other modules of the test binary may have reserved some already */
+    if (pid == KERNEL_PID_UNDEF) {
+        return;
+    }
+    TEST_ASSERT(pid >= RESERVED_PID_FIRST);
+    TEST_ASSERT(pid < RESERVED_PID_FIRST + THREAD_RESERVED_PIDS_NUMOF);
+    TEST_ASSERT(!pid_is_valid(pid));
+    TEST_ASSERT(pid != KERNEL_PID_ISR);
+    TEST_ASSERT_NULL(thread_get(pid));
+    TEST_ASSERT_EQUAL_INT(STATUS_NOT_FOUND, thread_getstatus(pid));
+}
+
+static void test_thread_reserve_pid__exhausted(void)
+{
+    kernel_pid_t prev = KERNEL_PID_UNDEF, pid;
+    unsigned numof = 0;
+
+    /* takes the rest of the PIDs, so this runs after all other users */
+    while ((pid = thread_reserve_pid()) != KERNEL_PID_UNDEF) {
+        if (prev != KERNEL_PID_UNDEF) {
+            TEST_ASSERT_EQUAL_INT(prev + 1, pid);
+        }
+        TEST_ASSERT(!pid_is_valid(pid));
+        prev = pid;
+        numof++;
+        TEST_ASSERT(numof <= THREAD_RESERVED_PIDS_NUMOF);
+    }
+    if (prev != KERNEL_PID_UNDEF) {
+        TEST_ASSERT_EQUAL_INT(RESERVED_PID_FIRST + THREAD_RESERVED_PIDS_NUMOF - 1,
+                              prev);
+    }
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF, thread_reserve_pid());
+}
+
+static void test_msg_send__invalid_pid(void)
+{
+    kernel_pid_t pids[] = { KERNEL_PID_UNDEF, KERNEL_PID_ISR,
+                            RESERVED_PID_FIRST, -1 };
+    msg_t m, reply;
+
+    for (unsigned i = 0; i < sizeof(pids) / sizeof(pids[0]); i++) {
+        TEST_ASSERT_EQUAL_INT(-1, msg_send(&m, pids[i]));
+        TEST_ASSERT_EQUAL_INT(-1, msg_try_send(&m, pids[i]));
+        TEST_ASSERT_EQUAL_INT(-1, msg_send_receive(&m, &reply, pids[i]));
+        /* msg_send_receive() must not leave the caller reply blocked */
+        TEST_ASSERT_EQUAL_INT(STATUS_RUNNING,
+                              thread_getstatus(thread_getpid()));
+    }
+}
+
+Test *tests_core_thread_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_thread_reserve_pid),
+        new_TestFixture(test_thread_reserve_pid__exhausted),
+        new_TestFixture(test_msg_send__invalid_pid),
+    };
+
+    EMB_UNIT_TESTCALLER(core_thread_tests, NULL, NULL, fixtures);
+
+    return (Test *)&core_thread_tests;
+}
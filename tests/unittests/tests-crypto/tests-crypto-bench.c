@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifdef MODULE_BENCHMARK
+
+#include <stddef.h>
+
+#include "benchmark.h"
+#include "embUnit.h"
+
+#include "crypto/sha256.h"
+
+#include "tests-crypto.h"
+
+static unsigned char data[1024];
+static unsigned char digest[32];
+
+static void bench_sha256_64(void)
+{
+    sha256(data, 64, digest);
+}
+
+static void bench_sha256_1024(void)
+{
+    sha256(data, sizeof(data), digest);
+}
+
+Test *tests_crypto_bench_tests(void)
+{
+    BENCHMARK_FIXTURES(fixtures) {
+        BENCHMARK_FIXTURE(bench_sha256_64),
+        BENCHMARK_FIXTURE(bench_sha256_1024),
+    };
+
+    BENCHMARK_CALLER(crypto_bench, NULL, NULL, fixtures);
+
+    return (Test *)&crypto_bench;
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_BENCHMARK */
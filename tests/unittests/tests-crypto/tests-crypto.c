@@ -11,4 +11,7 @@
 void tests_crypto(void)
 {
     TESTS_RUN(tests_crypto_sha256_tests());
+#ifdef MODULE_BENCHMARK
+    TESTS_RUN(tests_crypto_bench_tests());
+#endif
 }
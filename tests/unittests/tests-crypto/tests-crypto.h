@@ -36,6 +36,15 @@ void tests_crypto(void);
  */
 Test *tests_crypto_sha256_tests(void);
 
+#ifdef MODULE_BENCHMARK
+/**
+ * @brief   Generates benchmarks for crypto
+ *
+ * @return  benchmarks, run like embUnit tests
+ */
+Test *tests_crypto_bench_tests(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifdef MODULE_BENCHMARK
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "embUnit.h"
+#include "tests-fib.h"
+
+#include "thread.h"
+#include "ng_fib.h"
+
+#define ENTRIES         (20)
+#define ADDR_SIZE       (16)
+
+static char addr_first[ADDR_SIZE];
+static char addr_last[ADDR_SIZE];
+static char addr_unknown[] = "Test address 99";
+static char addr_nxt[ADDR_SIZE];
+
+/* same entries as the tests use */
+static void set_up(void)
+{
+    char addr_dst[ADDR_SIZE];
+
+    fib_init();
+    for (size_t i = 0; i < ENTRIES; ++i) {
+        snprintf(addr_dst, ADDR_SIZE, "Test address %02d", (int)i);
+        snprintf(addr_nxt, ADDR_SIZE, "Test address %02d", ENTRIES + (int)i);
+        fib_add_entry(42, (uint8_t *)addr_dst, ADDR_SIZE - 1, 0x77777777,
+                      (uint8_t *)addr_nxt, ADDR_SIZE - 1, 0x77777777, 10000);
+    }
+    snprintf(addr_first, ADDR_SIZE, "Test address %02d", 0);
+    snprintf(addr_last, ADDR_SIZE, "Test address %02d", ENTRIES - 1);
+}
+
+static void tear_down(void)
+{
+    fib_deinit();
+}
+
+static void _get_next_hop(char *dst)
+{
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    size_t nxt_size = ADDR_SIZE;
+    uint32_t flags = 0;
+
+    fib_get_next_hop(&iface_id, (uint8_t *)addr_nxt, &nxt_size, &flags,
+                     (uint8_t *)dst, ADDR_SIZE - 1, 0x13);
+}
+
+static void bench_fib_get_next_hop_first(void)
+{
+    _get_next_hop(addr_first);
+}
+
+static void bench_fib_get_next_hop_last(void)
+{
+    _get_next_hop(addr_last);
+}
+
+static void bench_fib_get_next_hop_unknown(void)
+{
+    _get_next_hop(addr_unknown);
+}
+
+static void bench_fib_add_remove_entry(void)
+{
+    fib_add_entry(42, (uint8_t *)addr_unknown, ADDR_SIZE - 1, 0x77777777,
+                  (uint8_t *)addr_first, ADDR_SIZE - 1, 0x77777777, 10000);
+    fib_remove_entry((uint8_t *)addr_unknown, ADDR_SIZE - 1);
+}
+
+Test *tests_fib_bench_tests(void)
+{
+    BENCHMARK_FIXTURES(fixtures) {
+        BENCHMARK_FIXTURE(bench_fib_get_next_hop_first),
+        BENCHMARK_FIXTURE(bench_fib_get_next_hop_last),
+        BENCHMARK_FIXTURE(bench_fib_get_next_hop_unknown),
+        BENCHMARK_FIXTURE(bench_fib_add_remove_entry),
+    };
+
+    BENCHMARK_CALLER(fib_bench, set_up, tear_down, fixtures);
+
+    return (Test *)&fib_bench;
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_BENCHMARK */
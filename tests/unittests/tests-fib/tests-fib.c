@@ -771,4 +771,7 @@ Test *tests_fib_tests(void)
 void tests_fib(void)
 {
     TESTS_RUN(tests_fib_tests());
+#ifdef MODULE_BENCHMARK
+    TESTS_RUN(tests_fib_bench_tests());
+#endif
 }
@@ -28,6 +28,15 @@ extern "C" {
 */
 void tests_fib(void);
 
+#ifdef MODULE_BENCHMARK
+/**
+ * @brief   Generates benchmarks for fib
+ *
+ * @return  benchmarks, run like embUnit tests
+ */
+Test *tests_fib_bench_tests(void);
+#endif
+
 /**
  * @brief   Generates tests for FIB
  *
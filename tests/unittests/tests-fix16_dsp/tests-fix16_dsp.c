@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+
+#include "embUnit.h"
+
+#include "fix16.h"
+#include "fix16_dsp.h"
+
+#include "tests-fix16_dsp.h"
+
+#define BLOCK           (32)
+#define TAPS            (8)
+
+#define F(x)            ((fix16_t)((x) * 65536))
+
+static uint32_t _rand_state;
+static fix16_t a[BLOCK], b[BLOCK], out[BLOCK];
+
+static int32_t _rand(void)
+{
+    _rand_state = _rand_state * 1103515245 + 12345;
+    return (int32_t)_rand_state;
+}
+
+static int32_t _abs(int32_t v)
+{
+    return (v < 0) ? -v : v;
+}
+
+static void set_up(void)
+{
+    _rand_state = 1;
+    for (unsigned i = 0; i < BLOCK; i++) {
+        a[i] = _rand() >> 12;
+        b[i] = _rand() >> 14;
+        out[i] = 0;
+    }
+}
+
+static void test_fix16_dsp_from_int16(void)
+{
+    int16_t src[] = { 0, 1, -1, 1000, INT16_MAX, INT16_MIN };
+    fix16_t dst[sizeof(src) / sizeof(src[0])];
+
+    fix16_dsp_from_int16(dst, src, F(0.5), 6);
+    for (unsigned i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_INT(src[i] * F(0.5), dst[i]);
+    }
+
+    /* the products do not fit into 32 bit */
+    fix16_dsp_from_int16(dst, src, F(100), 6);
+    TEST_ASSERT_EQUAL_INT(0, dst[0]);
+    TEST_ASSERT_EQUAL_INT(F(100), dst[1]);
+    TEST_ASSERT_EQUAL_INT(F(-100), dst[2]);
+    TEST_ASSERT_EQUAL_INT(FIX16_DSP_MAX, dst[3]);
+    TEST_ASSERT_EQUAL_INT(FIX16_DSP_MAX, dst[4]);
+    TEST_ASSERT_EQUAL_INT(FIX16_DSP_MIN, dst[5]);
+}
+
+static void test_fix16_dsp_mul(void)
+{
+    fix16_dsp_mul(out, a, b, BLOCK);
+    for (unsigned i = 0; i < BLOCK; i++) {
+        TEST_ASSERT(_abs(out[i] - fix16_mul(a[i], b[i])) <= 1);
+    }
+}
+
+static void test_fix16_dsp_scale(void)
+{
+    fix16_t big[] = { F(30000), F(-30000) };
+
+    fix16_dsp_scale(out, a, F(-1.25), BLOCK);
+    for (unsigned i = 0; i < BLOCK; i++) {
+        TEST_ASSERT(_abs(out[i] - fix16_mul(a[i], F(-1.25))) <= 1);
+    }
+
+    /* in place, saturating */
+    fix16_dsp_scale(big, big, F(2), 2);
+    TEST_ASSERT_EQUAL_INT(FIX16_DSP_MAX, big[0]);
+    TEST_ASSERT_EQUAL_INT(FIX16_DSP_MIN, big[1]);
+}
+
+static void test_fix16_dsp_mac(void)
+{
+    for (unsigned i = 0; i < BLOCK; i++) {
+        out[i] = b[i];
+    }
+    fix16_dsp_mac(out, a, F(0.75), BLOCK);
+    for (unsigned i = 0; i < BLOCK; i++) {
+        TEST_ASSERT(_abs(out[i] - fix16_add(b[i], fix16_mul(a[i], F(0.75))))
+                    <= 1);
+    }
+}
+
+static void test_fix16_dsp_dot(void)
+{
+    int64_t ref = 0;
+
+    for (unsigned i = 0; i < BLOCK; i++) {
+        ref += (int64_t)a[i] * b[i];
+    }
+    /* rounded once, not once per product */
+    TEST_ASSERT_EQUAL_INT((fix16_t)((ref + 0x8000) >> 16),
+                          fix16_dsp_dot(a, b, BLOCK));
+}
+
+static void test_fix16_dsp_fir(void)
+{
+    fix16_t coeffs[TAPS], state[2 * TAPS];
+    fix16_dsp_fir_t fir;
+
+    for (unsigned i = 0; i < TAPS; i++) {
+        coeffs[i] = F(1) / (i + 1);
+    }
+    fix16_dsp_fir_init(&fir, coeffs, state, TAPS);
+
+    /* two calls, the second one continues with the samples of the first */
+    fix16_dsp_fir(&fir, out, a, BLOCK / 2);
+    fix16_dsp_fir(&fir, &out[BLOCK / 2], &a[BLOCK / 2], BLOCK / 2);
+    for (unsigned i = 0; i < BLOCK; i++) {
+        int64_t ref = 0;
+
+        for (unsigned j = 0; (j < TAPS) && (j <= i); j++) {
+            ref += (int64_t)coeffs[j] * a[i - j];
+        }
+        TEST_ASSERT_EQUAL_INT((fix16_t)((ref + 0x8000) >> 16), out[i]);
+    }
+}
+
+static void test_fix16_dsp_fir_q15(void)
+{
+    int16_t coeffs[TAPS], state[2 * TAPS], src[BLOCK];
+    fix16_dsp_fir_q15_t fir;
+
+    for (unsigned i = 0; i < TAPS; i++) {
+        coeffs[i] = (int16_t)(0x4000 >> i);
+    }
+    fix16_dsp_fir_q15_init(&fir, coeffs, state, TAPS);
+
+    /* the impulse response are the coefficients */
+    for (unsigned i = 0; i < BLOCK; i++) {
+        src[i] = (i == 0) ? 1 : 0;
+    }
+    fix16_dsp_fir_q15(&fir, out, src, BLOCK);
+    for (unsigned i = 0; i < BLOCK; i++) {
+        TEST_ASSERT_EQUAL_INT((i < TAPS) ? (coeffs[i] * 2) : 0, out[i]);
+    }
+
+    /* a moving average keeps a constant signal, in units of the samples */
+    for (unsigned i = 0; i < TAPS; i++) {
+        coeffs[i] = 0x8000 / TAPS;
+    }
+    for (unsigned i = 0; i < BLOCK; i++) {
+        src[i] = -1234;
+    }
+    fix16_dsp_fir_q15(&fir, out, src, BLOCK);
+    for (unsigned i = TAPS - 1; i < BLOCK; i++) {
+        TEST_ASSERT_EQUAL_INT(F(-1234), out[i]);
+    }
+}
+
+static void test_fix16_dsp_biquad(void)
+{
+    /* two sections y[n] = x[n] + 0.5 y[n-1] */
+    fix16_dsp_biquad_t coeffs[2] = {
+        { .b0 = F(1), .a1 = F(-0.5) },
+        { .b0 = F(1), .a1 = F(-0.5) },
+    };
+    fix16_dsp_biquad_state_t state[2] = { { 0 }, { 0 } };
+    fix16_t src[BLOCK / 2];
+
+    for (unsigned i = 0; i < BLOCK / 2; i++) {
+        src[i] = (i == 0) ? F(1) : 0;
+    }
+    fix16_dsp_biquad(coeffs, state, 1, out, src, BLOCK / 2);
+    for (unsigned i = 0; i < BLOCK / 2; i++) {
+        TEST_ASSERT_EQUAL_INT(F(1) >> i, out[i]);
+    }
+
+    /* the cascade has the impulse response (n + 1) 0.5^n */
+    state[0] = state[1] = (fix16_dsp_biquad_state_t) { 0 };
+    fix16_dsp_biquad(coeffs, state, 2, out, src, BLOCK / 2);
+    for (unsigned i = 0; i < 8; i++) {
+        TEST_ASSERT(_abs(out[i] - (fix16_t)((i + 1) * (F(1) >> i))) <= 1);
+    }
+
+    /* the state carries over to the next call */
+    src[0] = 0;
+    state[0] = (fix16_dsp_biquad_state_t) { .y1 = F(1) };
+    fix16_dsp_biquad(coeffs, state, 1, out, src, 2);
+    TEST_ASSERT_EQUAL_INT(F(0.5), out[0]);
+    TEST_ASSERT_EQUAL_INT(F(0.25), out[1]);
+}
+
+static void test_fix16_dsp_lowpass(void)
+{
+    fix16_t src[8], y = 0;
+
+    for (unsigned i = 0; i < 8; i++) {
+        src[i] = F(1);
+    }
+    fix16_dsp_lowpass(&y, out, src, F(0.5), 8);
+    for (unsigned i = 0; i < 8; i++) {
+        /* 1 - 0.5^(i + 1) */
+        TEST_ASSERT(_abs(out[i] - (F(1) - (F(1) >> (i + 1)))) <= 1);
+    }
+    TEST_ASSERT_EQUAL_INT(out[7], y);
+
+    /* alpha = 1 passes the signal */
+    fix16_dsp_lowpass(&y, out, a, F(1), BLOCK);
+    for (unsigned i = 0; i < BLOCK; i++) {
+        TEST_ASSERT_EQUAL_INT(a[i], out[i]);
+    }
+}
+
+static void test_fix16_dsp_sqrt(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, fix16_dsp_sqrt(0));
+    TEST_ASSERT_EQUAL_INT(0, fix16_dsp_sqrt(F(-4)));
+    TEST_ASSERT_EQUAL_INT(F(2), fix16_dsp_sqrt(F(4)));
+
+    for (fix16_t x = 1; x < 0x7f000000; x += (x >> 6) + 1) {
+        fix16_t ref = fix16_sqrt(x);
+        int32_t err = _abs(fix16_dsp_sqrt(x) - ref);
+
+        /* one LSB for small results, else relative error below 2^-13 */
+        if (err > 1) {
+            TEST_ASSERT(((int64_t)err << 13) < ref);
+        }
+    }
+}
+
+static void test_fix16_dsp_atan2(void)
+{
+    for (unsigned i = 0; i < BLOCK; i++) {
+        for (unsigned j = 0; j < BLOCK; j++) {
+            fix16_t ref = fix16_atan2(a[i], b[j]);
+
+            /* error below 2^-14 */
+            TEST_ASSERT(_abs(fix16_dsp_atan2(a[i], b[j]) - ref) < 4);
+        }
+    }
+    TEST_ASSERT(_abs(fix16_dsp_atan2(F(1), 0) - fix16_pi / 2) < 4);
+    TEST_ASSERT(_abs(fix16_dsp_atan2(0, F(-1)) - fix16_pi) < 4);
+}
+
+static void test_fix16_dsp_quat_mul(void)
+{
+    fix16_dsp_quat_t i = { .x = F(1) }, j = { .y = F(1) }, q;
+
+    fix16_dsp_quat_mul(&q, &i, &j);
+    TEST_ASSERT_EQUAL_INT(0, q.w);
+    TEST_ASSERT_EQUAL_INT(0, q.x);
+    TEST_ASSERT_EQUAL_INT(0, q.y);
+    TEST_ASSERT_EQUAL_INT(F(1), q.z);
+
+    /* in place, j * i = -k */
+    fix16_dsp_quat_mul(&j, &j, &i);
+    TEST_ASSERT_EQUAL_INT(F(-1), j.z);
+}
+
+static void test_fix16_dsp_quat_normalize(void)
+{
+    fix16_dsp_quat_t q = { .w = F(2), .x = F(2), .y = F(-2), .z = F(2) };
+    fix16_dsp_quat_t zero = { 0 };
+
+    fix16_dsp_quat_normalize(&q);
+    TEST_ASSERT(_abs(q.w - F(0.5)) <= 2);
+    TEST_ASSERT(_abs(q.x - F(0.5)) <= 2);
+    TEST_ASSERT(_abs(q.y + F(0.5)) <= 2);
+    TEST_ASSERT(_abs(q.z - F(0.5)) <= 2);
+
+    fix16_dsp_quat_normalize(&zero);
+    TEST_ASSERT_EQUAL_INT(0, zero.w);
+}
+
+static void test_fix16_dsp_quat_integrate(void)
+{
+    fix16_dsp_quat_t q = { .w = F(1) };
+    fix16_t gyro[BLOCK][3];
+
+    /* pi/2 rad/s around z for 100 samples of 10 ms */
+    for (unsigned i = 0; i < BLOCK; i++) {
+        gyro[i][0] = gyro[i][1] = 0;
+        gyro[i][2] = fix16_pi / 2;
+    }
+    for (unsigned i = 0; i < 100; i += 25) {
+        fix16_dsp_quat_integrate(&q, (const fix16_t (*)[3])gyro, 25,
+                                 F(1) / 100);
+    }
+    /* rotated by pi/2: (cos(pi/4), 0, 0, sin(pi/4)) */
+    TEST_ASSERT(_abs(q.w - F(0.70711)) < F(0.005));
+    TEST_ASSERT(_abs(q.z - F(0.70711)) < F(0.005));
+    TEST_ASSERT_EQUAL_INT(0, q.x);
+    TEST_ASSERT_EQUAL_INT(0, q.y);
+}
+
+Test *tests_fix16_dsp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_fix16_dsp_from_int16),
+        new_TestFixture(test_fix16_dsp_mul),
+        new_TestFixture(test_fix16_dsp_scale),
+        new_TestFixture(test_fix16_dsp_mac),
+        new_TestFixture(test_fix16_dsp_dot),
+        new_TestFixture(test_fix16_dsp_fir),
+        new_TestFixture(test_fix16_dsp_fir_q15),
+        new_TestFixture(test_fix16_dsp_biquad),
+        new_TestFixture(test_fix16_dsp_lowpass),
+        new_TestFixture(test_fix16_dsp_sqrt),
+        new_TestFixture(test_fix16_dsp_atan2),
+        new_TestFixture(test_fix16_dsp_quat_mul),
+        new_TestFixture(test_fix16_dsp_quat_normalize),
+        new_TestFixture(test_fix16_dsp_quat_integrate),
+    };
+
+    EMB_UNIT_TESTCALLER(fix16_dsp_tests, set_up, NULL, fixtures);
+
+    return (Test *)&fix16_dsp_tests;
+}
+
+void tests_fix16_dsp(void)
+{
+    TESTS_RUN(tests_fix16_dsp_tests());
+}
+/** @} */
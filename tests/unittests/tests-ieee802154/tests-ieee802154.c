@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ng_ieee802154.h"
+#include "net/ng_netif/hdr.h"
+#include "net/ng_pktbuf.h"
+
+#include "unittests-constants.h"
+#include "tests-ieee802154.h"
+
+#define TEST_PAN        { .u8 = { 0xcd, 0xab } }
+#define TEST_SHORT_DST  { 0x12, 0x34 }
+#define TEST_SHORT_SRC  { 0x56, 0x78 }
+#define TEST_LONG_DST   { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef }
+#define TEST_LONG_SRC   { 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 }
+
+static void tear_down(void)
+{
+    ng_pktbuf_reset();
+}
+
+/* header length as computed field by field before the layout table */
+static size_t _ref_hdr_len(const uint8_t *mhr)
+{
+    uint8_t dst = mhr[1] & NG_IEEE802154_FCF_DST_ADDR_MASK;
+    uint8_t src = mhr[1] & NG_IEEE802154_FCF_SRC_ADDR_MASK;
+    size_t len = 3;
+
+    if (dst == NG_IEEE802154_FCF_DST_ADDR_SHORT) {
+        len += 4;
+    }
+    else if (dst == NG_IEEE802154_FCF_DST_ADDR_LONG) {
+        len += 10;
+    }
+    else if (dst != NG_IEEE802154_FCF_DST_ADDR_VOID) {
+        return 0;
+    }
+    if (src == NG_IEEE802154_FCF_SRC_ADDR_VOID) {
+        return len;
+    }
+    if (!(mhr[0] & NG_IEEE802154_FCF_PAN_COMP)) {
+        len += 2;
+    }
+    if (src == NG_IEEE802154_FCF_SRC_ADDR_SHORT) {
+        return len + 2;
+    }
+    else if (src == NG_IEEE802154_FCF_SRC_ADDR_LONG) {
+        return len + 8;
+    }
+    return 0;
+}
+
+static void test_ieee802154_get_frame_hdr_len__all_modes(void)
+{
+    for (unsigned comp = 0; comp < 2; comp++) {
+        for (unsigned modes = 0; modes < 16; modes++) {
+            uint8_t mhr[2];
+
+            mhr[0] = NG_IEEE802154_FCF_TYPE_DATA |
+                     (comp ? NG_IEEE802154_FCF_PAN_COMP : 0);
+            mhr[1] = ((modes & 0x03) << 2) | ((modes & 0x0c) << 4);
+            TEST_ASSERT_EQUAL_INT(_ref_hdr_len(mhr),
+                                  ng_ieee802154_get_frame_hdr_len(mhr));
+        }
+    }
+}
+
+static void test_ieee802154_get_frame_hdr_len__ignores_other_bits(void)
+{
+    /* frame pending, ACK request, and frame version must not matter */
+    uint8_t mhr[] = { 0x71, 0x98 };
+
+    TEST_ASSERT_EQUAL_INT(9, ng_ieee802154_get_frame_hdr_len(mhr));
+}
+
+static void test_ieee802154_set_frame_hdr__short_pan_comp(void)
+{
+    const uint8_t dst[] = TEST_SHORT_DST, src[] = TEST_SHORT_SRC;
+    const uint8_t exp[] = { 0x41, 0x88, 0x2a, 0xcd, 0xab, 0x34, 0x12, 0x78,
+                            0x56 };
+    const le_uint16_t pan = TEST_PAN;
+    uint8_t buf[NG_IEEE802154_MAX_HDR_LEN];
+
+    TEST_ASSERT_EQUAL_INT(sizeof(exp),
+                          ng_ieee802154_set_frame_hdr(buf, src, sizeof(src),
+                                                      dst, sizeof(dst), pan,
+                                                      pan,
+                                                      NG_IEEE802154_FCF_TYPE_DATA |
+                                                      NG_IEEE802154_FCF_PAN_COMP,
+                                                      0x2a));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp, buf, sizeof(exp)));
+}
+
+static void test_ieee802154_set_frame_hdr__long_src_pan(void)
+{
+    const uint8_t dst[] = TEST_LONG_DST, src[] = TEST_SHORT_SRC;
+    const uint8_t exp[] = { 0x21, 0x8c, 0x00, 0xcd, 0xab, 0xef, 0xcd, 0xab,
+                            0x89, 0x67, 0x45, 0x23, 0x01, 0x34, 0x12, 0x78,
+                            0x56 };
+    const le_uint16_t dst_pan = TEST_PAN;
+    const le_uint16_t src_pan = { .u8 = { 0x34, 0x12 } };
+    uint8_t buf[NG_IEEE802154_MAX_HDR_LEN];
+
+    TEST_ASSERT_EQUAL_INT(sizeof(exp),
+                          ng_ieee802154_set_frame_hdr(buf, src, sizeof(src),
+                                                      dst, sizeof(dst),
+                                                      src_pan, dst_pan,
+                                                      NG_IEEE802154_FCF_TYPE_DATA |
+                                                      NG_IEEE802154_FCF_ACK_REQ,
+                                                      0));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp, buf, sizeof(exp)));
+}
+
+static void test_ieee802154_set_frame_hdr__max_len(void)
+{
+    const uint8_t dst[] = TEST_LONG_DST, src[] = TEST_LONG_SRC;
+    const le_uint16_t pan = TEST_PAN;
+    uint8_t buf[NG_IEEE802154_MAX_HDR_LEN];
+
+    TEST_ASSERT_EQUAL_INT(NG_IEEE802154_MAX_HDR_LEN,
+                          ng_ieee802154_set_frame_hdr(buf, src, sizeof(src),
+                                                      dst, sizeof(dst), pan,
+                                                      pan,
+                                                      NG_IEEE802154_FCF_TYPE_DATA,
+                                                      0));
+    TEST_ASSERT_EQUAL_INT(0xcc, buf[1]);
+}
+
+static void test_ieee802154_set_frame_hdr__invalid_len(void)
+{
+    const uint8_t dst[] = TEST_LONG_DST, src[] = TEST_SHORT_SRC;
+    const le_uint16_t pan = TEST_PAN;
+    uint8_t buf[NG_IEEE802154_MAX_HDR_LEN];
+
+    TEST_ASSERT_EQUAL_INT(0, ng_ieee802154_set_frame_hdr(buf, src, sizeof(src),
+                                                         dst, 4, pan, pan,
+                                                         NG_IEEE802154_FCF_TYPE_DATA,
+                                                         0));
+    TEST_ASSERT_EQUAL_INT(0, ng_ieee802154_set_frame_hdr(buf, src, 1, dst,
+                                                         sizeof(dst), pan, pan,
+                                                         NG_IEEE802154_FCF_TYPE_DATA,
+                                                         0));
+}
+
+static void test_ieee802154_get_src_dst__roundtrip(void)
+{
+    const uint8_t dst[] = TEST_LONG_DST, src[] = TEST_SHORT_SRC;
+    const le_uint16_t pan = TEST_PAN;
+    uint8_t buf[NG_IEEE802154_MAX_HDR_LEN];
+    uint8_t addr[8];
+    le_uint16_t res_pan;
+
+    ng_ieee802154_set_frame_hdr(buf, src, sizeof(src), dst, sizeof(dst), pan,
+                                pan, NG_IEEE802154_FCF_TYPE_DATA |
+                                NG_IEEE802154_FCF_PAN_COMP, 0);
+    TEST_ASSERT_EQUAL_INT(sizeof(dst), ng_ieee802154_get_dst(buf, addr, &res_pan));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(dst, addr, sizeof(dst)));
+    TEST_ASSERT_EQUAL_INT(pan.u16, res_pan.u16);
+    res_pan.u16 = 0;
+    TEST_ASSERT_EQUAL_INT(sizeof(src), ng_ieee802154_get_src(buf, addr, &res_pan));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(src, addr, sizeof(src)));
+    /* compressed source PAN ID is the destination PAN ID */
+    TEST_ASSERT_EQUAL_INT(pan.u16, res_pan.u16);
+}
+
+static void test_ieee802154_get_src_dst__invalid(void)
+{
+    uint8_t mhr[] = { NG_IEEE802154_FCF_TYPE_DATA, 0x84 };
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ng_ieee802154_get_src(mhr, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ng_ieee802154_get_dst(mhr, NULL, NULL));
+}
+
+static void test_ieee802154_netif_hdr_build__success(void)
+{
+    const uint8_t dst[] = TEST_SHORT_DST, src[] = TEST_LONG_SRC;
+    const le_uint16_t pan = TEST_PAN;
+    uint8_t buf[NG_IEEE802154_MAX_HDR_LEN];
+    ng_pktsnip_t *snip;
+    ng_netif_hdr_t *hdr;
+
+    ng_ieee802154_set_frame_hdr(buf, src, sizeof(src), dst, sizeof(dst), pan,
+                                pan, NG_IEEE802154_FCF_TYPE_DATA, 0);
+    TEST_ASSERT_NOT_NULL((snip = ng_ieee802154_netif_hdr_build(buf)));
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_NETIF, snip->type);
+    hdr = snip->data;
+    TEST_ASSERT_EQUAL_INT(sizeof(src), hdr->src_l2addr_len);
+    TEST_ASSERT_EQUAL_INT(sizeof(dst), hdr->dst_l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(src, ng_netif_hdr_get_src_addr(hdr),
+                                    sizeof(src)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(dst, ng_netif_hdr_get_dst_addr(hdr),
+                                    sizeof(dst)));
+    ng_pktbuf_release(snip);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_ieee802154_netif_hdr_build__invalid(void)
+{
+    uint8_t mhr[] = { NG_IEEE802154_FCF_TYPE_DATA, 0x48 };
+
+    TEST_ASSERT_NULL(ng_ieee802154_netif_hdr_build(mhr));
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+Test *tests_ieee802154_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ieee802154_get_frame_hdr_len__all_modes),
+        new_TestFixture(test_ieee802154_get_frame_hdr_len__ignores_other_bits),
+        new_TestFixture(test_ieee802154_set_frame_hdr__short_pan_comp),
+        new_TestFixture(test_ieee802154_set_frame_hdr__long_src_pan),
+        new_TestFixture(test_ieee802154_set_frame_hdr__max_len),
+        new_TestFixture(test_ieee802154_set_frame_hdr__invalid_len),
+        new_TestFixture(test_ieee802154_get_src_dst__roundtrip),
+        new_TestFixture(test_ieee802154_get_src_dst__invalid),
+        new_TestFixture(test_ieee802154_netif_hdr_build__success),
+        new_TestFixture(test_ieee802154_netif_hdr_build__invalid),
+    };
+
+    EMB_UNIT_TESTCALLER(ieee802154_tests, NULL, tear_down, fixtures);
+
+    return (Test *)&ieee802154_tests;
+}
+
+void tests_ieee802154(void)
+{
+    TESTS_RUN(tests_ieee802154_tests());
+}
+/** @} */
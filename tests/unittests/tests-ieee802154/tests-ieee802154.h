@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``ng_ieee802154`` module
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ */
+#ifndef TESTS_IEEE802154_H_
+#define TESTS_IEEE802154_H_
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_ieee802154(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_IEEE802154_H_ */
+/** @} */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#ifdef MODULE_BENCHMARK
+
+#include <stdint.h>
+
+#include "benchmark.h"
+#include "embUnit.h"
+
+#include "net/ng_inet_csum.h"
+
+#include "tests-inet_csum.h"
+
+/* 64 bit aligned and one byte off */
+static uint64_t data[(1280 / sizeof(uint64_t)) + 1];
+
+static void bench_inet_csum__64(void)
+{
+    volatile uint16_t res = ng_inet_csum(0, (uint8_t *)data, 64);
+
+    (void)res;
+}
+
+static void bench_inet_csum__1280(void)
+{
+    volatile uint16_t res = ng_inet_csum(0, (uint8_t *)data, 1280);
+
+    (void)res;
+}
+
+static void bench_inet_csum__1280_unaligned(void)
+{
+    volatile uint16_t res = ng_inet_csum(0, ((uint8_t *)data) + 1, 1280);
+
+    (void)res;
+}
+
+Test *tests_inet_csum_bench_tests(void)
+{
+    BENCHMARK_FIXTURES(fixtures) {
+        BENCHMARK_FIXTURE(bench_inet_csum__64),
+        BENCHMARK_FIXTURE(bench_inet_csum__1280),
+        BENCHMARK_FIXTURE(bench_inet_csum__1280_unaligned),
+    };
+
+    BENCHMARK_CALLER(inet_csum_bench, NULL, NULL, fixtures);
+
+    return (Test *)&inet_csum_bench;
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_BENCHMARK */
+/** @} */
@@ -124,5 +124,8 @@ Test *tests_inet_csum_tests(void)
 void tests_inet_csum(void)
 {
     TESTS_RUN(tests_inet_csum_tests());
+#ifdef MODULE_BENCHMARK
+    TESTS_RUN(tests_inet_csum_bench_tests());
+#endif
 }
 /** @} */
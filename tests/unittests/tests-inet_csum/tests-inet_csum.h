@@ -29,6 +29,15 @@ extern "C" {
  */
 void tests_inet_csum(void);
 
+#ifdef MODULE_BENCHMARK
+/**
+ * @brief   Generates benchmarks for ng_inet_csum
+ *
+ * @return  benchmarks, run like embUnit tests
+ */
+Test *tests_inet_csum_bench_tests(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
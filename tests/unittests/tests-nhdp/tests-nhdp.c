@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdbool.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "thread.h"
+
+#include "nhdp.h"
+#include "nhdp_address.h"
+#include "nhdp_metric.h"
+#include "nhdp_writer.h"
+#include "iib_table.h"
+#include "lib_table.h"
+
+#include "unittests-constants.h"
+#include "tests-nhdp.h"
+
+#define TEST_ADDR           { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                              0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 }
+#define TEST_SENT_NUMOF     (3)
+
+/* one step of the fixed-point DAT loss in the metric value at DAT_MINIMUM_BITRATE */
+#define TEST_DAT_STEP       ((DAT_CONSTANT / DAT_MAXIMUM_LOSS) >> DAT_LOSS_FRAC_BITS)
+
+static nhdp_if_entry_t if_entry;
+static uint8_t packet_buffer[NHDP_MAX_RFC5444_PACKET_SZ];
+static uint8_t hello_buf[NHDP_MAX_RFC5444_PACKET_SZ];
+
+/* packets handed to the interface */
+static uint8_t sent[TEST_SENT_NUMOF][NHDP_MAX_RFC5444_PACKET_SZ];
+static size_t sent_len[TEST_SENT_NUMOF];
+static void *sent_buf[TEST_SENT_NUMOF];
+static unsigned sent_numof;
+
+static void _send_packet(struct rfc5444_writer *wr, struct rfc5444_writer_target *iface,
+                         void *buffer, size_t length)
+{
+    (void)wr;
+    (void)iface;
+    nhdp_writer_keep_packet(&if_entry, buffer, length);
+
+    if ((sent_numof < TEST_SENT_NUMOF) && (length <= NHDP_MAX_RFC5444_PACKET_SZ)) {
+        memcpy(sent[sent_numof], buffer, length);
+        sent_len[sent_numof] = length;
+        sent_buf[sent_numof] = buffer;
+    }
+    sent_numof++;
+}
+
+static uint16_t _seq_no(unsigned i)
+{
+    return (uint16_t)((sent[i][1] << 8) | sent[i][2]);
+}
+
+static void set_up(void)
+{
+    uint8_t addr[] = TEST_ADDR;
+    nhdp_addr_t *nhdp_addr;
+
+    memset(&if_entry, 0, sizeof(if_entry));
+    sent_numof = 0;
+
+    if_entry.if_pid = thread_getpid();
+    if_entry.hello_interval = timex_set(2, 0);
+    if_entry.validity_time = timex_set(6, 0);
+    if_entry.hello_buf = hello_buf;
+    if_entry.wr_target.packet_buffer = packet_buffer;
+    if_entry.wr_target.packet_size = sizeof(packet_buffer);
+    if_entry.wr_target.sendPacket = _send_packet;
+
+    nhdp_addr = nhdp_addr_db_get_address(addr, sizeof(addr), AF_INET6);
+    TEST_ASSERT_NOT_NULL(nhdp_addr);
+    TEST_ASSERT_EQUAL_INT(0, lib_add_if_addr(if_entry.if_pid, nhdp_addr));
+    nhdp_decrement_addr_usage(nhdp_addr);
+
+    nhdp_writer_init();
+    nhdp_writer_register_if(&if_entry.wr_target);
+}
+
+static void tear_down(void)
+{
+    nhdp_writer_cleanup();
+    lib_rem_if(if_entry.if_pid);
+}
+
+static void test_nhdp_writer_send_hello__reuse(void)
+{
+    nhdp_writer_send_hello(&if_entry);
+    TEST_ASSERT_EQUAL_INT(1, sent_numof);
+    TEST_ASSERT(sent_buf[0] == packet_buffer);
+    TEST_ASSERT_EQUAL_INT(sent_len[0], if_entry.hello_len);
+    TEST_ASSERT_EQUAL_INT(if_entry.seq_no, _seq_no(0));
+
+    /* nothing changed, the kept packet is sent again with the next sequence number */
+    nhdp_writer_send_hello(&if_entry);
+    TEST_ASSERT_EQUAL_INT(2, sent_numof);
+    TEST_ASSERT(sent_buf[1] == hello_buf);
+    TEST_ASSERT_EQUAL_INT(sent_len[0], sent_len[1]);
+    TEST_ASSERT_EQUAL_INT(_seq_no(0) + 1, _seq_no(1));
+    TEST_ASSERT_EQUAL_INT(if_entry.seq_no, _seq_no(1));
+    TEST_ASSERT_EQUAL_INT(sent[0][0], sent[1][0]);
+    TEST_ASSERT(memcmp(&sent[0][3], &sent[1][3], sent_len[0] - 3) == 0);
+}
+
+static void test_nhdp_writer_send_hello__invalidate(void)
+{
+    nhdp_writer_send_hello(&if_entry);
+    nhdp_writer_invalidate();
+
+    /* the information bases changed, the HELLO is created again */
+    nhdp_writer_send_hello(&if_entry);
+    TEST_ASSERT_EQUAL_INT(2, sent_numof);
+    TEST_ASSERT(sent_buf[1] == packet_buffer);
+    TEST_ASSERT_EQUAL_INT(_seq_no(0) + 1, _seq_no(1));
+    TEST_ASSERT_EQUAL_INT(sent_len[0], sent_len[1]);
+    TEST_ASSERT(memcmp(&sent[0][3], &sent[1][3], sent_len[0] - 3) == 0);
+
+    nhdp_writer_send_hello(&if_entry);
+    TEST_ASSERT_EQUAL_INT(3, sent_numof);
+    TEST_ASSERT(sent_buf[2] == hello_buf);
+    TEST_ASSERT_EQUAL_INT(_seq_no(1) + 1, _seq_no(2));
+}
+
+#if (NHDP_METRIC == NHDP_LMT_DAT)
+/* the DAT metric as computed in double before it moved to fixed point */
+static uint32_t _dat_metric_double(iib_link_set_entry_t *ls_entry)
+{
+    const double const_dat = (((double)DAT_CONSTANT) / DAT_MAXIMUM_LOSS);
+    double sum_rcvd = ls_entry->dat_received_sum, sum_total = ls_entry->dat_total_sum;
+    double loss;
+    uint32_t metric;
+
+    if ((ls_entry->hello_interval != 0) && (ls_entry->lost_hellos > 0)) {
+        loss = (((double)ls_entry->hello_interval) * ((double)ls_entry->lost_hellos))
+               / DAT_MEMORY_LENGTH;
+        if (loss >= 1.0) {
+            sum_rcvd = 0.0;
+        }
+        else {
+            sum_rcvd *= (1.0 - loss);
+        }
+    }
+
+    if (sum_rcvd < 1.0) {
+        return NHDP_METRIC_MAXIMUM;
+    }
+
+    loss = sum_total / sum_rcvd;
+    if (loss > DAT_MAXIMUM_LOSS) {
+        loss = DAT_MAXIMUM_LOSS;
+    }
+    metric = (const_dat * loss) / (ls_entry->rx_bitrate / DAT_MINIMUM_BITRATE);
+
+    return (metric > NHDP_METRIC_MAXIMUM) ? NHDP_METRIC_MAXIMUM : metric;
+}
+
+static void test_nhdp_dat_metric__boundaries(void)
+{
+    static const struct {
+        uint16_t received;
+        uint16_t total;
+        uint8_t hello_interval;
+        uint8_t lost_hellos;
+        bool exact;     /* loss representable in fixed point */
+    } cases[] = {
+        { 1, 1, 0, 0, true },                       /* no loss, single HELLO */
+        { 255 * DAT_MEMORY_LENGTH, 255 * DAT_MEMORY_LENGTH, 0, 0, true },  /* full queues */
+        { 0, 5, 0, 0, true },                       /* nothing received */
+        { 3, 7, 0, 0, false },
+        { 10, 79, 0, 0, false },                    /* just below maximum loss */
+        { 10, 80, 0, 0, true },                     /* maximum loss */
+        { 10, 81, 0, 0, true },                     /* above maximum loss */
+        { 2041, 255 * DAT_MEMORY_LENGTH, 0, 0, false },  /* full queues, high loss */
+        { 100, 100, 1, 8, false },                  /* 8/64 of the time lost */
+        { 100, 100, 7, 9, true },                   /* 63/64 of the time lost */
+        { 100, 100, 8, 8, true },                   /* all time lost */
+        { 1, 1, 1, 1, true },                       /* less than one HELLO left */
+        { 64, 64, 1, 63, true },                    /* exactly one HELLO left */
+    };
+    static const uint32_t bitrates[] = { DAT_MINIMUM_BITRATE, 250000, 999999 };
+    iib_link_set_entry_t ls_entry;
+
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        for (unsigned j = 0; j < sizeof(bitrates) / sizeof(bitrates[0]); j++) {
+            uint32_t fixed, dbl;
+
+            memset(&ls_entry, 0, sizeof(ls_entry));
+            ls_entry.dat_received_sum = cases[i].received;
+            ls_entry.dat_total_sum = cases[i].total;
+            ls_entry.hello_interval = cases[i].hello_interval;
+            ls_entry.lost_hellos = cases[i].lost_hellos;
+            ls_entry.rx_bitrate = bitrates[j];
+
+            fixed = iib_dat_metric(&ls_entry);
+            dbl = _dat_metric_double(&ls_entry);
+
+            if (cases[i].exact) {
+                TEST_ASSERT_EQUAL_INT(dbl, fixed);
+            }
+            else {
+                /* the fixed-point loss is truncated to one step */
+                TEST_ASSERT(fixed <= dbl);
+                TEST_ASSERT(dbl - fixed <= TEST_DAT_STEP);
+            }
+        }
+    }
+}
+#endif
+
+Test *tests_nhdp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_nhdp_writer_send_hello__reuse),
+        new_TestFixture(test_nhdp_writer_send_hello__invalidate),
+#if (NHDP_METRIC == NHDP_LMT_DAT)
+        new_TestFixture(test_nhdp_dat_metric__boundaries),
+#endif
+    };
+
+    EMB_UNIT_TESTCALLER(nhdp_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&nhdp_tests;
+}
+
+void tests_nhdp(void)
+{
+    TESTS_RUN(tests_nhdp_tests());
+}
+/** @} */
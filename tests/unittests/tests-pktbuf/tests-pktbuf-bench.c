@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#ifdef MODULE_BENCHMARK
+
+#include "benchmark.h"
+#include "embUnit.h"
+
+#include "net/ng_nettype.h"
+#include "net/ng_pkt.h"
+#include "net/ng_pktbuf.h"
+
+#include "tests-pktbuf.h"
+
+static uint8_t payload[64];
+
+static void tear_down(void)
+{
+    ng_pktbuf_reset();
+}
+
+static void bench_pktbuf_add_release(void)
+{
+    ng_pktsnip_t *pkt = ng_pktbuf_add(NULL, payload, sizeof(payload),
+                                      NG_NETTYPE_UNDEF);
+
+    ng_pktbuf_release(pkt);
+}
+
+static void bench_pktbuf_add_hdr_release(void)
+{
+    ng_pktsnip_t *pkt = ng_pktbuf_add(NULL, payload, sizeof(payload),
+                                      NG_NETTYPE_UNDEF);
+
+    pkt = ng_pktbuf_add(pkt, NULL, 40, NG_NETTYPE_UNDEF);
+    ng_pktbuf_release(pkt);
+}
+
+static void bench_pktbuf_start_write(void)
+{
+    ng_pktsnip_t *pkt = ng_pktbuf_add(NULL, payload, sizeof(payload),
+                                      NG_NETTYPE_UNDEF);
+    ng_pktsnip_t *copy;
+
+    ng_pktbuf_hold(pkt, 1);
+    copy = ng_pktbuf_start_write(pkt);
+    ng_pktbuf_release(copy);
+    ng_pktbuf_release(pkt);
+}
+
+Test *tests_pktbuf_bench_tests(void)
+{
+    BENCHMARK_FIXTURES(fixtures) {
+        BENCHMARK_FIXTURE(bench_pktbuf_add_release),
+        BENCHMARK_FIXTURE(bench_pktbuf_add_hdr_release),
+        BENCHMARK_FIXTURE(bench_pktbuf_start_write),
+    };
+
+    BENCHMARK_CALLER(ng_pktbuf_bench, NULL, tear_down, fixtures);
+
+    return (Test *)&ng_pktbuf_bench;
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_BENCHMARK */
+/** @} */
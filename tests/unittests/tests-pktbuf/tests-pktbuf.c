@@ -652,5 +652,8 @@ Test *tests_pktbuf_tests(void)
 void tests_pktbuf(void)
 {
     TESTS_RUN(tests_pktbuf_tests());
+#ifdef MODULE_BENCHMARK
+    TESTS_RUN(tests_pktbuf_bench_tests());
+#endif
 }
 /** @} */
@@ -29,6 +29,15 @@ extern "C" {
  */
 void tests_pktbuf(void);
 
+#ifdef MODULE_BENCHMARK
+/**
+ * @brief   Generates benchmarks for ng_pktbuf
+ *
+ * @return  benchmarks, run like embUnit tests
+ */
+Test *tests_pktbuf_bench_tests(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ng_ipv6/hdr.h"
+#include "net/ng_netif/hdr.h"
+#include "net/ng_pktbuf.h"
+#include "net/ng_sixlowpan/ctx.h"
+#include "net/ng_sixlowpan/iphc.h"
+
+#include "unittests-constants.h"
+#include "tests-sixlowpan_iphc.h"
+
+#define TEST_L2SRC          { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 }
+#define TEST_L2DST          { 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff }
+#define TEST_CTX_PREFIX     { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 \
+        } \
+    }
+#define TEST_CTX_PREFIX_LEN (64)
+#define TEST_NH             (TEST_UINT8)
+#define TEST_PACKETS        (16U)
+#define TEST_FRAME_MAX      (64U)
+
+static uint8_t l2src[] = TEST_L2SRC;
+static uint8_t l2dst[] = TEST_L2DST;
+
+static void set_up(void)
+{
+    ng_pktbuf_reset();
+}
+
+static void tear_down(void)
+{
+    ng_sixlowpan_ctx_reset();
+    ng_pktbuf_reset();
+}
+
+static void _set_iid(ng_ipv6_addr_t *addr, const uint8_t *l2addr)
+{
+    memcpy(&addr->u8[8], l2addr, 8);
+    addr->u8[8] ^= 0x02;    /* swap local/universal bit */
+}
+
+/* builds netif header -> IPv6 header -> payload as handed down by IPv6 */
+static ng_pktsnip_t *_build_ipv6(bool global_src)
+{
+    ng_pktsnip_t *payload, *ipv6, *netif;
+    ng_ipv6_hdr_t *hdr;
+
+    payload = ng_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                            NG_NETTYPE_UNDEF);
+    ipv6 = ng_pktbuf_add(payload, NULL, sizeof(ng_ipv6_hdr_t), NG_NETTYPE_IPV6);
+    netif = ng_netif_hdr_build(l2src, sizeof(l2src), l2dst, sizeof(l2dst));
+
+    if ((payload == NULL) || (ipv6 == NULL) || (netif == NULL)) {
+        return NULL;
+    }
+
+    netif->next = ipv6;
+
+    hdr = ipv6->data;
+    memset(hdr, 0, sizeof(ng_ipv6_hdr_t));
+    ng_ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(sizeof(TEST_STRING8));
+    hdr->nh = TEST_NH;
+    hdr->hl = 64;
+
+    if (global_src) {
+        ng_ipv6_addr_t prefix = TEST_CTX_PREFIX;
+
+        ng_ipv6_addr_init_prefix(&hdr->src, &prefix, TEST_CTX_PREFIX_LEN);
+    }
+    else {
+        ng_ipv6_addr_set_link_local_prefix(&hdr->src);
+    }
+    ng_ipv6_addr_set_link_local_prefix(&hdr->dst);
+    _set_iid(&hdr->src, l2src);
+    _set_iid(&hdr->dst, l2dst);
+
+    return netif;
+}
+
+/* turns an encoded packet into payload -> netif header as received */
+static ng_pktsnip_t *_build_rcvd(ng_pktsnip_t *encoded)
+{
+    ng_pktsnip_t *dispatch = encoded->next, *payload = dispatch->next;
+    ng_pktsnip_t *netif, *rcvd;
+    uint8_t frame[TEST_FRAME_MAX];
+
+    if ((dispatch->size + payload->size) > sizeof(frame)) {
+        return NULL;
+    }
+
+    memcpy(frame, dispatch->data, dispatch->size);
+    memcpy(frame + dispatch->size, payload->data, payload->size);
+
+    netif = ng_netif_hdr_build(l2src, sizeof(l2src), l2dst, sizeof(l2dst));
+
+    if (netif == NULL) {
+        return NULL;
+    }
+
+    rcvd = ng_pktbuf_add(netif, frame, dispatch->size + payload->size,
+                         NG_NETTYPE_SIXLOWPAN);
+
+    return rcvd;
+}
+
+static void _check_decoded(ng_pktsnip_t *pkt, bool global_src)
+{
+    ng_pktsnip_t *expected = _build_ipv6(global_src);
+    ng_ipv6_hdr_t *exp_hdr, *hdr;
+
+    TEST_ASSERT_NOT_NULL(expected);
+    exp_hdr = expected->next->data;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING8), pkt->size);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, (char *)pkt->data);
+    TEST_ASSERT_NOT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_IPV6, pkt->next->type);
+    TEST_ASSERT_EQUAL_INT(sizeof(ng_ipv6_hdr_t), pkt->next->size);
+    TEST_ASSERT_NOT_NULL(pkt->next->next);
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_NETIF, pkt->next->next->type);
+
+    hdr = pkt->next->data;
+    TEST_ASSERT(ng_ipv6_hdr_is(hdr));
+    TEST_ASSERT_EQUAL_INT(exp_hdr->nh, hdr->nh);
+    TEST_ASSERT_EQUAL_INT(exp_hdr->hl, hdr->hl);
+    TEST_ASSERT(ng_ipv6_addr_equal(&exp_hdr->src, &hdr->src));
+    TEST_ASSERT(ng_ipv6_addr_equal(&exp_hdr->dst, &hdr->dst));
+
+    ng_pktbuf_release(expected);
+}
+
+static void test_sixlowpan_iphc_encode__in_place(void)
+{
+    ng_pktsnip_t *pkt = _build_ipv6(false);
+    unsigned int allocs = ng_pktbuf_alloc_count();
+    uint8_t *iphc_hdr;
+    void *ipv6_data;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    ipv6_data = pkt->next->data;
+
+    TEST_ASSERT(ng_sixlowpan_iphc_encode(pkt));
+    TEST_ASSERT_EQUAL_INT(allocs, ng_pktbuf_alloc_count());
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_SIXLOWPAN, pkt->next->type);
+    TEST_ASSERT(ipv6_data == pkt->next->data);
+
+    /* TF elided, NH inline, HL 64, both addresses derived from L2 */
+    TEST_ASSERT_EQUAL_INT(NG_SIXLOWPAN_IPHC_HDR_LEN + 1, pkt->next->size);
+    iphc_hdr = pkt->next->data;
+    TEST_ASSERT_EQUAL_INT(0x7a, iphc_hdr[0]);
+    TEST_ASSERT_EQUAL_INT(0x33, iphc_hdr[1]);
+    TEST_ASSERT_EQUAL_INT(TEST_NH, iphc_hdr[2]);
+
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_encode__shared(void)
+{
+    ng_pktsnip_t *pkt = _build_ipv6(false);
+    ng_pktsnip_t *ipv6;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    ipv6 = pkt->next;
+    ng_pktbuf_hold(ipv6, 1);
+    TEST_ASSERT(ng_sixlowpan_iphc_encode(pkt));
+    TEST_ASSERT(ipv6 != pkt->next);
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_SIXLOWPAN, pkt->next->type);
+    /* other user still sees the uncompressed header */
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_IPV6, ipv6->type);
+    TEST_ASSERT_EQUAL_INT(sizeof(ng_ipv6_hdr_t), ipv6->size);
+
+    ng_pktbuf_release(pkt);
+    ng_pktbuf_release(ipv6);
+}
+
+static void test_sixlowpan_iphc_decode__link_local(void)
+{
+    ng_pktsnip_t *pkt = _build_ipv6(false), *rcvd;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(ng_sixlowpan_iphc_encode(pkt));
+    rcvd = _build_rcvd(pkt);
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT_NOT_NULL(rcvd);
+
+    TEST_ASSERT(ng_sixlowpan_iphc_decode(rcvd));
+    _check_decoded(rcvd, false);
+    ng_pktbuf_release(rcvd);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_decode__context(void)
+{
+    ng_ipv6_addr_t prefix = TEST_CTX_PREFIX;
+    ng_pktsnip_t *pkt, *rcvd;
+
+    TEST_ASSERT_NOT_NULL(ng_sixlowpan_ctx_update(0, &prefix, TEST_CTX_PREFIX_LEN,
+                                                 TEST_UINT16));
+    TEST_ASSERT_NOT_NULL((pkt = _build_ipv6(true)));
+    TEST_ASSERT(ng_sixlowpan_iphc_encode(pkt));
+    /* source address derived from context 0 and L2 */
+    TEST_ASSERT_EQUAL_INT(NG_SIXLOWPAN_IPHC_HDR_LEN + 1, pkt->next->size);
+    TEST_ASSERT_EQUAL_INT(0x73, ((uint8_t *)pkt->next->data)[1]);
+    rcvd = _build_rcvd(pkt);
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT_NOT_NULL(rcvd);
+
+    TEST_ASSERT(ng_sixlowpan_iphc_decode(rcvd));
+    _check_decoded(rcvd, true);
+    ng_pktbuf_release(rcvd);
+}
+
+static void test_sixlowpan_iphc__allocs_per_packet(void)
+{
+    unsigned int enc_allocs = 0, dec_allocs = 0;
+
+    for (unsigned int i = 0; i < TEST_PACKETS; i++) {
+        ng_pktsnip_t *pkt = _build_ipv6(false), *rcvd;
+        unsigned int allocs = ng_pktbuf_alloc_count();
+
+        TEST_ASSERT_NOT_NULL(pkt);
+        TEST_ASSERT(ng_sixlowpan_iphc_encode(pkt));
+        enc_allocs += ng_pktbuf_alloc_count() - allocs;
+
+        rcvd = _build_rcvd(pkt);
+        ng_pktbuf_release(pkt);
+        TEST_ASSERT_NOT_NULL(rcvd);
+
+        allocs = ng_pktbuf_alloc_count();
+        TEST_ASSERT(ng_sixlowpan_iphc_decode(rcvd));
+        dec_allocs += ng_pktbuf_alloc_count() - allocs;
+        ng_pktbuf_release(rcvd);
+    }
+
+    printf("\n6lo iphc: allocations per packet: encode %u/%u, decode %u/%u\n",
+           enc_allocs, TEST_PACKETS, dec_allocs, TEST_PACKETS);
+    TEST_ASSERT_EQUAL_INT(0, enc_allocs);
+    /* the compressed header is shorter than the IPv6 header: one snip marks
+     * the dispatch off the payload, which shares the frame's chunk, and the
+     * IPv6 header needs a snip and data of its own */
+    TEST_ASSERT_EQUAL_INT(3 * TEST_PACKETS, dec_allocs);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+Test *tests_sixlowpan_iphc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sixlowpan_iphc_encode__in_place),
+        new_TestFixture(test_sixlowpan_iphc_encode__shared),
+        new_TestFixture(test_sixlowpan_iphc_decode__link_local),
+        new_TestFixture(test_sixlowpan_iphc_decode__context),
+        new_TestFixture(test_sixlowpan_iphc__allocs_per_packet),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlowpan_iphc_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&sixlowpan_iphc_tests;
+}
+
+void tests_sixlowpan_iphc(void)
+{
+    TESTS_RUN(tests_sixlowpan_iphc_tests());
+}
+/** @} */
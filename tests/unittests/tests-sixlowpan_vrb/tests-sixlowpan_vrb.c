@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "thread.h"
+#include "net/ng_ipv6/hdr.h"
+#include "net/ng_ipv6/nc.h"
+#include "net/ng_ipv6/netif.h"
+#include "net/ng_netapi.h"
+#include "net/ng_netif/hdr.h"
+#include "net/ng_pktbuf.h"
+#include "net/ng_sixlowpan.h"
+#include "net/ng_sixlowpan/frag.h"
+#include "net/ng_sixlowpan/netif.h"
+#include "vrb.h"
+
+#include "unittests-constants.h"
+#include "tests-sixlowpan_vrb.h"
+
+#define TEST_L2SRC          { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 }
+#define TEST_L2NEXT         { 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff }
+#define TEST_PREFIX         { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 \
+        } \
+    }
+#define TEST_OWN_IID        (0x01)
+#define TEST_DST_IID        (0x02)
+#define TEST_HL             (64U)
+#define TEST_PAYLOAD1_LEN   (8U)    /**< payload of the first fragment */
+#define TEST_PAYLOADN_LEN   (16U)   /**< payload of the last fragment */
+#define TEST_DATAGRAM_SIZE  (sizeof(ng_ipv6_hdr_t) + TEST_PAYLOAD1_LEN + \
+                             TEST_PAYLOADN_LEN)
+/* forwarded first fragment: FRAG1 header, uncompressed dispatch, IPv6 header
+ * and payload */
+#define TEST_FWD_FRAG1_LEN  (sizeof(ng_sixlowpan_frag_t) + 1 + \
+                             sizeof(ng_ipv6_hdr_t) + TEST_PAYLOAD1_LEN)
+#define TEST_MSG_QUEUE_SIZE (4U)
+
+static uint8_t l2src[] = TEST_L2SRC;
+static uint8_t l2next[] = TEST_L2NEXT;
+static msg_t msg_queue[TEST_MSG_QUEUE_SIZE];
+static kernel_pid_t iface = KERNEL_PID_UNDEF;
+
+static void _set_addr(ng_ipv6_addr_t *addr, uint8_t iid)
+{
+    ng_ipv6_addr_t prefix = TEST_PREFIX;
+
+    *addr = prefix;
+    addr->u8[15] = iid;
+}
+
+static void _setup_iface(uint16_t max_frag_size)
+{
+    ng_ipv6_addr_t addr;
+
+    /* the unittests thread is the interface: sent packets end up in its
+     * message queue */
+    if (iface == KERNEL_PID_UNDEF) {
+        iface = thread_getpid();
+        msg_init_queue(msg_queue, TEST_MSG_QUEUE_SIZE);
+    }
+
+    ng_ipv6_netif_add(iface);
+    _set_addr(&addr, TEST_OWN_IID);
+    ng_ipv6_netif_add_addr(iface, &addr, 64, NG_IPV6_NETIF_ADDR_FLAGS_NDP_ON_LINK);
+    _set_addr(&addr, TEST_DST_IID);
+    ng_ipv6_nc_add(iface, &addr, l2next, sizeof(l2next),
+                   NG_IPV6_NC_STATE_REACHABLE << NG_IPV6_NC_STATE_POS);
+    ng_sixlowpan_netif_add(iface, max_frag_size);
+#ifdef MODULE_NG_SIXLOWPAN_IPHC
+    ng_sixlowpan_netif_get(iface)->iphc_enabled = false;
+#endif
+}
+
+static void set_up(void)
+{
+    ng_pktbuf_reset();
+    ng_ipv6_netif_init();
+    ng_ipv6_nc_init();
+    ng_sixlowpan_netif_init();
+}
+
+static void tear_down(void)
+{
+    msg_t msg;
+
+    /* drop anything a failed test left behind */
+    while (msg_try_receive(&msg) == 1) {
+        if (msg.type == NG_NETAPI_MSG_TYPE_SND) {
+            ng_pktbuf_release((ng_pktsnip_t *)msg.content.ptr);
+        }
+    }
+    ng_pktbuf_reset();
+}
+
+/* builds a received fragment: fragment snip -> interface header */
+static ng_pktsnip_t *_build_frag(uint8_t *frame, size_t len)
+{
+    ng_pktsnip_t *netif = ng_netif_hdr_build(l2src, sizeof(l2src), NULL, 0);
+
+    if (netif == NULL) {
+        return NULL;
+    }
+    ((ng_netif_hdr_t *)netif->data)->if_pid = iface;
+
+    return ng_pktbuf_add(netif, frame, len, NG_NETTYPE_SIXLOWPAN);
+}
+
+static ng_pktsnip_t *_build_frag1(uint16_t tag, uint8_t dst_iid)
+{
+    uint8_t frame[sizeof(ng_sixlowpan_frag_t) + 1 + sizeof(ng_ipv6_hdr_t) +
+                  TEST_PAYLOAD1_LEN];
+    ng_sixlowpan_frag_t *frag = (ng_sixlowpan_frag_t *)frame;
+    ng_ipv6_hdr_t *hdr = (ng_ipv6_hdr_t *)&frame[sizeof(ng_sixlowpan_frag_t) + 1];
+
+    memset(frame, TEST_UINT8, sizeof(frame));
+    frag->disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+    frag->disp_size.u8[0] |= NG_SIXLOWPAN_FRAG_1_DISP;
+    frag->tag = byteorder_htons(tag);
+    frame[sizeof(ng_sixlowpan_frag_t)] = NG_SIXLOWPAN_UNCOMPRESSED;
+    memset(hdr, 0, sizeof(ng_ipv6_hdr_t));
+    ng_ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(TEST_PAYLOAD1_LEN + TEST_PAYLOADN_LEN);
+    hdr->nh = NG_PROTNUM_RESERVED;
+    hdr->hl = TEST_HL;
+    _set_addr(&hdr->src, TEST_UINT8);
+    _set_addr(&hdr->dst, dst_iid);
+
+    return _build_frag(frame, sizeof(frame));
+}
+
+/* the last fragment of the datagram */
+static ng_pktsnip_t *_build_fragn(uint16_t tag)
+{
+    uint8_t frame[sizeof(ng_sixlowpan_frag_n_t) + TEST_PAYLOADN_LEN];
+    ng_sixlowpan_frag_n_t *frag = (ng_sixlowpan_frag_n_t *)frame;
+
+    memset(frame, TEST_UINT8, sizeof(frame));
+    frag->disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+    frag->disp_size.u8[0] |= NG_SIXLOWPAN_FRAG_N_DISP;
+    frag->tag = byteorder_htons(tag);
+    frag->offset = (sizeof(ng_ipv6_hdr_t) + TEST_PAYLOAD1_LEN) / 8;
+
+    return _build_frag(frame, sizeof(frame));
+}
+
+/* gets the next packet sent to the interface, NULL if there is none */
+static ng_pktsnip_t *_sent(void)
+{
+    msg_t msg;
+
+    if ((msg_try_receive(&msg) != 1) || (msg.type != NG_NETAPI_MSG_TYPE_SND)) {
+        return NULL;
+    }
+
+    return (ng_pktsnip_t *)msg.content.ptr;
+}
+
+static void test_vrb_forward__fragments(void)
+{
+    ng_pktsnip_t *pkt, *sent;
+    ng_netif_hdr_t *netif_hdr;
+    ng_sixlowpan_frag_t *frag;
+    ng_ipv6_hdr_t *hdr;
+    uint16_t out_tag;
+
+    _setup_iface(TEST_FWD_FRAG1_LEN);
+
+    pkt = _build_frag1(TEST_UINT16, TEST_DST_IID);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(vrb_forward(pkt, 0));
+
+    TEST_ASSERT_NOT_NULL((sent = _sent()));
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_NETIF, sent->type);
+    netif_hdr = sent->data;
+    TEST_ASSERT_EQUAL_INT(iface, netif_hdr->if_pid);
+    TEST_ASSERT_EQUAL_INT(sizeof(l2next), netif_hdr->dst_l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(l2next, ng_netif_hdr_get_dst_addr(netif_hdr),
+                                    sizeof(l2next)));
+    TEST_ASSERT_EQUAL_INT(TEST_FWD_FRAG1_LEN, ng_pkt_len(sent->next));
+    frag = sent->next->data;
+    TEST_ASSERT_EQUAL_INT(NG_SIXLOWPAN_FRAG_1_DISP,
+                          frag->disp_size.u8[0] & NG_SIXLOWPAN_FRAG_DISP_MASK);
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE,
+                          byteorder_ntohs(frag->disp_size) & NG_SIXLOWPAN_FRAG_SIZE_MASK);
+    out_tag = byteorder_ntohs(frag->tag);
+    TEST_ASSERT_EQUAL_INT(NG_SIXLOWPAN_UNCOMPRESSED,
+                          *((uint8_t *)sent->next->next->data));
+    hdr = sent->next->next->next->data;
+    TEST_ASSERT_EQUAL_INT(TEST_HL - 1, hdr->hl);
+    ng_pktbuf_release(sent);
+
+    pkt = _build_fragn(TEST_UINT16);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(vrb_forward(pkt, sizeof(ng_ipv6_hdr_t) + TEST_PAYLOAD1_LEN));
+
+    TEST_ASSERT_NOT_NULL((sent = _sent()));
+    frag = sent->next->data;
+    TEST_ASSERT_EQUAL_INT(NG_SIXLOWPAN_FRAG_N_DISP,
+                          frag->disp_size.u8[0] & NG_SIXLOWPAN_FRAG_DISP_MASK);
+    TEST_ASSERT_EQUAL_INT(out_tag, byteorder_ntohs(frag->tag));
+    TEST_ASSERT_EQUAL_INT(sizeof(ng_sixlowpan_frag_n_t) + TEST_PAYLOADN_LEN,
+                          sent->next->size);
+    ng_pktbuf_release(sent);
+
+    TEST_ASSERT_NULL(_sent());
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_vrb_forward__for_this_node(void)
+{
+    ng_pktsnip_t *pkt;
+
+    _setup_iface(TEST_FWD_FRAG1_LEN);
+
+    pkt = _build_frag1(TEST_UINT16 + 1, TEST_OWN_IID);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* left untouched for reassembly */
+    TEST_ASSERT(!vrb_forward(pkt, 0));
+    TEST_ASSERT_NULL(_sent());
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_vrb_forward__no_first_fragment(void)
+{
+    ng_pktsnip_t *pkt;
+
+    _setup_iface(TEST_FWD_FRAG1_LEN);
+
+    pkt = _build_fragn(TEST_UINT16 + 2);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(!vrb_forward(pkt, sizeof(ng_ipv6_hdr_t) + TEST_PAYLOAD1_LEN));
+    TEST_ASSERT_NULL(_sent());
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_vrb_forward__first_fragment_too_big(void)
+{
+    ng_pktsnip_t *pkt;
+
+    /* the forwarded first fragment does not fit the interface */
+    _setup_iface(TEST_FWD_FRAG1_LEN - 1);
+
+    pkt = _build_frag1(TEST_UINT16 + 3, TEST_DST_IID);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(vrb_forward(pkt, 0));
+    TEST_ASSERT_NULL(_sent());
+
+    /* the rest of the datagram is dropped, not reassembled */
+    pkt = _build_fragn(TEST_UINT16 + 3);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(vrb_forward(pkt, sizeof(ng_ipv6_hdr_t) + TEST_PAYLOAD1_LEN));
+    TEST_ASSERT_NULL(_sent());
+    TEST_ASSERT(ng_pktbuf_is_empty());
+
+    /* the last fragment removed the entry */
+    pkt = _build_fragn(TEST_UINT16 + 3);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(!vrb_forward(pkt, sizeof(ng_ipv6_hdr_t) + TEST_PAYLOAD1_LEN));
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+Test *tests_sixlowpan_vrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_vrb_forward__fragments),
+        new_TestFixture(test_vrb_forward__for_this_node),
+        new_TestFixture(test_vrb_forward__no_first_fragment),
+        new_TestFixture(test_vrb_forward__first_fragment_too_big),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlowpan_vrb_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&sixlowpan_vrb_tests;
+}
+
+void tests_sixlowpan_vrb(void)
+{
+    TESTS_RUN(tests_sixlowpan_vrb_tests());
+}
+/** @} */
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "thread.h"
+#include "net/ng_ipv6/hdr.h"
+#include "net/ng_netapi.h"
+#include "net/ng_netreg.h"
+#include "net/ng_pktbuf.h"
+#include "net/ng_udp.h"
+#include "net/ng_udp/ep.h"
+
+#include "unittests-constants.h"
+#include "tests-udp_ep.h"
+
+#define TEST_PORT1          (TEST_UINT16)
+#define TEST_PORT2          (TEST_UINT16 + 1)
+#define TEST_REMOTE_PORT    (TEST_UINT16 + 2)
+#define TEST_ADDR           { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 \
+        } \
+    }
+#define TEST_MSG_TYPE       (0x1234)
+#define TEST_MSG_QUEUE_SIZE (8U)
+
+static const char payload1[] = TEST_STRING8;
+static const char payload2[] = TEST_STRING12;
+static msg_t msg_queue[TEST_MSG_QUEUE_SIZE];
+/* the unittests thread also plays the UDP thread */
+static ng_netreg_entry_t udp_thread = { NULL, NG_NETREG_DEMUX_CTX_ALL,
+                                        KERNEL_PID_UNDEF };
+/* a UDP thread that does not exist */
+static ng_netreg_entry_t dead_thread = { NULL, NG_NETREG_DEMUX_CTX_ALL,
+                                         KERNEL_PID_LAST };
+static ng_udp_ep_t ep1, ep2;
+
+static void set_up(void)
+{
+    if (udp_thread.pid == KERNEL_PID_UNDEF) {
+        udp_thread.pid = thread_getpid();
+        msg_init_queue(msg_queue, TEST_MSG_QUEUE_SIZE);
+    }
+    ng_pktbuf_reset();
+    ng_netreg_init();
+    ng_netreg_register(NG_NETTYPE_UDP, &udp_thread);
+}
+
+static void tear_down(void)
+{
+    msg_t msg;
+
+    ng_udp_ep_close(&ep1);
+    ng_udp_ep_close(&ep2);
+    /* drop anything a failed test left behind */
+    while (msg_try_receive(&msg) == 1) {
+        if ((msg.type == NG_NETAPI_MSG_TYPE_SND) ||
+            (msg.type == NG_NETAPI_MSG_TYPE_RCV)) {
+            ng_pktbuf_release((ng_pktsnip_t *)msg.content.ptr);
+        }
+    }
+    ng_pktbuf_reset();
+}
+
+/* queues a datagram for port as the UDP thread would deliver it */
+static void _deliver(uint16_t port, const char *data, size_t len)
+{
+    ng_ipv6_addr_t src = TEST_ADDR;
+    ng_pktsnip_t *ipv6, *udp, *payload;
+    ng_udp_hdr_t *udp_hdr;
+    msg_t msg;
+
+    ipv6 = ng_pktbuf_add(NULL, NULL, sizeof(ng_ipv6_hdr_t), NG_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(ipv6);
+    memset(ipv6->data, 0, ipv6->size);
+    ((ng_ipv6_hdr_t *)ipv6->data)->src = src;
+    udp = ng_pktbuf_add(ipv6, NULL, sizeof(ng_udp_hdr_t), NG_NETTYPE_UDP);
+    TEST_ASSERT_NOT_NULL(udp);
+    udp_hdr = udp->data;
+    udp_hdr->src_port = byteorder_htons(TEST_REMOTE_PORT);
+    udp_hdr->dst_port = byteorder_htons(port);
+    payload = ng_pktbuf_add(udp, (void *)data, len, NG_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(payload);
+
+    msg.type = NG_NETAPI_MSG_TYPE_RCV;
+    msg.content.ptr = (void *)payload;
+    TEST_ASSERT_EQUAL_INT(1, msg_send_to_self(&msg));
+}
+
+static void _assert_dgram(ng_udp_ep_dgram_t *dgram, const char *data,
+                          size_t len)
+{
+    ng_ipv6_addr_t src = TEST_ADDR;
+
+    TEST_ASSERT_NOT_NULL(dgram->pkt);
+    TEST_ASSERT_EQUAL_INT(len, dgram->pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, dgram->pkt->data, len));
+    TEST_ASSERT(ng_ipv6_addr_equal(&src, &dgram->addr));
+    TEST_ASSERT_EQUAL_INT(TEST_REMOTE_PORT, dgram->port);
+    ng_pktbuf_release(dgram->pkt);
+}
+
+static void test_udp_ep_create__inval(void)
+{
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ng_udp_ep_create(NULL, TEST_PORT1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ng_udp_ep_create(&ep1, 0));
+}
+
+static void test_udp_ep_create__no_udp(void)
+{
+    ng_netreg_unregister(NG_NETTYPE_UDP, &udp_thread);
+    TEST_ASSERT_EQUAL_INT(-ENOTCONN, ng_udp_ep_create(&ep1, TEST_PORT1));
+}
+
+static void test_udp_ep_create__success(void)
+{
+    ng_netreg_entry_t *entry;
+
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep1, TEST_PORT1));
+    TEST_ASSERT_NOT_NULL((entry = ng_netreg_lookup(NG_NETTYPE_UDP, TEST_PORT1)));
+    TEST_ASSERT_EQUAL_INT(thread_getpid(), entry->pid);
+    ng_udp_ep_close(&ep1);
+    TEST_ASSERT_NULL(ng_netreg_lookup(NG_NETTYPE_UDP, TEST_PORT1));
+}
+
+static void test_udp_ep_send__success(void)
+{
+    ng_ipv6_addr_t dst = TEST_ADDR;
+    ng_udp_ep_dgram_t dgram;
+    ng_pktsnip_t *pkt;
+    ng_udp_hdr_t *udp_hdr;
+    msg_t msg;
+
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep1, TEST_PORT1));
+    TEST_ASSERT_NOT_NULL((dgram.pkt = ng_udp_ep_alloc(sizeof(payload1))));
+    memcpy(dgram.pkt->data, payload1, sizeof(payload1));
+    dgram.addr = dst;
+    dgram.port = TEST_REMOTE_PORT;
+    TEST_ASSERT_EQUAL_INT(1, ng_udp_ep_send(&ep1, &dgram, 1));
+
+    TEST_ASSERT_EQUAL_INT(1, msg_try_receive(&msg));
+    TEST_ASSERT_EQUAL_INT(NG_NETAPI_MSG_TYPE_SND, msg.type);
+    pkt = (ng_pktsnip_t *)msg.content.ptr;
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_IPV6, pkt->type);
+    TEST_ASSERT(ng_ipv6_addr_equal(&dst, &((ng_ipv6_hdr_t *)pkt->data)->dst));
+    TEST_ASSERT_NOT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_UDP, pkt->next->type);
+    udp_hdr = pkt->next->data;
+    TEST_ASSERT_EQUAL_INT(TEST_PORT1, byteorder_ntohs(udp_hdr->src_port));
+    TEST_ASSERT_EQUAL_INT(TEST_REMOTE_PORT, byteorder_ntohs(udp_hdr->dst_port));
+    /* the payload was not copied */
+    TEST_ASSERT(dgram.pkt == pkt->next->next);
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_udp_ep_send__no_udp(void)
+{
+    ng_ipv6_addr_t dst = TEST_ADDR;
+    ng_udp_ep_dgram_t dgram;
+
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep1, TEST_PORT1));
+    ng_netreg_unregister(NG_NETTYPE_UDP, &udp_thread);
+    TEST_ASSERT_NOT_NULL((dgram.pkt = ng_udp_ep_alloc(sizeof(payload1))));
+    dgram.addr = dst;
+    dgram.port = TEST_REMOTE_PORT;
+    TEST_ASSERT_EQUAL_INT(-ENOTCONN, ng_udp_ep_send(&ep1, &dgram, 1));
+    /* the payload was consumed anyway */
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_udp_ep_send__not_taken(void)
+{
+    ng_ipv6_addr_t dst = TEST_ADDR;
+    ng_udp_ep_dgram_t dgrams[2];
+
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep1, TEST_PORT1));
+    ng_netreg_unregister(NG_NETTYPE_UDP, &udp_thread);
+    ng_netreg_register(NG_NETTYPE_UDP, &dead_thread);
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_NOT_NULL((dgrams[i].pkt = ng_udp_ep_alloc(sizeof(payload1))));
+        dgrams[i].addr = dst;
+        dgrams[i].port = TEST_REMOTE_PORT;
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOTCONN, ng_udp_ep_send(&ep1, dgrams, 2));
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_udp_ep_recv__timeout(void)
+{
+    ng_udp_ep_dgram_t dgram;
+
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep1, TEST_PORT1));
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_recv(&ep1, &dgram, 1, 0));
+}
+
+static void test_udp_ep_recv__success(void)
+{
+    ng_udp_ep_dgram_t dgrams[3];
+
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep1, TEST_PORT1));
+    _deliver(TEST_PORT1, payload1, sizeof(payload1));
+    _deliver(TEST_PORT1, payload2, sizeof(payload2));
+    TEST_ASSERT_EQUAL_INT(2, ng_udp_ep_recv(&ep1, dgrams, 3, 0));
+    _assert_dgram(&dgrams[0], payload1, sizeof(payload1));
+    _assert_dgram(&dgrams[1], payload2, sizeof(payload2));
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_udp_ep_recv__two_endpoints(void)
+{
+    ng_udp_ep_dgram_t dgram;
+
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep1, TEST_PORT1));
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep2, TEST_PORT2));
+    _deliver(TEST_PORT2, payload2, sizeof(payload2));
+    _deliver(TEST_PORT1, payload1, sizeof(payload1));
+
+    /* the datagram for ep2 is kept for ep2 */
+    TEST_ASSERT_EQUAL_INT(1, ng_udp_ep_recv(&ep1, &dgram, 1, 0));
+    _assert_dgram(&dgram, payload1, sizeof(payload1));
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_recv(&ep1, &dgram, 1, 0));
+    TEST_ASSERT_EQUAL_INT(1, ng_udp_ep_recv(&ep2, &dgram, 1, 0));
+    _assert_dgram(&dgram, payload2, sizeof(payload2));
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_udp_ep_recv__other_msg(void)
+{
+    ng_udp_ep_dgram_t dgram;
+    msg_t msg;
+
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep1, TEST_PORT1));
+    msg.type = TEST_MSG_TYPE;
+    msg.content.value = TEST_UINT32;
+    TEST_ASSERT_EQUAL_INT(1, msg_send_to_self(&msg));
+    _deliver(TEST_PORT1, payload1, sizeof(payload1));
+
+    TEST_ASSERT_EQUAL_INT(-EINTR, ng_udp_ep_recv(&ep1, &dgram, 1, 0));
+    /* the datagram is received on the next call, the other message stays
+     * for the thread */
+    TEST_ASSERT_EQUAL_INT(1, ng_udp_ep_recv(&ep1, &dgram, 1, 0));
+    _assert_dgram(&dgram, payload1, sizeof(payload1));
+    TEST_ASSERT_EQUAL_INT(1, msg_try_receive(&msg));
+    TEST_ASSERT_EQUAL_INT(TEST_MSG_TYPE, msg.type);
+    TEST_ASSERT_EQUAL_INT(TEST_UINT32, msg.content.value);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_udp_ep_close__release_queued(void)
+{
+    ng_udp_ep_dgram_t dgram;
+
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep1, TEST_PORT1));
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_create(&ep2, TEST_PORT2));
+    _deliver(TEST_PORT2, payload2, sizeof(payload2));
+    TEST_ASSERT_EQUAL_INT(0, ng_udp_ep_recv(&ep1, &dgram, 1, 0));
+    ng_udp_ep_close(&ep2);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+Test *tests_udp_ep_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_udp_ep_create__inval),
+        new_TestFixture(test_udp_ep_create__no_udp),
+        new_TestFixture(test_udp_ep_create__success),
+        new_TestFixture(test_udp_ep_send__success),
+        new_TestFixture(test_udp_ep_send__no_udp),
+        new_TestFixture(test_udp_ep_send__not_taken),
+        new_TestFixture(test_udp_ep_recv__timeout),
+        new_TestFixture(test_udp_ep_recv__success),
+        new_TestFixture(test_udp_ep_recv__two_endpoints),
+        new_TestFixture(test_udp_ep_recv__other_msg),
+        new_TestFixture(test_udp_ep_close__release_queued),
+    };
+
+    EMB_UNIT_TESTCALLER(udp_ep_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&udp_ep_tests;
+}
+
+void tests_udp_ep(void)
+{
+    TESTS_RUN(tests_udp_ep_tests());
+}
+/** @} */